@@ -9,11 +9,13 @@
 #include <so_5/send_functions.hpp>
 
 #include <so_5/impl/internal_env_iface.hpp>
+#include <so_5/impl/agent_migration.hpp>
 #include <so_5/impl/coop_private_iface.hpp>
 
 #include <so_5/impl/delivery_filter_storage.hpp>
 #include <so_5/impl/msg_tracing_helpers.hpp>
 #include <so_5/impl/process_unhandled_exception.hpp>
+#include <so_5/impl/resolved_handler_cache.hpp>
 #include <so_5/impl/std_message_sinks.hpp>
 #include <so_5/impl/subscription_storage_iface.hpp>
 
@@ -24,6 +26,7 @@
 #include <so_5/spinlocks.hpp>
 
 #include <algorithm>
+#include <array>
 #include <sstream>
 #include <cstdint>
 #include <cstdlib>
@@ -638,6 +641,32 @@ detect_subscription_storage_factory_to_use(
 
 } /* namespace anonymous */
 
+//
+// execution_hint_t
+//
+void
+execution_hint_t::exec( current_thread_id_t working_thread_id ) const
+{
+	// If message limit is defined then message count
+	// must be decremented.
+	message_limit::control_block_t::decrement( m_demand.m_limit );
+
+	const auto thread_id = is_thread_safe() ?
+			null_current_thread_id() : working_thread_id;
+
+	// The most frequent case is checked first.
+	if( demand_kind_t::message == m_kind )
+		agent_t::process_message(
+				thread_id,
+				m_demand,
+				m_handler->m_thread_safety,
+				m_handler->m_method );
+	else if( demand_kind_t::enveloped_msg == m_kind )
+		agent_t::process_enveloped_msg( thread_id, m_demand, m_handler );
+	else if( demand_kind_t::special == m_kind )
+		m_demand.call_handler( thread_id );
+}
+
 //
 // agent_t
 //
@@ -687,6 +716,8 @@ agent_t::agent_t(
 	,	m_priority( ctx.options().query_priority() )
 	,	m_name( ctx.options().giveout_agent_name() )
 {
+	if( ctx.options().query_resolved_handler_cache() )
+		m_handler_cache = std::make_unique< impl::resolved_handler_cache_t >();
 }
 
 agent_t::~agent_t()
@@ -896,77 +927,116 @@ agent_t::so_bind_to_dispatcher(
 	m_event_queue = actual_queue;
 }
 
+void
+agent_t::so_migrate_to_dispatcher(
+	disp_binder_shptr_t new_binder )
+{
+	ensure_operation_is_on_working_thread( "so_migrate_to_dispatcher" );
+
+	if( m_migration )
+		SO_5_THROW_EXCEPTION(
+				rc_agent_migration_in_progress,
+				"so_migrate_to_dispatcher: the previous migration isn't "
+				"completed yet" );
+
+	auto * provider = dynamic_cast< transfer_queue_provider_t * >(
+			new_binder.get() );
+	if( !provider )
+		SO_5_THROW_EXCEPTION(
+				rc_disp_binder_does_not_support_transfer,
+				"so_migrate_to_dispatcher: the binder doesn't implement "
+				"transfer_queue_provider_t interface" );
+
+	new_binder->preallocate_resources( *this );
+	so_5::details::do_with_rollback_on_exception(
+		[&] {
+			std::lock_guard< default_rw_spinlock_t > queue_lock{
+					m_event_queue_lock };
+
+			if( !m_event_queue )
+				SO_5_THROW_EXCEPTION(
+						rc_agent_cannot_be_migrated,
+						"so_migrate_to_dispatcher: the agent isn't bound to "
+						"a dispatcher or is being deregistered" );
+
+			auto migration = std::make_unique< impl::agent_migration_t >(
+					*m_event_queue, m_disp_binder );
+
+			// This demand will be handled when all demands that are
+			// already in the old queue will be handled.
+			m_event_queue->push(
+					execution_demand_t(
+							this,
+							message_limit::control_block_t::none(),
+							0,
+							typeid(void),
+							message_ref_t(),
+							&agent_t::demand_handler_on_migration ) );
+
+			// All new demands will be collected until the completion
+			// of the migration.
+			m_migration = std::move(migration);
+			m_event_queue = m_migration.get();
+		},
+		[&] { new_binder->undo_preallocation( *this ); } );
+
+	// There won't be exceptions from this point.
+	m_migration->set_new_queue(
+			*(impl::internal_env_iface_t{ m_env }.event_queue_on_bind(
+					this,
+					&(provider->bind_transferred( *this ) ) ) ) );
+
+	m_disp_binder = std::move(new_binder);
+}
+
 execution_hint_t
 agent_t::so_create_execution_hint(
 	execution_demand_t & d )
 {
-	enum class demand_type_t {
-			message, enveloped_msg, other
-	};
+	using demand_kind_t = execution_hint_t::demand_kind_t;
 
 	// We can't use message_kind_t here because there are special
 	// demands like demands for so_evt_start/so_evt_finish.
 	// Because of that a pointer to demand handler will be analyzed.
-	const auto demand_type =
-			(d.m_demand_handler == &agent_t::demand_handler_on_message ?
-				demand_type_t::message :
-				(d.m_demand_handler == &agent_t::demand_handler_on_enveloped_msg ?
-					demand_type_t::enveloped_msg : demand_type_t::other));
-
-	if( demand_type_t::other != demand_type )
+	if( d.m_demand_handler == &agent_t::demand_handler_on_message )
 		{
-			// Try to find handler for the demand.
+			// This is the most frequent case, so it's checked first.
 			auto handler = d.m_receiver->m_handler_finder(
 					d, "create_execution_hint" );
-			if( demand_type_t::message == demand_type )
-				{
-					if( handler )
-						return execution_hint_t(
-								d,
-								[handler](
-										execution_demand_t & demand,
-										current_thread_id_t thread_id ) {
-									process_message(
-											thread_id,
-											demand,
-											handler->m_thread_safety,
-											handler->m_method );
-								},
-								handler->m_thread_safety );
-					else
-						// Handler not found.
-						return execution_hint_t::create_empty_execution_hint( d );
-				}
+			if( handler )
+				return execution_hint_t(
+						d,
+						demand_kind_t::message,
+						handler,
+						handler->m_thread_safety );
 			else
-				{
-					// Execution hint for enveloped message is
-					// very similar to hint for service request.
-					return execution_hint_t(
-							d,
-							[handler](
-									execution_demand_t & demand,
-									current_thread_id_t thread_id ) {
-								process_enveloped_msg(
-										thread_id,
-										demand,
-										handler );
-							},
-							handler ? handler->m_thread_safety :
-								// If there is no real handler then
-								// there will only be actions from
-								// envelope.
-								// These actions should be thread safe.
-								thread_safe );
-				}
+				// Handler not found.
+				return execution_hint_t::create_empty_execution_hint( d );
+		}
+	else if( d.m_demand_handler == &agent_t::demand_handler_on_enveloped_msg )
+		{
+			// Execution hint for enveloped message is
+			// very similar to hint for service request.
+			auto handler = d.m_receiver->m_handler_finder(
+					d, "create_execution_hint" );
+			return execution_hint_t(
+					d,
+					demand_kind_t::enveloped_msg,
+					handler,
+					handler ? handler->m_thread_safety :
+						// If there is no real handler then
+						// there will only be actions from
+						// envelope.
+						// These actions should be thread safe.
+						thread_safe );
 		}
 	else
-		// This is demand_handler_on_start or demand_handler_on_finish.
+		// This is demand_handler_on_start, demand_handler_on_finish or
+		// one of demand handlers for the migration.
 		return execution_hint_t(
 				d,
-				[]( execution_demand_t & demand,
-					current_thread_id_t thread_id ) {
-					demand.call_handler( thread_id );
-				},
+				demand_kind_t::special,
+				nullptr,
 				not_thread_safe );
 }
 
@@ -1008,6 +1078,7 @@ void
 agent_t::destroy_all_subscriptions_and_filters() noexcept
 {
 	drop_all_delivery_filters();
+	invalidate_handler_cache();
 	m_subscriptions->drop_all_subscriptions();
 }
 
@@ -1041,7 +1112,11 @@ agent_t::shutdown_agent() noexcept
 		if( m_event_queue )
 		{
 			// This pointer will be used later.
-			actual_queue = m_event_queue;
+			// But if the migration is in progress then evt_finish will
+			// be delayed and the event queues will be released at the
+			// end of the migration.
+			if( m_event_queue != m_migration.get() )
+				actual_queue = m_event_queue;
 
 			// Final event must be pushed to queue.
 			so_5::details::invoke_noexcept_code( [&] {
@@ -1099,6 +1174,7 @@ agent_t::so_create_event_subscription(
 				so_5::rc_agent_deactivated,
 				"new subscription can't made for deactivated agent" );
 
+	invalidate_handler_cache();
 	m_subscriptions->create_event_subscription(
 			mbox_ref,
 			msg_type,
@@ -1124,6 +1200,7 @@ agent_t::so_create_deadletter_subscription(
 				so_5::rc_agent_deactivated,
 				"new deadletter handler can't be set for deactivated agent" );
 
+	invalidate_handler_cache();
 	m_subscriptions->create_event_subscription(
 			mbox,
 			msg_type,
@@ -1145,6 +1222,7 @@ agent_t::so_destroy_deadletter_subscription(
 
 	ensure_operation_is_on_working_thread( "do_drop_deadletter_handler" );
 
+	invalidate_handler_cache();
 	m_subscriptions->drop_subscription( mbox, msg_type, deadletter_state );
 }
 
@@ -1176,6 +1254,7 @@ agent_t::do_drop_subscription(
 
 	ensure_operation_is_on_working_thread( "do_drop_subscription" );
 
+	invalidate_handler_cache();
 	m_subscriptions->drop_subscription( mbox, msg_type, target_state );
 }
 
@@ -1191,6 +1270,7 @@ agent_t::do_drop_subscription_for_all_states(
 	ensure_operation_is_on_working_thread(
 			"do_drop_subscription_for_all_states" );
 
+	invalidate_handler_cache();
 	m_subscriptions->drop_subscription_for_all_states( mbox, msg_type );
 }
 
@@ -1201,7 +1281,7 @@ agent_t::do_check_subscription_presence(
 	const state_t & target_state ) const noexcept
 {
 	return nullptr != m_subscriptions->find_handler(
-			mbox->id(), msg_type, target_state );
+			mbox->id(), message_type_id_for( msg_type ), target_state );
 }
 
 bool
@@ -1210,7 +1290,7 @@ agent_t::do_check_deadletter_presence(
 	const std::type_index & msg_type ) const noexcept
 {
 	return nullptr != m_subscriptions->find_handler(
-			mbox->id(), msg_type, deadletter_state );
+			mbox->id(), message_type_id_for( msg_type ), deadletter_state );
 }
 
 namespace {
@@ -1282,6 +1362,52 @@ agent_t::push_event(
 					handler ) );
 }
 
+void
+agent_t::push_event_batch(
+	const message_limit::control_block_t * limit,
+	mbox_id_t mbox_id,
+	const std::type_index & msg_type,
+	const message_ref_t * messages,
+	std::size_t count,
+	std::size_t & pushed )
+{
+	// Demands are prepared by small chunks to avoid dynamic allocations.
+	constexpr std::size_t chunk_size = 32u;
+	std::array< execution_demand_t, chunk_size > demands;
+
+	pushed = 0u;
+
+	read_lock_guard_t< default_rw_spinlock_t > queue_lock{ m_event_queue_lock };
+
+	if( !m_event_queue )
+	{
+		// There is no queue anymore. All messages are just ignored.
+		pushed = count;
+		return;
+	}
+
+	const auto msg_type_id = message_type_id_for( msg_type );
+	while( pushed != count )
+	{
+		const auto n = std::min( chunk_size, count - pushed );
+		for( std::size_t i = 0u; i != n; ++i )
+		{
+			const auto & message = messages[ pushed + i ];
+			demands[ i ] = execution_demand_t(
+					this,
+					limit,
+					mbox_id,
+					msg_type,
+					msg_type_id,
+					message,
+					select_demand_handler_for_message( *this, message ) );
+		}
+
+		m_event_queue->push_batch( demands.data(), n );
+		pushed += n;
+	}
+}
+
 void
 agent_t::demand_handler_on_start(
 	current_thread_id_t working_thread_id,
@@ -1366,6 +1492,63 @@ agent_t::get_demand_handler_on_finish_ptr() noexcept
 	return &agent_t::demand_handler_on_finish;
 }
 
+void
+agent_t::demand_handler_on_migration(
+	current_thread_id_t /*working_thread_id*/,
+	execution_demand_t & d )
+{
+	d.m_receiver->complete_migration();
+}
+
+void
+agent_t::demand_handler_on_old_binder_release(
+	current_thread_id_t /*working_thread_id*/,
+	execution_demand_t & d )
+{
+	const auto & msg = dynamic_cast< const impl::msg_release_old_binder_t & >(
+			*(d.m_message_ref) );
+	msg.m_binder->unbind( *(d.m_receiver) );
+}
+
+void
+agent_t::complete_migration() noexcept
+{
+	event_queue_t * old_queue = nullptr;
+	event_queue_t * new_queue = nullptr;
+	bool finished = false;
+	{
+		std::lock_guard< default_rw_spinlock_t > queue_lock{ m_event_queue_lock };
+
+		old_queue = &(m_migration->old_queue());
+		new_queue = &(m_migration->new_queue());
+
+		// If some demand can't be stored there is no way to recover.
+		so_5::details::invoke_noexcept_code( [&] {
+				finished = m_migration->flush_to_new_queue(
+						execution_demand_t(
+								this,
+								message_limit::control_block_t::none(),
+								0,
+								typeid(void),
+								message_ref_t(),
+								&agent_t::demand_handler_on_old_binder_release ) );
+			} );
+
+		// If evt_finish was delayed then m_event_queue is already nullptr.
+		if( !finished )
+			m_event_queue = new_queue;
+
+		m_migration.reset();
+	}
+
+	impl::internal_env_iface_t{ m_env }
+			.event_queue_on_unbind( this, old_queue );
+	if( finished )
+		// shutdown_agent() didn't release the new queue.
+		impl::internal_env_iface_t{ m_env }
+				.event_queue_on_unbind( this, new_queue );
+}
+
 void
 agent_t::demand_handler_on_message(
 	current_thread_id_t working_thread_id,
@@ -1559,6 +1742,13 @@ agent_t::handler_finder_msg_tracing_disabled(
 	execution_demand_t & d,
 	const char * /*context_marker*/ )
 {
+	if( d.m_receiver->m_handler_cache )
+	{
+		const auto handlers = find_handlers_via_cache( d );
+		return handlers.m_handler ?
+				handlers.m_handler : handlers.m_deadletter_handler;
+	}
+
 	auto search_result = find_event_handler_for_current_state( d );
 	if( !search_result )
 		// Since v.5.5.21 we should check for deadletter handler for that demand.
@@ -1572,12 +1762,21 @@ agent_t::handler_finder_msg_tracing_enabled(
 	execution_demand_t & d,
 	const char * context_marker )
 {
-	auto search_result = find_event_handler_for_current_state( d );
+	// Since v.5.8.3 handlers can be taken from the cache.
+	const auto handlers = d.m_receiver->m_handler_cache ?
+			find_handlers_via_cache( d ) :
+			impl::resolved_handlers_t{
+					find_event_handler_for_current_state( d ),
+					nullptr };
+
+	auto search_result = handlers.m_handler;
 
 	if( !search_result )
 	{
 		// Since v.5.5.21 we should check for deadletter handler for that demand.
-		search_result = find_deadletter_handler( d );
+		search_result = d.m_receiver->m_handler_cache ?
+				handlers.m_deadletter_handler :
+				find_deadletter_handler( d );
 
 		if( search_result )
 		{
@@ -1611,7 +1810,7 @@ agent_t::find_event_handler_for_current_state(
 	do {
 		search_result = d.m_receiver->m_subscriptions->find_handler(
 				d.m_mbox_id,
-				d.m_msg_type, 
+				d.m_msg_type_id,
 				*s );
 
 		if( !search_result )
@@ -1628,10 +1827,36 @@ agent_t::find_deadletter_handler(
 {
 	return demand.m_receiver->m_subscriptions->find_handler(
 			demand.m_mbox_id,
-			demand.m_msg_type,
+			demand.m_msg_type_id,
 			deadletter_state );
 }
 
+impl::resolved_handlers_t
+agent_t::find_handlers_via_cache(
+	execution_demand_t & demand )
+{
+	auto & receiver = *demand.m_receiver;
+	return receiver.m_handler_cache->find_or_resolve(
+			receiver.so_current_state(),
+			demand.m_mbox_id,
+			demand.m_msg_type_id,
+			[&demand] {
+				impl::resolved_handlers_t result;
+				result.m_handler = find_event_handler_for_current_state( demand );
+				if( !result.m_handler )
+					result.m_deadletter_handler = find_deadletter_handler( demand );
+
+				return result;
+			} );
+}
+
+void
+agent_t::invalidate_handler_cache() noexcept
+{
+	if( m_handler_cache )
+		m_handler_cache->clear();
+}
+
 void
 agent_t::do_change_agent_state(
 	const state_t & state_to_be_set )
@@ -680,6 +680,9 @@ class SO_5_TYPE agent_t
 
 		friend class so_5::enveloped_msg::impl::agent_demand_handler_invoker_t;
 
+		// Since v.5.8.3 execution_hint_t calls agent's internals directly.
+		friend class so_5::execution_hint_t;
+
 		template< typename T >
 		friend class intrusive_ptr_t;
 
@@ -1044,6 +1047,27 @@ class SO_5_TYPE agent_t
 				agent.push_event( limit, mbox_id, msg_type, message );
 			}
 
+		//! Push several events of the same type to the agent's event queue.
+		/*!
+			This method is used by SObjectizer for the 
+			agent's event scheduling.
+
+			\since v.5.8.3
+		*/
+		static inline void
+		call_push_event_batch(
+			agent_t & agent,
+			const message_limit::control_block_t * limit,
+			mbox_id_t mbox_id,
+			const std::type_index & msg_type,
+			const message_ref_t * messages,
+			std::size_t count,
+			std::size_t & pushed )
+			{
+				agent.push_event_batch(
+						limit, mbox_id, msg_type, messages, count, pushed );
+			}
+
 		/*!
 		 * \brief Get the agent's direct mbox.
 		 *
@@ -2348,6 +2372,60 @@ class SO_5_TYPE agent_t
 			//! Actual event queue for an agent.
 			event_queue_t & queue ) noexcept;
 
+		/*!
+		 * \brief Move the agent to another dispatcher.
+		 *
+		 * The agent continues its work on the dispatcher specified
+		 * by \a new_binder. The migration is performed asynchronously:
+		 * - all demands already queued for the agent on the current
+		 *   dispatcher are handled on the current dispatcher;
+		 * - all demands sent to the agent after the call to
+		 *   so_migrate_to_dispatcher() are delayed and then passed to
+		 *   the new dispatcher in the original order;
+		 * - the agent is never run on two dispatchers at the same time;
+		 * - so_evt_start() isn't called again, so_evt_finish() will be
+		 *   called on the dispatcher where the agent is at the moment
+		 *   of deregistration.
+		 *
+		 * The binder for the new dispatcher must implement
+		 * so_5::transfer_queue_provider_t interface. All standard dispatchers
+		 * implement it.
+		 *
+		 * \par Usage sample
+		 * \code
+		 * class worker final : public so_5::agent_t {
+		 * 	so_5::disp_binder_shptr_t m_heavy_disp;
+		 * ...
+		 * 	void on_heavy_mode(mhood_t<heavy_mode_on>) {
+		 * 		// All next events will be handled on the another dispatcher.
+		 * 		so_migrate_to_dispatcher( m_heavy_disp );
+		 * 	}
+		 * };
+		 * \endcode
+		 *
+		 * \note
+		 * This method can be called only on agent's working thread.
+		 *
+		 * \attention
+		 * The migration to the same dispatcher where the agent
+		 * works now isn't supported.
+		 *
+		 * \throw so_5::exception_t with rc_disp_binder_does_not_support_transfer
+		 * if \a new_binder doesn't implement so_5::transfer_queue_provider_t.
+		 *
+		 * \throw so_5::exception_t with rc_agent_migration_in_progress if
+		 * the previous migration isn't completed yet.
+		 *
+		 * \throw so_5::exception_t with rc_agent_cannot_be_migrated if
+		 * the agent isn't bound to a dispatcher or is being deregistered.
+		 *
+		 * \since v.5.8.3
+		 */
+		void
+		so_migrate_to_dispatcher(
+			//! Binder for the new dispatcher.
+			disp_binder_shptr_t new_binder );
+
 		/*!
 		 * \brief Create execution hint for the specified demand.
 		 *
@@ -2889,6 +2967,16 @@ class SO_5_TYPE agent_t
 		 */
 		std::unique_ptr< impl::delivery_filter_storage_t > m_delivery_filters;
 
+		/*!
+		 * \brief Cache of resolved event handlers.
+		 *
+		 * \note It's created only if the cache is turned on in
+		 * agent's tuning options.
+		 *
+		 * \since v.5.8.3
+		 */
+		std::unique_ptr< impl::resolved_handler_cache_t > m_handler_cache;
+
 		/*!
 		 * \brief Priority of the agent.
 		 *
@@ -2914,6 +3002,20 @@ class SO_5_TYPE agent_t
 		 */
 		disp_binder_shptr_t m_disp_binder;
 
+		/*!
+		 * \brief State of the migration to another dispatcher.
+		 *
+		 * Isn't empty only while the migration is in progress. In that
+		 * case m_event_queue points to this object.
+		 *
+		 * \attention
+		 * It's changed only on agent's working thread under acquired
+		 * m_event_queue_lock.
+		 *
+		 * \since v.5.8.3
+		 */
+		std::unique_ptr< impl::agent_migration_t > m_migration;
+
 		/*!
 		 * \brief Optional name for the agent.
 		 *
@@ -2972,6 +3074,15 @@ class SO_5_TYPE agent_t
 		 */
 		void
 		shutdown_agent() noexcept;
+
+		/*!
+		 * \brief Switch the agent to the new event queue at the end
+		 * of the migration.
+		 *
+		 * \since v.5.8.3
+		 */
+		void
+		complete_migration() noexcept;
 		/*!
 		 * \}
 		 */
@@ -3063,6 +3174,31 @@ class SO_5_TYPE agent_t
 			const std::type_index & msg_type,
 			//! Event message.
 			const message_ref_t & message );
+
+		//! Push several events of the same type into the event queue.
+		/*!
+		 * Demands are prepared by chunks of fixed size on the stack and
+		 * every chunk is passed to event_queue_t::push_batch().
+		 *
+		 * \since v.5.8.3
+		 */
+		void
+		push_event_batch(
+			//! Optional message limit.
+			const message_limit::control_block_t * limit,
+			//! ID of mbox for this event.
+			mbox_id_t mbox_id,
+			//! Message type for event.
+			const std::type_index & msg_type,
+			//! Pointer to the first event message.
+			const message_ref_t * messages,
+			//! Count of event messages.
+			std::size_t count,
+			//! Receiver for the count of messages that were pushed to
+			//! the queue (or ignored because there is no queue anymore).
+			//! It's updated after every successful push_batch() call and
+			//! allows to handle exceptions properly.
+			std::size_t & pushed );
 		/*!
 		 * \}
 		 */
@@ -3152,6 +3288,31 @@ class SO_5_TYPE agent_t
 		 */
 		static demand_handler_pfn_t
 		get_demand_handler_on_enveloped_msg_ptr() noexcept;
+
+		/*!
+		 * \brief Completes the migration of the agent to another dispatcher.
+		 *
+		 * It's called on the old dispatcher when all demands from the
+		 * old event queue are handled.
+		 *
+		 * \since v.5.8.3
+		 */
+		static void
+		demand_handler_on_migration(
+			current_thread_id_t working_thread_id,
+			execution_demand_t & d );
+
+		/*!
+		 * \brief Releases the old dispatcher after the migration of the agent.
+		 *
+		 * It's the first demand handled on the new dispatcher.
+		 *
+		 * \since v.5.8.3
+		 */
+		static void
+		demand_handler_on_old_binder_release(
+			current_thread_id_t working_thread_id,
+			execution_demand_t & d );
 		/*!
 		 * \}
 		 */
@@ -3285,6 +3446,29 @@ class SO_5_TYPE agent_t
 		find_deadletter_handler(
 			execution_demand_t & demand );
 
+		/*!
+		 * \brief Search for event handlers via the cache of
+		 * resolved handlers.
+		 *
+		 * \pre The cache is turned on for the receiver of \a demand.
+		 *
+		 * \since v.5.8.3
+		 */
+		static impl::resolved_handlers_t
+		find_handlers_via_cache(
+			execution_demand_t & demand );
+
+		/*!
+		 * \brief Invalidate the cache of resolved event handlers (if
+		 * it's turned on).
+		 *
+		 * Should be called on every change of subscriptions.
+		 *
+		 * \since v.5.8.3
+		 */
+		void
+		invalidate_handler_cache() noexcept;
+
 		/*!
 		 * \brief Perform actual operations related to state switch.
 		 *
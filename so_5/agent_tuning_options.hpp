@@ -213,6 +213,7 @@ class agent_tuning_options_t
 				swap( a.m_is_user_provided_subscription_storage_factory,
 						b.m_is_user_provided_subscription_storage_factory );
 				swap( a.m_agent_name, b.m_agent_name );
+				swap( a.m_resolved_handler_cache, b.m_resolved_handler_cache );
 			}
 
 		//! Set factory for subscription storage creation.
@@ -376,6 +377,46 @@ class agent_tuning_options_t
 				return name_for_agent_t{ std::move(m_agent_name) };
 			}
 
+		/*!
+		 * \brief Turn the cache of resolved event handlers on or off.
+		 *
+		 * If the cache is turned on then an agent remembers the event
+		 * handler found for (current state, mbox, message type).
+		 * It makes the search of an event handler a single lookup
+		 * regardless of the nesting depth of the current state.
+		 * It can be useful for agents with deep hierarchical state
+		 * machines. The cache is cleared on every change of agent's
+		 * subscriptions.
+		 *
+		 * The cache is turned off by default.
+		 *
+		 * Usage example:
+		 * \code
+		 * env.make_agent< my_agent >( so_5::agent_t::tuning_options()
+		 * 		.resolved_handler_cache( true ) );
+		 * \endcode
+		 *
+		 * \since v.5.8.3
+		 */
+		agent_tuning_options_t &
+		resolved_handler_cache( bool enabled ) noexcept
+			{
+				m_resolved_handler_cache = enabled;
+				return *this;
+			}
+
+		/*!
+		 * \brief Is the cache of resolved event handlers turned on?
+		 *
+		 * \since v.5.8.3
+		 */
+		[[nodiscard]]
+		bool
+		query_resolved_handler_cache() const noexcept
+			{
+				return m_resolved_handler_cache;
+			}
+
 	private :
 		//FIXME(v.5.9.0): this member has to be changed to:
 		//
@@ -417,6 +458,13 @@ class agent_tuning_options_t
 		 * \since v.5.8.2
 		 */
 		name_for_agent_t m_agent_name;
+
+		/*!
+		 * \brief Is the cache of resolved event handlers turned on?
+		 *
+		 * \since v.5.8.3
+		 */
+		bool m_resolved_handler_cache{ false };
 	};
 
 } /* namespace so_5 */
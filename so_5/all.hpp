@@ -28,9 +28,11 @@
 #include <so_5/disp/nef_one_thread/pub.hpp>
 #include <so_5/disp/active_obj/pub.hpp>
 #include <so_5/disp/active_group/pub.hpp>
+#include <so_5/disp/balancing_one_thread/pub.hpp>
 #include <so_5/disp/thread_pool/pub.hpp>
 #include <so_5/disp/adv_thread_pool/pub.hpp>
 #include <so_5/disp/nef_thread_pool/pub.hpp>
+#include <so_5/disp/work_stealing_pool/pub.hpp>
 #include <so_5/disp/prio_one_thread/strictly_ordered/pub.hpp>
 #include <so_5/disp/prio_one_thread/quoted_round_robin/pub.hpp>
 #include <so_5/disp/prio_dedicated_threads/one_per_prio/pub.hpp>
@@ -38,6 +40,8 @@
 #include <so_5/version.hpp>
 
 #include <so_5/unique_subscribers_mbox.hpp>
+#include <so_5/snapshot_mbox.hpp>
+#include <so_5/named_mbox_handle.hpp>
 
 #include <so_5/bind_transformer_helpers.hpp>
 
@@ -0,0 +1,338 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \file
+ * \brief A std::function-like type-erased callable with inline storage.
+ *
+ * \since v.5.8.3
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace so_5 {
+
+namespace details {
+
+namespace inplace_function_details {
+
+//! Operations to be performed by a manager function.
+enum class operation_t
+	{
+		//! Copy-construct object from the source storage to the destination.
+		copy,
+		//! Move-construct object from the source storage to the destination
+		//! and destroy the source object.
+		move,
+		//! Destroy object in the destination storage.
+		destroy
+	};
+
+//! Can an object of type \a F be stored inside a buffer of \a Capacity bytes?
+template< typename F, std::size_t Capacity >
+constexpr bool fits_inline_v =
+		sizeof(F) <= Capacity &&
+		alignof(F) <= alignof(std::max_align_t) &&
+		std::is_nothrow_move_constructible_v< F >;
+
+//! Is \a F a pointer which can be null?
+template< typename F >
+constexpr bool is_nullable_pointer_v =
+		std::is_pointer_v< F > || std::is_member_pointer_v< F >;
+
+} /* namespace inplace_function_details */
+
+template< typename Signature, std::size_t Capacity >
+class inplace_function_t;
+
+//
+// inplace_function_t
+//
+/*!
+ * \brief A replacement for std::function that stores small callables
+ * without dynamic memory allocation.
+ *
+ * Implementations of std::function have a small internal buffer
+ * (usually for 2 pointers). Callables which don't fit into it are
+ * allocated in the heap. It means that a lambda which captures a pointer
+ * to an agent and a pointer to a member function (a typical event handler)
+ * requires an allocation for every copy of std::function.
+ *
+ * inplace_function_t has an internal buffer of \a Capacity bytes.
+ * A callable that fits into that buffer (and has a noexcept move
+ * constructor) is stored inline. Bigger callables are still supported,
+ * but they are allocated in the heap.
+ *
+ * Like std::function this type is copyable. A call of an empty
+ * object throws std::bad_function_call.
+ *
+ * \note
+ * The stored callable is called as a non-const object even if
+ * operator() is called for a const inplace_function_t (as it is done
+ * by std::function).
+ *
+ * \since v.5.8.3
+ */
+template< typename R, typename... Args, std::size_t Capacity >
+class inplace_function_t< R(Args...), Capacity >
+	{
+		using operation_t = inplace_function_details::operation_t;
+
+		//! Type of pointer to function that calls stored callable.
+		using invoker_t = R (*)( void *, Args &&... );
+
+		//! Type of pointer to function that copies/moves/destroys
+		//! stored callable.
+		using manager_t = void (*)( operation_t, void *, void * );
+
+		//! Is \a F the type to be stored inline?
+		template< typename F >
+		static constexpr bool is_inline_v =
+				inplace_function_details::fits_inline_v< F, Capacity >;
+
+		//! Is \a F suitable for this type of inplace_function_t?
+		template< typename F >
+		static constexpr bool is_acceptable_callable_v =
+				!std::is_same_v< std::decay_t< F >, inplace_function_t > &&
+				std::is_invocable_r_v< R, std::decay_t< F > &, Args... >;
+
+	public :
+		//! Size of the internal buffer.
+		static constexpr std::size_t capacity = Capacity;
+
+		//! Default constructor makes an empty object.
+		inplace_function_t() noexcept = default;
+
+		//! Constructor for an empty object.
+		inplace_function_t( std::nullptr_t ) noexcept {}
+
+		//! Constructor from a callable object.
+		template<
+			typename F,
+			typename = std::enable_if_t< is_acceptable_callable_v< F > > >
+		inplace_function_t( F && f )
+			{
+				using D = std::decay_t< F >;
+
+				if constexpr( inplace_function_details::is_nullable_pointer_v< D > )
+					{
+						// Null pointer has to produce an empty object.
+						if( nullptr == f )
+							return;
+					}
+
+				if constexpr( is_inline_v< D > )
+					::new( static_cast< void * >( m_storage ) )
+							D( std::forward< F >(f) );
+				else
+					::new( static_cast< void * >( m_storage ) )
+							D*( new D( std::forward< F >(f) ) );
+
+				m_invoker = &invoke_impl< D >;
+				m_manager = &manage_impl< D >;
+			}
+
+		inplace_function_t( const inplace_function_t & o )
+			{
+				if( o.m_manager )
+					{
+						o.m_manager( operation_t::copy, m_storage, o.m_storage );
+						m_invoker = o.m_invoker;
+						m_manager = o.m_manager;
+					}
+			}
+
+		inplace_function_t( inplace_function_t && o ) noexcept
+			{
+				take_from( o );
+			}
+
+		~inplace_function_t()
+			{
+				reset();
+			}
+
+		friend void
+		swap( inplace_function_t & a, inplace_function_t & b ) noexcept
+			{
+				inplace_function_t tmp{ std::move(a) };
+				a.take_from( b );
+				b.take_from( tmp );
+			}
+
+		inplace_function_t &
+		operator=( const inplace_function_t & o )
+			{
+				inplace_function_t tmp{ o };
+				swap( *this, tmp );
+				return *this;
+			}
+
+		inplace_function_t &
+		operator=( inplace_function_t && o ) noexcept
+			{
+				if( this != &o )
+					{
+						reset();
+						take_from( o );
+					}
+				return *this;
+			}
+
+		inplace_function_t &
+		operator=( std::nullptr_t ) noexcept
+			{
+				reset();
+				return *this;
+			}
+
+		template<
+			typename F,
+			typename = std::enable_if_t< is_acceptable_callable_v< F > > >
+		inplace_function_t &
+		operator=( F && f )
+			{
+				inplace_function_t tmp{ std::forward< F >(f) };
+				swap( *this, tmp );
+				return *this;
+			}
+
+		//! Does this object hold a callable?
+		explicit operator bool() const noexcept
+			{
+				return nullptr != m_manager;
+			}
+
+		//! Call the stored callable.
+		/*!
+		 * \throw std::bad_function_call if the object is empty.
+		 */
+		R
+		operator()( Args... args ) const
+			{
+				return m_invoker( m_storage, std::forward< Args >(args)... );
+			}
+
+	private :
+		//! Storage for the callable or for a pointer to heap-allocated
+		//! callable.
+		alignas(std::max_align_t) mutable unsigned char m_storage[ Capacity ];
+
+		//! Pointer to function that calls the stored callable.
+		/*!
+		 * It is never null, an empty object uses invoke_empty().
+		 */
+		invoker_t m_invoker{ &invoke_empty };
+
+		//! Pointer to function that manages the stored callable.
+		/*!
+		 * Null for an empty object.
+		 */
+		manager_t m_manager{ nullptr };
+
+		static_assert( Capacity >= sizeof(void *),
+				"Capacity must be enough to hold a pointer" );
+
+		template< typename D >
+		static D *
+		object_from( void * storage ) noexcept
+			{
+				if constexpr( is_inline_v< D > )
+					return std::launder( reinterpret_cast< D * >( storage ) );
+				else
+					return *std::launder( reinterpret_cast< D ** >( storage ) );
+			}
+
+		static R
+		invoke_empty( void *, Args &&... )
+			{
+				throw std::bad_function_call{};
+			}
+
+		template< typename D >
+		static R
+		invoke_impl( void * storage, Args &&... args )
+			{
+				if constexpr( std::is_void_v< R > )
+					std::invoke( *object_from< D >( storage ),
+							std::forward< Args >(args)... );
+				else
+					return std::invoke( *object_from< D >( storage ),
+							std::forward< Args >(args)... );
+			}
+
+		template< typename D >
+		static void
+		manage_impl( operation_t op, void * dest, void * src )
+			{
+				switch( op )
+					{
+					case operation_t::copy :
+						if constexpr( is_inline_v< D > )
+							::new( dest ) D( *object_from< D >( src ) );
+						else
+							::new( dest ) D*( new D( *object_from< D >( src ) ) );
+					break;
+
+					case operation_t::move :
+						if constexpr( is_inline_v< D > )
+							{
+								D * s = object_from< D >( src );
+								::new( dest ) D( std::move(*s) );
+								s->~D();
+							}
+						else
+							// Only the pointer has to be moved.
+							::new( dest ) D*( object_from< D >( src ) );
+					break;
+
+					case operation_t::destroy :
+						if constexpr( is_inline_v< D > )
+							object_from< D >( dest )->~D();
+						else
+							delete object_from< D >( dest );
+					break;
+					}
+			}
+
+		//! Take the content from \a o and make \a o empty.
+		/*!
+		 * \pre this object is empty.
+		 */
+		void
+		take_from( inplace_function_t & o ) noexcept
+			{
+				if( o.m_manager )
+					{
+						o.m_manager( operation_t::move, m_storage, o.m_storage );
+						m_invoker = o.m_invoker;
+						m_manager = o.m_manager;
+
+						o.m_invoker = &invoke_empty;
+						o.m_manager = nullptr;
+					}
+			}
+
+		void
+		reset() noexcept
+			{
+				if( m_manager )
+					{
+						m_manager( operation_t::destroy, m_storage, nullptr );
+						m_invoker = &invoke_empty;
+						m_manager = nullptr;
+					}
+			}
+	};
+
+} /* namespace details */
+
+} /* namespace so_5 */
+
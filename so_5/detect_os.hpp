@@ -40,6 +40,15 @@
  * \brief A marker for macOS/iOS.
  */
 
+/*!
+ * \def SO_5_OS_LINUX
+ * \brief A marker for Linux.
+ *
+ * \note SO_5_OS_UNIX is also defined for Linux.
+ *
+ * \since v.5.8.3
+ */
+
 #if defined( _WIN64 )
 	#define SO_5_OS_WIN64
 #endif
@@ -60,3 +69,6 @@
 	#define SO_5_OS_APPLE
 #endif
 
+#if defined(__linux__)
+	#define SO_5_OS_LINUX
+#endif
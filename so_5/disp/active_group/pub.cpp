@@ -140,7 +140,9 @@ using actual_dispatcher_iface_shptr_t =
  * \since
  * v.5.6.0
  */
-class actual_binder_t final : public disp_binder_t
+class actual_binder_t final
+	:	public disp_binder_t
+	,	public transfer_queue_provider_t
 	{
 		//! Dispatcher to be used.
 		actual_dispatcher_iface_shptr_t m_disp;
@@ -173,8 +175,7 @@ class actual_binder_t final : public disp_binder_t
 		bind(
 			agent_t & agent ) noexcept override
 			{
-				auto queue = m_disp->query_thread_for_group( m_group_name );
-				agent.so_bind_to_dispatcher( *queue );
+				agent.so_bind_to_dispatcher( bind_transferred( agent ) );
 			}
 
 		void
@@ -183,6 +184,13 @@ class actual_binder_t final : public disp_binder_t
 			{
 				m_disp->release_thread_for_group( m_group_name );
 			}
+
+		event_queue_t &
+		bind_transferred(
+			agent_t & /*agent*/ ) noexcept override
+			{
+				return *(m_disp->query_thread_for_group( m_group_name ));
+			}
 	};
 
 //
@@ -380,6 +388,11 @@ class dispatcher_template_t final : public actual_dispatcher_iface_t
 								stats::suffixes::work_thread_queue_size(),
 								wt.m_thread->demands_count() );
 
+						so_5::disp::reuse::send_wakeup_stats(
+								mbox,
+								prefix,
+								wt.m_thread->wakeup_stats() );
+
 						send_thread_activity_stats(
 								mbox,
 								prefix,
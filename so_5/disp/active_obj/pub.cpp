@@ -91,6 +91,35 @@ send_thread_activity_stats(
 				wt.take_activity_stats() );
 	}
 
+/*!
+ * \since v.5.8.3
+ */
+void
+send_thread_activity_stats(
+	const so_5::mbox_t &,
+	const stats::prefix_t &,
+	work_thread::lock_free_work_thread_no_activity_tracking_t & )
+	{
+		/* Nothing to do */
+	}
+
+/*!
+ * \since v.5.8.3
+ */
+void
+send_thread_activity_stats(
+	const so_5::mbox_t & mbox,
+	const stats::prefix_t & prefix,
+	work_thread::lock_free_work_thread_with_activity_tracking_t & wt )
+	{
+		so_5::send< stats::messages::work_thread_activity >(
+				mbox,
+				prefix,
+				stats::suffixes::work_thread_activity(),
+				wt.thread_id(),
+				wt.take_activity_stats() );
+	}
+
 } /* anonymous */
 
 //
@@ -101,7 +130,9 @@ send_thread_activity_stats(
  * \brief Implementation of active object dispatcher in form of template class.
  */
 template< typename Work_Thread >
-class dispatcher_template_t final : public disp_binder_t
+class dispatcher_template_t final
+	:	public disp_binder_t
+	,	public transfer_queue_provider_t
 	{
 	public:
 		dispatcher_template_t(
@@ -147,6 +178,9 @@ class dispatcher_template_t final : public disp_binder_t
 						acquire_work_thread( m_params, m_env.get() ),
 						std::move(lock_factory) );
 
+				if( m_params.same_thread_delivery() )
+					thread->turn_same_thread_delivery_on();
+
 				thread->start();
 				so_5::details::do_with_rollback_on_exception(
 						[&] { m_agent_threads[ &agent ] = thread; },
@@ -174,12 +208,7 @@ class dispatcher_template_t final : public disp_binder_t
 		bind(
 			agent_t & agent ) noexcept override
 			{
-				const auto get_queue = [&] {
-					std::lock_guard< std::mutex > lock{ m_lock };
-					return m_agent_threads.find( &agent )->second->get_agent_binding();
-				};
-
-				agent.so_bind_to_dispatcher( *get_queue() );
+				agent.so_bind_to_dispatcher( bind_transferred( agent ) );
 			}
 
 		void
@@ -190,6 +219,14 @@ class dispatcher_template_t final : public disp_binder_t
 				undo_preallocation( agent );
 			}
 
+		event_queue_t &
+		bind_transferred(
+			agent_t & agent ) noexcept override
+			{
+				std::lock_guard< std::mutex > lock{ m_lock };
+				return *(m_agent_threads.find( &agent )->second->get_agent_binding());
+			}
+
 	private:
 		friend class disp_data_source_t;
 
@@ -258,6 +295,8 @@ class dispatcher_template_t final : public disp_binder_t
 						const stats::prefix_t wt_prefix{ ss.str() };
 
 						send_demands_count_stats( mbox, wt_prefix, wt );
+						so_5::disp::reuse::send_wakeup_stats(
+								mbox, wt_prefix, wt.wakeup_stats() );
 						send_thread_activity_stats( mbox, wt_prefix, wt );
 					}
 			};
@@ -330,13 +369,32 @@ make_dispatcher(
 				impl::dispatcher_template_t<
 						work_thread::work_thread_with_activity_tracking_t >;
 
-		disp_binder_shptr_t binder = so_5::disp::reuse::make_actual_dispatcher<
-						disp_binder_t,
-						dispatcher_no_activity_tracking_t,
-						dispatcher_with_activity_tracking_t >(
-				outliving_mutable(env),
-				data_sources_name_base,
-				std::move(params) );
+		using lock_free_dispatcher_no_activity_tracking_t =
+				impl::dispatcher_template_t<
+						work_thread::lock_free_work_thread_no_activity_tracking_t >;
+
+		using lock_free_dispatcher_with_activity_tracking_t =
+				impl::dispatcher_template_t<
+						work_thread::lock_free_work_thread_with_activity_tracking_t >;
+
+		disp_binder_shptr_t binder;
+		if( queue_traits::demand_queue_kind_t::lock_free ==
+				params.demand_queue_kind() )
+			binder = so_5::disp::reuse::make_actual_dispatcher<
+							disp_binder_t,
+							lock_free_dispatcher_no_activity_tracking_t,
+							lock_free_dispatcher_with_activity_tracking_t >(
+					outliving_mutable(env),
+					data_sources_name_base,
+					std::move(params) );
+		else
+			binder = so_5::disp::reuse::make_actual_dispatcher<
+							disp_binder_t,
+							dispatcher_no_activity_tracking_t,
+							dispatcher_with_activity_tracking_t >(
+					outliving_mutable(env),
+					data_sources_name_base,
+					std::move(params) );
 
 		return impl::dispatcher_handle_maker_t::make( std::move(binder) );
 	}
@@ -25,7 +25,11 @@
 
 #include <so_5/impl/thread_join_stuff.hpp>
 
+#include <so_5/details/rollback_on_exception.hpp>
+
+#include <atomic>
 #include <forward_list>
+#include <mutex>
 
 #if 0
 	#define SO_5_CHECK_INVARIANT_IMPL(what, data, file, line) \
@@ -58,10 +62,379 @@ class agent_queue_t;
 namespace stats = so_5::stats;
 namespace tp_stats = so_5::disp::reuse::thread_pool_stats;
 
+//
+// demand_node_t
+//
+/*!
+ * \brief Actual demand in event queue.
+ *
+ * \note
+ * It was a nested type agent_queue_t::demand_t before v.5.8.3.
+ *
+ * \since v.5.8.3
+ */
+struct demand_node_t
+	{
+		//! Actual demand.
+		execution_demand_t m_demand;
+
+		//! Next item in queue.
+		demand_node_t * m_next;
+
+		demand_node_t()
+			:	m_next( nullptr )
+			{}
+		demand_node_t( execution_demand_t && original )
+			:	m_demand( std::move( original ) )
+			,	m_next( nullptr )
+			{}
+	};
+
+//
+// demand_node_cache_t
+//
+/*!
+ * \brief A bounded cache of demand nodes owned by one work thread.
+ *
+ * A work thread puts nodes of already extracted demands into its cache.
+ * Those nodes are reused when the same work thread pushes a new demand
+ * to any agent_queue. It means that an event handler that sends messages
+ * to agents from adv_thread_pool dispatcher doesn't allocate demand nodes
+ * in the steady state.
+ *
+ * \attention
+ * All methods except counter getters have to be called only from
+ * the owner thread.
+ *
+ * \since v.5.8.3
+ */
+class demand_node_cache_t
+	{
+	public :
+		explicit demand_node_cache_t( std::size_t capacity ) noexcept
+			:	m_capacity{ capacity }
+			{}
+
+		demand_node_cache_t( const demand_node_cache_t & ) = delete;
+		demand_node_cache_t & operator=( const demand_node_cache_t & ) = delete;
+
+		~demand_node_cache_t() noexcept
+			{
+				clear();
+			}
+
+		//! Get a node for a new demand.
+		/*!
+		 * Takes a node from the cache if the cache isn't empty.
+		 * Allocates a new node otherwise.
+		 */
+		[[nodiscard]]
+		demand_node_t *
+		allocate( execution_demand_t && demand )
+			{
+				if( m_head )
+					{
+						increment( m_hits );
+
+						auto * node = m_head;
+						m_head = node->m_next;
+						--m_size;
+
+						node->m_next = nullptr;
+						node->m_demand = std::move( demand );
+						return node;
+					}
+
+				increment( m_misses );
+				return new demand_node_t( std::move( demand ) );
+			}
+
+		//! Return a node of an already extracted demand.
+		/*!
+		 * The node is deleted if the cache is full.
+		 */
+		void
+		deallocate( demand_node_t * node ) noexcept
+			{
+				if( m_size < m_capacity )
+					{
+						// Message instance has to be released right now.
+						// NOTE: it can lead to a recursive call to allocate()
+						// so the cache is modified only after that.
+						node->m_demand = execution_demand_t{};
+
+						node->m_next = m_head;
+						m_head = node;
+						++m_size;
+					}
+				else
+					delete node;
+			}
+
+		//! Delete all cached nodes.
+		void
+		clear() noexcept
+			{
+				while( m_head )
+					{
+						auto * node = m_head;
+						m_head = node->m_next;
+						delete node;
+					}
+				m_size = 0u;
+			}
+
+		[[nodiscard]]
+		std::size_t
+		hits() const noexcept
+			{
+				return m_hits.load( std::memory_order_relaxed );
+			}
+
+		[[nodiscard]]
+		std::size_t
+		misses() const noexcept
+			{
+				return m_misses.load( std::memory_order_relaxed );
+			}
+
+	private :
+		//! Max count of nodes in the cache.
+		const std::size_t m_capacity;
+
+		//! Head of the list of free nodes.
+		demand_node_t * m_head{ nullptr };
+
+		//! Count of free nodes.
+		std::size_t m_size{};
+
+		//! Count of allocations satisfied by the cache.
+		/*!
+		 * \note
+		 * This value is modified only by the owner thread but
+		 * can be read by the stats distribution thread.
+		 */
+		std::atomic< std::size_t > m_hits{};
+
+		//! Count of allocations that required a new node.
+		std::atomic< std::size_t > m_misses{};
+
+		static void
+		increment( std::atomic< std::size_t > & counter ) noexcept
+			{
+				// There is only one writer, so RMW operation isn't necessary.
+				counter.store(
+						counter.load( std::memory_order_relaxed ) + 1u,
+						std::memory_order_relaxed );
+			}
+	};
+
+//
+// demand_pool_t
+//
+/*!
+ * \brief A set of demand node caches for work threads of one dispatcher.
+ *
+ * \since v.5.8.3
+ */
+class demand_pool_t
+	{
+	public :
+		explicit demand_pool_t( std::size_t cache_capacity )
+			:	m_cache_capacity{ cache_capacity }
+			{}
+
+		demand_pool_t( const demand_pool_t & ) = delete;
+		demand_pool_t & operator=( const demand_pool_t & ) = delete;
+
+		//! Get a cache for a work thread.
+		/*!
+		 * \note
+		 * Since v.5.8.3 a cache released by a finished work thread is
+		 * reused. A new cache is created only if there is no free one.
+		 *
+		 * \return nullptr if caching of demand nodes is turned off.
+		 */
+		[[nodiscard]]
+		demand_node_cache_t *
+		acquire_cache()
+			{
+				if( !m_cache_capacity )
+					return nullptr;
+
+				std::lock_guard< std::mutex > lock{ m_lock };
+				for( auto & slot : m_caches )
+					if( !slot.m_in_use )
+						{
+							slot.m_in_use = true;
+							return &slot.m_cache;
+						}
+
+				m_caches.emplace_front( m_cache_capacity );
+				return &m_caches.front().m_cache;
+			}
+
+		//! Return a cache that is no more used by a work thread.
+		/*!
+		 * \note
+		 * The cache must be cleared before the call to this method.
+		 *
+		 * \since v.5.8.3
+		 */
+		void
+		release_cache( demand_node_cache_t * cache ) noexcept
+			{
+				if( !cache )
+					return;
+
+				std::lock_guard< std::mutex > lock{ m_lock };
+				for( auto & slot : m_caches )
+					if( &slot.m_cache == cache )
+						{
+							slot.m_in_use = false;
+							break;
+						}
+			}
+
+		//! Get totals for hits and misses of all caches.
+		template< typename L >
+		void
+		take_stats( L lambda )
+			{
+				std::size_t hits{};
+				std::size_t misses{};
+				{
+					std::lock_guard< std::mutex > lock{ m_lock };
+					for( const auto & slot : m_caches )
+						{
+							hits += slot.m_cache.hits();
+							misses += slot.m_cache.misses();
+						}
+				}
+
+				lambda( hits, misses );
+			}
+
+	private :
+		//! Max count of nodes in a cache of one work thread.
+		const std::size_t m_cache_capacity;
+
+		//! Object's lock.
+		std::mutex m_lock;
+
+		//! A cache with the flag of its usage.
+		/*!
+		 * \since v.5.8.3
+		 */
+		struct cache_slot_t
+			{
+				demand_node_cache_t m_cache;
+				bool m_in_use{ true };
+
+				explicit cache_slot_t( std::size_t capacity ) noexcept
+					:	m_cache{ capacity }
+					{}
+			};
+
+		//! Caches of work threads.
+		std::forward_list< cache_slot_t > m_caches;
+	};
+
+//
+// t_demand_node_cache
+//
+/*!
+ * \brief Demand node cache of the current work thread.
+ *
+ * Holds nullptr if the current thread isn't a work thread of
+ * adv_thread_pool dispatcher (or caching is turned off).
+ *
+ * \note
+ * Nodes from this cache can be used for an agent_queue of any
+ * adv_thread_pool dispatcher because all of them have the same type.
+ *
+ * \since v.5.8.3
+ */
+inline thread_local demand_node_cache_t * t_demand_node_cache = nullptr;
+
+//
+// make_demand_node
+//
+/*!
+ * \brief Get a node for a new demand.
+ *
+ * Uses the cache of the current work thread if it is present.
+ *
+ * \since v.5.8.3
+ */
+[[nodiscard]]
+inline demand_node_t *
+make_demand_node( execution_demand_t && demand )
+	{
+		if( auto * cache = t_demand_node_cache )
+			return cache->allocate( std::move( demand ) );
+		else
+			return new demand_node_t( std::move( demand ) );
+	}
+
+//
+// recycle_demand_node
+//
+/*!
+ * \brief Release a node of an already extracted demand.
+ *
+ * Returns the node to the cache of the current work thread if it is present.
+ *
+ * \since v.5.8.3
+ */
+inline void
+recycle_demand_node( demand_node_t * node ) noexcept
+	{
+		if( auto * cache = t_demand_node_cache )
+			cache->deallocate( node );
+		else
+			delete node;
+	}
+
 //
 // dispatcher_queue_t
 //
-using dispatcher_queue_t = so_5::disp::reuse::queue_of_queues_t< agent_queue_t >;
+/*!
+ * \brief Type of dispatcher queue for adv_thread_pool dispatcher.
+ *
+ * It is queue_of_queues_t that also holds a reference to the
+ * demand pool of the dispatcher.
+ *
+ * \note
+ * It was just an alias for queue_of_queues_t before v.5.8.3.
+ *
+ * \since v.5.8.3
+ */
+class dispatcher_queue_t final
+	:	public so_5::disp::reuse::queue_of_queues_t< agent_queue_t >
+	{
+		using base_type_t = so_5::disp::reuse::queue_of_queues_t< agent_queue_t >;
+
+	public :
+		dispatcher_queue_t(
+			const so_5::disp::mpmc_queue_traits::queue_params_t & queue_params,
+			std::size_t thread_count,
+			outliving_reference_t< demand_pool_t > demand_pool )
+			:	base_type_t{ queue_params, thread_count }
+			,	m_demand_pool{ demand_pool.get() }
+			{}
+
+		[[nodiscard]]
+		demand_pool_t &
+		demand_pool() const noexcept
+			{
+				return m_demand_pool;
+			}
+
+	private :
+		//! Demand pool of the dispatcher.
+		demand_pool_t & m_demand_pool;
+	};
 
 //
 // agent_queue_t
@@ -79,23 +452,8 @@ class agent_queue_t final
 		friend class so_5::intrusive_ptr_t< agent_queue_t >;
 
 	private :
-		//! Actual demand in event queue.
-		struct demand_t
-			{
-				//! Actual demand.
-				execution_demand_t m_demand;
-
-				//! Next item in queue.
-				demand_t * m_next;
-
-				demand_t()
-					:	m_next( nullptr )
-					{}
-				demand_t( execution_demand_t && original )
-					:	m_demand( std::move( original ) )
-					,	m_next( nullptr )
-					{}
-			};
+		//! Short alias for the type of queue item.
+		using demand_t = demand_node_t;
 
 	public :
 		static constexpr const unsigned int thread_safe_worker = 2;
@@ -118,7 +476,7 @@ class agent_queue_t final
 		~agent_queue_t() override
 			{
 				while( m_head_demand.m_next )
-					delete_head();
+					delete node_without_head();
 			}
 
 		//! Access to the queue's lock.
@@ -136,7 +494,7 @@ class agent_queue_t final
 				bool need_schedule = false;
 				{
 					// Do memory allocation before spinlock locking.
-					auto new_demand = new demand_t( std::move( demand ) );
+					auto new_demand = make_demand_node( std::move( demand ) );
 
 					std::lock_guard< spinlock_t > lock( m_lock );
 
@@ -166,6 +524,71 @@ class agent_queue_t final
 					m_disp_queue.schedule( this );
 			}
 
+		//! Push several demands to queue.
+		/*!
+		 * All nodes are prepared before acquiring the queue's lock.
+		 * The whole chain is appended under one lock.
+		 *
+		 * \since v.5.8.3
+		 */
+		void
+		push_batch( execution_demand_t * demands, std::size_t count ) override
+			{
+				if( !count )
+					return;
+
+				demand_t * first = make_demand_node( std::move( demands[ 0 ] ) );
+				demand_t * last = first;
+
+				so_5::details::do_with_rollback_on_exception(
+					[&] {
+						for( std::size_t i = 1u; i != count; ++i )
+							{
+								last->m_next = make_demand_node( std::move( demands[ i ] ) );
+								last = last->m_next;
+							}
+					},
+					[&] {
+						while( first )
+							{
+								auto * victim = first;
+								first = first->m_next;
+								recycle_demand_node( victim );
+							}
+					} );
+
+				bool need_schedule = false;
+				{
+					std::lock_guard< spinlock_t > lock( m_lock );
+
+					const bool queue_was_empty = (nullptr == m_head_demand.m_next);
+
+					m_tail_demand->m_next = first;
+					m_tail_demand = last;
+
+					m_size += count;
+
+					if( queue_was_empty )
+						{
+							// Queue was empty. Need to detect
+							// necessity of queue activation.
+							if( !m_active )
+								if( !is_there_not_thread_safe_worker() )
+								{
+									need_schedule = true;
+									m_active = true;
+								}
+						}
+
+					SO_5_CHECK_INVARIANT( !empty(), this )
+					SO_5_CHECK_INVARIANT( m_active || is_there_any_worker(), this )
+					SO_5_CHECK_INVARIANT( !(need_schedule && !m_active), this )
+				}
+
+				if( need_schedule )
+					m_disp_queue.schedule( this );
+			}
+
 		/*!
 		 * \note
 		 * Delegates the work to the push() method.
@@ -378,16 +801,34 @@ class agent_queue_t final
 		 */
 		agent_queue_t * m_intrusive_queue_next{ nullptr };
 
-		//! Helper method for deleting queue's head object.
-		inline void
-		delete_head() noexcept
+		//! Helper method for excluding queue's head object from the queue.
+		/*!
+		 * \return pointer to the excluded object.
+		 *
+		 * \since v.5.8.3
+		 */
+		[[nodiscard]]
+		demand_t *
+		node_without_head() noexcept
 			{
-				auto to_be_deleted = m_head_demand.m_next;
+				auto r = m_head_demand.m_next;
 				m_head_demand.m_next = m_head_demand.m_next->m_next;
 
 				--m_size;
 
-				delete to_be_deleted;
+				return r;
+			}
+
+		//! Helper method for deleting queue's head object.
+		/*!
+		 * \note
+		 * Since v.5.8.3 the node of the head object is returned
+		 * to the demand node cache of the current work thread.
+		 */
+		inline void
+		delete_head() noexcept
+			{
+				recycle_demand_node( node_without_head() );
 			}
 	};
 
@@ -404,6 +845,42 @@ using agent_queue_ref_t = so_5::intrusive_ptr_t< agent_queue_t >;
 
 namespace work_thread_details {
 
+/*!
+ * \brief Helper for setting the demand node cache for the current
+ * work thread and clearing it at the end of the thread.
+ *
+ * \since v.5.8.3
+ */
+class demand_node_cache_binding_t
+	{
+		demand_pool_t & m_pool;
+		demand_node_cache_t * m_cache;
+
+	public :
+		explicit demand_node_cache_binding_t(
+			demand_pool_t & pool )
+			:	m_pool{ pool }
+			,	m_cache{ pool.acquire_cache() }
+			{
+				t_demand_node_cache = m_cache;
+			}
+
+		demand_node_cache_binding_t(
+			const demand_node_cache_binding_t & ) = delete;
+		demand_node_cache_binding_t &
+		operator=( const demand_node_cache_binding_t & ) = delete;
+
+		~demand_node_cache_binding_t() noexcept
+			{
+				t_demand_node_cache = nullptr;
+				if( m_cache )
+					{
+						m_cache->clear();
+						m_pool.release_cache( m_cache );
+					}
+			}
+	};
+
 /*!
  * \brief Main data for work_thread.
  *
@@ -590,22 +1067,50 @@ class work_thread_template_t final : public Impl
 				return this->m_thread_id;
 			}
 
+		/*!
+		 * \brief Has the thread body been finished?
+		 *
+		 * \since v.5.8.3
+		 */
+		[[nodiscard]]
+		bool
+		is_finished() const noexcept
+			{
+				return m_finished.load( std::memory_order_acquire );
+			}
+
 	private :
+		/*!
+		 * \brief Is the thread body finished?
+		 *
+		 * \since v.5.8.3
+		 */
+		std::atomic< bool > m_finished{ false };
+
 		//! Thread body method.
 		void
 		body()
 			{
 				this->m_thread_id = so_5::query_current_thread_id();
 
-				agent_queue_t * agent_queue;
-				while( nullptr != (agent_queue = this->pop_agent_queue()) )
-					{
-						// This guard is necessary to ensure that queue
-						// will exist until processing of queue finished.
-						agent_queue_ref_t agent_queue_guard( agent_queue );
+				{
+					// Demand node cache has to be created and set as the
+					// cache of the current thread.
+					demand_node_cache_binding_t cache_binding{
+							this->m_disp_queue->demand_pool() };
 
-						process_queue( *agent_queue );
-					}
+					agent_queue_t * agent_queue;
+					while( nullptr != (agent_queue = this->pop_agent_queue()) )
+						{
+							// This guard is necessary to ensure that queue
+							// will exist until processing of queue finished.
+							agent_queue_ref_t agent_queue_guard( agent_queue );
+
+							process_queue( *agent_queue );
+						}
+				}
+
+				m_finished.store( true, std::memory_order_release );
 			}
 
 		/*!
@@ -14,6 +14,11 @@
 #include <so_5/disp/adv_thread_pool/impl/disp.hpp>
 
 #include <so_5/disp/reuse/make_actual_dispatcher.hpp>
+#include <so_5/disp/reuse/data_source_prefix_helpers.hpp>
+
+#include <so_5/stats/repository.hpp>
+#include <so_5/stats/messages.hpp>
+#include <so_5/stats/std_names.hpp>
 
 #include <so_5/ret_code.hpp>
 
@@ -81,7 +86,9 @@ using actual_dispatcher_iface_shptr_t =
  * \since
  * v.5.6.0
  */
-class actual_binder_t final : public disp_binder_t
+class actual_binder_t final
+	:	public disp_binder_t
+	,	public transfer_queue_provider_t
 	{
 		//! Dispatcher to be used.
 		actual_dispatcher_iface_shptr_t m_disp;
@@ -114,8 +121,7 @@ class actual_binder_t final : public disp_binder_t
 		bind(
 			agent_t & agent ) noexcept override
 			{
-				auto queue = m_disp->query_resources_for_agent( agent );
-				agent.so_bind_to_dispatcher( *queue );
+				agent.so_bind_to_dispatcher( bind_transferred( agent ) );
 			}
 
 		void
@@ -124,6 +130,61 @@ class actual_binder_t final : public disp_binder_t
 			{
 				m_disp->unbind_agent( agent );
 			}
+
+		event_queue_t &
+		bind_transferred(
+			agent_t & agent ) noexcept override
+			{
+				return *(m_disp->query_resources_for_agent( agent ));
+			}
+	};
+
+//
+// demand_pool_data_source_t
+//
+/*!
+ * \brief Data source for statistics of the demand pool.
+ *
+ * \since v.5.8.3
+ */
+class demand_pool_data_source_t final : public stats::source_t
+	{
+		//! Prefix for data sources.
+		const stats::prefix_t m_prefix;
+
+		//! Pool to be monitored.
+		demand_pool_t & m_pool;
+
+	public :
+		demand_pool_data_source_t(
+			const std::string_view name_base,
+			const void * pointer_to_disp,
+			outliving_reference_t< demand_pool_t > pool )
+			:	m_prefix{ so_5::disp::reuse::make_disp_prefix(
+					adaptation_t::dispatcher_type_name(),
+					name_base,
+					pointer_to_disp ) }
+			,	m_pool{ pool.get() }
+			{}
+
+		void
+		distribute( const mbox_t & mbox ) override
+			{
+				m_pool.take_stats(
+					[&]( std::size_t hits, std::size_t misses ) {
+						so_5::send< stats::messages::quantity< std::size_t > >(
+								mbox,
+								m_prefix,
+								stats::suffixes::demand_pool_hits(),
+								hits );
+
+						so_5::send< stats::messages::quantity< std::size_t > >(
+								mbox,
+								m_prefix,
+								stats::suffixes::demand_pool_misses(),
+								misses );
+					} );
+			}
 	};
 
 //
@@ -139,9 +200,25 @@ template< typename Work_Thread >
 class actual_dispatcher_implementation_t final
 	:	public actual_dispatcher_iface_t
 	{
+		//! Pool of demand nodes for work threads.
+		/*!
+		 * \note
+		 * It has to be destroyed after m_impl.
+		 *
+		 * \since v.5.8.3
+		 */
+		demand_pool_t m_demand_pool;
+
 		//! Real dispatcher.
 		dispatcher_template_t< Work_Thread > m_impl;
 
+		//! Data source for the demand pool statistics.
+		/*!
+		 * \since v.5.8.3
+		 */
+		stats::auto_registered_source_holder_t< demand_pool_data_source_t >
+				m_demand_pool_data_source;
+
 	public :
 		actual_dispatcher_implementation_t(
 			//! SObjectizer Environment to work in.
@@ -150,14 +227,29 @@ class actual_dispatcher_implementation_t final
 			const std::string_view name_base,
 			//! Dispatcher's parameters.
 			disp_params_t params )
-			:	m_impl{
+			:	m_demand_pool{ params.demand_node_cache_size() }
+			,	m_impl{
 					env.get(),
 					params,
 					name_base,
-					params.thread_count(),
-					params.queue_params()
+					so_5::disp::reuse::initial_thread_count(
+							params.thread_count(), params.elastic() ),
+					params.queue_params(),
+					outliving_mutable( m_demand_pool )
+				}
+			,	m_demand_pool_data_source{
+					outliving_mutable( env.get().stats_repository() ),
+					name_base,
+					// NOTE: the same pointer is used by m_impl for
+					// its data sources.
+					&m_impl,
+					outliving_mutable( m_demand_pool )
 				}
 			{
+				if( const auto & elastic = params.elastic() )
+					m_impl.turn_elastic_mode_on(
+							env.get(), params, *elastic, params.thread_count() );
+
 				m_impl.start( env.get() );
 			}
 
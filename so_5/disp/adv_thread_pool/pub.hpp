@@ -21,6 +21,7 @@
 #include <so_5/disp/reuse/work_thread_activity_tracking.hpp>
 #include <so_5/disp/reuse/work_thread_factory_params.hpp>
 #include <so_5/disp/reuse/default_thread_pool_size.hpp>
+#include <so_5/disp/reuse/elastic_pool.hpp>
 
 #include <string_view>
 #include <utility>
@@ -55,11 +56,14 @@ namespace queue_traits = so_5::disp::mpmc_queue_traits;
 class disp_params_t
 	:	public so_5::disp::reuse::work_thread_activity_tracking_flag_mixin_t< disp_params_t >
 	,	public so_5::disp::reuse::work_thread_factory_mixin_t< disp_params_t >
+	,	public so_5::disp::reuse::elastic_pool_mixin_t< disp_params_t >
 	{
 		using activity_tracking_mixin_t = so_5::disp::reuse::
 				work_thread_activity_tracking_flag_mixin_t< disp_params_t >;
 		using thread_factory_mixin_t = so_5::disp::reuse::
 				work_thread_factory_mixin_t< disp_params_t >;
+		using elastic_mixin_t = so_5::disp::reuse::
+				elastic_pool_mixin_t< disp_params_t >;
 
 	public :
 		//! Default constructor.
@@ -78,8 +82,13 @@ class disp_params_t
 						static_cast< work_thread_factory_mixin_t & >(a),
 						static_cast< work_thread_factory_mixin_t & >(b) );
 
+				swap(
+						static_cast< elastic_mixin_t & >(a),
+						static_cast< elastic_mixin_t & >(b) );
+
 				swap( a.m_thread_count, b.m_thread_count );
 				swap( a.m_queue_params, b.m_queue_params );
+				swap( a.m_demand_node_cache_size, b.m_demand_node_cache_size );
 			}
 
 		//! Setter for thread count.
@@ -136,6 +145,48 @@ class disp_params_t
 				return m_queue_params;
 			}
 
+		//! Setter for the size of demand node cache.
+		/*!
+		 * Every work thread of the dispatcher keeps a cache of nodes
+		 * of already processed demands. Those nodes are reused when
+		 * the work thread pushes new demands to agent queues (it is
+		 * the case when an event handler sends a message to an agent
+		 * bound to adv_thread_pool dispatcher). It allows to avoid
+		 * memory allocation for a demand in the steady state.
+		 *
+		 * This value specifies the max count of nodes in the cache of one
+		 * work thread. Value 0 turns caching off.
+		 *
+		 * Usage example:
+		 * \code
+		 * using namespace so_5::disp::adv_thread_pool;
+		 * auto disp = make_dispatcher( env,
+		 * 	"workers_disp",
+		 * 	disp_params_t{}
+		 * 		.thread_count( 10 )
+		 * 		.demand_node_cache_size( 1024 ) );
+		 * \endcode
+		 *
+		 * \since v.5.8.3
+		 */
+		disp_params_t &
+		demand_node_cache_size( std::size_t v )
+			{
+				m_demand_node_cache_size = v;
+				return *this;
+			}
+
+		//! Getter for the size of demand node cache.
+		/*!
+		 * \since v.5.8.3
+		 */
+		[[nodiscard]]
+		std::size_t
+		demand_node_cache_size() const noexcept
+			{
+				return m_demand_node_cache_size;
+			}
+
 	private :
 		//! Count of working threads.
 		/*!
@@ -144,6 +195,12 @@ class disp_params_t
 		std::size_t m_thread_count = { 0 };
 		//! Queue parameters.
 		queue_traits::queue_params_t m_queue_params;
+
+		//! Max count of nodes in demand node cache of a work thread.
+		/*!
+		 * \since v.5.8.3
+		 */
+		std::size_t m_demand_node_cache_size = { 64 };
 	};
 
 //
@@ -0,0 +1,786 @@
+/*
+	SObjectizer 5.
+*/
+
+/*!
+	\file
+	\brief Implementation of the balancing_one_thread dispatcher.
+
+	\since v.5.8.3
+*/
+
+#include <so_5/disp/balancing_one_thread/pub.hpp>
+
+#include <so_5/send_functions.hpp>
+
+#include <so_5/details/invoke_noexcept_code.hpp>
+#include <so_5/details/rollback_on_exception.hpp>
+
+#include <so_5/disp/reuse/actual_work_thread_factory_to_use.hpp>
+#include <so_5/disp/reuse/data_source_prefix_helpers.hpp>
+#include <so_5/disp/reuse/default_thread_pool_size.hpp>
+#include <so_5/disp/reuse/make_actual_dispatcher.hpp>
+
+#include <so_5/disp/reuse/work_thread/work_thread.hpp>
+
+#include <so_5/stats/repository.hpp>
+#include <so_5/stats/messages.hpp>
+#include <so_5/stats/std_names.hpp>
+
+#include <algorithm>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <optional>
+
+namespace so_5
+{
+
+namespace disp
+{
+
+namespace balancing_one_thread
+{
+
+namespace impl
+{
+
+namespace work_thread = so_5::disp::reuse::work_thread;
+namespace stats = so_5::stats;
+
+namespace
+{
+
+template< class T >
+void
+shutdown_and_wait( T & w )
+	{
+		w.shutdown();
+		w.wait();
+	}
+
+void
+send_thread_activity_stats(
+	const so_5::mbox_t &,
+	const stats::prefix_t &,
+	work_thread::work_thread_no_activity_tracking_t & )
+	{
+		/* Nothing to do */
+	}
+
+void
+send_thread_activity_stats(
+	const so_5::mbox_t & mbox,
+	const stats::prefix_t & prefix,
+	work_thread::work_thread_with_activity_tracking_t & wt )
+	{
+		so_5::send< stats::messages::work_thread_activity >(
+				mbox,
+				prefix,
+				stats::suffixes::work_thread_activity(),
+				wt.thread_id(),
+				wt.take_activity_stats() );
+	}
+
+} /* anonymous */
+
+//
+// agent_queue_proxy_t
+//
+/*!
+ * \brief An event queue of an agent that redirects all demands to
+ * the queue of the current work thread of the agent.
+ *
+ * An agent is bound to this proxy instead of the queue of a work thread.
+ * It allows to switch the agent to another work thread.
+ *
+ * The switching is performed in the following way:
+ *
+ * - a special demand is pushed to the queue of the old work thread and
+ *   all new demands for the agent are stored inside the proxy;
+ * - when the special demand is handled on the old work thread all
+ *   previous demands for the agent are already handled. So the proxy
+ *   switches to the new work thread and pushes the delayed demands to it.
+ */
+class agent_queue_proxy_t final : public event_queue_t
+	{
+		//! A message for the special demand that completes the switching.
+		struct msg_switch_completion final : public message_t
+			{
+				agent_queue_proxy_t * m_proxy;
+
+				msg_switch_completion( agent_queue_proxy_t * proxy ) noexcept
+					:	m_proxy{ proxy }
+					{}
+			};
+
+	public :
+		//! Set the initial target.
+		/*!
+		 * \attention
+		 * Must be called before binding of the agent to the proxy.
+		 */
+		void
+		set_target( event_queue_t & target ) noexcept
+			{
+				m_target = &target;
+			}
+
+		void
+		push( execution_demand_t demand ) override
+			{
+				std::lock_guard< std::mutex > lock{ m_lock };
+
+				if( m_next_target )
+					m_delayed.push_back( std::move(demand) );
+				else
+					m_target->push( std::move(demand) );
+			}
+
+		void
+		push_evt_start( execution_demand_t demand ) override
+			{
+				// NOTE: the agent can't be switched before the completion
+				// of binding. So there is no need to check the switching.
+				std::lock_guard< std::mutex > lock{ m_lock };
+
+				m_target->push_evt_start( std::move(demand) );
+			}
+
+		void
+		push_evt_finish( execution_demand_t demand ) noexcept override
+			{
+				std::lock_guard< std::mutex > lock{ m_lock };
+
+				// The agent can't be switched anymore.
+				m_finish_received = true;
+
+				if( m_next_target )
+					m_delayed_finish = std::move(demand);
+				else
+					m_target->push_evt_finish( std::move(demand) );
+			}
+
+		void
+		push_batch(
+			execution_demand_t * demands,
+			std::size_t count ) override
+			{
+				std::lock_guard< std::mutex > lock{ m_lock };
+
+				if( m_next_target )
+					m_delayed.insert( m_delayed.end(),
+							std::make_move_iterator( demands ),
+							std::make_move_iterator( demands + count ) );
+				else
+					m_target->push_batch( demands, count );
+			}
+
+		/*!
+		 * \brief Initiate the switching of the agent to another work thread.
+		 *
+		 * \retval false if the agent can't be switched (it is being
+		 * switched already or it is being deregistered).
+		 */
+		[[nodiscard]]
+		bool
+		try_start_switching(
+			agent_t & agent,
+			event_queue_t & new_target )
+			{
+				message_ref_t msg{ new msg_switch_completion{ this } };
+
+				std::lock_guard< std::mutex > lock{ m_lock };
+
+				if( m_finish_received || m_next_target )
+					return false;
+
+				m_target->push( execution_demand_t{
+						&agent,
+						message_limit::control_block_t::none(),
+						0u,
+						typeid(msg_switch_completion),
+						std::move(msg),
+						&agent_queue_proxy_t::demand_handler_on_switch_completion
+					} );
+
+				m_next_target = &new_target;
+
+				return true;
+			}
+
+	private :
+		//! Object's lock.
+		std::mutex m_lock;
+
+		//! The queue of the current work thread.
+		event_queue_t * m_target{ nullptr };
+
+		//! The queue of the new work thread.
+		/*!
+		 * Is not nullptr only during the switching.
+		 */
+		event_queue_t * m_next_target{ nullptr };
+
+		//! Demands those were pushed during the switching.
+		std::deque< execution_demand_t > m_delayed;
+
+		//! Demand for so_evt_finish pushed during the switching.
+		std::optional< execution_demand_t > m_delayed_finish;
+
+		//! Has the demand for so_evt_finish been received?
+		bool m_finish_received{ false };
+
+		static void
+		demand_handler_on_switch_completion(
+			current_thread_id_t,
+			execution_demand_t & d )
+			{
+				const auto & msg = static_cast< const msg_switch_completion & >(
+						*(d.m_message_ref) );
+
+				msg.m_proxy->complete_switching();
+			}
+
+		void
+		complete_switching() noexcept
+			{
+				std::lock_guard< std::mutex > lock{ m_lock };
+
+				m_target = m_next_target;
+				m_next_target = nullptr;
+
+				// We can't recover if the new queue doesn't accept
+				// the delayed demands.
+				so_5::details::invoke_noexcept_code( [this] {
+						for( auto & d : m_delayed )
+							m_target->push( std::move(d) );
+						m_delayed.clear();
+					} );
+
+				if( m_delayed_finish )
+					{
+						m_target->push_evt_finish( std::move(*m_delayed_finish) );
+						m_delayed_finish.reset();
+					}
+			}
+	};
+
+//
+// actual_dispatcher_iface_t
+//
+/*!
+ * \brief An actual interface of %balancing_one_thread dispatcher.
+ *
+ * \since v.5.8.3
+ */
+class actual_dispatcher_iface_t : public basic_dispatcher_iface_t
+	{
+	public :
+		virtual void
+		preallocate_resources( agent_t & agent ) = 0;
+
+		virtual void
+		undo_preallocation( agent_t & agent ) noexcept = 0;
+
+		virtual void
+		bind( agent_t & agent ) noexcept = 0;
+
+		virtual void
+		unbind( agent_t & agent ) noexcept = 0;
+
+		[[nodiscard]]
+		virtual event_queue_t &
+		bind_transferred( agent_t & agent ) noexcept = 0;
+	};
+
+//
+// actual_dispatcher_iface_shptr_t
+//
+using actual_dispatcher_iface_shptr_t =
+		std::shared_ptr< actual_dispatcher_iface_t >;
+
+//
+// actual_binder_t
+//
+/*!
+ * \brief Implementation of binder interface for %balancing_one_thread
+ * dispatcher.
+ *
+ * \since v.5.8.3
+ */
+class actual_binder_t final
+	:	public disp_binder_t
+	,	public transfer_queue_provider_t
+	{
+		//! Dispatcher to be used.
+		actual_dispatcher_iface_shptr_t m_disp;
+
+	public :
+		actual_binder_t(
+			actual_dispatcher_iface_shptr_t disp ) noexcept
+			:	m_disp{ std::move(disp) }
+			{}
+
+		void
+		preallocate_resources(
+			agent_t & agent ) override
+			{
+				m_disp->preallocate_resources( agent );
+			}
+
+		void
+		undo_preallocation(
+			agent_t & agent ) noexcept override
+			{
+				m_disp->undo_preallocation( agent );
+			}
+
+		void
+		bind(
+			agent_t & agent ) noexcept override
+			{
+				m_disp->bind( agent );
+			}
+
+		void
+		unbind(
+			agent_t & agent ) noexcept override
+			{
+				m_disp->unbind( agent );
+			}
+
+		event_queue_t &
+		bind_transferred(
+			agent_t & agent ) noexcept override
+			{
+				return m_disp->bind_transferred( agent );
+			}
+	};
+
+//
+// dispatcher_template_t
+//
+
+/*!
+ * \brief Implementation of %balancing_one_thread dispatcher in form
+ * of template class.
+ *
+ * \since v.5.8.3
+ */
+template< typename Work_Thread >
+class dispatcher_template_t final : public actual_dispatcher_iface_t
+	{
+	public:
+		dispatcher_template_t(
+			//! SObjectizer Environment to work in.
+			outliving_reference_t< environment_t > env,
+			//! Base part of data sources names.
+			const std::string_view name_base,
+			//! Dispatcher's parameters.
+			disp_params_t params )
+			:	m_load_metric{ params.load_metric() }
+			// NOTE: threads have to be created before the registration
+			// of the data source.
+			,	m_threads{ make_threads( env.get(), params ) }
+			,	m_agent_counts( params.thread_count(), 0u )
+			,	m_data_source{
+					outliving_mutable(env.get().stats_repository()),
+					name_base,
+					outliving_mutable( *this )
+				}
+			{
+				std::size_t started = 0u;
+				so_5::details::do_with_rollback_on_exception(
+						[&] {
+							for( ; started != m_threads.size(); ++started )
+								m_threads[ started ]->start();
+						},
+						[&] {
+							for( std::size_t i = 0; i != started; ++i )
+								shutdown_and_wait( *m_threads[ i ] );
+						} );
+			}
+
+		~dispatcher_template_t() noexcept override
+			{
+				// All working threads should receive stop signal.
+				for( auto & t : m_threads )
+					t->shutdown();
+
+				// All working threads should be joined.
+				for( auto & t : m_threads )
+					t->wait();
+			}
+
+		disp_binder_shptr_t
+		binder() override
+			{
+				return std::make_shared< actual_binder_t >(
+						this->shared_from_this() );
+			}
+
+		std::size_t
+		rebalance() override
+			{
+				std::lock_guard< std::mutex > lock{ m_lock };
+
+				std::size_t switched = 0u;
+				for(;;)
+					{
+						const auto [min_it, max_it] = std::minmax_element(
+								m_agent_counts.begin(), m_agent_counts.end() );
+						if( *max_it - *min_it <= 1u )
+							break;
+
+						const auto from = static_cast< std::size_t >(
+								std::distance( m_agent_counts.begin(), max_it ) );
+						const auto to = static_cast< std::size_t >(
+								std::distance( m_agent_counts.begin(), min_it ) );
+
+						if( !try_switch_some_agent( from, to ) )
+							// There is no agents to be switched from
+							// the most loaded thread.
+							break;
+
+						++switched;
+					}
+
+				return switched;
+			}
+
+		std::vector< std::size_t >
+		agents_per_thread() override
+			{
+				std::lock_guard< std::mutex > lock{ m_lock };
+
+				return m_agent_counts;
+			}
+
+		void
+		preallocate_resources( agent_t & agent ) override
+			{
+				auto proxy = std::make_unique< agent_queue_proxy_t >();
+
+				std::lock_guard< std::mutex > lock{ m_lock };
+
+				m_agents.emplace( &agent, agent_info_t{ std::move(proxy) } );
+			}
+
+		void
+		undo_preallocation( agent_t & agent ) noexcept override
+			{
+				std::lock_guard< std::mutex > lock{ m_lock };
+
+				m_agents.erase( &agent );
+			}
+
+		void
+		bind( agent_t & agent ) noexcept override
+			{
+				agent.so_bind_to_dispatcher(
+						attach_to_thread( agent, false /* not started yet */ ) );
+
+				{
+					// Since now the agent can be switched to another thread.
+					std::lock_guard< std::mutex > lock{ m_lock };
+
+					m_agents.find( &agent )->second.m_bound = true;
+				}
+			}
+
+		event_queue_t &
+		bind_transferred( agent_t & agent ) noexcept override
+			{
+				// The agent is already started and can be switched to
+				// another thread right now.
+				return attach_to_thread( agent, true );
+			}
+
+		void
+		unbind( agent_t & agent ) noexcept override
+			{
+				std::lock_guard< std::mutex > lock{ m_lock };
+
+				auto it = m_agents.find( &agent );
+				if( it != m_agents.end() )
+					{
+						--m_agent_counts[ it->second.m_thread_index ];
+						m_agents.erase( it );
+					}
+			}
+
+	private:
+		friend class disp_data_source_t;
+
+		//! Information about an agent bound to the dispatcher.
+		struct agent_info_t
+			{
+				//! Event queue for the agent.
+				std::unique_ptr< agent_queue_proxy_t > m_proxy;
+
+				//! Index of the current work thread for the agent.
+				/*!
+				 * If the agent is being switched to another thread then
+				 * it's the index of the new thread.
+				 */
+				std::size_t m_thread_index{ 0u };
+
+				//! Is the agent already bound?
+				bool m_bound{ false };
+			};
+
+		/*!
+		 * \brief Data source for run-time monitoring of whole dispatcher.
+		 */
+		class disp_data_source_t final : public stats::source_t
+			{
+				//! Dispatcher to work with.
+				outliving_reference_t< dispatcher_template_t > m_dispatcher;
+
+				//! Basic prefix for data sources.
+				stats::prefix_t m_base_prefix;
+
+			public :
+				disp_data_source_t(
+					const std::string_view name_base,
+					outliving_reference_t< dispatcher_template_t > disp )
+					:	m_dispatcher{ disp }
+					{
+						using namespace so_5::disp::reuse;
+
+						m_base_prefix = make_disp_prefix(
+								"bot", // bot -- balancing_one_thread
+								name_base,
+								&(m_dispatcher.get()) );
+					}
+
+				void
+				distribute( const so_5::mbox_t & mbox ) override
+					{
+						auto & disp = m_dispatcher.get();
+
+						std::lock_guard< std::mutex > lock{ disp.m_lock };
+
+						so_5::send< stats::messages::quantity< std::size_t > >(
+								mbox,
+								m_base_prefix,
+								stats::suffixes::agent_count(),
+								disp.m_agents.size() );
+
+						for( std::size_t i = 0; i != disp.m_threads.size(); ++i )
+							{
+								const auto prefix = so_5::disp::reuse::
+										make_disp_working_thread_prefix( m_base_prefix, i );
+
+								so_5::send< stats::messages::quantity< std::size_t > >(
+										mbox,
+										prefix,
+										stats::suffixes::agent_count(),
+										disp.m_agent_counts[ i ] );
+
+								so_5::send< stats::messages::quantity< std::size_t > >(
+										mbox,
+										prefix,
+										stats::suffixes::work_thread_queue_size(),
+										disp.m_threads[ i ]->demands_count() );
+
+								so_5::disp::reuse::send_wakeup_stats(
+										mbox,
+										prefix,
+										disp.m_threads[ i ]->wakeup_stats() );
+
+								send_thread_activity_stats(
+										mbox,
+										prefix,
+										*(disp.m_threads[ i ]) );
+							}
+					}
+			};
+
+		//! The metric for the selection of a thread for a new agent.
+		const load_metric_t m_load_metric;
+
+		//! Working threads.
+		std::vector< std::unique_ptr< Work_Thread > > m_threads;
+
+		//! Count of agents for every working thread.
+		std::vector< std::size_t > m_agent_counts;
+
+		//! Agents those use the dispatcher.
+		std::map< agent_t *, agent_info_t > m_agents;
+
+		//! This object lock.
+		std::mutex m_lock;
+
+		/*!
+		 * \brief Data source for run-time monitoring.
+		 */
+		stats::auto_registered_source_holder_t< disp_data_source_t >
+				m_data_source;
+
+		//! Helper for creation of working threads.
+		[[nodiscard]]
+		static std::vector< std::unique_ptr< Work_Thread > >
+		make_threads(
+			environment_t & env,
+			const disp_params_t & params )
+			{
+				std::vector< std::unique_ptr< Work_Thread > > threads;
+				threads.reserve( params.thread_count() );
+				for( std::size_t i = 0; i != params.thread_count(); ++i )
+					threads.push_back( std::make_unique< Work_Thread >(
+							acquire_work_thread( params, env ),
+							params.queue_params().lock_factory() ) );
+
+				return threads;
+			}
+
+		//! Select a work thread for the agent and bind the agent's proxy to it.
+		[[nodiscard]]
+		agent_queue_proxy_t &
+		attach_to_thread(
+			agent_t & agent,
+			//! Can the agent be switched to another thread right now?
+			bool bound ) noexcept
+			{
+				std::lock_guard< std::mutex > lock{ m_lock };
+
+				auto & info = m_agents.find( &agent )->second;
+
+				info.m_thread_index = select_thread();
+				++m_agent_counts[ info.m_thread_index ];
+				info.m_bound = bound;
+
+				info.m_proxy->set_target(
+						*(m_threads[ info.m_thread_index ]->get_agent_binding()) );
+
+				return *(info.m_proxy);
+			}
+
+		/*!
+		 * \brief Select the least loaded thread.
+		 *
+		 * \note Must be called on locked object.
+		 */
+		[[nodiscard]]
+		std::size_t
+		select_thread() noexcept
+			{
+				const auto load_of = [this]( std::size_t i ) noexcept {
+						switch( m_load_metric )
+							{
+							case load_metric_t::agent_count:
+								return std::make_pair(
+										m_agent_counts[ i ], std::size_t{} );
+
+							case load_metric_t::demand_count:
+								return std::make_pair(
+										m_threads[ i ]->demands_count(),
+										m_agent_counts[ i ] );
+
+							case load_metric_t::agent_and_demand_count:
+							break;
+							}
+
+						return std::make_pair(
+								m_agent_counts[ i ] + m_threads[ i ]->demands_count(),
+								std::size_t{} );
+					};
+
+				std::size_t result = 0u;
+				auto min_load = load_of( 0u );
+				for( std::size_t i = 1u; i < m_threads.size(); ++i )
+					{
+						const auto load = load_of( i );
+						if( load < min_load )
+							{
+								result = i;
+								min_load = load;
+							}
+					}
+
+				return result;
+			}
+
+		/*!
+		 * \brief Try to switch an agent from one thread to another.
+		 *
+		 * \note Must be called on locked object.
+		 */
+		[[nodiscard]]
+		bool
+		try_switch_some_agent( std::size_t from, std::size_t to )
+			{
+				for( auto & [agent, info] : m_agents )
+					{
+						if( info.m_bound && from == info.m_thread_index &&
+								info.m_proxy->try_start_switching(
+										*agent,
+										*(m_threads[ to ]->get_agent_binding()) ) )
+							{
+								info.m_thread_index = to;
+								--m_agent_counts[ from ];
+								++m_agent_counts[ to ];
+
+								return true;
+							}
+					}
+
+				return false;
+			}
+	};
+
+//
+// dispatcher_handle_maker_t
+//
+class dispatcher_handle_maker_t
+	{
+	public :
+		static dispatcher_handle_t
+		make( actual_dispatcher_iface_shptr_t disp ) noexcept
+			{
+				return { std::move( disp ) };
+			}
+	};
+
+} /* namespace impl */
+
+//
+// make_dispatcher
+//
+SO_5_FUNC dispatcher_handle_t
+make_dispatcher(
+	environment_t & env,
+	const std::string_view data_sources_name_base,
+	disp_params_t params )
+	{
+		using namespace so_5::disp::reuse;
+
+		if( !params.thread_count() )
+			params.thread_count( default_thread_pool_size() );
+
+		using dispatcher_no_activity_tracking_t =
+				impl::dispatcher_template_t<
+						work_thread::work_thread_no_activity_tracking_t >;
+
+		using dispatcher_with_activity_tracking_t =
+				impl::dispatcher_template_t<
+						work_thread::work_thread_with_activity_tracking_t >;
+
+		auto disp = so_5::disp::reuse::make_actual_dispatcher<
+						impl::actual_dispatcher_iface_t,
+						dispatcher_no_activity_tracking_t,
+						dispatcher_with_activity_tracking_t >(
+				outliving_mutable(env),
+				data_sources_name_base,
+				std::move(params) );
+
+		return impl::dispatcher_handle_maker_t::make( std::move(disp) );
+	}
+
+} /* namespace balancing_one_thread */
+
+} /* namespace disp */
+
+} /* namespace so_5 */
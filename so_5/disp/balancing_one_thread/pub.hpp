@@ -0,0 +1,394 @@
+/*
+	SObjectizer 5.
+*/
+
+/*!
+	\file
+	\brief Functions for creating and binding to the balancing_one_thread
+	dispatcher.
+
+	\since v.5.8.3
+*/
+
+#pragma once
+
+#include <so_5/declspec.hpp>
+
+#include <so_5/disp_binder.hpp>
+
+#include <so_5/disp/mpsc_queue_traits/pub.hpp>
+
+#include <so_5/disp/reuse/work_thread_activity_tracking.hpp>
+#include <so_5/disp/reuse/work_thread_factory_params.hpp>
+
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace so_5
+{
+
+namespace disp
+{
+
+namespace balancing_one_thread
+{
+
+/*!
+ * \brief Alias for namespace with traits of event queue.
+ *
+ * \since v.5.8.3
+ */
+namespace queue_traits = so_5::disp::mpsc_queue_traits;
+
+//
+// load_metric_t
+//
+/*!
+ * \brief A metric for selection of the least loaded work thread.
+ *
+ * \since v.5.8.3
+ */
+enum class load_metric_t
+	{
+		//! Count of agents bound to a work thread.
+		agent_count,
+		//! Count of demands waiting in the queue of a work thread.
+		/*!
+		 * If there are several threads with the same count of demands
+		 * then the thread with the minimal count of agents is selected.
+		 */
+		demand_count,
+		//! The sum of agents bound and demands waiting.
+		agent_and_demand_count
+	};
+
+//
+// disp_params_t
+//
+/*!
+ * \brief Parameters for %balancing_one_thread dispatcher.
+ *
+ * \since v.5.8.3
+ */
+class disp_params_t
+	:	public so_5::disp::reuse::work_thread_activity_tracking_flag_mixin_t< disp_params_t >
+	,	public so_5::disp::reuse::work_thread_factory_mixin_t< disp_params_t >
+	{
+		using activity_tracking_mixin_t = so_5::disp::reuse::
+				work_thread_activity_tracking_flag_mixin_t< disp_params_t >;
+		using thread_factory_mixin_t = so_5::disp::reuse::
+				work_thread_factory_mixin_t< disp_params_t >;
+
+	public :
+		//! Default constructor.
+		disp_params_t() = default;
+
+		friend inline void
+		swap( disp_params_t & a, disp_params_t & b ) noexcept
+			{
+				using std::swap;
+
+				swap(
+						static_cast< activity_tracking_mixin_t & >(a),
+						static_cast< activity_tracking_mixin_t & >(b) );
+
+				swap(
+						static_cast< work_thread_factory_mixin_t & >(a),
+						static_cast< work_thread_factory_mixin_t & >(b) );
+
+				swap( a.m_thread_count, b.m_thread_count );
+				swap( a.m_load_metric, b.m_load_metric );
+				swap( a.m_queue_params, b.m_queue_params );
+			}
+
+		//! Setter for thread count.
+		/*!
+		 * \note
+		 * Value 0 means that the default thread pool size will be used.
+		 */
+		disp_params_t &
+		thread_count( std::size_t count ) noexcept
+			{
+				m_thread_count = count;
+				return *this;
+			}
+
+		//! Getter for thread count.
+		[[nodiscard]]
+		std::size_t
+		thread_count() const noexcept
+			{
+				return m_thread_count;
+			}
+
+		//! Setter for the load metric.
+		disp_params_t &
+		load_metric( load_metric_t v ) noexcept
+			{
+				m_load_metric = v;
+				return *this;
+			}
+
+		//! Getter for the load metric.
+		[[nodiscard]]
+		load_metric_t
+		load_metric() const noexcept
+			{
+				return m_load_metric;
+			}
+
+		//! Setter for queue parameters.
+		disp_params_t &
+		set_queue_params( queue_traits::queue_params_t p )
+			{
+				m_queue_params = std::move(p);
+				return *this;
+			}
+
+		//! Tuner for queue parameters.
+		/*!
+		 * Accepts lambda-function or functional object which tunes
+		 * queue parameters.
+			\code
+			so_5::disp::balancing_one_thread::make_dispatcher( env,
+				"my_disp",
+				so_5::disp::balancing_one_thread::disp_params_t{}.tune_queue_params(
+					[]( so_5::disp::balancing_one_thread::queue_traits::queue_params_t & p ) {
+						p.lock_factory( so_5::disp::balancing_one_thread::queue_traits::simple_lock_factory() );
+					} ) );
+			\endcode
+		 */
+		template< typename L >
+		disp_params_t &
+		tune_queue_params( L tunner )
+			{
+				tunner( m_queue_params );
+				return *this;
+			}
+
+		//! Getter for queue parameters.
+		const queue_traits::queue_params_t &
+		queue_params() const
+			{
+				return m_queue_params;
+			}
+
+	private :
+		//! Count of working threads.
+		std::size_t m_thread_count{ 0u };
+
+		//! The metric for the selection of a thread for a new agent.
+		load_metric_t m_load_metric{ load_metric_t::agent_count };
+
+		//! Queue parameters.
+		queue_traits::queue_params_t m_queue_params;
+	};
+
+namespace impl {
+
+class actual_dispatcher_iface_t;
+
+//
+// basic_dispatcher_iface_t
+//
+/*!
+ * \brief The very basic interface of %balancing_one_thread dispatcher.
+ *
+ * This class contains a minimum that is necessary for implementation
+ * of dispatcher_handle class.
+ *
+ * \since v.5.8.3
+ */
+class basic_dispatcher_iface_t
+	:	public std::enable_shared_from_this<actual_dispatcher_iface_t>
+	{
+	public :
+		virtual ~basic_dispatcher_iface_t() noexcept = default;
+
+		[[nodiscard]]
+		virtual disp_binder_shptr_t
+		binder() = 0;
+
+		virtual std::size_t
+		rebalance() = 0;
+
+		[[nodiscard]]
+		virtual std::vector< std::size_t >
+		agents_per_thread() = 0;
+	};
+
+using basic_dispatcher_iface_shptr_t =
+		std::shared_ptr< basic_dispatcher_iface_t >;
+
+class dispatcher_handle_maker_t;
+
+} /* namespace impl */
+
+//
+// dispatcher_handle_t
+//
+
+/*!
+ * \brief A handle for %balancing_one_thread dispatcher.
+ *
+ * \since v.5.8.3
+ */
+class [[nodiscard]] dispatcher_handle_t
+	{
+		friend class impl::dispatcher_handle_maker_t;
+
+		//! A reference to actual implementation of a dispatcher.
+		impl::basic_dispatcher_iface_shptr_t m_dispatcher;
+
+		dispatcher_handle_t(
+			impl::basic_dispatcher_iface_shptr_t dispatcher ) noexcept
+			:	m_dispatcher{ std::move(dispatcher) }
+			{}
+
+		//! Is this handle empty?
+		bool
+		empty() const noexcept { return !m_dispatcher; }
+
+	public :
+		dispatcher_handle_t() noexcept = default;
+
+		//! Get a binder for that dispatcher.
+		/*!
+		 * Every new agent bound via this binder is placed on the least
+		 * loaded work thread. The load is measured by the metric from
+		 * disp_params_t::load_metric().
+		 *
+		 * \attention
+		 * An attempt to call this method on empty handle is UB.
+		 */
+		[[nodiscard]]
+		disp_binder_shptr_t
+		binder() const
+			{
+				return m_dispatcher->binder();
+			}
+
+		//! Move agents from the most loaded work threads to the least
+		//! loaded ones.
+		/*!
+		 * Agents are moved until the difference in the count of agents
+		 * between work threads is not greater than 1.
+		 *
+		 * An agent is switched to the new work thread only when all
+		 * demands already queued for it on the old work thread are
+		 * handled. Demands sent to the agent after the start of the move
+		 * are delayed and then passed to the new work thread in the
+		 * original order. So the agent is never run on two work threads
+		 * at the same time and the order of demands is preserved.
+		 *
+		 * \return count of agents whose moving is initiated.
+		 *
+		 * \attention
+		 * An attempt to call this method on empty handle is UB.
+		 */
+		std::size_t
+		rebalance() const
+			{
+				return m_dispatcher->rebalance();
+			}
+
+		//! Get the count of agents for every work thread.
+		/*!
+		 * Agents those are being moved are counted for their new
+		 * work threads.
+		 *
+		 * \attention
+		 * An attempt to call this method on empty handle is UB.
+		 */
+		[[nodiscard]]
+		std::vector< std::size_t >
+		agents_per_thread() const
+			{
+				return m_dispatcher->agents_per_thread();
+			}
+
+		//! Is this handle empty?
+		operator bool() const noexcept { return empty(); }
+
+		//! Does this handle contain a reference to dispatcher?
+		bool
+		operator!() const noexcept { return !empty(); }
+
+		//! Drop the content of handle.
+		void
+		reset() noexcept { m_dispatcher.reset(); }
+	};
+
+/*!
+ * \brief Create an instance of %balancing_one_thread dispatcher.
+ *
+ * The dispatcher owns a set of work threads. Every work thread works
+ * like a %one_thread dispatcher: all agents bound to it are run on
+ * the same thread. But a new agent isn't bound to a thread selected
+ * by a user. It's bound to the least loaded thread instead.
+ *
+ * \par Usage sample
+\code
+auto disp = so_5::disp::balancing_one_thread::make_dispatcher(
+	env,
+	"session_handlers",
+	so_5::disp::balancing_one_thread::disp_params_t{}
+		.thread_count( 8 )
+		.load_metric( so_5::disp::balancing_one_thread::load_metric_t::demand_count ) );
+auto coop = env.make_coop(
+	// Every agent of that coop will be bound to the least loaded thread.
+	disp.binder() );
+...
+// Agents can be redistributed between threads later.
+disp.rebalance();
+\endcode
+ *
+ * \since v.5.8.3
+ */
+SO_5_FUNC dispatcher_handle_t
+make_dispatcher(
+	//! SObjectizer Environment to work in.
+	so_5::environment_t & env,
+	//! Value for creating names of data sources for
+	//! run-time monitoring.
+	const std::string_view data_sources_name_base,
+	//! Parameters for dispatcher.
+	disp_params_t params );
+
+/*!
+ * \brief Create an instance of %balancing_one_thread dispatcher with
+ * the default parameters.
+ *
+ * \since v.5.8.3
+ */
+inline dispatcher_handle_t
+make_dispatcher(
+	//! SObjectizer Environment to work in.
+	so_5::environment_t & env,
+	//! Value for creating names of data sources for
+	//! run-time monitoring.
+	const std::string_view data_sources_name_base )
+	{
+		return make_dispatcher( env, data_sources_name_base, disp_params_t{} );
+	}
+
+/*!
+ * \brief Create an instance of %balancing_one_thread dispatcher with
+ * the default parameters and without the name.
+ *
+ * \since v.5.8.3
+ */
+inline dispatcher_handle_t
+make_dispatcher(
+	//! SObjectizer Environment to work in.
+	so_5::environment_t & env )
+	{
+		return make_dispatcher( env, std::string_view{} );
+	}
+
+} /* namespace balancing_one_thread */
+
+} /* namespace disp */
+
+} /* namespace so_5 */
@@ -0,0 +1,153 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \file
+ * \brief Parameters of elastic mode for thread-pool dispatchers.
+ *
+ * \since v.5.8.3
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+
+namespace so_5::disp
+{
+
+//
+// elastic_pool_params_t
+//
+/*!
+ * \brief Parameters of elastic mode for thread-pool dispatchers.
+ *
+ * In the elastic mode a dispatcher starts with min_threads() threads
+ * and then adds or removes threads depending on the load:
+ * - a new thread is started if the count of non-empty agent queues waiting
+ *   for a free worker thread was not less than scale_up_queue_depth()
+ *   at every check during scale_up_delay(). It means that
+ *   scale_up_delay() is the max time a ready agent queue waits for
+ *   a free thread under a sustained load;
+ * - an idle thread is stopped if there was at least one idle worker
+ *   at every check during scale_down_idle_time().
+ *
+ * The count of threads is always in [min_threads(), thread_count()],
+ * where thread_count() is the value from dispatcher's parameters.
+ *
+ * The load is checked every check_period() by a separate monitoring
+ * thread.
+ *
+ * Usage example:
+ * \code
+ * using namespace so_5::disp::thread_pool;
+ * auto disp = make_dispatcher( env, "db_workers",
+ * 	disp_params_t{}
+ * 		// No more than 32 threads.
+ * 		.thread_count( 32 )
+ * 		.elastic( so_5::disp::elastic_pool_params_t{}
+ * 			.min_threads( 2 )
+ * 			.scale_up_delay( std::chrono::milliseconds{ 5 } )
+ * 			.scale_down_idle_time( std::chrono::seconds{ 30 } ) ) );
+ * \endcode
+ *
+ * \since v.5.8.3
+ */
+class elastic_pool_params_t
+	{
+	public :
+		//! Type of duration for time-related parameters.
+		using duration_t = std::chrono::steady_clock::duration;
+
+		//! Set the min count of threads.
+		/*!
+		 * \note
+		 * Value 0 is treated as 1.
+		 */
+		elastic_pool_params_t &
+		min_threads( std::size_t v ) noexcept
+			{
+				m_min_threads = v ? v : 1u;
+				return *this;
+			}
+
+		//! Get the min count of threads.
+		[[nodiscard]]
+		std::size_t
+		min_threads() const noexcept { return m_min_threads; }
+
+		//! Set the count of waiting agent queues that means the overload.
+		/*!
+		 * \note
+		 * Value 0 is treated as 1.
+		 */
+		elastic_pool_params_t &
+		scale_up_queue_depth( std::size_t v ) noexcept
+			{
+				m_scale_up_queue_depth = v ? v : 1u;
+				return *this;
+			}
+
+		//! Get the count of waiting agent queues that means the overload.
+		[[nodiscard]]
+		std::size_t
+		scale_up_queue_depth() const noexcept { return m_scale_up_queue_depth; }
+
+		//! Set the duration of overload before the start of a new thread.
+		elastic_pool_params_t &
+		scale_up_delay( duration_t v ) noexcept
+			{
+				m_scale_up_delay = v;
+				return *this;
+			}
+
+		//! Get the duration of overload before the start of a new thread.
+		[[nodiscard]]
+		duration_t
+		scale_up_delay() const noexcept { return m_scale_up_delay; }
+
+		//! Set the duration of idleness before the stop of a thread.
+		elastic_pool_params_t &
+		scale_down_idle_time( duration_t v ) noexcept
+			{
+				m_scale_down_idle_time = v;
+				return *this;
+			}
+
+		//! Get the duration of idleness before the stop of a thread.
+		[[nodiscard]]
+		duration_t
+		scale_down_idle_time() const noexcept { return m_scale_down_idle_time; }
+
+		//! Set the period of load checks.
+		elastic_pool_params_t &
+		check_period( duration_t v ) noexcept
+			{
+				m_check_period = v;
+				return *this;
+			}
+
+		//! Get the period of load checks.
+		[[nodiscard]]
+		duration_t
+		check_period() const noexcept { return m_check_period; }
+
+	private :
+		//! The min count of threads.
+		std::size_t m_min_threads{ 1u };
+
+		//! The count of waiting agent queues that means the overload.
+		std::size_t m_scale_up_queue_depth{ 1u };
+
+		//! The duration of overload before the start of a new thread.
+		duration_t m_scale_up_delay{ std::chrono::milliseconds{ 10 } };
+
+		//! The duration of idleness before the stop of a thread.
+		duration_t m_scale_down_idle_time{ std::chrono::seconds{ 1 } };
+
+		//! The period of load checks.
+		duration_t m_check_period{ std::chrono::milliseconds{ 5 } };
+	};
+
+} /* namespace so_5::disp */
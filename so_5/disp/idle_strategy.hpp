@@ -0,0 +1,362 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \file
+ * \brief Idle strategies for worker threads of dispatchers.
+ *
+ * \since v.5.8.3
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace so_5::disp
+{
+
+//
+// idle_strategy_kind_t
+//
+/*!
+ * \brief Kind of idle strategy.
+ *
+ * \since v.5.8.3
+ */
+enum class idle_strategy_kind_t
+	{
+		//! Busy waiting with `pause` instruction without parking.
+		/*!
+		 * A worker thread never goes to the OS-level sleep. It gives
+		 * the minimal wakeup latency, but a CPU is fully loaded even if
+		 * there is no work.
+		 */
+		busy_spin,
+		//! Bounded busy waiting then yielding then parking.
+		spin_then_yield,
+		//! Busy waiting then sleeping with exponentially growing pauses.
+		/*!
+		 * A worker thread never parks on a condition variable. It wakes
+		 * up periodically to check for new work, the max period is
+		 * limited by idle_strategy_t::max_sleep().
+		 */
+		exponential_backoff,
+		//! Parking without any busy waiting.
+		/*!
+		 * A worker thread goes to the OS-level sleep immediately.
+		 * It saves a CPU but gives the biggest wakeup latency.
+		 */
+		park
+	};
+
+//
+// idle_strategy_t
+//
+/*!
+ * \brief Description of the behavior of a worker thread that has no work.
+ *
+ * Idle strategy is used by locks created by
+ * so_5::disp::mpsc_queue_traits::idle_strategy_lock_factory() and
+ * so_5::disp::mpmc_queue_traits::idle_strategy_lock_factory().
+ *
+ * Usage example:
+ * \code
+ * using namespace so_5::disp;
+ *
+ * // Latency-critical agents, a CPU will be burnt.
+ * auto fast = one_thread::make_dispatcher( env, "fast",
+ * 	one_thread::disp_params_t{}
+ * 		.tune_queue_params( []( one_thread::queue_traits::queue_params_t & p ) {
+ * 			p.lock_factory( one_thread::queue_traits::idle_strategy_lock_factory(
+ * 				idle_strategy_t::busy_spin() ) );
+ * 		} ) );
+ *
+ * // Background agents, no CPU is used when there is no work.
+ * auto background = thread_pool::make_dispatcher( env, "background",
+ * 	thread_pool::disp_params_t{}
+ * 		.thread_count( 4 )
+ * 		.tune_queue_params( []( thread_pool::queue_traits::queue_params_t & p ) {
+ * 			p.lock_factory( thread_pool::queue_traits::idle_strategy_lock_factory(
+ * 				idle_strategy_t::park() ) );
+ * 		} ) );
+ * \endcode
+ *
+ * \since v.5.8.3
+ */
+class idle_strategy_t
+	{
+	public :
+		//! Type of duration used by idle strategies.
+		using duration_t = std::chrono::steady_clock::duration;
+
+		//! Busy waiting without parking.
+		[[nodiscard]]
+		static idle_strategy_t
+		busy_spin() noexcept
+			{
+				return { idle_strategy_kind_t::busy_spin, 0u, {}, {} };
+			}
+
+		//! Bounded busy waiting then yielding then parking.
+		/*!
+		 * A worker thread executes \a spin_count iterations with `pause`
+		 * instruction, then calls std::this_thread::yield() during
+		 * \a yield_time, then parks.
+		 */
+		[[nodiscard]]
+		static idle_strategy_t
+		spin_then_yield(
+			//! Count of iterations with `pause` instruction.
+			std::size_t spin_count = 1000u,
+			//! Max time for yielding stage.
+			duration_t yield_time = std::chrono::milliseconds{ 1 } ) noexcept
+			{
+				return { idle_strategy_kind_t::spin_then_yield,
+						spin_count, yield_time, {} };
+			}
+
+		//! Busy waiting then sleeping with exponentially growing pauses.
+		/*!
+		 * A worker thread executes several series of `pause` instructions
+		 * (the length of every series is doubled), then sleeps for
+		 * \a min_sleep, then for 2*min_sleep and so on. The length of
+		 * a sleep is limited by \a max_sleep.
+		 */
+		[[nodiscard]]
+		static idle_strategy_t
+		exponential_backoff(
+			//! The length of the first sleep.
+			duration_t min_sleep = std::chrono::microseconds{ 1 },
+			//! The max length of a sleep.
+			duration_t max_sleep = std::chrono::milliseconds{ 1 } ) noexcept
+			{
+				return { idle_strategy_kind_t::exponential_backoff,
+						0u, min_sleep, max_sleep };
+			}
+
+		//! Parking without busy waiting.
+		[[nodiscard]]
+		static idle_strategy_t
+		park() noexcept
+			{
+				return { idle_strategy_kind_t::park, 0u, {}, {} };
+			}
+
+		//! Kind of the strategy.
+		[[nodiscard]]
+		idle_strategy_kind_t
+		kind() const noexcept { return m_kind; }
+
+		//! Count of busy waiting iterations for spin_then_yield.
+		[[nodiscard]]
+		std::size_t
+		spin_count() const noexcept { return m_spin_count; }
+
+		//! Time of yielding for spin_then_yield.
+		[[nodiscard]]
+		duration_t
+		yield_time() const noexcept { return m_time; }
+
+		//! The length of the first sleep for exponential_backoff.
+		[[nodiscard]]
+		duration_t
+		min_sleep() const noexcept { return m_time; }
+
+		//! The max length of a sleep for exponential_backoff.
+		[[nodiscard]]
+		duration_t
+		max_sleep() const noexcept { return m_max_time; }
+
+	private :
+		idle_strategy_t(
+			idle_strategy_kind_t kind,
+			std::size_t spin_count,
+			duration_t time,
+			duration_t max_time ) noexcept
+			:	m_kind{ kind }
+			,	m_spin_count{ spin_count }
+			,	m_time{ time }
+			,	m_max_time{ max_time }
+			{}
+
+		//! Kind of the strategy.
+		idle_strategy_kind_t m_kind;
+		//! Count of busy waiting iterations.
+		std::size_t m_spin_count;
+		//! Yielding time or the length of the first sleep.
+		duration_t m_time;
+		//! The max length of a sleep.
+		duration_t m_max_time;
+	};
+
+//
+// idle_stats_t
+//
+/*!
+ * \brief Statistics for idle periods of worker threads.
+ *
+ * \since v.5.8.3
+ */
+struct idle_stats_t
+	{
+		//! Total count of wakeups.
+		std::uint64_t m_wakeups{};
+
+		//! Count of wakeups without parking.
+		/*!
+		 * It's the count of notifications received during busy waiting,
+		 * yielding or sleeping stages.
+		 */
+		std::uint64_t m_active_wakeups{};
+
+		//! Count of wakeups from parking.
+		std::uint64_t m_parked_wakeups{};
+
+		//! Total time between notifications and returns from waiting.
+		std::chrono::nanoseconds m_total_wakeup_latency{};
+
+		//! Max time between a notification and return from waiting.
+		std::chrono::nanoseconds m_max_wakeup_latency{};
+
+		//! Total time spent in busy waiting, yielding and sleeping stages.
+		/*!
+		 * It's the estimation of CPU time spent by worker threads while
+		 * they have no work.
+		 *
+		 * \note
+		 * For exponential_backoff strategy it also includes time of
+		 * short sleeps.
+		 */
+		std::chrono::nanoseconds m_idle_cpu_time{};
+
+		//! Total time spent in parking.
+		std::chrono::nanoseconds m_parked_time{};
+
+		//! Average wakeup latency.
+		[[nodiscard]]
+		std::chrono::nanoseconds
+		avg_wakeup_latency() const noexcept
+			{
+				return m_wakeups ?
+						m_total_wakeup_latency / static_cast< std::int64_t >( m_wakeups ) :
+						std::chrono::nanoseconds::zero();
+			}
+	};
+
+//
+// idle_stats_collector_t
+//
+/*!
+ * \brief A thread-safe collector of idle statistics.
+ *
+ * An instance of collector can be passed to lock factories. All locks
+ * created by a factory will update the same collector.
+ *
+ * Usage example:
+ * \code
+ * auto stats = std::make_shared< so_5::disp::idle_stats_collector_t >();
+ * auto disp = so_5::disp::one_thread::make_dispatcher( env, "fast",
+ * 	so_5::disp::one_thread::disp_params_t{}
+ * 		.tune_queue_params( [stats]( auto & p ) {
+ * 			p.lock_factory(
+ * 				so_5::disp::mpsc_queue_traits::idle_strategy_lock_factory(
+ * 					so_5::disp::idle_strategy_t::spin_then_yield(),
+ * 					stats ) );
+ * 		} ) );
+ * ...
+ * const auto snapshot = stats->stats();
+ * std::cout << "avg wakeup latency: "
+ * 	<< snapshot.avg_wakeup_latency().count() << "ns" << std::endl;
+ * \endcode
+ *
+ * \note
+ * Time is measured only if a collector is specified. If there is no
+ * collector then there is no overhead for calls to clock.
+ *
+ * \since v.5.8.3
+ */
+class idle_stats_collector_t
+	{
+	public :
+		//! Record information about one wakeup.
+		void
+		record_wakeup(
+			//! Was the worker thread parked?
+			bool parked,
+			//! Time between notification and return from waiting.
+			std::chrono::nanoseconds wakeup_latency,
+			//! Time of busy waiting, yielding and sleeping stages.
+			std::chrono::nanoseconds idle_cpu_time,
+			//! Time of parking.
+			std::chrono::nanoseconds parked_time ) noexcept
+			{
+				m_wakeups.fetch_add( 1u, std::memory_order_relaxed );
+				( parked ? m_parked_wakeups : m_active_wakeups ).fetch_add(
+						1u, std::memory_order_relaxed );
+
+				m_total_wakeup_latency.fetch_add(
+						wakeup_latency.count(), std::memory_order_relaxed );
+
+				auto max = m_max_wakeup_latency.load( std::memory_order_relaxed );
+				while( max < wakeup_latency.count() &&
+						!m_max_wakeup_latency.compare_exchange_weak(
+								max, wakeup_latency.count(),
+								std::memory_order_relaxed ) )
+					{}
+
+				m_idle_cpu_time.fetch_add(
+						idle_cpu_time.count(), std::memory_order_relaxed );
+				m_parked_time.fetch_add(
+						parked_time.count(), std::memory_order_relaxed );
+			}
+
+		//! Get the current values of counters.
+		[[nodiscard]]
+		idle_stats_t
+		stats() const noexcept
+			{
+				idle_stats_t r;
+				r.m_wakeups = m_wakeups.load( std::memory_order_relaxed );
+				r.m_active_wakeups = m_active_wakeups.load( std::memory_order_relaxed );
+				r.m_parked_wakeups = m_parked_wakeups.load( std::memory_order_relaxed );
+				r.m_total_wakeup_latency = std::chrono::nanoseconds{
+						m_total_wakeup_latency.load( std::memory_order_relaxed ) };
+				r.m_max_wakeup_latency = std::chrono::nanoseconds{
+						m_max_wakeup_latency.load( std::memory_order_relaxed ) };
+				r.m_idle_cpu_time = std::chrono::nanoseconds{
+						m_idle_cpu_time.load( std::memory_order_relaxed ) };
+				r.m_parked_time = std::chrono::nanoseconds{
+						m_parked_time.load( std::memory_order_relaxed ) };
+
+				return r;
+			}
+
+	private :
+		using counter_t = std::atomic< std::uint64_t >;
+		using nanoseconds_t = std::atomic< std::chrono::nanoseconds::rep >;
+
+		counter_t m_wakeups{ 0u };
+		counter_t m_active_wakeups{ 0u };
+		counter_t m_parked_wakeups{ 0u };
+		nanoseconds_t m_total_wakeup_latency{ 0 };
+		nanoseconds_t m_max_wakeup_latency{ 0 };
+		nanoseconds_t m_idle_cpu_time{ 0 };
+		nanoseconds_t m_parked_time{ 0 };
+	};
+
+//
+// idle_stats_collector_shptr_t
+//
+/*!
+ * \brief An alias for shared_ptr to idle_stats_collector.
+ *
+ * \since v.5.8.3
+ */
+using idle_stats_collector_shptr_t = std::shared_ptr< idle_stats_collector_t >;
+
+} /* namespace so_5::disp */
@@ -14,6 +14,8 @@
 
 #include <so_5/spinlocks.hpp>
 
+#include <so_5/disp/reuse/idle_waiting.hpp>
+
 #include <mutex>
 #include <condition_variable>
 
@@ -267,6 +269,162 @@ class actual_lock_t : public lock_t
 
 } /* namespace simple_lock */
 
+namespace idle_strategy_lock
+{
+
+using spinlock_t = so_5::default_spinlock_t;
+
+//
+// actual_cond_t
+//
+/*!
+ * \brief Implementation of condition object for the case of lock with
+ * idle strategy.
+ *
+ * \since v.5.8.3
+ */
+class actual_cond_t final : public condition_t
+	{
+		//! Spinlock from parent lock object.
+		spinlock_t & m_spinlock;
+		//! Idle strategy from parent lock object.
+		const idle_strategy_t & m_strategy;
+		//! Stats collector from parent lock object. Can be nullptr.
+		idle_stats_collector_t * m_stats;
+
+		//! An indicator of notification for condition object.
+		bool m_signaled{ false };
+		//! Is the owner of condition parked?
+		bool m_parked{ false };
+
+		//! Time of the last notification.
+		/*!
+		 * Updated only if there is a stats collector.
+		 */
+		reuse::idle_waiting::clock_t::time_point m_notified_at{};
+
+		//! Personal mutex to be used with condition variable.
+		std::mutex m_mutex;
+		//! Condition variable for parking.
+		std::condition_variable m_condition;
+
+	public :
+		//! Initializing constructor.
+		actual_cond_t(
+			spinlock_t & spinlock,
+			const idle_strategy_t & strategy,
+			idle_stats_collector_t * stats )
+			:	m_spinlock( spinlock )
+			,	m_strategy( strategy )
+			,	m_stats( stats )
+			{}
+
+		void
+		wait() noexcept override
+			{
+				/*
+				 * NOTE: spinlock of the parent lock object is already
+				 * acquired by the current thread.
+				 */
+				m_signaled = false;
+
+				reuse::idle_waiting::waiting_meter_t meter{ m_stats, m_strategy };
+
+				const bool signaled = reuse::idle_waiting::wait_actively(
+						m_strategy, m_spinlock, [this]{ return m_signaled; } );
+
+				if( !signaled )
+					{
+						meter.parking_started();
+
+						// Personal mutex must be acquired before the release
+						// of the spinlock. Otherwise a notification can be lost.
+						std::unique_lock< std::mutex > mutex_lock{ m_mutex };
+						m_parked = true;
+						m_spinlock.unlock();
+
+						m_condition.wait( mutex_lock, [this]{ return m_signaled; } );
+
+						// Personal mutex must be released before the acquisition
+						// of the spinlock to avoid a deadlock with notify().
+						mutex_lock.unlock();
+						m_spinlock.lock();
+						m_parked = false;
+					}
+
+				meter.waiting_finished( m_notified_at );
+			}
+
+		/*!
+		 * \attention
+		 * Must be called only when the spinlock of the parent lock object
+		 * is acquired.
+		 */
+		void
+		notify() noexcept override
+			{
+				if( m_stats )
+					m_notified_at = reuse::idle_waiting::clock_t::now();
+
+				if( m_parked )
+					{
+						std::lock_guard< std::mutex > mutex_lock{ m_mutex };
+						m_signaled = true;
+						m_condition.notify_one();
+					}
+				else
+					m_signaled = true;
+			}
+	};
+
+//
+// actual_lock_t
+//
+/*!
+ * \brief Actual implementation of lock object with idle strategy.
+ *
+ * \since v.5.8.3
+ */
+class actual_lock_t final : public lock_t
+	{
+		//! Common spinlock for locking of producers and consumers.
+		spinlock_t m_spinlock;
+		//! Idle strategy for all customers.
+		const idle_strategy_t m_strategy;
+		//! Optional stats collector.
+		const idle_stats_collector_shptr_t m_stats;
+
+	public :
+		//! Initializing constructor.
+		actual_lock_t(
+			idle_strategy_t strategy,
+			idle_stats_collector_shptr_t stats )
+			:	m_strategy{ strategy }
+			,	m_stats{ std::move(stats) }
+			{}
+
+		void
+		lock() noexcept override
+			{
+				m_spinlock.lock();
+			}
+
+		void
+		unlock() noexcept override
+			{
+				m_spinlock.unlock();
+			}
+
+		condition_unique_ptr_t
+		allocate_condition() override
+			{
+				return condition_unique_ptr_t{
+					new actual_cond_t{ m_spinlock, m_strategy, m_stats.get() } };
+			}
+	};
+
+} /* namespace idle_strategy_lock */
+
 //
 // combined_lock_factory
 //
@@ -291,6 +449,20 @@ simple_lock_factory()
 			};
 	}
 
+//
+// idle_strategy_lock_factory
+//
+SO_5_FUNC lock_factory_t
+idle_strategy_lock_factory(
+	idle_strategy_t strategy,
+	idle_stats_collector_shptr_t stats )
+	{
+		return [strategy, stats = std::move(stats)] {
+				return lock_unique_ptr_t{
+					new idle_strategy_lock::actual_lock_t{ strategy, stats } };
+			};
+	}
+
 } /* namespace mpmc_queue_traits */
 
 } /* namespace disp */
@@ -14,6 +14,8 @@
 #include <so_5/declspec.hpp>
 #include <so_5/compiler_features.hpp>
 
+#include <so_5/disp/idle_strategy.hpp>
+
 #include <functional>
 #include <memory>
 #include <chrono>
@@ -221,6 +223,39 @@ combined_lock_factory()
 SO_5_FUNC lock_factory_t
 simple_lock_factory();
 
+//
+// idle_strategy_lock_factory
+//
+/*!
+ * \brief Factory for creation of queue lock with the specified idle
+ * strategy.
+ *
+ * If \a stats is not empty then every created lock will update it.
+ *
+ * \par Usage example:
+	\code
+	using namespace so_5::disp::thread_pool;
+	auto disp = make_dispatcher(
+		env,
+		"background_pool",
+		disp_params_t{}
+			.thread_count( 4 )
+			.tune_queue_params( []( queue_traits::queue_params_t & params ) {
+					params.lock_factory( queue_traits::idle_strategy_lock_factory(
+						// Park idle threads immediately.
+						so_5::disp::idle_strategy_t::park() ) );
+				} ) );
+	\endcode
+ *
+ * \since v.5.8.3
+ */
+SO_5_FUNC lock_factory_t
+idle_strategy_lock_factory(
+	//! Behavior of a waiting thread.
+	idle_strategy_t strategy,
+	//! Optional collector of idle statistics.
+	idle_stats_collector_shptr_t stats = {} );
+
 //
 // queue_params_t
 //
@@ -14,6 +14,8 @@
 
 #include <so_5/spinlocks.hpp>
 
+#include <so_5/disp/reuse/idle_waiting.hpp>
+
 #include <so_5/details/invoke_noexcept_code.hpp>
 
 #include <mutex>
@@ -196,6 +198,118 @@ class simple_lock_t : public lock_t
 		bool m_signaled = { false };
 	};
 
+//
+// idle_strategy_lock_t
+//
+/*!
+ * \brief A lock that uses idle strategy for waiting.
+ *
+ * Spinlock is used for queue protection. std::mutex and
+ * std::condition_variable are used only if the waiting thread is parked.
+ * If the waiting thread isn't parked then notification is just a change
+ * of a flag.
+ *
+ * \attention This lock can be used only for single-consumer queues!
+ *
+ * \since v.5.8.3
+ */
+class idle_strategy_lock_t final : public lock_t
+	{
+	public :
+		idle_strategy_lock_t(
+			idle_strategy_t strategy,
+			idle_stats_collector_shptr_t stats )
+			:	m_strategy{ strategy }
+			,	m_stats{ std::move(stats) }
+			{}
+
+		void
+		lock() noexcept override
+			{
+				m_spinlock.lock();
+			}
+
+		void
+		unlock() noexcept override
+			{
+				m_spinlock.unlock();
+			}
+
+	protected :
+		void
+		wait_for_notify() noexcept override
+			{
+				m_waiting = true;
+
+				reuse::idle_waiting::waiting_meter_t meter{ m_stats.get(), m_strategy };
+
+				const bool signaled = reuse::idle_waiting::wait_actively(
+						m_strategy, m_spinlock, [this]{ return m_signaled; } );
+
+				if( !signaled )
+					{
+						meter.parking_started();
+
+						// The mutex must be acquired before the release of the
+						// spinlock. Otherwise a notification can be lost.
+						std::unique_lock< std::mutex > mlock{ m_mutex };
+						m_parked = true;
+						m_spinlock.unlock();
+
+						m_condition.wait( mlock, [this]{ return m_signaled; } );
+
+						// The mutex must be released before the acquisition of
+						// the spinlock to avoid a deadlock with notify_one().
+						mlock.unlock();
+						m_spinlock.lock();
+						m_parked = false;
+					}
+
+				m_waiting = false;
+				m_signaled = false;
+
+				meter.waiting_finished( m_notified_at );
+			}
+
+		void
+		notify_one() noexcept override
+			{
+				if( m_waiting && !m_signaled )
+					{
+						if( m_stats )
+							m_notified_at = reuse::idle_waiting::clock_t::now();
+
+						if( m_parked )
+							{
+								std::lock_guard< std::mutex > mlock{ m_mutex };
+								m_signaled = true;
+								m_condition.notify_one();
+							}
+						else
+							m_signaled = true;
+					}
+			}
+
+	private :
+		const idle_strategy_t m_strategy;
+		const idle_stats_collector_shptr_t m_stats;
+
+		default_spinlock_t m_spinlock;
+
+		std::mutex m_mutex;
+		std::condition_variable m_condition;
+
+		bool m_waiting{ false };
+		bool m_parked{ false };
+		bool m_signaled{ false };
+
+		//! Time of the last notification.
+		/*!
+		 * Updated only if there is a stats collector.
+		 */
+		reuse::idle_waiting::clock_t::time_point m_notified_at{};
+	};
+
 } /* namespace impl */
 
 //
@@ -219,6 +333,20 @@ simple_lock_factory()
 		return [] { return lock_unique_ptr_t{ new impl::simple_lock_t{} }; };
 	}
 
+//
+// idle_strategy_lock_factory
+//
+SO_5_FUNC lock_factory_t
+idle_strategy_lock_factory(
+	idle_strategy_t strategy,
+	idle_stats_collector_shptr_t stats )
+	{
+		return [strategy, stats = std::move(stats)] {
+			return lock_unique_ptr_t{
+					new impl::idle_strategy_lock_t{ strategy, stats } };
+		};
+	}
+
 } /* namespace mpsc_queue_traits */
 
 } /* namespace disp */
@@ -14,6 +14,8 @@
 #include <so_5/declspec.hpp>
 #include <so_5/compiler_features.hpp>
 
+#include <so_5/disp/idle_strategy.hpp>
+
 #include <functional>
 #include <memory>
 #include <chrono>
@@ -162,6 +164,37 @@ combined_lock_factory()
 SO_5_FUNC lock_factory_t
 simple_lock_factory();
 
+//
+// idle_strategy_lock_factory
+//
+/*!
+ * \brief Factory for creation of queue lock with the specified idle
+ * strategy.
+ *
+ * If \a stats is not empty then every created lock will update it.
+ *
+ * \par Usage example:
+	\code
+	auto disp = so_5::disp::one_thread::make_dispatcher(
+		env,
+		"market_data",
+		so_5::disp::one_thread::disp_params_t{}.tune_queue_params(
+			[]( so_5::disp::one_thread::queue_traits::queue_params_t & p ) {
+				p.lock_factory( so_5::disp::one_thread::queue_traits::idle_strategy_lock_factory(
+					// Never park the work thread.
+					so_5::disp::idle_strategy_t::busy_spin() ) );
+			} ) );
+	\endcode
+ *
+ * \since v.5.8.3
+ */
+SO_5_FUNC lock_factory_t
+idle_strategy_lock_factory(
+	//! Behavior of a waiting thread.
+	idle_strategy_t strategy,
+	//! Optional collector of idle statistics.
+	idle_stats_collector_shptr_t stats = {} );
+
 //
 // unique_lock_t
 //
@@ -240,6 +273,35 @@ class lock_guard_t
 		lock_t & m_lock;
 	};
 
+//
+// demand_queue_kind_t
+//
+/*!
+ * \brief Kind of demand queue for dispatchers with dedicated work threads.
+ *
+ * \since v.5.8.3
+ */
+enum class demand_queue_kind_t
+	{
+		//! Demands are stored in a container protected by a lock.
+		/*!
+		 * Every push acquires the lock created by lock factory.
+		 * It's the default kind.
+		 */
+		lock_based,
+		//! Demands are stored in an intrusive lock-free MPSC list.
+		/*!
+		 * A push is just one atomic exchange. The lock created by lock
+		 * factory is used only for sleeping of the work thread when
+		 * the queue is empty.
+		 *
+		 * \note
+		 * The size of the queue reported by run-time monitoring includes
+		 * only demands already extracted by the work thread.
+		 */
+		lock_free
+	};
+
 //
 // queue_params_t
 //
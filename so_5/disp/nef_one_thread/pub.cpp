@@ -547,7 +547,9 @@ send_thread_activity_stats(
  * \since v.5.8.0
  */
 template< typename Work_Thread >
-class dispatcher_template_t final : public disp_binder_t
+class dispatcher_template_t final
+	:	public disp_binder_t
+	,	public transfer_queue_provider_t
 	{
 		friend class disp_data_source_t;
 
@@ -610,25 +612,7 @@ class dispatcher_template_t final : public disp_binder_t
 		bind(
 			agent_t & agent ) noexcept override
 			{
-				event_queue_t & queue = [&]() -> event_queue_t &
-					{
-						std::lock_guard< std::mutex > lock{ m_agent_map_lock };
-
-						auto it = m_agents.find( std::addressof(agent) );
-						// Just in case, to simplify debugging if something
-						// went very, very wrong.
-						// This will lead to the termination of the application,
-						// but it is better than accessing a random pointer.
-						if( it == m_agents.end() )
-							SO_5_THROW_EXCEPTION(
-									rc_no_preallocated_resources_for_agent,
-									"nef_one_thread dispatcher has no info about an agent "
-									"in bind() method" );
-
-						return *(it->second);
-					}();
-
-				agent.so_bind_to_dispatcher( queue );
+				agent.so_bind_to_dispatcher( bind_transferred( agent ) );
 			}
 
 		void
@@ -639,6 +623,26 @@ class dispatcher_template_t final : public disp_binder_t
 				this->undo_preallocation( agent );
 			}
 
+		event_queue_t &
+		bind_transferred(
+			agent_t & agent ) noexcept override
+			{
+				std::lock_guard< std::mutex > lock{ m_agent_map_lock };
+
+				auto it = m_agents.find( std::addressof(agent) );
+				// Just in case, to simplify debugging if something
+				// went very, very wrong.
+				// This will lead to the termination of the application,
+				// but it is better than accessing a random pointer.
+				if( it == m_agents.end() )
+					SO_5_THROW_EXCEPTION(
+							rc_no_preallocated_resources_for_agent,
+							"nef_one_thread dispatcher has no info about an agent "
+							"in bind() method" );
+
+				return *(it->second);
+			}
+
 	private:
 		/*!
 		 * \brief Data source for run-time monitoring of whole dispatcher.
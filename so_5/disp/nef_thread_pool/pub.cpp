@@ -260,7 +260,9 @@ using actual_dispatcher_iface_shptr_t =
  *
  * \since v.5.8.0
  */
-class actual_binder_t final : public disp_binder_t
+class actual_binder_t final
+	:	public disp_binder_t
+	,	public transfer_queue_provider_t
 	{
 		//! Dispatcher to be used.
 		actual_dispatcher_iface_shptr_t m_disp;
@@ -293,8 +295,7 @@ class actual_binder_t final : public disp_binder_t
 		bind(
 			agent_t & agent ) noexcept override
 			{
-				auto queue = m_disp->query_resources_for_agent( agent );
-				agent.so_bind_to_dispatcher( *queue );
+				agent.so_bind_to_dispatcher( bind_transferred( agent ) );
 			}
 
 		void
@@ -303,6 +304,13 @@ class actual_binder_t final : public disp_binder_t
 			{
 				m_disp->unbind_agent( agent );
 			}
+
+		event_queue_t &
+		bind_transferred(
+			agent_t & agent ) noexcept override
+			{
+				return *(m_disp->query_resources_for_agent( agent ));
+			}
 	};
 
 //
@@ -19,6 +19,8 @@
 
 #include <so_5/disp/reuse/work_thread_activity_tracking.hpp>
 #include <so_5/disp/reuse/work_thread_factory_params.hpp>
+#include <so_5/disp/reuse/demand_queue_kind_mixin.hpp>
+#include <so_5/disp/reuse/same_thread_delivery_mixin.hpp>
 
 namespace so_5
 {
@@ -47,11 +49,17 @@ namespace queue_traits = so_5::disp::mpsc_queue_traits;
 class disp_params_t
 	:	public so_5::disp::reuse::work_thread_activity_tracking_flag_mixin_t< disp_params_t >
 	,	public so_5::disp::reuse::work_thread_factory_mixin_t< disp_params_t >
+	,	public so_5::disp::reuse::demand_queue_kind_mixin_t< disp_params_t >
+	,	public so_5::disp::reuse::same_thread_delivery_mixin_t< disp_params_t >
 	{
 		using activity_tracking_mixin_t = so_5::disp::reuse::
 				work_thread_activity_tracking_flag_mixin_t< disp_params_t >;
 		using thread_factory_mixin_t = so_5::disp::reuse::
 				work_thread_factory_mixin_t< disp_params_t >;
+		using queue_kind_mixin_t = so_5::disp::reuse::
+				demand_queue_kind_mixin_t< disp_params_t >;
+		using same_thread_delivery_mixin_t = so_5::disp::reuse::
+				same_thread_delivery_mixin_t< disp_params_t >;
 
 	public :
 		//! Default constructor.
@@ -68,6 +76,12 @@ class disp_params_t
 				swap(
 						static_cast< thread_factory_mixin_t & >(a),
 						static_cast< thread_factory_mixin_t & >(b) );
+				swap(
+						static_cast< queue_kind_mixin_t & >(a),
+						static_cast< queue_kind_mixin_t & >(b) );
+				swap(
+						static_cast< same_thread_delivery_mixin_t & >(a),
+						static_cast< same_thread_delivery_mixin_t & >(b) );
 				swap( a.m_queue_params, b.m_queue_params );
 			}
 
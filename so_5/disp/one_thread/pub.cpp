@@ -82,6 +82,33 @@ track_activity(
 				data.m_work_thread.take_activity_stats() );
 	}
 
+/*!
+ * \since v.5.8.3
+ */
+inline void
+track_activity(
+	const mbox_t &,
+	const common_data_t<
+			work_thread::lock_free_work_thread_no_activity_tracking_t > & )
+	{}
+
+/*!
+ * \since v.5.8.3
+ */
+inline void
+track_activity(
+	const mbox_t & mbox,
+	const common_data_t<
+			work_thread::lock_free_work_thread_with_activity_tracking_t > & data )
+	{
+		so_5::send< stats::messages::work_thread_activity >(
+				mbox,
+				data.m_base_prefix,
+				stats::suffixes::work_thread_activity(),
+				data.m_work_thread.thread_id(),
+				data.m_work_thread.take_activity_stats() );
+	}
+
 } /* namespace data_source_details */
 
 /*!
@@ -131,6 +158,11 @@ class data_source_t final
 						stats::suffixes::work_thread_queue_size(),
 						this->m_work_thread.demands_count() );
 
+				so_5::disp::reuse::send_wakeup_stats(
+						mbox,
+						this->m_work_thread_prefix,
+						this->m_work_thread.wakeup_stats() );
+
 				data_source_details::track_activity( mbox, *this );
 			}
 	};
@@ -151,7 +183,9 @@ class data_source_t final
  * v.5.6.0
  */
 template< typename Work_Thread >
-class actual_dispatcher_t final : public disp_binder_t
+class actual_dispatcher_t final
+	:	public disp_binder_t
+	,	public transfer_queue_provider_t
 	{
 	public:
 		actual_dispatcher_t(
@@ -168,6 +202,9 @@ class actual_dispatcher_t final : public disp_binder_t
 					name_base,
 					this }
 			{
+				if( params.same_thread_delivery() )
+					m_work_thread.turn_same_thread_delivery_on();
+
 				m_work_thread.start();
 			}
 
@@ -196,8 +233,7 @@ class actual_dispatcher_t final : public disp_binder_t
 		bind(
 			agent_t & agent ) noexcept override
 			{
-				agent.so_bind_to_dispatcher( *(m_work_thread.get_agent_binding()) );
-				++m_agents_bound;
+				agent.so_bind_to_dispatcher( bind_transferred( agent ) );
 			}
 
 		virtual void
@@ -207,6 +243,15 @@ class actual_dispatcher_t final : public disp_binder_t
 				--m_agents_bound;
 			}
 
+		// Implementation of methods, inherited from transfer_queue_provider_t.
+		event_queue_t &
+		bind_transferred(
+			agent_t & /*agent*/ ) noexcept override
+			{
+				++m_agents_bound;
+				return *(m_work_thread.get_agent_binding());
+			}
+
 	private:
 		//! Working thread for the dispatcher.
 		Work_Thread m_work_thread;
@@ -263,13 +308,32 @@ make_dispatcher(
 				impl::actual_dispatcher_t<
 						work_thread::work_thread_with_activity_tracking_t >;
 
-		disp_binder_shptr_t binder = so_5::disp::reuse::make_actual_dispatcher<
-						disp_binder_t,
-						dispatcher_no_activity_tracking_t,
-						dispatcher_with_activity_tracking_t >(
-				outliving_mutable(env),
-				data_sources_name_base,
-				std::move(params) );
+		using lock_free_dispatcher_no_activity_tracking_t =
+				impl::actual_dispatcher_t<
+						work_thread::lock_free_work_thread_no_activity_tracking_t >;
+
+		using lock_free_dispatcher_with_activity_tracking_t =
+				impl::actual_dispatcher_t<
+						work_thread::lock_free_work_thread_with_activity_tracking_t >;
+
+		disp_binder_shptr_t binder;
+		if( queue_traits::demand_queue_kind_t::lock_free ==
+				params.demand_queue_kind() )
+			binder = so_5::disp::reuse::make_actual_dispatcher<
+							disp_binder_t,
+							lock_free_dispatcher_no_activity_tracking_t,
+							lock_free_dispatcher_with_activity_tracking_t >(
+					outliving_mutable(env),
+					data_sources_name_base,
+					std::move(params) );
+		else
+			binder = so_5::disp::reuse::make_actual_dispatcher<
+							disp_binder_t,
+							dispatcher_no_activity_tracking_t,
+							dispatcher_with_activity_tracking_t >(
+					outliving_mutable(env),
+					data_sources_name_base,
+					std::move(params) );
 
 		return impl::dispatcher_handle_maker_t::make( std::move(binder) );
 	}
@@ -79,7 +79,9 @@ send_thread_activity_stats(
  * v.5.5.8, v.5.5.18, v.5.6.0
  */
 template< typename Work_Thread >
-class dispatcher_template_t final : public disp_binder_t
+class dispatcher_template_t final
+	:	public disp_binder_t
+	,	public transfer_queue_provider_t
 	{
 	public:
 		dispatcher_template_t(
@@ -123,12 +125,7 @@ class dispatcher_template_t final : public disp_binder_t
 		bind(
 			agent_t & agent ) noexcept override
 			{
-				const auto priority = agent.so_priority();
-
-				agent.so_bind_to_dispatcher(
-						*(m_threads[ to_size_t(priority) ]->get_agent_binding()) );
-
-				m_agents_per_priority[ to_size_t(priority) ] += 1;
+				agent.so_bind_to_dispatcher( bind_transferred( agent ) );
 			}
 
 		void
@@ -140,6 +137,17 @@ class dispatcher_template_t final : public disp_binder_t
 				m_agents_per_priority[ to_size_t(priority) ] -= 1;
 			}
 
+		event_queue_t &
+		bind_transferred(
+			agent_t & agent ) noexcept override
+			{
+				const auto priority = agent.so_priority();
+
+				m_agents_per_priority[ to_size_t(priority) ] += 1;
+
+				return *(m_threads[ to_size_t(priority) ]->get_agent_binding());
+			}
+
 	private:
 		friend class disp_data_source_t;
 
@@ -215,6 +223,11 @@ class dispatcher_template_t final : public disp_binder_t
 								stats::suffixes::work_thread_queue_size(),
 								wt.demands_count() );
 
+						so_5::disp::reuse::send_wakeup_stats(
+								mbox,
+								prefix,
+								wt.wakeup_stats() );
+
 						so_5::send< stats::messages::quantity< std::size_t > >(
 								mbox,
 								prefix,
@@ -0,0 +1,169 @@
+/*
+	SObjectizer 5.
+*/
+
+/*!
+ * \file
+ * \brief A lock-free demand queue for dispatcher with one common
+ * working thread and round-robin processing of prioritised demand on
+ * quoted basic.
+ *
+ * \since v.5.8.3
+ */
+
+#pragma once
+
+#include <so_5/disp/prio_one_thread/reuse/lock_free_demand_queue.hpp>
+
+#include <so_5/disp/prio_one_thread/quoted_round_robin/quotes.hpp>
+
+namespace so_5 {
+
+namespace disp {
+
+namespace prio_one_thread {
+
+namespace quoted_round_robin {
+
+namespace impl {
+
+//
+// lock_free_demand_queue_t
+//
+/*!
+ * \brief A lock-free demand queue for dispatcher with one common working
+ * thread and round-robin processing of prioritised demand on
+ * quoted basic.
+ *
+ * The policy is the same as for demand_queue_t: demands of the current
+ * priority are extracted until the quote is exhausted or there are no
+ * more demands of that priority. Then the next lower non-empty priority
+ * is selected (or the highest non-empty one at the start of a new
+ * iteration). Non-empty priorities are found by the bitmap of non-empty
+ * queues.
+ *
+ * \since v.5.8.3
+ */
+class lock_free_demand_queue_t final
+	:	public so_5::disp::prio_one_thread::reuse::lock_free_demand_queue_base_t
+	{
+		using base_type_t =
+				so_5::disp::prio_one_thread::reuse::lock_free_demand_queue_base_t;
+
+	public :
+		//! Statistic about one subqueue.
+		struct queue_stats_t
+			{
+				priority_t m_priority;
+				std::size_t m_quote;
+				std::size_t m_agents_count;
+				std::size_t m_demands_count;
+			};
+
+		lock_free_demand_queue_t(
+			queue_traits::lock_unique_ptr_t lock,
+			const quotes_t & quotes )
+			:	base_type_t{ std::move(lock) }
+			{
+				so_5::prio::for_each_priority( [&]( priority_t p ) {
+						m_quotes[ to_size_t(p) ] = quotes.query( p );
+					} );
+			}
+
+		//! Pop demand from the queue.
+		/*!
+		 * \throw shutdown_ex_t in the case when queue is shut down.
+		 */
+		[[nodiscard]]
+		so_5::disp::prio_one_thread::reuse::lock_free_demand_unique_ptr_t
+		pop()
+			{
+				for(;;)
+					{
+						this->throw_if_shutdown();
+
+						const auto non_empty = this->non_empty_queues();
+						if( !non_empty )
+							{
+								this->wait_for_demands();
+								continue;
+							}
+
+						// The current priority or the next lower non-empty one.
+						// If there is no such priority then a new iteration
+						// is started from the highest non-empty priority.
+						const auto not_higher = non_empty &
+								( ( std::uint32_t{1u} << ( m_current_priority + 1u ) ) - 1u );
+						const auto priority = highest_priority(
+								not_higher ? not_higher : non_empty );
+						if( priority != m_current_priority )
+							{
+								// Count of processed demands must be started from zero.
+								m_current_priority = priority;
+								m_demands_processed = 0u;
+							}
+
+						if( auto r = this->try_pop( m_current_priority ) )
+							{
+								if( ++m_demands_processed >= m_quotes[ m_current_priority ] )
+									// Processing of this priority on the current
+									// iteration is finished.
+									switch_to_lower_priority();
+
+								return r;
+							}
+					}
+			}
+
+		//! A special method for handling statistical data for
+		//! every subqueue.
+		template< class Lambda >
+		void
+		handle_stats_for_each_prio( Lambda handler )
+			{
+				so_5::prio::for_each_priority( [&]( so_5::priority_t p ) {
+						handler( queue_stats_t{ p,
+								m_quotes[ to_size_t(p) ],
+								this->agents_count( p ),
+								this->demands_count( p ) } );
+					} );
+			}
+
+	private :
+		//! Quotes for priorities.
+		std::size_t m_quotes[ so_5::prio::total_priorities_count ];
+
+		//! Index of the current priority.
+		/*!
+		 * Is used by the consumer only.
+		 */
+		std::size_t m_current_priority{ to_size_t( so_5::priority_t::p_max ) };
+
+		//! Count of processed demands on the current iterations.
+		/*!
+		 * Is used by the consumer only.
+		 */
+		std::size_t m_demands_processed{ 0u };
+
+		void
+		switch_to_lower_priority() noexcept
+			{
+				m_demands_processed = 0u;
+
+				if( m_current_priority )
+					--m_current_priority;
+				else
+					// Start new iteration from the highest priority.
+					m_current_priority = to_size_t( so_5::priority_t::p_max );
+			}
+	};
+
+} /* namespace impl */
+
+} /* namespace quoted_round_robin */
+
+} /* namespace prio_one_thread */
+
+} /* namespace disp */
+
+} /* namespace so_5 */
@@ -0,0 +1,501 @@
+/*
+	SObjectizer 5.
+*/
+
+/*!
+ * \file
+ * \brief A basic part of lock-free demand queues for dispatchers with
+ * one common working thread and support of demands priority.
+ *
+ * \since v.5.8.3
+ */
+
+#pragma once
+
+#include <so_5/execution_demand.hpp>
+#include <so_5/event_queue.hpp>
+
+#include <so_5/priority.hpp>
+
+#include <so_5/disp/mpsc_queue_traits/pub.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <thread>
+
+namespace so_5 {
+
+namespace disp {
+
+namespace prio_one_thread {
+
+namespace reuse {
+
+namespace queue_traits = so_5::disp::mpsc_queue_traits;
+
+//
+// lock_free_demand_t
+//
+/*!
+ * \brief A single execution demand in a lock-free queue.
+ *
+ * \since v.5.8.3
+ */
+struct lock_free_demand_t final : public execution_demand_t
+	{
+		//! Next demand in the queue.
+		std::atomic< lock_free_demand_t * > m_next{ nullptr };
+
+		//! Default constructor for the stub node.
+		lock_free_demand_t() = default;
+
+		//! Initializing constructor.
+		lock_free_demand_t( execution_demand_t && source )
+			:	execution_demand_t( std::move( source ) )
+			{}
+	};
+
+//
+// lock_free_demand_unique_ptr_t
+//
+/*!
+ * \brief An alias for unique_ptr to demand.
+ *
+ * \since v.5.8.3
+ */
+using lock_free_demand_unique_ptr_t = std::unique_ptr< lock_free_demand_t >;
+
+//
+// lock_free_demand_queue_base_t
+//
+/*!
+ * \brief A basic part of lock-free demand queues with support of
+ * demands priority.
+ *
+ * Every priority has its own intrusive MPSC queue. So producers of
+ * different priorities don't interfere with each other. A push is
+ * an atomic exchange of the pointer to the last demand in the queue for
+ * that priority.
+ *
+ * There is also a bitmap of non-empty queues. A producer sets the bit
+ * for the priority after the push (only if the bit isn't set yet). The
+ * consumer clears the bit when the queue for the priority becomes empty
+ * and then checks the queue again. If there is a new demand the bit is
+ * set back. A bit can be set for an empty queue for a short time, but
+ * there is no non-empty queue without its bit set when the consumer
+ * goes to sleep.
+ *
+ * The selection of a priority is made by a derived class by scanning
+ * the bitmap.
+ *
+ * The lock is used only for sleeping of the consumer when all queues
+ * are empty.
+ *
+ * \since v.5.8.3
+ */
+class lock_free_demand_queue_base_t
+	{
+		//! Queue for one priority.
+		struct queue_for_one_priority_t
+			:	public event_queue_t
+			{
+				//! Pointer to main demand queue.
+				lock_free_demand_queue_base_t * m_demand_queue = nullptr;
+
+				//! Bit of that queue in the bitmap of non-empty queues.
+				std::uint32_t m_bit = 0u;
+
+				//! The last added demand.
+				/*!
+				 * Modified by producers.
+				 */
+				alignas(64) std::atomic< lock_free_demand_t * > m_head;
+
+				//! The first demand to be extracted.
+				/*!
+				 * Modified by the consumer only.
+				 */
+				alignas(64) lock_free_demand_t * m_tail;
+
+				//! Stub node for the empty queue.
+				lock_free_demand_t m_stub;
+
+				/*!
+				 * \name Information for run-time monitoring.
+				 * \{
+				 */
+				//! Count of agents attached to that queue.
+				std::atomic< std::size_t > m_agents_count = { 0 };
+				//! Count of demands in the queue.
+				std::atomic< std::size_t > m_demands_count = { 0 };
+				/*!
+				 * \}
+				 */
+
+				queue_for_one_priority_t()
+					:	m_head{ &m_stub }
+					,	m_tail{ &m_stub }
+					{}
+
+				~queue_for_one_priority_t() override
+					{
+						while( auto * d = try_pop_node() )
+							delete d;
+					}
+
+				void
+				push( execution_demand_t exec_demand ) override
+					{
+						lock_free_demand_unique_ptr_t what{ new lock_free_demand_t{
+								std::move( exec_demand ) } };
+
+						m_demand_queue->push( *this, std::move( what ) );
+					}
+
+				/*!
+				 * \note
+				 * Delegates the work to the push() method.
+				 */
+				void
+				push_evt_start( execution_demand_t demand ) override
+					{
+						this->push( std::move(demand) );
+					}
+
+				/*!
+				 * \note
+				 * Delegates the work to the push() method.
+				 *
+				 * \attention
+				 * Terminates the whole application if the push() throws.
+				 */
+				void
+				push_evt_finish( execution_demand_t demand ) noexcept override
+					{
+						this->push( std::move(demand) );
+					}
+
+				//! Add a demand (or the stub) to the queue.
+				void
+				push_node( lock_free_demand_t * node ) noexcept
+					{
+						node->m_next.store( nullptr, std::memory_order_relaxed );
+
+						// NOTE: seq_cst is necessary here because of the check
+						// of the bitmap of non-empty queues after that.
+						auto * prev = m_head.exchange( node, std::memory_order_seq_cst );
+						prev->m_next.store( node, std::memory_order_release );
+					}
+
+				//! Try to extract a demand from the queue.
+				/*!
+				 * \return nullptr if the queue is empty or the next demand
+				 * is being added by a producer right now.
+				 *
+				 * \note
+				 * Can be called by the consumer only.
+				 */
+				[[nodiscard]]
+				lock_free_demand_t *
+				try_pop_node() noexcept
+					{
+						auto * tail = m_tail;
+						auto * next = tail->m_next.load( std::memory_order_acquire );
+						if( &m_stub == tail )
+							{
+								if( !next )
+									return nullptr;
+
+								m_tail = next;
+								tail = next;
+								next = next->m_next.load( std::memory_order_acquire );
+							}
+
+						if( next )
+							{
+								m_tail = next;
+								return tail;
+							}
+
+						if( tail != m_head.load( std::memory_order_acquire ) )
+							// A producer hasn't completed its push yet.
+							return nullptr;
+
+						// The stub has to be returned to the queue to extract
+						// the last demand.
+						push_node( &m_stub );
+
+						next = tail->m_next.load( std::memory_order_acquire );
+						if( next )
+							{
+								m_tail = next;
+								return tail;
+							}
+
+						return nullptr;
+					}
+
+				//! Is the queue empty and there is no incomplete pushes?
+				/*!
+				 * \note
+				 * Can be called by the consumer only.
+				 */
+				[[nodiscard]]
+				bool
+				is_empty() const noexcept
+					{
+						return &m_stub == m_tail &&
+								&m_stub == m_head.load( std::memory_order_seq_cst );
+					}
+			};
+
+	public :
+		//! This exception is thrown when pop is called after stop.
+		class shutdown_ex_t : public std::exception
+			{};
+
+		lock_free_demand_queue_base_t(
+			//! Lock to be used for sleeping of the consumer.
+			queue_traits::lock_unique_ptr_t lock )
+			:	m_lock{ std::move(lock) }
+			{
+				so_5::prio::for_each_priority( [&]( priority_t p ) {
+						auto & q = m_priorities[ to_size_t(p) ];
+						// Every subqueue must have a valid pointer to main demand
+						// queue.
+						q.m_demand_queue = this;
+						q.m_bit = std::uint32_t{1u} << to_size_t(p);
+					} );
+			}
+
+		lock_free_demand_queue_base_t(
+			const lock_free_demand_queue_base_t & ) = delete;
+		lock_free_demand_queue_base_t &
+		operator=( const lock_free_demand_queue_base_t & ) = delete;
+
+		//! Set the shutdown signal.
+		void
+		stop()
+			{
+				m_shutdown.store( true, std::memory_order_seq_cst );
+
+				queue_traits::lock_guard_t lock{ *m_lock };
+				notify_sleeping_consumer( lock );
+			}
+
+		//! Get queue for the priority specified.
+		event_queue_t &
+		event_queue_by_priority( priority_t priority )
+			{
+				return m_priorities[ to_size_t(priority) ];
+			}
+
+		//! Notification about attachment of yet another agent to the queue.
+		void
+		agent_bound( priority_t priority )
+			{
+				++(m_priorities[ to_size_t(priority) ].m_agents_count);
+			}
+
+		//! Notification about detachment of an agent from the queue.
+		void
+		agent_unbound( priority_t priority )
+			{
+				--(m_priorities[ to_size_t(priority) ].m_agents_count);
+			}
+
+	protected :
+		~lock_free_demand_queue_base_t() = default;
+
+		//! Count of agents attached to the queue for the priority.
+		[[nodiscard]]
+		std::size_t
+		agents_count( priority_t priority ) const noexcept
+			{
+				return m_priorities[ to_size_t(priority) ].m_agents_count.load(
+						std::memory_order_relaxed );
+			}
+
+		//! Count of demands in the queue for the priority.
+		[[nodiscard]]
+		std::size_t
+		demands_count( priority_t priority ) const noexcept
+			{
+				return m_priorities[ to_size_t(priority) ].m_demands_count.load(
+						std::memory_order_relaxed );
+			}
+
+		//! Throw shutdown_ex_t if the queue is stopped.
+		void
+		throw_if_shutdown() const
+			{
+				if( m_shutdown.load( std::memory_order_acquire ) )
+					throw shutdown_ex_t();
+			}
+
+		//! Get the bitmap of non-empty queues.
+		/*!
+		 * Bit N is set if there are demands with priority N.
+		 */
+		[[nodiscard]]
+		std::uint32_t
+		non_empty_queues() const noexcept
+			{
+				return m_non_empty.load( std::memory_order_seq_cst );
+			}
+
+		//! Get the highest priority from the bitmap of non-empty queues.
+		/*!
+		 * \attention
+		 * The \a bitmap must not be zero.
+		 */
+		[[nodiscard]]
+		static std::size_t
+		highest_priority( std::uint32_t bitmap ) noexcept
+			{
+				std::size_t r = so_5::prio::total_priorities_count - 1u;
+				while( !( bitmap & ( std::uint32_t{1u} << r ) ) )
+					--r;
+
+				return r;
+			}
+
+		//! Try to extract a demand with the priority specified.
+		/*!
+		 * Clears the bit in the bitmap of non-empty queues if the queue
+		 * for that priority is empty.
+		 *
+		 * \return nullptr if there is no demand for that priority.
+		 *
+		 * \note
+		 * Can be called by the consumer only.
+		 */
+		[[nodiscard]]
+		lock_free_demand_unique_ptr_t
+		try_pop( std::size_t priority_index )
+			{
+				auto & q = m_priorities[ priority_index ];
+
+				lock_free_demand_unique_ptr_t result{ q.try_pop_node() };
+				if( result )
+					{
+						--(q.m_demands_count);
+						return result;
+					}
+
+				if( q.is_empty() )
+					{
+						m_non_empty.fetch_and( ~q.m_bit, std::memory_order_seq_cst );
+
+						// A producer could add a demand and see the bit
+						// that is cleared just now.
+						if( !q.is_empty() )
+							m_non_empty.fetch_or( q.m_bit, std::memory_order_seq_cst );
+					}
+				else
+					// A producer is in the middle of push.
+					std::this_thread::yield();
+
+				return result;
+			}
+
+		//! Sleep until a new demand or the shutdown signal.
+		void
+		wait_for_demands()
+			{
+				queue_traits::unique_lock_t lock{ *m_lock };
+
+				m_sleeping.store( true, std::memory_order_seq_cst );
+
+				if( !m_shutdown.load( std::memory_order_seq_cst ) &&
+						!m_non_empty.load( std::memory_order_seq_cst ) )
+					lock.wait_for_notify();
+
+				// NOTE: the lock is acquired here again.
+				m_sleeping.store( false, std::memory_order_relaxed );
+			}
+
+	private :
+		//! Queue lock.
+		/*!
+		 * It isn't used for push and pop operations. It's necessary only
+		 * for sleeping of the consumer.
+		 */
+		queue_traits::lock_unique_ptr_t m_lock;
+
+		//! Shutdown flag.
+		std::atomic< bool > m_shutdown{ false };
+
+		//! Is the consumer going to sleep (or is sleeping already)?
+		/*!
+		 * Is modified only when m_lock is acquired. But it's read by
+		 * producers without the lock.
+		 */
+		std::atomic< bool > m_sleeping{ false };
+
+		//! Bitmap of non-empty queues.
+		alignas(64) std::atomic< std::uint32_t > m_non_empty{ 0u };
+
+		//! Subqueues for priorities.
+		queue_for_one_priority_t m_priorities[ so_5::prio::total_priorities_count ];
+
+		//! Push a new demand to the queue.
+		void
+		push(
+			//! Subqueue for the demand.
+			queue_for_one_priority_t & subqueue,
+			//! Demand to be pushed.
+			lock_free_demand_unique_ptr_t demand )
+			{
+				++(subqueue.m_demands_count);
+				subqueue.push_node( demand.release() );
+
+				// NOTE: seq_cst is necessary here. The consumer clears the bit
+				// and then checks the subqueue. The producer changes the
+				// subqueue and then checks the bit. At least one of them
+				// will see the change made by another.
+				if( !( m_non_empty.load( std::memory_order_seq_cst ) &
+						subqueue.m_bit ) )
+					{
+						const auto old = m_non_empty.fetch_or(
+								subqueue.m_bit, std::memory_order_seq_cst );
+
+						// The consumer can sleep only if all queues were empty.
+						if( !old && m_sleeping.load( std::memory_order_seq_cst ) )
+							{
+								queue_traits::lock_guard_t lock{ *m_lock };
+								notify_sleeping_consumer( lock );
+							}
+					}
+			}
+
+		//! Wake up the consumer if it's sleeping.
+		/*!
+		 * \attention
+		 * Must be called only when m_lock is acquired.
+		 *
+		 * \note
+		 * The consumer is notified only once for every sleep because
+		 * queue locks don't expect a notification of a thread which
+		 * is already notified.
+		 */
+		void
+		notify_sleeping_consumer( queue_traits::lock_guard_t & lock ) noexcept
+			{
+				if( m_sleeping.load( std::memory_order_relaxed ) )
+					{
+						m_sleeping.store( false, std::memory_order_relaxed );
+						lock.notify_one();
+					}
+			}
+	};
+
+} /* namespace reuse */
+
+} /* namespace prio_one_thread */
+
+} /* namespace disp */
+
+} /* namespace so_5 */
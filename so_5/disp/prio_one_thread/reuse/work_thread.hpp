@@ -175,6 +175,12 @@ class work_thread_template_t : public Work_Thread< Demand_Queue >
 		using base_type_t = Work_Thread< Demand_Queue >;
 
 	public :
+		//! Type of demand queue to work with.
+		/*!
+		 * \since v.5.8.3
+		 */
+		using demand_queue_type = Demand_Queue;
+
 		//! Initializing constructor.
 		work_thread_template_t(
 			work_thread_holder_t thread_holder,
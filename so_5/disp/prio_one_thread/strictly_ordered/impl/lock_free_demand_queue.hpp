@@ -0,0 +1,99 @@
+/*
+	SObjectizer 5.
+*/
+
+/*!
+ * \file
+ * \brief A lock-free demand queue for dispatcher with one common
+ * working thread and support of demands priority (strictly ordered
+ * policy).
+ *
+ * \since v.5.8.3
+ */
+
+#pragma once
+
+#include <so_5/disp/prio_one_thread/reuse/lock_free_demand_queue.hpp>
+
+namespace so_5 {
+
+namespace disp {
+
+namespace prio_one_thread {
+
+namespace strictly_ordered {
+
+namespace impl {
+
+//
+// lock_free_demand_queue_t
+//
+/*!
+ * \brief A lock-free demand queue with support of demands priorities.
+ *
+ * A demand with the highest priority is always extracted first.
+ * The highest priority is found by the bitmap of non-empty queues.
+ *
+ * \since v.5.8.3
+ */
+class lock_free_demand_queue_t final
+	:	public so_5::disp::prio_one_thread::reuse::lock_free_demand_queue_base_t
+	{
+		using base_type_t =
+				so_5::disp::prio_one_thread::reuse::lock_free_demand_queue_base_t;
+
+	public :
+		//! Statistic about one subqueue.
+		struct queue_stats_t
+			{
+				priority_t m_priority;
+				std::size_t m_agents_count;
+				std::size_t m_demands_count;
+			};
+
+		using base_type_t::base_type_t;
+
+		//! Pop demand from the queue.
+		/*!
+		 * \throw shutdown_ex_t in the case when queue is shut down.
+		 */
+		[[nodiscard]]
+		so_5::disp::prio_one_thread::reuse::lock_free_demand_unique_ptr_t
+		pop()
+			{
+				for(;;)
+					{
+						this->throw_if_shutdown();
+
+						const auto non_empty = this->non_empty_queues();
+						if( !non_empty )
+							this->wait_for_demands();
+						else if( auto r = this->try_pop(
+								highest_priority( non_empty ) ) )
+							return r;
+					}
+			}
+
+		//! A special method for handling statistical data for
+		//! every subqueue.
+		template< class Lambda >
+		void
+		handle_stats_for_each_prio( Lambda handler )
+			{
+				so_5::prio::for_each_priority( [&]( so_5::priority_t p ) {
+						handler( queue_stats_t{ p,
+								this->agents_count( p ),
+								this->demands_count( p ) } );
+					} );
+			}
+	};
+
+} /* namespace impl */
+
+} /* namespace strictly_ordered */
+
+} /* namespace prio_one_thread */
+
+} /* namespace disp */
+
+} /* namespace so_5 */
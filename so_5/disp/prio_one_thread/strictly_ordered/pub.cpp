@@ -13,6 +13,7 @@
 #include <so_5/disp/prio_one_thread/strictly_ordered/pub.hpp>
 
 #include <so_5/disp/prio_one_thread/strictly_ordered/impl/demand_queue.hpp>
+#include <so_5/disp/prio_one_thread/strictly_ordered/impl/lock_free_demand_queue.hpp>
 #include <so_5/disp/prio_one_thread/reuse/work_thread.hpp>
 
 #include <so_5/disp/reuse/actual_work_thread_factory_to_use.hpp>
@@ -39,22 +40,24 @@ namespace stats = so_5::stats;
 
 namespace {
 
+template< typename Demand_Queue >
 void
 send_thread_activity_stats(
 	const so_5::mbox_t &,
 	const stats::prefix_t &,
 	so_5::disp::prio_one_thread::reuse::work_thread_no_activity_tracking_t<
-			demand_queue_t > & )
+			Demand_Queue > & )
 	{
 		/* Nothing to do */
 	}
 
+template< typename Demand_Queue >
 void
 send_thread_activity_stats(
 	const so_5::mbox_t & mbox,
 	const stats::prefix_t & prefix,
 	so_5::disp::prio_one_thread::reuse::work_thread_with_activity_tracking_t<
-			demand_queue_t > & wt )
+			Demand_Queue > & wt )
 	{
 		so_5::send< stats::messages::work_thread_activity >(
 				mbox,
@@ -76,10 +79,15 @@ send_thread_activity_stats(
  * \since v.5.5.8, v.5.5.18, v.5.6.0
  */
 template< typename Work_Thread >
-class dispatcher_template_t final : public disp_binder_t
+class dispatcher_template_t final
+	:	public disp_binder_t
+	,	public transfer_queue_provider_t
 	{
 		friend class disp_data_source_t;
 
+		//! Type of demand queue to be used.
+		using demand_queue_type = typename Work_Thread::demand_queue_type;
+
 	public:
 		dispatcher_template_t(
 			outliving_reference_t< environment_t > env,
@@ -123,12 +131,7 @@ class dispatcher_template_t final : public disp_binder_t
 		bind(
 			agent_t & agent ) noexcept override
 			{
-				const auto priority = agent.so_priority();
-
-				agent.so_bind_to_dispatcher(
-						m_demand_queue.event_queue_by_priority( priority ) );
-
-				m_demand_queue.agent_bound( priority );
+				agent.so_bind_to_dispatcher( bind_transferred( agent ) );
 			}
 
 		void
@@ -140,6 +143,17 @@ class dispatcher_template_t final : public disp_binder_t
 				m_demand_queue.agent_unbound( priority );
 			}
 
+		event_queue_t &
+		bind_transferred(
+			agent_t & agent ) noexcept override
+			{
+				const auto priority = agent.so_priority();
+
+				m_demand_queue.agent_bound( priority );
+
+				return m_demand_queue.event_queue_by_priority( priority );
+			}
+
 	private:
 
 		/*!
@@ -175,7 +189,7 @@ class dispatcher_template_t final : public disp_binder_t
 						std::size_t agents_count = 0;
 
 						disp.m_demand_queue.handle_stats_for_each_prio(
-							[&]( const demand_queue_t::queue_stats_t & stat ) {
+							[&]( const typename demand_queue_type::queue_stats_t & stat ) {
 								distribute_value_for_priority(
 									mbox,
 									stat.m_priority,
@@ -225,7 +239,7 @@ class dispatcher_template_t final : public disp_binder_t
 			};
 
 		//! Demand queue for the dispatcher.
-		demand_queue_t m_demand_queue;
+		demand_queue_type m_demand_queue;
 
 		//! Working thread for the dispatcher.
 		Work_Thread m_work_thread;
@@ -270,13 +284,34 @@ make_dispatcher(
 				impl::dispatcher_template_t<
 						work_thread_with_activity_tracking_t< impl::demand_queue_t > >;
 
-		disp_binder_shptr_t binder = so_5::disp::reuse::make_actual_dispatcher<
-						disp_binder_t,
-						dispatcher_no_activity_tracking_t,
-						dispatcher_with_activity_tracking_t >(
-				outliving_mutable(env),
-				data_sources_name_base,
-				std::move(params) );
+		using lock_free_dispatcher_no_activity_tracking_t =
+				impl::dispatcher_template_t<
+						work_thread_no_activity_tracking_t<
+								impl::lock_free_demand_queue_t > >;
+
+		using lock_free_dispatcher_with_activity_tracking_t =
+				impl::dispatcher_template_t<
+						work_thread_with_activity_tracking_t<
+								impl::lock_free_demand_queue_t > >;
+
+		disp_binder_shptr_t binder;
+		if( queue_traits::demand_queue_kind_t::lock_free ==
+				params.demand_queue_kind() )
+			binder = so_5::disp::reuse::make_actual_dispatcher<
+							disp_binder_t,
+							lock_free_dispatcher_no_activity_tracking_t,
+							lock_free_dispatcher_with_activity_tracking_t >(
+					outliving_mutable(env),
+					data_sources_name_base,
+					std::move(params) );
+		else
+			binder = so_5::disp::reuse::make_actual_dispatcher<
+							disp_binder_t,
+							dispatcher_no_activity_tracking_t,
+							dispatcher_with_activity_tracking_t >(
+					outliving_mutable(env),
+					data_sources_name_base,
+					std::move(params) );
 
 		return impl::dispatcher_handle_maker_t::make( std::move(binder) );
 	}
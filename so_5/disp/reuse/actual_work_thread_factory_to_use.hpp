@@ -61,6 +61,10 @@ actual_work_thread_factory_to_use(
  * is used for acquiring new work thread. Otherwise the factory
  * from \a env is used.
  *
+ * \note
+ * Since v.5.8.3 the actual factory is wrapped by a placement aware
+ * factory if \a params defines a placement for worker threads.
+ *
  * \since v.5.7.3
  */
 template< typename Params >
@@ -71,6 +75,11 @@ acquire_work_thread(
 	environment_t & env )
 	{
 		auto factory = actual_work_thread_factory_to_use( params, env );
+		if( !params.work_thread_placement().empty() )
+			factory = make_placement_aware_work_thread_factory(
+					std::move(factory),
+					params.work_thread_placement() );
+
 		auto & thread = factory->acquire( env );
 
 		// This block of code shouldn't throw.
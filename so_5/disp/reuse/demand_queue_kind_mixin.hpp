@@ -0,0 +1,80 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \file
+ * \brief Mixin for selection of kind of demand queue.
+ *
+ * \since v.5.8.3
+ */
+
+#pragma once
+
+#include <so_5/disp/mpsc_queue_traits/pub.hpp>
+
+#include <utility>
+
+namespace so_5 {
+
+namespace disp {
+
+namespace reuse {
+
+/*!
+ * \brief Mixin with kind of demand queue.
+ *
+ * Intended to be used as mixin for disp_params_t classes of dispatchers
+ * which use so_5::disp::reuse::work_thread.
+ *
+ * \since v.5.8.3
+ */
+template< typename Params >
+class demand_queue_kind_mixin_t
+	{
+		mpsc_queue_traits::demand_queue_kind_t m_kind{
+				mpsc_queue_traits::demand_queue_kind_t::lock_based };
+
+	public :
+		//! Getter for kind of demand queue.
+		[[nodiscard]]
+		mpsc_queue_traits::demand_queue_kind_t
+		demand_queue_kind() const noexcept
+			{
+				return m_kind;
+			}
+
+		friend inline void
+		swap(
+				demand_queue_kind_mixin_t & a,
+				demand_queue_kind_mixin_t & b ) noexcept
+			{
+				using std::swap;
+				swap( a.m_kind, b.m_kind );
+			}
+
+		//! Setter for kind of demand queue.
+		/*!
+		 * Usage example:
+		 * \code
+		 * so_5::disp::one_thread::make_dispatcher( env,
+		 * 	"my_disp",
+		 * 	so_5::disp::one_thread::disp_params_t{}.demand_queue_kind(
+		 * 		so_5::disp::mpsc_queue_traits::demand_queue_kind_t::lock_free ) );
+		 * \endcode
+		 */
+		Params &
+		demand_queue_kind(
+			mpsc_queue_traits::demand_queue_kind_t v ) noexcept
+			{
+				m_kind = v;
+				return static_cast< Params & >(*this);
+			}
+	};
+
+} /* namespace reuse */
+
+} /* namespace disp */
+
+} /* namespace so_5 */
+
@@ -0,0 +1,289 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \file
+ * \brief Reusable tools for elastic mode of thread-pool dispatchers.
+ *
+ * \since v.5.8.3
+ */
+
+#pragma once
+
+#include <so_5/disp/elastic_pool_params.hpp>
+
+#include <so_5/details/invoke_noexcept_code.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+
+namespace so_5 {
+
+namespace disp {
+
+namespace reuse {
+
+/*!
+ * \brief Mixin with parameters of elastic mode.
+ *
+ * Intended to be used as mixin for disp_params_t classes of
+ * thread-pool dispatchers.
+ *
+ * \since v.5.8.3
+ */
+template< typename Params >
+class elastic_pool_mixin_t
+	{
+		std::optional< elastic_pool_params_t > m_elastic;
+
+	public :
+		//! Getter for parameters of elastic mode.
+		/*!
+		 * An empty value means that elastic mode isn't used.
+		 */
+		[[nodiscard]]
+		const std::optional< elastic_pool_params_t > &
+		elastic() const noexcept
+			{
+				return m_elastic;
+			}
+
+		friend inline void
+		swap(
+				elastic_pool_mixin_t & a,
+				elastic_pool_mixin_t & b ) noexcept
+			{
+				using std::swap;
+				swap( a.m_elastic, b.m_elastic );
+			}
+
+		//! Turn the elastic mode on.
+		/*!
+		 * In the elastic mode thread_count() is the max count of threads.
+		 *
+		 * Usage example:
+		 * \code
+		 * so_5::disp::thread_pool::make_dispatcher( env,
+		 * 	"my_disp",
+		 * 	so_5::disp::thread_pool::disp_params_t{}
+		 * 		.thread_count( 16 )
+		 * 		.elastic( so_5::disp::elastic_pool_params_t{}.min_threads( 2 ) ) );
+		 * \endcode
+		 */
+		Params &
+		elastic( elastic_pool_params_t v ) noexcept
+			{
+				m_elastic = v;
+				return static_cast< Params & >(*this);
+			}
+	};
+
+/*!
+ * \brief Get the count of threads to be started at the beginning.
+ *
+ * \since v.5.8.3
+ */
+[[nodiscard]]
+inline std::size_t
+initial_thread_count(
+	//! Count of threads from dispatcher's parameters.
+	std::size_t thread_count,
+	//! Parameters of elastic mode (if any).
+	const std::optional< elastic_pool_params_t > & elastic ) noexcept
+	{
+		if( elastic )
+			return (std::min)( thread_count, elastic->min_threads() );
+		return thread_count;
+	}
+
+//
+// elastic_pool_controller_t
+//
+/*!
+ * \brief Decision logic of elastic mode.
+ *
+ * It has no thread-safety, all calls are expected from the monitoring
+ * thread only.
+ *
+ * \since v.5.8.3
+ */
+class elastic_pool_controller_t
+	{
+	public :
+		using clock_t = std::chrono::steady_clock;
+
+		//! What should be done with the pool.
+		enum class decision_t
+			{
+				nothing,
+				add_thread,
+				retire_thread
+			};
+
+		//! Snapshot of pool load.
+		struct load_t
+			{
+				//! Count of non-empty agent queues waiting for a thread.
+				std::size_t m_queue_size;
+				//! Count of idle threads.
+				std::size_t m_idle_threads;
+				//! Count of alive threads.
+				std::size_t m_thread_count;
+			};
+
+		elastic_pool_controller_t(
+			const elastic_pool_params_t & params,
+			std::size_t max_threads ) noexcept
+			:	m_params{ params }
+			,	m_max_threads{ max_threads }
+			{}
+
+		[[nodiscard]]
+		const elastic_pool_params_t &
+		params() const noexcept { return m_params; }
+
+		[[nodiscard]]
+		std::size_t
+		max_threads() const noexcept { return m_max_threads; }
+
+		//! Make a decision on the basis of the current load.
+		[[nodiscard]]
+		decision_t
+		check( clock_t::time_point now, const load_t & load ) noexcept
+			{
+				if( load.m_queue_size >= m_params.scale_up_queue_depth() &&
+						load.m_thread_count < m_max_threads )
+					{
+						m_idle_since.reset();
+						if( !m_overload_since )
+							m_overload_since = now;
+
+						if( now - *m_overload_since >= m_params.scale_up_delay() )
+							{
+								m_overload_since.reset();
+								return decision_t::add_thread;
+							}
+
+						return decision_t::nothing;
+					}
+
+				m_overload_since.reset();
+
+				if( load.m_idle_threads && load.m_thread_count > m_params.min_threads() )
+					{
+						if( !m_idle_since )
+							m_idle_since = now;
+
+						if( now - *m_idle_since >= m_params.scale_down_idle_time() )
+							{
+								// The next thread can be retired only after
+								// another period of idleness.
+								m_idle_since = now;
+								return decision_t::retire_thread;
+							}
+					}
+				else
+					m_idle_since.reset();
+
+				return decision_t::nothing;
+			}
+
+	private :
+		//! Parameters of elastic mode.
+		const elastic_pool_params_t m_params;
+
+		//! Max count of threads.
+		const std::size_t m_max_threads;
+
+		//! Start of the current overload.
+		std::optional< clock_t::time_point > m_overload_since;
+
+		//! Start of the current idle period.
+		std::optional< clock_t::time_point > m_idle_since;
+	};
+
+//
+// periodic_monitor_t
+//
+/*!
+ * \brief A thread that periodically calls an action.
+ *
+ * \since v.5.8.3
+ */
+class periodic_monitor_t
+	{
+	public :
+		periodic_monitor_t() = default;
+		periodic_monitor_t( const periodic_monitor_t & ) = delete;
+		periodic_monitor_t & operator=( const periodic_monitor_t & ) = delete;
+
+		~periodic_monitor_t() noexcept
+			{
+				stop_then_join();
+			}
+
+		//! Start the monitoring thread.
+		/*!
+		 * \attention
+		 * The action must not throw.
+		 */
+		void
+		start(
+			std::chrono::steady_clock::duration period,
+			std::function< void() > action )
+			{
+				m_thread = std::thread{
+					[this, period, action = std::move(action)] {
+						std::unique_lock< std::mutex > lock{ m_lock };
+						while( !m_stop )
+							{
+								m_wakeup_cv.wait_for( lock, period,
+										[this]{ return m_stop; } );
+								if( m_stop )
+									break;
+
+								lock.unlock();
+								so_5::details::invoke_noexcept_code( action );
+								lock.lock();
+							}
+					} };
+			}
+
+		//! Stop the monitoring thread and wait for its completion.
+		void
+		stop_then_join() noexcept
+			{
+				if( !m_thread.joinable() )
+					return;
+
+				so_5::details::invoke_noexcept_code( [this] {
+						{
+							std::lock_guard< std::mutex > lock{ m_lock };
+							m_stop = true;
+						}
+						m_wakeup_cv.notify_one();
+
+						m_thread.join();
+					} );
+			}
+
+	private :
+		std::mutex m_lock;
+		std::condition_variable m_wakeup_cv;
+		bool m_stop{ false };
+
+		std::thread m_thread;
+	};
+
+} /* namespace reuse */
+
+} /* namespace disp */
+
+} /* namespace so_5 */
@@ -0,0 +1,194 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \file
+ * \brief Helpers for implementation of idle strategies in queue locks.
+ *
+ * \since v.5.8.3
+ */
+
+#pragma once
+
+#include <so_5/disp/idle_strategy.hpp>
+
+#include <so_5/spinlocks.hpp>
+
+#include <algorithm>
+#include <thread>
+
+namespace so_5 {
+
+namespace disp {
+
+namespace reuse {
+
+namespace idle_waiting {
+
+//! Type of clock to be used for measurements.
+using clock_t = std::chrono::steady_clock;
+
+//
+// waiting_meter_t
+//
+/*!
+ * \brief A helper for measuring stages of waiting.
+ *
+ * Does nothing if there is no stats collector.
+ *
+ * \since v.5.8.3
+ */
+class waiting_meter_t
+	{
+		//! Collector to be updated. Can be nullptr.
+		idle_stats_collector_t * m_stats;
+		//! Does the strategy have active (non-parking) stages?
+		const bool m_has_active_stages;
+
+		//! The start of waiting.
+		clock_t::time_point m_started_at{};
+		//! The start of parking stage.
+		clock_t::time_point m_parked_at{};
+		//! Has parking stage been started?
+		bool m_parked{ false };
+
+		[[nodiscard]]
+		static std::chrono::nanoseconds
+		non_negative( clock_t::duration d ) noexcept
+			{
+				return std::chrono::duration_cast< std::chrono::nanoseconds >(
+						std::max( d, clock_t::duration::zero() ) );
+			}
+
+	public :
+		waiting_meter_t(
+			idle_stats_collector_t * stats,
+			const idle_strategy_t & strategy ) noexcept
+			:	m_stats{ stats }
+			,	m_has_active_stages{
+					idle_strategy_kind_t::park != strategy.kind() }
+			{
+				if( m_stats )
+					m_started_at = clock_t::now();
+			}
+
+		//! Parking stage is about to be started.
+		void
+		parking_started() noexcept
+			{
+				m_parked = true;
+				if( m_stats )
+					m_parked_at = clock_t::now();
+			}
+
+		//! Waiting is finished.
+		void
+		waiting_finished(
+			//! The time point of the notification.
+			clock_t::time_point notified_at ) noexcept
+			{
+				if( !m_stats )
+					return;
+
+				const auto now = clock_t::now();
+				const auto active_finished_at = m_parked ? m_parked_at : now;
+
+				m_stats->record_wakeup(
+						m_parked,
+						non_negative( now - notified_at ),
+						m_has_active_stages ?
+								non_negative( active_finished_at - m_started_at ) :
+								std::chrono::nanoseconds::zero(),
+						m_parked ? non_negative( now - m_parked_at ) :
+								std::chrono::nanoseconds::zero() );
+			}
+	};
+
+//
+// wait_actively
+//
+/*!
+ * \brief Perform active (non-parking) stages of idle strategy.
+ *
+ * \attention
+ * \a lock must be acquired by the current thread. It is released during
+ * every pause and is acquired again before the check of \a signaled.
+ *
+ * \retval true if \a signaled returned true.
+ * \retval false if the current thread has to be parked.
+ *
+ * \since v.5.8.3
+ */
+template< typename Lock, typename Signaled >
+[[nodiscard]]
+bool
+wait_actively(
+	const idle_strategy_t & strategy,
+	Lock & lock,
+	Signaled && signaled ) noexcept
+	{
+		const auto pause_then_check = [&]( auto pause_action ) -> bool {
+				lock.unlock();
+				pause_action();
+				lock.lock();
+
+				return signaled();
+			};
+
+		switch( strategy.kind() )
+			{
+			case idle_strategy_kind_t::busy_spin:
+				while( !pause_then_check( pause_backoff_t{} ) )
+					{}
+			return true;
+
+			case idle_strategy_kind_t::spin_then_yield:
+				{
+					for( std::size_t i = 0u; i != strategy.spin_count(); ++i )
+						if( pause_then_check( pause_backoff_t{} ) )
+							return true;
+
+					const auto stop_point = clock_t::now() + strategy.yield_time();
+					while( stop_point > clock_t::now() )
+						if( pause_then_check( yield_backoff_t{} ) )
+							return true;
+				}
+			break;
+
+			case idle_strategy_kind_t::exponential_backoff:
+				{
+					// Series of 1, 2, 4, ..., 64 pauses.
+					constexpr unsigned int spin_series = 7u;
+					for( unsigned int s = 0u; s != spin_series; ++s )
+						if( pause_then_check( [s] {
+									pause_backoff_t backoff;
+									for( unsigned int i = 0u; i != (1u << s); ++i )
+										backoff();
+								} ) )
+							return true;
+
+					const auto max_sleep = std::max(
+							strategy.max_sleep(), clock_t::duration{ 1 } );
+					auto sleep_time = std::clamp(
+							strategy.min_sleep(), clock_t::duration{ 1 }, max_sleep );
+					while( !pause_then_check(
+							[sleep_time] { std::this_thread::sleep_for( sleep_time ); } ) )
+						sleep_time = std::min( sleep_time * 2, max_sleep );
+				}
+			return true;
+
+			case idle_strategy_kind_t::park:
+			break;
+			}
+
+		return false;
+	}
+
+} /* namespace idle_waiting */
+
+} /* namespace reuse */
+
+} /* namespace disp */
+
+} /* namespace so_5 */
@@ -13,6 +13,10 @@
 
 #include <so_5/disp/mpmc_queue_traits/pub.hpp>
 
+#include <so_5/disp/reuse/elastic_pool.hpp>
+#include <so_5/disp/reuse/wakeup_stats.hpp>
+
+#include <algorithm>
 #include <deque>
 #include <mutex>
 #include <vector>
@@ -54,13 +58,14 @@ class queue_of_queues_t
 			const so_5::disp::mpmc_queue_traits::queue_params_t & queue_params,
 			std::size_t thread_count )
 			:	m_lock{ queue_params.lock_factory()() }
-			,	m_max_thread_count{ thread_count }
+			,	m_thread_count{ thread_count }
 			,	m_next_thread_wakeup_threshold{
 					queue_params.next_thread_wakeup_threshold() }
 			{
 				// Reserve some space for storing infos about waiting
 				// customer threads.
 				m_waiting_customers.reserve( thread_count );
+				m_retiring_customers.reserve( thread_count );
 			}
 
 		//! Initiate shutdown for working threads.
@@ -95,7 +100,7 @@ class queue_of_queues_t
 								auto r = pop_head();
 
 								// There could be non-empty queue and sleeping workers...
-								try_wakeup_someone_if_possible();
+								(void)try_wakeup_someone_if_possible();
 
 								return r;
 							}
@@ -109,6 +114,11 @@ class queue_of_queues_t
 						m_waiting_customers.push_back( &condition );
 
 						condition.wait();
+
+						// Since v.5.8.3 the thread can be awakened for retirement.
+						if( try_complete_retirement( condition ) )
+							break;
+
 						// If we are here then the current wakeup procedure is
 						// finished.
 						m_wakeup_in_progress = false;
@@ -156,7 +166,9 @@ class queue_of_queues_t
 
 				push_to_queue( queue );
 
-				try_wakeup_someone_if_possible();
+				// Since v.5.8.3 the absence of wakeup is counted.
+				if( !try_wakeup_someone_if_possible() )
+					m_wakeup_counters.wakeups_avoided( 1u );
 			}
 
 		so_5::disp::mpmc_queue_traits::condition_unique_ptr_t
@@ -165,6 +177,102 @@ class queue_of_queues_t
 				return m_lock->allocate_condition();
 			}
 
+		/*!
+		 * \brief Get the current load of the queue.
+		 *
+		 * \since v.5.8.3
+		 */
+		[[nodiscard]]
+		elastic_pool_controller_t::load_t
+		load() noexcept
+			{
+				std::lock_guard< so_5::disp::mpmc_queue_traits::lock_t > lock{ *m_lock };
+
+				return { m_queue_size, m_waiting_customers.size(), m_thread_count };
+			}
+
+		/*!
+		 * \brief Get the current values of wakeup counters.
+		 *
+		 * A wakeup is issued when a sleeping working thread is notified
+		 * about a non-empty queue. A wakeup is avoided when a queue
+		 * is scheduled but there is no need to notify anyone: there are
+		 * no sleeping threads, or some thread is being awakened already,
+		 * or the wakeup threshold isn't reached.
+		 *
+		 * \since v.5.8.3
+		 */
+		[[nodiscard]]
+		wakeup_stats_t
+		wakeup_stats() const noexcept
+			{
+				return m_wakeup_counters.stats();
+			}
+
+		/*!
+		 * \brief Inform the queue about a new working thread.
+		 *
+		 * Must be called before the start of the new thread.
+		 *
+		 * \since v.5.8.3
+		 */
+		void
+		thread_added()
+			{
+				std::lock_guard< so_5::disp::mpmc_queue_traits::lock_t > lock{ *m_lock };
+
+				// There must be a room for all threads, it guarantees that
+				// pop() won't allocate memory.
+				m_waiting_customers.reserve( m_thread_count + 1u );
+				m_retiring_customers.reserve( m_thread_count + 1u );
+
+				++m_thread_count;
+			}
+
+		/*!
+		 * \brief Rollback of thread_added() if the thread can't be started.
+		 *
+		 * \since v.5.8.3
+		 */
+		void
+		thread_not_started() noexcept
+			{
+				std::lock_guard< so_5::disp::mpmc_queue_traits::lock_t > lock{ *m_lock };
+
+				--m_thread_count;
+			}
+
+		/*!
+		 * \brief Ask the thread that waits the longest to finish its work.
+		 *
+		 * The retired thread gets nullptr from pop() and should finish
+		 * its work. The count of threads is decremented when the thread
+		 * leaves pop().
+		 *
+		 * \retval false if there is no waiting threads or the queue is
+		 * shutting down.
+		 *
+		 * \since v.5.8.3
+		 */
+		bool
+		retire_idle_thread() noexcept
+			{
+				std::lock_guard< so_5::disp::mpmc_queue_traits::lock_t > lock{ *m_lock };
+
+				if( m_shutdown || m_waiting_customers.empty() )
+					return false;
+
+				auto * condition = m_waiting_customers.front();
+				m_waiting_customers.erase( m_waiting_customers.begin() );
+
+				// There is no memory allocation because m_retiring_customers
+				// is reserved in the constructor and in thread_added().
+				m_retiring_customers.push_back( condition );
+				condition->notify();
+
+				return true;
+			}
+
 	private :
 		//! Object's lock.
 		so_5::disp::mpmc_queue_traits::lock_unique_ptr_t m_lock;
@@ -207,12 +315,14 @@ class queue_of_queues_t
 		bool m_wakeup_in_progress{ false };
 
 		/*!
-		 * \brief Maximum count of working threads to be used with
-		 * that mpmc_queue.
+		 * \brief Count of working threads to be used with that mpmc_queue.
+		 *
+		 * \note
+		 * Since v.5.8.3 it can be changed in the elastic mode.
 		 *
 		 * \since v.5.5.16
 		 */
-		const std::size_t m_max_thread_count;
+		std::size_t m_thread_count;
 
 		/*!
 		 * \brief Threshold for wake up next working thread if there are
@@ -222,9 +332,50 @@ class queue_of_queues_t
 		 */
 		const std::size_t m_next_thread_wakeup_threshold;
 
+		/*!
+		 * \brief Counters of wakeups of working threads.
+		 *
+		 * Are modified only when m_lock is acquired.
+		 *
+		 * \since v.5.8.3
+		 */
+		wakeup_counters_t m_wakeup_counters;
+
 		//! Waiting threads.
 		std::vector< so_5::disp::mpmc_queue_traits::condition_t * > m_waiting_customers;
 
+		/*!
+		 * \brief Threads that are awakened for retirement.
+		 *
+		 * \since v.5.8.3
+		 */
+		std::vector< so_5::disp::mpmc_queue_traits::condition_t * > m_retiring_customers;
+
+		/*!
+		 * \brief Check that the thread was awakened for retirement.
+		 *
+		 * Updates the count of threads if it is so.
+		 *
+		 * \since v.5.8.3
+		 */
+		[[nodiscard]]
+		bool
+		try_complete_retirement(
+			so_5::disp::mpmc_queue_traits::condition_t & condition ) noexcept
+			{
+				const auto it = std::find(
+						m_retiring_customers.begin(),
+						m_retiring_customers.end(),
+						&condition );
+				if( it == m_retiring_customers.end() )
+					return false;
+
+				m_retiring_customers.erase( it );
+				--m_thread_count;
+
+				return true;
+			}
+
 		void
 		pop_and_notify_one_waiting_customer() noexcept
 			{
@@ -247,19 +398,27 @@ class queue_of_queues_t
 		 *   m_next_thread_wakeup_threshold or there is no active customers at
 		 *   all.
 		 *
+		 * \note Since v.5.8.3 it returns true if a thread was awakened.
+		 *
 		 * \since v.5.5.15.1
 		 */
-		void
+		[[nodiscard]]
+		bool
 		try_wakeup_someone_if_possible() noexcept
 			{
 				if( m_head &&
 						!m_waiting_customers.empty() &&
 						!m_wakeup_in_progress &&
 						( m_queue_size > m_next_thread_wakeup_threshold ||
-						m_max_thread_count == m_waiting_customers.size() ) )
+						m_thread_count == m_waiting_customers.size() ) )
 					{
 						pop_and_notify_one_waiting_customer();
+						m_wakeup_counters.wakeup_issued();
+
+						return true;
 					}
+
+				return false;
 			}
 
 		/*!
@@ -0,0 +1,87 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \file
+ * \brief Mixin for turning the same-thread delivery of demands on.
+ *
+ * \since v.5.8.3
+ */
+
+#pragma once
+
+#include <utility>
+
+namespace so_5 {
+
+namespace disp {
+
+namespace reuse {
+
+/*!
+ * \brief Mixin with the flag of the same-thread delivery.
+ *
+ * Intended to be used as mixin for disp_params_t classes of dispatchers
+ * which use so_5::disp::reuse::work_thread.
+ *
+ * \since v.5.8.3
+ */
+template< typename Params >
+class same_thread_delivery_mixin_t
+	{
+		bool m_same_thread_delivery{ false };
+
+	public :
+		//! Getter for the same-thread delivery flag.
+		[[nodiscard]]
+		bool
+		same_thread_delivery() const noexcept
+			{
+				return m_same_thread_delivery;
+			}
+
+		friend inline void
+		swap(
+				same_thread_delivery_mixin_t & a,
+				same_thread_delivery_mixin_t & b ) noexcept
+			{
+				using std::swap;
+				swap( a.m_same_thread_delivery, b.m_same_thread_delivery );
+			}
+
+		//! Setter for the same-thread delivery flag.
+		/*!
+		 * If the same-thread delivery is turned on then a demand sent
+		 * from the work thread to an agent bound to the same work thread
+		 * doesn't go through the demand queue. It's appended to the block
+		 * of demands that is being processed by the work thread right now.
+		 * Neither the queue's lock nor the notification of the work thread
+		 * are used for such demands.
+		 *
+		 * The order of demands isn't changed: all demands from the current
+		 * block were queued before the new one, and all demands those are
+		 * still in the queue will be extracted after the current block.
+		 *
+		 * The same-thread delivery is turned off by default.
+		 *
+		 * Usage example:
+		 * \code
+		 * so_5::disp::one_thread::make_dispatcher( env,
+		 * 	"my_disp",
+		 * 	so_5::disp::one_thread::disp_params_t{}.same_thread_delivery( true ) );
+		 * \endcode
+		 */
+		Params &
+		same_thread_delivery( bool v ) noexcept
+			{
+				m_same_thread_delivery = v;
+				return static_cast< Params & >(*this);
+			}
+	};
+
+} /* namespace reuse */
+
+} /* namespace disp */
+
+} /* namespace so_5 */
@@ -21,6 +21,7 @@
 #include <so_5/stats/std_names.hpp>
 
 #include <so_5/disp/reuse/data_source_prefix_helpers.hpp>
+#include <so_5/disp/reuse/wakeup_stats.hpp>
 
 namespace so_5 {
 
@@ -182,6 +183,14 @@ class stats_consumer_t
 			const so_5::current_thread_id_t & thread_id,
 			//! Statistics of working thread.
 			const so_5::stats::work_thread_activity_stats_t & stats ) = 0;
+
+		/*!
+		 * \brief Informs consumer about wakeups of working threads.
+		 *
+		 * \since v.5.8.3
+		 */
+		virtual void
+		set_wakeup_stats( const wakeup_stats_t & value ) = 0;
 	};
 
 /*!
@@ -258,6 +267,8 @@ class data_source_t : public stats::source_t
 						stats::suffixes::agent_count(),
 						collector.agent_count() );
 
+				send_wakeup_stats( mbox, m_prefix, collector.wakeup_stats() );
+
 				collector.for_each_thread_activity(
 					[this, &mbox]( const so_5::current_thread_id_t & thread_id,
 						const so_5::stats::work_thread_activity_stats_t & stats ) {
@@ -405,6 +416,12 @@ class data_source_t : public stats::source_t
 						m_wt_activity.emplace_back( thread_id, stats );
 					}
 
+				virtual void
+				set_wakeup_stats( const wakeup_stats_t & value ) override
+					{
+						m_wakeup_stats = value;
+					}
+
 				std::size_t
 				thread_count() const
 					{
@@ -417,6 +434,12 @@ class data_source_t : public stats::source_t
 						return m_agent_count;
 					}
 
+				const wakeup_stats_t &
+				wakeup_stats() const
+					{
+						return m_wakeup_stats;
+					}
+
 				template< typename Lambda >
 				void
 				for_each_queue( Lambda lambda ) const
@@ -443,6 +466,7 @@ class data_source_t : public stats::source_t
 
 				std::size_t m_thread_count = { 0 };
 				std::size_t m_agent_count = { 0 };
+				wakeup_stats_t m_wakeup_stats;
 
 				wt_activity_info_container_t & m_wt_activity;
 
@@ -0,0 +1,127 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \file
+ * \brief Counters of wakeups of sleeping consumers of dispatcher queues.
+ *
+ * \since v.5.8.3
+ */
+
+#pragma once
+
+#include <so_5/send_functions.hpp>
+
+#include <so_5/stats/messages.hpp>
+#include <so_5/stats/std_names.hpp>
+
+#include <atomic>
+
+namespace so_5 {
+
+namespace disp {
+
+namespace reuse {
+
+/*!
+ * \brief Values of wakeup counters.
+ *
+ * \since v.5.8.3
+ */
+struct wakeup_stats_t
+	{
+		//! Count of notifications of sleeping consumers.
+		std::size_t m_issued{ 0u };
+
+		//! Count of new items those didn't require a notification
+		//! because the consumer wasn't sleeping.
+		std::size_t m_avoided{ 0u };
+	};
+
+/*!
+ * \brief Counters of wakeups of sleeping consumers.
+ *
+ * A queue increments the counter of issued wakeups every time it
+ * notifies a sleeping consumer. The counter of avoided wakeups is
+ * incremented for a new item if the consumer is running and the
+ * notification isn't necessary.
+ *
+ * \attention
+ * Every counter must be modified by one thread at a time (for example,
+ * under the queue's lock). That is why the modification isn't an atomic
+ * read-modify-write operation. Atomics are necessary only for reading
+ * of values from the stats thread.
+ *
+ * \since v.5.8.3
+ */
+class wakeup_counters_t
+	{
+		std::atomic< std::size_t > m_issued{ 0u };
+		std::atomic< std::size_t > m_avoided{ 0u };
+
+		static void
+		increment( std::atomic< std::size_t > & counter, std::size_t delta ) noexcept
+			{
+				counter.store(
+						counter.load( std::memory_order_relaxed ) + delta,
+						std::memory_order_relaxed );
+			}
+
+	public :
+		//! A sleeping consumer was notified.
+		void
+		wakeup_issued() noexcept
+			{
+				increment( m_issued, 1u );
+			}
+
+		//! There were new items those didn't require a notification.
+		void
+		wakeups_avoided( std::size_t count ) noexcept
+			{
+				if( count )
+					increment( m_avoided, count );
+			}
+
+		//! Get the current values.
+		[[nodiscard]]
+		wakeup_stats_t
+		stats() const noexcept
+			{
+				return {
+						m_issued.load( std::memory_order_relaxed ),
+						m_avoided.load( std::memory_order_relaxed )
+					};
+			}
+	};
+
+/*!
+ * \brief Helper for distribution of wakeup counters.
+ *
+ * \since v.5.8.3
+ */
+inline void
+send_wakeup_stats(
+	const mbox_t & mbox,
+	const stats::prefix_t & prefix,
+	const wakeup_stats_t & values )
+	{
+		so_5::send< stats::messages::quantity< std::size_t > >(
+				mbox,
+				prefix,
+				stats::suffixes::wakeups_issued(),
+				values.m_issued );
+
+		so_5::send< stats::messages::quantity< std::size_t > >(
+				mbox,
+				prefix,
+				stats::suffixes::wakeups_avoided(),
+				values.m_avoided );
+	}
+
+} /* namespace reuse */
+
+} /* namespace disp */
+
+} /* namespace so_5 */
@@ -24,6 +24,8 @@
 
 #include <so_5/disp/mpsc_queue_traits/pub.hpp>
 
+#include <so_5/disp/reuse/wakeup_stats.hpp>
+
 #include <so_5/stats/work_thread_activity.hpp>
 #include <so_5/stats/impl/activity_tracking.hpp>
 
@@ -31,6 +33,7 @@
 
 #include <so_5/details/rollback_on_exception.hpp>
 #include <so_5/details/invoke_noexcept_code.hpp>
+#include <so_5/details/at_scope_exit.hpp>
 
 namespace so_5
 {
@@ -93,6 +96,24 @@ struct common_data_t
 	*/
 	bool m_in_service{ false };
 
+	//! Is the consumer sleeping inside pop()?
+	/*!
+	 * Is modified only when m_lock is acquired. It's reset by a producer
+	 * that notifies the consumer, so the consumer is notified only once
+	 * for every sleep.
+	 *
+	 * \since v.5.8.3
+	 */
+	bool m_sleeping{ false };
+
+	//! Counters of wakeups of the consumer.
+	/*!
+	 * Are modified only when m_lock is acquired.
+	 *
+	 * \since v.5.8.3
+	 */
+	wakeup_counters_t m_wakeup_counters;
+
 	//! Initializing constructor.
 	common_data_t(
 		//! Lock object to be used by queue.
@@ -106,84 +127,934 @@ struct common_data_t
 	}
 };
 
-/*!
- * \brief A part of demand queue implementation for the case
- * when activity tracking is not used.
- */
-class no_activity_tracking_impl_t : protected common_data_t
-{
-public :
-	no_activity_tracking_impl_t(
-		queue_traits::lock_unique_ptr_t lock )
-		:	common_data_t( std::move(lock) )
-	{}
+/*!
+ * \brief A part of demand queue implementation for the case
+ * when activity tracking is not used.
+ *
+ * \note
+ * It's a template since v.5.8.3. Common_Data is the type of data
+ * for a specific kind of demand queue.
+ */
+template< typename Common_Data >
+class no_activity_tracking_impl_t : protected Common_Data
+{
+public :
+	no_activity_tracking_impl_t(
+		queue_traits::lock_unique_ptr_t lock )
+		:	Common_Data( std::move(lock) )
+	{}
+
+protected :
+	void
+	wait_started() {}
+
+	void
+	wait_finished() {}
+};
+
+/*!
+ * \brief A part of demand queue implementation for the case
+ * when activity tracking is used.
+ *
+ * \note
+ * It's a template since v.5.8.3. Common_Data is the type of data
+ * for a specific kind of demand queue.
+ */
+template< typename Common_Data >
+class with_activity_tracking_impl_t : protected Common_Data
+{
+public :
+	with_activity_tracking_impl_t(
+		queue_traits::lock_unique_ptr_t lock )
+		:	Common_Data( std::move(lock) )
+		,	m_waiting_stats( *(this->m_lock) )
+	{}
+
+	so_5::stats::activity_stats_t
+	take_activity_stats()
+	{
+		return m_waiting_stats.take_stats();
+	}
+
+protected :
+	void
+	wait_started()
+	{
+		m_waiting_stats.start();
+	}
+
+	void
+	wait_finished()
+	{
+		m_waiting_stats.stop();
+	}
+
+private :
+	so_5::stats::activity_tracking_stuff::stats_collector_t<
+			so_5::stats::activity_tracking_stuff::external_lock<
+					queue_traits::lock_t,
+					so_5::stats::activity_tracking_stuff::no_lock_at_start_stop_policy > >
+		m_waiting_stats;
+};
+
+//! The demand queue whose work thread is the current thread.
+/*!
+ * It's set only by work threads with the same-thread delivery
+ * turned on.
+ *
+ * \since v.5.8.3
+ */
+inline thread_local const event_queue_t * t_same_thread_queue = nullptr;
+
+//
+// same_thread_delivery_t
+//
+/*!
+ * \brief Support for the same-thread delivery of demands.
+ *
+ * If a demand is pushed to a queue from the work thread of that queue
+ * then the demand is appended to the block of demands that is being
+ * processed by the work thread. The queue's lock isn't acquired and
+ * the work thread isn't notified in that case.
+ *
+ * All demands in the current block were queued before the new demand
+ * and all demands those are still in the queue will be processed after
+ * the current block. So the order of demands is the same as for
+ * the ordinary push.
+ *
+ * \since v.5.8.3
+ */
+template< typename Container >
+class same_thread_delivery_t
+{
+public :
+	//! Turn the same-thread delivery on for the current thread.
+	/*!
+	 * \attention
+	 * Must be called on the work thread only.
+	 */
+	void
+	attach(
+		//! The queue of the current work thread.
+		const event_queue_t & queue,
+		//! The block of demands being processed by the work thread.
+		Container & demands,
+		//! The counter of demands of the work thread.
+		demands_counter_t & counter ) noexcept
+	{
+		m_demands = &demands;
+		m_counter = &counter;
+		t_same_thread_queue = &queue;
+	}
+
+	//! Turn the same-thread delivery off for the current thread.
+	void
+	detach() noexcept
+	{
+		t_same_thread_queue = nullptr;
+		m_demands = nullptr;
+		m_counter = nullptr;
+	}
+
+	//! Try to deliver a demand without the queue.
+	/*!
+	 * \retval true if the demand is delivered.
+	 */
+	[[nodiscard]]
+	bool
+	try_push(
+		const event_queue_t & queue,
+		execution_demand_t & demand )
+	{
+		if( &queue != t_same_thread_queue )
+			return false;
+
+		m_demands->push_back( std::move(demand) );
+		++(*m_counter);
+
+		return true;
+	}
+
+	//! Try to deliver several demands without the queue.
+	/*!
+	 * \note
+	 * Provides only the basic exception guarantee.
+	 *
+	 * \retval true if demands are delivered.
+	 */
+	[[nodiscard]]
+	bool
+	try_push_batch(
+		const event_queue_t & queue,
+		execution_demand_t * demands,
+		std::size_t count )
+	{
+		if( &queue != t_same_thread_queue )
+			return false;
+
+		for( std::size_t i = 0u; i != count; ++i )
+		{
+			m_demands->push_back( std::move( demands[ i ] ) );
+			++(*m_counter);
+		}
+
+		return true;
+	}
+
+private :
+	//! The block of demands being processed by the work thread.
+	/*!
+	 * Is accessed only by the work thread.
+	 */
+	Container * m_demands{ nullptr };
+
+	//! The counter of demands of the work thread.
+	demands_counter_t * m_counter{ nullptr };
+};
+
+//
+// demand_queue_template_t
+//
+
+//! Implementation of demand_queue in form of a template.
+/*!
+	demand_queue_t has shutdown flag inside.
+
+	demand_queue_t is thread safe and is intended to be used by 
+	several concurrent threads.
+*/
+template< typename Impl >
+class queue_template_t final
+	:	public event_queue_t
+	,	public Impl
+{
+public:
+	//! Type of container for extracted demands.
+	/*!
+	 * \since v.5.8.3
+	 */
+	using demand_container_type = demand_container_t;
+
+	queue_template_t(
+		//! Lock object to be used by queue.
+		queue_traits::lock_unique_ptr_t lock )
+		:	Impl( std::move(lock) )
+	{}
+
+	/*!
+	 * \name Implementation of event_queue interface.
+	 * \{
+	 */
+	virtual void
+	push( execution_demand_t demand ) override
+	{
+		if( m_same_thread_delivery.try_push( *this, demand ) )
+			return;
+
+		queue_traits::lock_guard_t guard{ *(this->m_lock) };
+
+		if( this->m_in_service )
+		{
+			this->m_demands.push_back( std::move( demand ) );
+
+			wake_up_consumer_if_necessary( guard, 1u );
+		}
+	}
+
+	/*!
+	 * \note
+	 * All demands are added under one lock. If an exception is thrown
+	 * then already added demands are removed.
+	 *
+	 * \since v.5.8.3
+	 */
+	void
+	push_batch( execution_demand_t * demands, std::size_t count ) override
+	{
+		if( m_same_thread_delivery.try_push_batch( *this, demands, count ) )
+			return;
+
+		queue_traits::lock_guard_t guard{ *(this->m_lock) };
+
+		if( this->m_in_service && count )
+		{
+			const auto size_before = this->m_demands.size();
+
+			so_5::details::do_with_rollback_on_exception(
+				[&] {
+					for( std::size_t i = 0u; i != count; ++i )
+						this->m_demands.push_back( std::move( demands[ i ] ) );
+				},
+				[&] {
+					this->m_demands.resize( size_before );
+				} );
+
+			wake_up_consumer_if_necessary( guard, count );
+		}
+	}
+
+	/*!
+	 * \note
+	 * Delegates the work to the push() method.
+	 */
+	void
+	push_evt_start( execution_demand_t demand ) override
+		{
+			this->push( std::move(demand) );
+		}
+
+	/*!
+	 * \note
+	 * Delegates the work to the push() method.
+	 *
+	 * \attention
+	 * Terminates the whole application if the push() throws.
+	 */
+	void
+	push_evt_finish( execution_demand_t demand ) noexcept override
+		{
+			this->push( std::move(demand) );
+		}
+	/*!
+	 * \}
+	 */
+
+	//! Try to extract demands from the queue.
+	/*!
+		If there is no demands in queue then current thread
+		will sleep until:
+		- the new demand is put in the queue;
+		- a shutdown signal.
+
+		\note Since v.5.5.7 this method also updates external demands
+		counter. This update is performed under queue's lock.
+		It should prevent errors when run-time monitor can get wrong
+		quantity of demands.
+	*/
+	extraction_result_t
+	pop(
+		/*! Receiver for extracted demands. */
+		demand_container_t & demands,
+		/*! External demands counter to be updated. */
+		demands_counter_t & external_counter )
+	{
+		queue_traits::unique_lock_t lock{ *(this->m_lock) };
+		while( true )
+		{
+			if( this->m_in_service && !this->m_demands.empty() )
+			{
+				swap( demands, this->m_demands );
+
+				// It's time to update external counter.
+				external_counter.store( demands.size(), std::memory_order_release );
+
+				break;
+			}
+			else if( !this->m_in_service )
+				return extraction_result_t::shutting_down;
+			else
+			{
+				// Queue is empty. We should wait for a demand or
+				// a shutdown signal.
+
+				// Since v.5.5.18 we must take care about activity tracking.
+				this->wait_started();
+
+				// Since v.5.8.3 producers notify the consumer only
+				// if this flag is set.
+				this->m_sleeping = true;
+
+				lock.wait_for_notify();
+
+				// NOTE: the flag is already reset if the consumer was
+				// notified. But it has to be reset in the case of
+				// a spurious wakeup.
+				this->m_sleeping = false;
+
+				this->wait_finished();
+			}
+		}
+
+		return extraction_result_t::demand_extracted;
+	}
+
+	//! Start demands processing.
+	void
+	start_service()
+	{
+		queue_traits::lock_guard_t lock{ *(this->m_lock) };
+
+		this->m_in_service = true;
+	}
+
+	//! Stop demands processing.
+	void
+	stop_service()
+	{
+		queue_traits::lock_guard_t lock{ *(this->m_lock) };
+
+		this->m_in_service = false;
+		// The consumer can be waiting for new demands inside pop().
+		(void)notify_sleeping_consumer( lock );
+	}
+
+	//! Clear demands queue.
+	void
+	clear()
+	{
+		queue_traits::lock_guard_t lock{ *(this->m_lock) };
+
+		this->m_demands.clear();
+	}
+
+	/*!
+	 * \brief Get the count of demands in the queue.
+	 *
+	 * \note Since v.5.5.7 this method also uses external demands
+	 * counter. Addition of demands quantity inside demands queue and
+	 * the value of external counter is performed under the queue lock.
+	 *
+	 * \since v.5.5.4
+	 */
+	std::size_t
+	demands_count( const demands_counter_t & external_counter )
+	{
+		queue_traits::lock_guard_t lock{ *(this->m_lock) };
+
+		return this->m_demands.size()
+				+ external_counter.load( std::memory_order_acquire );
+	}
+
+	//! Turn the same-thread delivery on.
+	/*!
+	 * \attention
+	 * Must be called on the work thread only.
+	 *
+	 * \since v.5.8.3
+	 */
+	void
+	attach_same_thread_delivery(
+		demand_container_type & demands,
+		demands_counter_t & external_counter ) noexcept
+	{
+		m_same_thread_delivery.attach( *this, demands, external_counter );
+	}
+
+	//! Turn the same-thread delivery off.
+	/*!
+	 * \attention
+	 * Must be called on the work thread only.
+	 *
+	 * \since v.5.8.3
+	 */
+	void
+	detach_same_thread_delivery() noexcept
+	{
+		m_same_thread_delivery.detach();
+	}
+
+	/*!
+	 * \brief Get the current values of wakeup counters.
+	 *
+	 * \since v.5.8.3
+	 */
+	[[nodiscard]]
+	wakeup_stats_t
+	wakeup_stats() const noexcept
+	{
+		return this->m_wakeup_counters.stats();
+	}
+
+private :
+	//! Support for the same-thread delivery.
+	/*!
+	 * \since v.5.8.3
+	 */
+	same_thread_delivery_t< demand_container_type > m_same_thread_delivery;
+
+	//! Wake up the consumer if it's sleeping and update wakeup counters.
+	/*!
+	 * \attention
+	 * Must be called only when m_lock is acquired.
+	 *
+	 * \since v.5.8.3
+	 */
+	void
+	wake_up_consumer_if_necessary(
+		queue_traits::lock_guard_t & guard,
+		//! Count of demands added to the queue.
+		std::size_t demands_added ) noexcept
+	{
+		if( notify_sleeping_consumer( guard ) )
+		{
+			this->m_wakeup_counters.wakeup_issued();
+			--demands_added;
+		}
+
+		this->m_wakeup_counters.wakeups_avoided( demands_added );
+	}
+
+	//! Wake up the consumer if it's sleeping.
+	/*!
+	 * \attention
+	 * Must be called only when m_lock is acquired.
+	 *
+	 * \note
+	 * The consumer is notified only once for every sleep because
+	 * queue locks don't expect a notification of a thread which
+	 * is already notified.
+	 *
+	 * \retval true if the consumer was notified.
+	 *
+	 * \since v.5.8.3
+	 */
+	[[nodiscard]]
+	bool
+	notify_sleeping_consumer( queue_traits::lock_guard_t & guard ) noexcept
+	{
+		if( this->m_sleeping )
+		{
+			this->m_sleeping = false;
+			guard.notify_one();
+			return true;
+		}
+
+		return false;
+	}
+};
+
+//
+// lock_free_node_t
+//
+/*!
+ * \brief A node of intrusive lock-free demand queue.
+ *
+ * \since v.5.8.3
+ */
+struct lock_free_node_t
+{
+	//! Next node in the queue.
+	std::atomic< lock_free_node_t * > m_next{ nullptr };
+
+	//! Demand to be processed.
+	execution_demand_t m_demand;
+};
+
+//
+// lock_free_node_cache_t
+//
+/*!
+ * \brief Thread-local cache of free nodes.
+ *
+ * A producer takes nodes from this cache. If the cache is empty
+ * then all free nodes of the target queue are moved to the cache.
+ *
+ * \since v.5.8.3
+ */
+struct lock_free_node_cache_t
+{
+	//! Head of the list of free nodes.
+	lock_free_node_t * m_head{ nullptr };
+
+	~lock_free_node_cache_t();
+};
+
+//! The cache of free nodes for the current thread.
+/*!
+ * \since v.5.8.3
+ */
+inline thread_local lock_free_node_cache_t t_lock_free_node_cache;
+
+//! Is the cache of the current thread already destroyed?
+/*!
+ * The cache can be destroyed before other thread_local objects
+ * those can send messages in their destructors.
+ *
+ * \since v.5.8.3
+ */
+inline thread_local bool t_lock_free_node_cache_destroyed = false;
+
+//! Destroy all nodes in a list linked by m_next.
+/*!
+ * \since v.5.8.3
+ */
+inline void
+destroy_node_list( lock_free_node_t * head ) noexcept
+{
+	while( head )
+	{
+		auto * next = head->m_next.load( std::memory_order_relaxed );
+		delete head;
+		head = next;
+	}
+}
+
+inline
+lock_free_node_cache_t::~lock_free_node_cache_t()
+{
+	destroy_node_list( m_head );
+	m_head = nullptr;
+	t_lock_free_node_cache_destroyed = true;
+}
+
+//
+// lock_free_demand_list_t
+//
+/*!
+ * \brief Container for demands extracted from lock-free demand queue.
+ *
+ * Is used only by the work thread. Nodes of processed demands are
+ * collected inside the list and are returned to the queue on the next
+ * extraction.
+ *
+ * \since v.5.8.3
+ */
+class lock_free_demand_list_t
+{
+public :
+	lock_free_demand_list_t() = default;
+
+	lock_free_demand_list_t( const lock_free_demand_list_t & ) = delete;
+	lock_free_demand_list_t &
+	operator=( const lock_free_demand_list_t & ) = delete;
+
+	~lock_free_demand_list_t()
+	{
+		clear();
+		destroy_node_list( m_freed_head );
+	}
+
+	[[nodiscard]]
+	bool
+	empty() const noexcept { return nullptr == m_head; }
+
+	[[nodiscard]]
+	execution_demand_t &
+	front() noexcept { return m_head->m_demand; }
+
+	//! Remove the first demand.
+	/*!
+	 * The node is kept for reuse.
+	 */
+	void
+	pop_front() noexcept
+	{
+		auto * node = m_head;
+		m_head = node->m_next.load( std::memory_order_relaxed );
+		if( !m_head )
+			m_tail = nullptr;
+
+		// Resources of the demand (like message instance) should be
+		// released right now.
+		node->m_demand = execution_demand_t{};
+
+		if( m_freed_count < max_freed_nodes )
+		{
+			node->m_next.store( m_freed_head, std::memory_order_relaxed );
+			if( !m_freed_head )
+				m_freed_tail = node;
+			m_freed_head = node;
+			++m_freed_count;
+		}
+		else
+			delete node;
+	}
+
+	//! Add a node to the end of the list.
+	void
+	push_back( lock_free_node_t * node ) noexcept
+	{
+		node->m_next.store( nullptr, std::memory_order_relaxed );
+		if( m_tail )
+			m_tail->m_next.store( node, std::memory_order_relaxed );
+		else
+			m_head = node;
+		m_tail = node;
+	}
+
+	//! Add a demand to the end of the list.
+	/*!
+	 * A node of an already processed demand is reused if there is one.
+	 *
+	 * \since v.5.8.3
+	 */
+	void
+	push_back( execution_demand_t && demand )
+	{
+		lock_free_node_t * node = m_freed_head;
+		if( node )
+		{
+			m_freed_head = node->m_next.load( std::memory_order_relaxed );
+			if( !m_freed_head )
+				m_freed_tail = nullptr;
+			--m_freed_count;
+		}
+		else
+			node = new lock_free_node_t{};
+
+		node->m_demand = std::move(demand);
+		push_back( node );
+	}
+
+	//! Destroy all demands.
+	void
+	clear() noexcept
+	{
+		destroy_node_list( m_head );
+		m_head = m_tail = nullptr;
+	}
+
+	//! Take the list of nodes of already processed demands.
+	/*!
+	 * \return first and last nodes of the list or (nullptr, nullptr)
+	 * if there is no such nodes.
+	 */
+	[[nodiscard]]
+	std::pair< lock_free_node_t *, lock_free_node_t * >
+	take_freed_nodes() noexcept
+	{
+		std::pair< lock_free_node_t *, lock_free_node_t * > result{
+				m_freed_head, m_freed_tail };
+		m_freed_head = m_freed_tail = nullptr;
+		m_freed_count = 0u;
+
+		return result;
+	}
+
+private :
+	//! Max count of nodes to be kept for reuse.
+	static constexpr std::size_t max_freed_nodes = 1024u;
+
+	lock_free_node_t * m_head{ nullptr };
+	lock_free_node_t * m_tail{ nullptr };
+
+	lock_free_node_t * m_freed_head{ nullptr };
+	lock_free_node_t * m_freed_tail{ nullptr };
+	std::size_t m_freed_count{ 0u };
+};
+
+//
+// lock_free_common_data_t
+//
+/*!
+ * \brief Common data for all implementations of lock-free demand_queue.
+ *
+ * Contains an intrusive MPSC queue by Dmitry Vyukov: a producer performs
+ * just one atomic exchange, a consumer doesn't use atomic RMW operations
+ * at all.
+ *
+ * \since v.5.8.3
+ */
+struct lock_free_common_data_t
+{
+	//! The last added node.
+	/*!
+	 * Modified by producers.
+	 */
+	alignas(64) std::atomic< lock_free_node_t * > m_head;
+
+	//! The first node to be extracted.
+	/*!
+	 * Modified by the consumer only.
+	 */
+	alignas(64) lock_free_node_t * m_tail;
+
+	//! Stub node for the empty queue.
+	lock_free_node_t m_stub;
+
+	//! Free nodes returned by the consumer.
+	alignas(64) std::atomic< lock_free_node_t * > m_free_nodes{ nullptr };
+
+	//! Lock object.
+	/*!
+	 * It isn't used for push and pop operations. It's necessary only
+	 * for sleeping of the consumer on the empty queue.
+	 */
+	queue_traits::lock_unique_ptr_t m_lock;
+
+	//! Service flag.
+	std::atomic< bool > m_in_service{ false };
+
+	//! Is the consumer going to sleep (or is sleeping already)?
+	/*!
+	 * Is modified only when m_lock is acquired. But it's read by
+	 * producers without the lock.
+	 */
+	std::atomic< bool > m_sleeping{ false };
+
+	//! Counters of wakeups of the consumer.
+	/*!
+	 * The count of issued wakeups is modified only when m_lock is
+	 * acquired. The count of avoided wakeups is modified by the consumer
+	 * only.
+	 *
+	 * \since v.5.8.3
+	 */
+	wakeup_counters_t m_wakeup_counters;
+
+	//! Initializing constructor.
+	lock_free_common_data_t(
+		//! Lock object to be used by queue.
+		queue_traits::lock_unique_ptr_t lock )
+		:	m_head{ &m_stub }
+		,	m_tail{ &m_stub }
+		,	m_lock( std::move(lock) )
+	{}
+
+	~lock_free_common_data_t()
+	{
+		while( auto * node = try_pop_node() )
+			delete node;
+
+		destroy_node_list( m_free_nodes.load( std::memory_order_acquire ) );
+	}
+
+	//! Add a chain of linked nodes to the queue.
+	void
+	push_chain(
+		lock_free_node_t * first,
+		lock_free_node_t * last ) noexcept
+	{
+		last->m_next.store( nullptr, std::memory_order_relaxed );
+
+		// NOTE: seq_cst is necessary here because of the check
+		// of m_sleeping after that.
+		auto * prev = m_head.exchange( last, std::memory_order_seq_cst );
+		prev->m_next.store( first, std::memory_order_release );
+	}
+
+	//! Try to extract a node from the queue.
+	/*!
+	 * \return nullptr if the queue is empty or the next node is being
+	 * added by a producer right now.
+	 *
+	 * \note
+	 * Can be called by the consumer only.
+	 */
+	[[nodiscard]]
+	lock_free_node_t *
+	try_pop_node() noexcept
+	{
+		auto * tail = m_tail;
+		auto * next = tail->m_next.load( std::memory_order_acquire );
+		if( &m_stub == tail )
+		{
+			if( !next )
+				return nullptr;
+
+			m_tail = next;
+			tail = next;
+			next = next->m_next.load( std::memory_order_acquire );
+		}
+
+		if( next )
+		{
+			m_tail = next;
+			return tail;
+		}
 
-protected :
-	void
-	wait_started() {}
+		if( tail != m_head.load( std::memory_order_acquire ) )
+			// A producer hasn't completed its push yet.
+			return nullptr;
 
-	void
-	wait_finished() {}
-};
+		// The stub has to be returned to the queue to extract the last node.
+		push_chain( &m_stub, &m_stub );
 
-/*!
- * \brief A part of demand queue implementation for the case
- * when activity tracking is used.
- */
-class with_activity_tracking_impl_t : protected common_data_t
-{
-public :
-	with_activity_tracking_impl_t(
-		queue_traits::lock_unique_ptr_t lock )
-		:	common_data_t( std::move(lock) )
-		,	m_waiting_stats( *m_lock )
-	{}
+		next = tail->m_next.load( std::memory_order_acquire );
+		if( next )
+		{
+			m_tail = next;
+			return tail;
+		}
 
-	so_5::stats::activity_stats_t
-	take_activity_stats()
+		return nullptr;
+	}
+
+	//! Is the queue empty and there is no incomplete pushes?
+	/*!
+	 * \note
+	 * Can be called by the consumer only.
+	 */
+	[[nodiscard]]
+	bool
+	is_empty() const noexcept
 	{
-		return m_waiting_stats.take_stats();
+		return &m_stub == m_tail &&
+				&m_stub == m_head.load( std::memory_order_seq_cst );
 	}
 
-protected :
-	void
-	wait_started()
+	//! Get a node for a new demand.
+	[[nodiscard]]
+	lock_free_node_t *
+	make_node( execution_demand_t && demand )
 	{
-		m_waiting_stats.start();
+		lock_free_node_t * node = nullptr;
+		if( !t_lock_free_node_cache_destroyed )
+		{
+			auto & cache = t_lock_free_node_cache;
+			if( !cache.m_head )
+				cache.m_head = m_free_nodes.exchange(
+						nullptr, std::memory_order_acquire );
+
+			node = cache.m_head;
+			if( node )
+				cache.m_head = node->m_next.load( std::memory_order_relaxed );
+		}
+
+		if( !node )
+			node = new lock_free_node_t{};
+
+		node->m_demand = std::move(demand);
+
+		return node;
 	}
 
+	//! Return nodes of processed demands for reuse.
+	/*!
+	 * \note
+	 * Can be called by the consumer only.
+	 */
 	void
-	wait_finished()
+	return_free_nodes(
+		std::pair< lock_free_node_t *, lock_free_node_t * > nodes ) noexcept
 	{
-		m_waiting_stats.stop();
-	}
+		if( !nodes.first )
+			return;
 
-private :
-	so_5::stats::activity_tracking_stuff::stats_collector_t<
-			so_5::stats::activity_tracking_stuff::external_lock<
-					queue_traits::lock_t,
-					so_5::stats::activity_tracking_stuff::no_lock_at_start_stop_policy > >
-		m_waiting_stats;
+		auto * head = m_free_nodes.load( std::memory_order_relaxed );
+		do
+		{
+			nodes.second->m_next.store( head, std::memory_order_relaxed );
+		}
+		while( !m_free_nodes.compare_exchange_weak(
+				head, nodes.first,
+				std::memory_order_release,
+				std::memory_order_relaxed ) );
+	}
 };
 
 //
-// demand_queue_template_t
+// lock_free_queue_template_t
 //
 
-//! Implementation of demand_queue in form of a template.
+//! Implementation of lock-free demand_queue in form of a template.
 /*!
-	demand_queue_t has shutdown flag inside.
-
-	demand_queue_t is thread safe and is intended to be used by 
-	several concurrent threads.
-*/
+ * A push to the queue is an atomic exchange of the pointer to the last
+ * node. The lock object is acquired by a producer only if the consumer
+ * is sleeping on the empty queue.
+ *
+ * \since v.5.8.3
+ */
 template< typename Impl >
-class queue_template_t final
+class lock_free_queue_template_t final
 	:	public event_queue_t
 	,	public Impl
 {
 public:
-	queue_template_t(
+	//! Type of container for extracted demands.
+	using demand_container_type = lock_free_demand_list_t;
+
+	lock_free_queue_template_t(
 		//! Lock object to be used by queue.
 		queue_traits::lock_unique_ptr_t lock )
 		:	Impl( std::move(lock) )
@@ -193,23 +1064,57 @@ public:
 	 * \name Implementation of event_queue interface.
 	 * \{
 	 */
-	virtual void
+	void
 	push( execution_demand_t demand ) override
 	{
-		queue_traits::lock_guard_t guard{ *(this->m_lock) };
+		if( m_same_thread_delivery.try_push( *this, demand ) )
+			return;
 
-		if( this->m_in_service )
+		if( this->m_in_service.load( std::memory_order_acquire ) )
 		{
-			const bool demands_empty_before_service = this->m_demands.empty();
+			auto * node = this->make_node( std::move(demand) );
+			this->push_chain( node, node );
 
-			this->m_demands.push_back( std::move( demand ) );
+			wake_up_consumer_if_necessary();
+		}
+	}
 
-			if( demands_empty_before_service )
-			{
-				// May be someone is waiting...
-				// It should be informed about new demands.
-				guard.notify_one();
-			}
+	/*!
+	 * \note
+	 * All demands are added by one atomic operation. If an exception is
+	 * thrown then no demands are added.
+	 */
+	void
+	push_batch( execution_demand_t * demands, std::size_t count ) override
+	{
+		if( m_same_thread_delivery.try_push_batch( *this, demands, count ) )
+			return;
+
+		if( this->m_in_service.load( std::memory_order_acquire ) && count )
+		{
+			lock_free_node_t * first = nullptr;
+			lock_free_node_t * last = nullptr;
+
+			so_5::details::do_with_rollback_on_exception(
+				[&] {
+					for( std::size_t i = 0u; i != count; ++i )
+					{
+						auto * node = this->make_node( std::move( demands[ i ] ) );
+						node->m_next.store( nullptr, std::memory_order_relaxed );
+						if( last )
+							last->m_next.store( node, std::memory_order_relaxed );
+						else
+							first = node;
+						last = node;
+					}
+				},
+				[&] {
+					destroy_node_list( first );
+				} );
+
+			this->push_chain( first, last );
+
+			wake_up_consumer_if_necessary();
 		}
 	}
 
@@ -246,44 +1151,50 @@ public:
 		- the new demand is put in the queue;
 		- a shutdown signal.
 
-		\note Since v.5.5.7 this method also updates external demands
-		counter. This update is performed under queue's lock.
-		It should prevent errors when run-time monitor can get wrong
-		quantity of demands.
+		All available demands are moved to \a demands.
 	*/
 	extraction_result_t
 	pop(
 		/*! Receiver for extracted demands. */
-		demand_container_t & demands,
+		demand_container_type & demands,
 		/*! External demands counter to be updated. */
 		demands_counter_t & external_counter )
 	{
-		queue_traits::unique_lock_t lock{ *(this->m_lock) };
+		this->return_free_nodes( demands.take_freed_nodes() );
+
+		// Was the consumer notified by a producer?
+		bool notified = false;
+
 		while( true )
 		{
-			if( this->m_in_service && !this->m_demands.empty() )
-			{
-				swap( demands, this->m_demands );
+			if( !this->m_in_service.load( std::memory_order_acquire ) )
+				return extraction_result_t::shutting_down;
 
-				// It's time to update external counter.
-				external_counter.store( demands.size(), std::memory_order_release );
+			std::size_t extracted = 0u;
+			while( auto * node = this->try_pop_node() )
+			{
+				demands.push_back( node );
+				++extracted;
+			}
 
+			if( extracted )
+			{
+				external_counter.store( extracted, std::memory_order_release );
+
+				// Producers don't count avoided wakeups to keep the push
+				// free from modifications of shared data. All extracted
+				// demands except the one that woke up the consumer
+				// didn't require a notification.
+				this->m_wakeup_counters.wakeups_avoided(
+						notified ? extracted - 1u : extracted );
 				break;
 			}
-			else if( !this->m_in_service )
-				return extraction_result_t::shutting_down;
-			else
-			{
-				// Queue is empty. We should wait for a demand or
-				// a shutdown signal.
-
-				// Since v.5.5.18 we must take care about activity tracking.
-				this->wait_started();
-
-				lock.wait_for_notify();
 
-				this->wait_finished();
-			}
+			if( !this->is_empty() )
+				// A producer is in the middle of push.
+				std::this_thread::yield();
+			else
+				notified = wait_for_demands() || notified;
 		}
 
 		return extraction_result_t::demand_extracted;
@@ -293,49 +1204,162 @@ public:
 	void
 	start_service()
 	{
-		queue_traits::lock_guard_t lock{ *(this->m_lock) };
-
-		this->m_in_service = true;
+		this->m_in_service.store( true, std::memory_order_release );
 	}
 
 	//! Stop demands processing.
 	void
 	stop_service()
 	{
-		queue_traits::lock_guard_t lock{ *(this->m_lock) };
+		this->m_in_service.store( false, std::memory_order_seq_cst );
 
-		this->m_in_service = false;
-		// If the demands queue is empty then someone is waiting
-		// for new demands inside pop().
-		if( this->m_demands.empty() )
-			lock.notify_one();
+		queue_traits::lock_guard_t lock{ *(this->m_lock) };
+		(void)notify_sleeping_consumer( lock );
 	}
 
 	//! Clear demands queue.
+	/*!
+	 * \attention
+	 * Must be called only when the work thread is finished.
+	 */
 	void
 	clear()
 	{
-		queue_traits::lock_guard_t lock{ *(this->m_lock) };
-
-		this->m_demands.clear();
+		while( auto * node = this->try_pop_node() )
+			delete node;
 	}
 
 	/*!
 	 * \brief Get the count of demands in the queue.
 	 *
-	 * \note Since v.5.5.7 this method also uses external demands
-	 * counter. Addition of demands quantity inside demands queue and
-	 * the value of external counter is performed under the queue lock.
-	 *
-	 * \since v.5.5.4
+	 * \note
+	 * Demands inside the lock-free queue aren't counted. Only demands
+	 * already extracted by the work thread are taken into the account.
 	 */
 	std::size_t
 	demands_count( const demands_counter_t & external_counter )
 	{
-		queue_traits::lock_guard_t lock{ *(this->m_lock) };
+		return external_counter.load( std::memory_order_acquire );
+	}
 
-		return this->m_demands.size()
-				+ external_counter.load( std::memory_order_acquire );
+	//! Turn the same-thread delivery on.
+	/*!
+	 * \attention
+	 * Must be called on the work thread only.
+	 *
+	 * \since v.5.8.3
+	 */
+	void
+	attach_same_thread_delivery(
+		demand_container_type & demands,
+		demands_counter_t & external_counter ) noexcept
+	{
+		m_same_thread_delivery.attach( *this, demands, external_counter );
+	}
+
+	//! Turn the same-thread delivery off.
+	/*!
+	 * \attention
+	 * Must be called on the work thread only.
+	 *
+	 * \since v.5.8.3
+	 */
+	void
+	detach_same_thread_delivery() noexcept
+	{
+		m_same_thread_delivery.detach();
+	}
+
+	/*!
+	 * \brief Get the current values of wakeup counters.
+	 *
+	 * \since v.5.8.3
+	 */
+	[[nodiscard]]
+	wakeup_stats_t
+	wakeup_stats() const noexcept
+	{
+		return this->m_wakeup_counters.stats();
+	}
+
+private :
+	//! Support for the same-thread delivery.
+	/*!
+	 * \since v.5.8.3
+	 */
+	same_thread_delivery_t< demand_container_type > m_same_thread_delivery;
+
+	void
+	wake_up_consumer_if_necessary()
+	{
+		// NOTE: seq_cst is necessary here. The consumer sets m_sleeping
+		// and then checks m_head. The producer changes m_head and then
+		// checks m_sleeping. At least one of them will see the change
+		// made by another.
+		if( this->m_sleeping.load( std::memory_order_seq_cst ) )
+		{
+			queue_traits::lock_guard_t guard{ *(this->m_lock) };
+			if( notify_sleeping_consumer( guard ) )
+				this->m_wakeup_counters.wakeup_issued();
+		}
+	}
+
+	//! Wake up the consumer if it's sleeping.
+	/*!
+	 * \attention
+	 * Must be called only when m_lock is acquired.
+	 *
+	 * \note
+	 * The consumer is notified only once for every sleep because
+	 * queue locks don't expect a notification of a thread which
+	 * is already notified.
+	 *
+	 * \retval true if the consumer was notified (since v.5.8.3).
+	 */
+	[[nodiscard]]
+	bool
+	notify_sleeping_consumer( queue_traits::lock_guard_t & guard )
+	{
+		if( this->m_sleeping.load( std::memory_order_relaxed ) )
+		{
+			this->m_sleeping.store( false, std::memory_order_relaxed );
+			guard.notify_one();
+			return true;
+		}
+
+		return false;
+	}
+
+	//! Sleep until a notification from a producer.
+	/*!
+	 * \retval true if the consumer was notified (since v.5.8.3).
+	 */
+	[[nodiscard]]
+	bool
+	wait_for_demands()
+	{
+		queue_traits::unique_lock_t lock{ *(this->m_lock) };
+
+		this->m_sleeping.store( true, std::memory_order_seq_cst );
+
+		bool notified = false;
+		if( this->m_in_service.load( std::memory_order_seq_cst ) &&
+				this->is_empty() )
+		{
+			this->wait_started();
+
+			lock.wait_for_notify();
+
+			this->wait_finished();
+
+			// The flag is reset by the notifier.
+			notified = !this->m_sleeping.load( std::memory_order_relaxed );
+		}
+
+		// NOTE: the lock is acquired here again.
+		this->m_sleeping.store( false, std::memory_order_relaxed );
+
+		return notified;
 	}
 };
 
@@ -348,7 +1372,8 @@ public:
  */
 using demand_queue_no_activity_tracking_t =
 	demand_queue_details::queue_template_t<
-		demand_queue_details::no_activity_tracking_impl_t >;
+		demand_queue_details::no_activity_tracking_impl_t<
+				demand_queue_details::common_data_t > >;
 
 /*!
  * \brief An alias for demand_queue with activity tracking.
@@ -357,7 +1382,28 @@ using demand_queue_no_activity_tracking_t =
  */
 using demand_queue_with_activity_tracking_t =
 	demand_queue_details::queue_template_t<
-		demand_queue_details::with_activity_tracking_impl_t >;
+		demand_queue_details::with_activity_tracking_impl_t<
+				demand_queue_details::common_data_t > >;
+
+/*!
+ * \brief An alias for lock-free demand_queue without activity tracking.
+ *
+ * \since v.5.8.3
+ */
+using lock_free_demand_queue_no_activity_tracking_t =
+	demand_queue_details::lock_free_queue_template_t<
+		demand_queue_details::no_activity_tracking_impl_t<
+				demand_queue_details::lock_free_common_data_t > >;
+
+/*!
+ * \brief An alias for lock-free demand_queue with activity tracking.
+ *
+ * \since v.5.8.3
+ */
+using lock_free_demand_queue_with_activity_tracking_t =
+	demand_queue_details::lock_free_queue_template_t<
+		demand_queue_details::with_activity_tracking_impl_t<
+				demand_queue_details::lock_free_common_data_t > >;
 
 namespace details
 {
@@ -385,6 +1431,13 @@ struct common_data_t
 	//! Thread status flag.
 	std::atomic< status_t > m_status{ status_t::stopped };
 
+	//! Type of container for extracted demands.
+	/*!
+	 * \since v.5.8.3
+	 */
+	using demand_container_type =
+			typename Demand_Queue::demand_container_type;
+
 	//! Demands queue.
 	Demand_Queue m_queue;
 
@@ -403,6 +1456,13 @@ struct common_data_t
 	 */
 	demands_counter_t m_demands_count = { 0 };
 
+	/*!
+	 * \brief Is the same-thread delivery turned on?
+	 *
+	 * \since v.5.8.3
+	 */
+	bool m_same_thread_delivery{ false };
+
 	common_data_t(
 		work_thread_holder_t thread_holder,
 		queue_traits::lock_factory_t queue_lock_factory )
@@ -414,16 +1474,22 @@ struct common_data_t
 /*!
  * \brief Part of implementation of work thread without activity tracking.
  *
+ * \note
+ * It's a template since v.5.8.3.
+ *
  * \since v.5.5.18
  */
+template< typename Demand_Queue >
 class no_activity_tracking_impl_t
-	: protected common_data_t< demand_queue_no_activity_tracking_t >
+	: protected common_data_t< Demand_Queue >
 {
+	using base_type_t = common_data_t< Demand_Queue >;
+
 public :
 	no_activity_tracking_impl_t(
 		work_thread_holder_t thread_holder,
 		queue_traits::lock_factory_t queue_lock_factory )
-		:	common_data_t{
+		:	base_type_t{
 				std::move(thread_holder),
 				std::move(queue_lock_factory)
 			}
@@ -434,7 +1500,7 @@ protected :
 	void
 	serve_demands_block(
 		//! Bunch of demands to be processed.
-		demand_container_t & demands )
+		typename base_type_t::demand_container_type & demands )
 	{
 		while( !demands.empty() )
 		{
@@ -451,19 +1517,25 @@ protected :
 /*!
  * \brief Part of implementation of work thread with activity tracking.
  *
+ * \note
+ * It's a template since v.5.8.3.
+ *
  * \since
  * v.5.5.18
  */
+template< typename Demand_Queue >
 class activity_tracking_impl_t
-	: protected common_data_t< demand_queue_with_activity_tracking_t >
+	: protected common_data_t< Demand_Queue >
 {
 	using activity_tracking_traits = so_5::stats::activity_tracking_stuff::traits;
 
+	using base_type_t = common_data_t< Demand_Queue >;
+
 public :
 	activity_tracking_impl_t(
 		work_thread_holder_t thread_holder,
 		queue_traits::lock_factory_t queue_lock_factory )
-		:	common_data_t{
+		:	base_type_t{
 				std::move(thread_holder),
 				std::move(queue_lock_factory)
 			}
@@ -500,7 +1572,7 @@ public :
 					working_started_at );
 		}
 
-		result.m_waiting_stats = m_queue.take_activity_stats();
+		result.m_waiting_stats = this->m_queue.take_activity_stats();
 
 		return result;
 	}
@@ -510,7 +1582,7 @@ protected :
 	void
 	serve_demands_block(
 		//! Bunch of demands to be processed.
-		demand_container_t & demands )
+		typename base_type_t::demand_container_type & demands )
 	{
 		auto activity_started_at = so_5::stats::clock_type_t::now();
 
@@ -524,12 +1596,12 @@ protected :
 		{
 			auto & demand = demands.front();
 
-			demand.call_handler( m_thread_id );
+			demand.call_handler( this->m_thread_id );
 
 			const auto activity_finished_at = so_5::stats::clock_type_t::now();
 
 			demands.pop_front();
-			--m_demands_count;
+			--(this->m_demands_count);
 
 			{
 				std::lock_guard< activity_tracking_traits::lock_t > lock{ m_stats_lock };
@@ -630,6 +1702,21 @@ public :
 		this->m_queue.clear();
 	}
 
+	//! Turn the same-thread delivery on.
+	/*!
+	 * See so_5::disp::reuse::same_thread_delivery_mixin_t for details.
+	 *
+	 * \attention
+	 * Must be called before start().
+	 *
+	 * \since v.5.8.3
+	 */
+	void
+	turn_same_thread_delivery_on() noexcept
+	{
+		this->m_same_thread_delivery = true;
+	}
+
 	/*!
 	 * \brief Get the underlying event_queue object.
 	 */
@@ -657,6 +1744,18 @@ public :
 		return this->m_queue.demands_count( this->m_demands_count );
 	}
 
+	/*!
+	 * \brief Get the current values of wakeup counters of the queue.
+	 *
+	 * \since v.5.8.3
+	 */
+	[[nodiscard]]
+	wakeup_stats_t
+	wakeup_stats() const noexcept
+	{
+		return this->m_queue.wakeup_stats();
+	}
+
 	/*!
 	 * \brief Get ID of work thread.
 	 *
@@ -682,7 +1781,17 @@ private :
 		this->m_thread_id = so_5::query_current_thread_id();
 
 		// Local demands queue.
-		demand_container_t demands;
+		typename Impl::demand_container_type demands;
+
+		// Since v.5.8.3 demands sent from this thread can be appended
+		// to the local demands queue directly.
+		if( this->m_same_thread_delivery )
+			this->m_queue.attach_same_thread_delivery(
+					demands, this->m_demands_count );
+		auto delivery_detacher = so_5::details::at_scope_exit( [this] {
+				if( this->m_same_thread_delivery )
+					this->m_queue.detach_same_thread_delivery();
+			} );
 
 		auto result = extraction_result_t::no_demands;
 
@@ -711,7 +1820,8 @@ private :
  */
 using work_thread_no_activity_tracking_t =
 	details::work_thread_template_t<
-		details::no_activity_tracking_impl_t >;
+		details::no_activity_tracking_impl_t<
+				demand_queue_no_activity_tracking_t > >;
 
 //
 // work_thread_with_activity_tracking_t
@@ -724,7 +1834,38 @@ using work_thread_no_activity_tracking_t =
  */
 using work_thread_with_activity_tracking_t =
 	details::work_thread_template_t<
-		details::activity_tracking_impl_t >;
+		details::activity_tracking_impl_t<
+				demand_queue_with_activity_tracking_t > >;
+
+//
+// lock_free_work_thread_no_activity_tracking_t
+//
+
+/*!
+ * \brief Type of work thread with lock-free demand queue and without
+ * activity tracking.
+ *
+ * \since v.5.8.3
+ */
+using lock_free_work_thread_no_activity_tracking_t =
+	details::work_thread_template_t<
+		details::no_activity_tracking_impl_t<
+				lock_free_demand_queue_no_activity_tracking_t > >;
+
+//
+// lock_free_work_thread_with_activity_tracking_t
+//
+
+/*!
+ * \brief Type of work thread with lock-free demand queue and with
+ * activity tracking.
+ *
+ * \since v.5.8.3
+ */
+using lock_free_work_thread_with_activity_tracking_t =
+	details::work_thread_template_t<
+		details::activity_tracking_impl_t<
+				lock_free_demand_queue_with_activity_tracking_t > >;
 
 } /* namespace work_thread */
 
@@ -12,6 +12,7 @@
 #pragma once
 
 #include <so_5/disp/abstract_work_thread.hpp>
+#include <so_5/disp/work_thread_placement.hpp>
 
 namespace so_5 {
 
@@ -24,6 +25,10 @@ namespace reuse {
  *
  * Indended to be used as mixin for various disp_params_t classes.
  *
+ * \note
+ * Since v.5.8.3 this mixin also holds an optional placement for
+ * worker threads (see work_thread_placement_t).
+ *
  * \since v.5.7.3
  */
 template< typename Params >
@@ -37,6 +42,16 @@ class work_thread_factory_mixin_t
 		 */
 		abstract_work_thread_factory_shptr_t m_factory;
 
+		/*!
+		 * Placement for worker threads.
+		 *
+		 * \note
+		 * It can be empty.
+		 *
+		 * \since v.5.8.3
+		 */
+		work_thread_placement_t m_placement;
+
 	public :
 		//! Getter for work thread factory.
 		[[nodiscard]]
@@ -53,6 +68,7 @@ class work_thread_factory_mixin_t
 			{
 				using std::swap;
 				swap( a.m_factory, b.m_factory );
+				swap( a.m_placement, b.m_placement );
 			}
 
 		//! Setter for work thread factory.
@@ -63,6 +79,40 @@ class work_thread_factory_mixin_t
 				m_factory = std::move(v);
 				return static_cast< Params & >(*this);
 			}
+
+		/*!
+		 * \brief Getter for placement of worker threads.
+		 *
+		 * \since v.5.8.3
+		 */
+		[[nodiscard]]
+		const work_thread_placement_t &
+		work_thread_placement() const noexcept
+			{
+				return m_placement;
+			}
+
+		/*!
+		 * \brief Setter for placement of worker threads.
+		 *
+		 * Usage example:
+		 * \code
+		 * auto disp = so_5::disp::active_obj::make_dispatcher( env, "io",
+		 * 	so_5::disp::active_obj::disp_params_t{}
+		 * 		.work_thread_placement(
+		 * 			so_5::disp::work_thread_placement_t::cpus( { 2, 3 } )
+		 * 				.thread_name( "io" ) ) );
+		 * \endcode
+		 *
+		 * \since v.5.8.3
+		 */
+		Params &
+		work_thread_placement(
+			work_thread_placement_t v ) noexcept
+			{
+				m_placement = std::move(v);
+				return static_cast< Params & >(*this);
+			}
 	};
 
 } /* namespace reuse */
@@ -18,6 +18,8 @@
 #include <so_5/outliving.hpp>
 #include <so_5/spinlocks.hpp>
 
+#include <so_5/details/rollback_on_exception.hpp>
+
 namespace so_5
 {
 
@@ -113,6 +115,56 @@ class basic_event_queue_t
 				push_preallocated( std::move(tail_demand) );
 			}
 
+		//! Push several demands to queue.
+		/*!
+		 * All new items are allocated before acquiring the queue's lock.
+		 * The whole chain is appended under one lock.
+		 *
+		 * \since v.5.8.3
+		 */
+		void
+		push_batch( execution_demand_t * demands, std::size_t count ) override
+			{
+				if( !count )
+					return;
+
+				std::unique_ptr< demand_t > first{
+						new demand_t( std::move( demands[ 0 ] ) ) };
+				demand_t * last = first.get();
+
+				so_5::details::do_with_rollback_on_exception(
+					[&] {
+						for( std::size_t i = 1u; i != count; ++i )
+							{
+								last->m_next = new demand_t( std::move( demands[ i ] ) );
+								last = last->m_next;
+							}
+					},
+					[&] {
+						while( first->m_next )
+							{
+								std::unique_ptr< demand_t > victim{ first->m_next };
+								first->m_next = victim->m_next;
+							}
+					} );
+
+				const bool was_empty = [&]() noexcept {
+					std::lock_guard< spinlock_t > lock( m_lock );
+
+					const bool queue_was_empty = (nullptr == m_head_demand.m_next);
+
+					m_tail_demand->m_next = first.release();
+					m_tail_demand = last;
+
+					m_size += count;
+
+					return queue_was_empty;
+				}();
+
+				if( was_empty )
+					this->schedule_on_disp_queue();
+			}
+
 		//! Push evt_start demand to the queue.
 		void
 		push_evt_start( execution_demand_t demand ) override
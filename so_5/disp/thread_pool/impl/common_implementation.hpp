@@ -14,11 +14,16 @@
 #include <so_5/event_queue.hpp>
 
 #include <so_5/disp/reuse/actual_work_thread_factory_to_use.hpp>
+#include <so_5/disp/reuse/elastic_pool.hpp>
 #include <so_5/disp/reuse/queue_of_queues.hpp>
 #include <so_5/disp/reuse/thread_pool_stats.hpp>
 
 #include <so_5/details/rollback_on_exception.hpp>
+#include <so_5/details/suppress_exceptions.hpp>
 
+#include <algorithm>
+#include <functional>
+#include <memory>
 #include <mutex>
 
 namespace so_5 {
@@ -52,6 +57,21 @@ namespace tp_stats = so_5::disp::reuse::thread_pool_stats;
  * needs of the dispatcher. See so_5::disp::thread_pool::impl::adaptation_t
  * or so_5::disp::adv_thread_pool::impl::adaptation_t as examples.
  *
+ * \note
+ * Since v.5.8.3 the dispatcher can work in the elastic mode (see
+ * turn_elastic_mode_on()). This mode requires the following methods
+ * from Dispatcher_Queue:
+ * \code
+ * so_5::disp::reuse::elastic_pool_controller_t::load_t load() noexcept;
+ * void thread_added();
+ * void thread_not_started() noexcept;
+ * bool retire_idle_thread() noexcept;
+ * \endcode
+ * and the following method from Work_Thread:
+ * \code
+ * bool is_finished() const noexcept;
+ * \endcode
+ *
  * \since v.5.5.4
  */
 template<
@@ -195,15 +215,27 @@ class dispatcher_t final
 		dispatcher_t & operator=( const dispatcher_t & ) = delete;
 
 		//! Constructor.
-		template< typename Dispatcher_Params >
+		/*!
+		 * \note
+		 * Values of \a queue_extra_args are passed to the constructor of
+		 * Dispatcher_Queue after \a queue_params and \a thread_count.
+		 * It allows to use a dispatcher-specific type of dispatcher queue
+		 * that requires some additional information.
+		 */
+		template< typename Dispatcher_Params, typename... Queue_Extra_Args >
 		dispatcher_t(
 			environment_t & env,
 			const so_5::disp::reuse::work_thread_factory_mixin_t< Dispatcher_Params >
 				& disp_params,
 			const std::string_view name_base,
 			std::size_t thread_count,
-			const so_5::disp::mpmc_queue_traits::queue_params_t & queue_params )
-			:	m_queue{ queue_params, thread_count }
+			const so_5::disp::mpmc_queue_traits::queue_params_t & queue_params,
+			Queue_Extra_Args && ...queue_extra_args )
+			:	m_queue{
+					queue_params,
+					thread_count,
+					std::forward< Queue_Extra_Args >( queue_extra_args )...
+				}
 			,	m_thread_count( thread_count )
 			,	m_data_source( stats_supplier() )
 			{
@@ -229,6 +261,42 @@ class dispatcher_t final
 						this );
 			}
 
+		/*!
+		 * \brief Turn the elastic mode on.
+		 *
+		 * Threads created in the constructor are the initial threads.
+		 * Additional threads are acquired from the same work thread factory.
+		 *
+		 * \attention
+		 * Must be called before start().
+		 *
+		 * \since v.5.8.3
+		 */
+		template< typename Dispatcher_Params >
+		void
+		turn_elastic_mode_on(
+			environment_t & env,
+			const so_5::disp::reuse::work_thread_factory_mixin_t< Dispatcher_Params >
+				& disp_params,
+			const so_5::disp::elastic_pool_params_t & elastic_params,
+			//! Max count of threads.
+			std::size_t max_thread_count )
+			{
+				using factory_params_t = so_5::disp::reuse::
+						work_thread_factory_mixin_t< Dispatcher_Params >;
+
+				m_elastic = std::make_unique< elastic_data_t >(
+						elastic_params,
+						max_thread_count,
+						[&env, factory_params = factory_params_t{ disp_params }] {
+							return acquire_work_thread( factory_params, env );
+						},
+						// NOTE: do_elastic_check() is instantiated only if
+						// the elastic mode is used. It allows to use
+						// Dispatcher_Queue types without support for that mode.
+						[this] { do_elastic_check(); } );
+			}
+
 		void
 		start( environment_t & env )
 			{
@@ -237,11 +305,20 @@ class dispatcher_t final
 
 				for( auto & t : m_threads )
 					t->start();
+
+				if( m_elastic )
+					m_elastic->m_monitor.start(
+							m_elastic->m_controller.params().check_period(),
+							m_elastic->m_check_action );
 			}
 
 		void
 		shutdown_then_wait() noexcept
 			{
+				// No more threads can be added or removed after that.
+				if( m_elastic )
+					m_elastic->m_monitor.stop_then_join();
+
 				m_queue.shutdown();
 
 				for( auto & t : m_threads )
@@ -324,6 +401,36 @@ class dispatcher_t final
 			}
 
 	private :
+		/*!
+		 * \brief Data for the elastic mode.
+		 *
+		 * \since v.5.8.3
+		 */
+		struct elastic_data_t
+			{
+				//! Decision logic.
+				so_5::disp::reuse::elastic_pool_controller_t m_controller;
+
+				//! Acquirer of new work threads.
+				std::function< work_thread_holder_t() > m_thread_acquirer;
+
+				//! Action to be called by the monitoring thread.
+				std::function< void() > m_check_action;
+
+				//! Thread that checks the load.
+				so_5::disp::reuse::periodic_monitor_t m_monitor;
+
+				elastic_data_t(
+					const so_5::disp::elastic_pool_params_t & params,
+					std::size_t max_thread_count,
+					std::function< work_thread_holder_t() > thread_acquirer,
+					std::function< void() > check_action )
+					:	m_controller{ params, max_thread_count }
+					,	m_thread_acquirer{ std::move(thread_acquirer) }
+					,	m_check_action{ std::move(check_action) }
+					{}
+			};
+
 		//! Queue for active agent's queues.
 		Dispatcher_Queue m_queue;
 
@@ -355,6 +462,103 @@ class dispatcher_t final
 		stats::manually_registered_source_holder_t< tp_stats::data_source_t >
 				m_data_source;
 
+		/*!
+		 * \brief Data for the elastic mode.
+		 *
+		 * Is nullptr if the elastic mode isn't used.
+		 *
+		 * \since v.5.8.3
+		 */
+		std::unique_ptr< elastic_data_t > m_elastic;
+
+		/*!
+		 * \brief Check the load and add/remove a thread if necessary.
+		 *
+		 * Is called periodically by the monitoring thread.
+		 *
+		 * \since v.5.8.3
+		 */
+		void
+		do_elastic_check() noexcept
+			{
+				using decision_t =
+						so_5::disp::reuse::elastic_pool_controller_t::decision_t;
+
+				join_finished_threads();
+
+				const auto decision = m_elastic->m_controller.check(
+						std::chrono::steady_clock::now(),
+						m_queue.load() );
+
+				switch( decision )
+					{
+					case decision_t::nothing:
+					break;
+
+					case decision_t::add_thread:
+						// If a thread can't be acquired or started then
+						// another attempt will be made during the next checks.
+						so_5::details::suppress_exceptions(
+								[this] { add_elastic_thread(); } );
+					break;
+
+					case decision_t::retire_thread:
+						(void)m_queue.retire_idle_thread();
+					break;
+					}
+			}
+
+		/*!
+		 * \brief Start a new thread in the elastic mode.
+		 *
+		 * \since v.5.8.3
+		 */
+		void
+		add_elastic_thread()
+			{
+				std::unique_ptr< Work_Thread > thread{
+						new Work_Thread{
+								outliving_mutable(m_queue),
+								m_elastic->m_thread_acquirer()
+						} };
+
+				m_queue.thread_added();
+				so_5::details::do_with_rollback_on_exception(
+						[&] {
+							std::lock_guard< std::mutex > lock{ m_lock };
+
+							// There must be a room for the new thread before
+							// the start of it.
+							m_threads.reserve( m_threads.size() + 1u );
+
+							thread->start();
+							m_threads.push_back( std::move(thread) );
+						},
+						[&] { m_queue.thread_not_started(); } );
+			}
+
+		/*!
+		 * \brief Join and remove threads finished after retirement.
+		 *
+		 * \since v.5.8.3
+		 */
+		void
+		join_finished_threads() noexcept
+			{
+				std::lock_guard< std::mutex > lock{ m_lock };
+
+				for( auto it = m_threads.begin(); it != m_threads.end(); )
+					{
+						if( (*it)->is_finished() )
+							{
+								(*it)->join();
+								it = m_threads.erase( it );
+							}
+						else
+							++it;
+					}
+			}
+
 		//! Creation event queue for an agent with individual FIFO.
 		void
 		bind_agent_with_inidividual_fifo(
@@ -442,7 +646,13 @@ class dispatcher_t final
 				// Statics must be collected on locked object.
 				std::lock_guard< std::mutex > lock{ m_lock };
 
-				consumer.set_thread_count( m_threads.size() );
+				// NOTE: threads that are finished after retirement but
+				// aren't joined yet are not counted.
+				consumer.set_thread_count( static_cast< std::size_t >(
+						std::count_if( m_threads.begin(), m_threads.end(),
+								[]( const auto & t ) { return !t->is_finished(); } ) ) );
+
+				consumer.set_wakeup_stats( m_queue.wakeup_stats() );
 
 				for( auto & t : m_threads )
 					{
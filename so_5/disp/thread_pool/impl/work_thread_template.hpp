@@ -20,6 +20,8 @@
 
 #include <so_5/impl/thread_join_stuff.hpp>
 
+#include <atomic>
+
 namespace so_5
 {
 
@@ -270,7 +272,26 @@ class work_thread_template_t final : public Impl
 				return this->m_thread_id;
 			}
 
+		/*!
+		 * \brief Has the thread body been finished?
+		 *
+		 * \since v.5.8.3
+		 */
+		[[nodiscard]]
+		bool
+		is_finished() const noexcept
+			{
+				return m_finished.load( std::memory_order_acquire );
+			}
+
 	private :
+		/*!
+		 * \brief Is the thread body finished?
+		 *
+		 * \since v.5.8.3
+		 */
+		std::atomic< bool > m_finished{ false };
+
 		//! Thread body method.
 		void
 		body()
@@ -282,6 +303,8 @@ class work_thread_template_t final : public Impl
 					{
 						this->do_queue_processing( agent_queue );
 					}
+
+				m_finished.store( true, std::memory_order_release );
 			}
 
 		/*!
@@ -80,7 +80,9 @@ using actual_dispatcher_iface_shptr_t =
  *
  * \since v.5.6.0
  */
-class actual_binder_t final : public disp_binder_t
+class actual_binder_t final
+	:	public disp_binder_t
+	,	public transfer_queue_provider_t
 	{
 		//! Dispatcher to be used.
 		actual_dispatcher_iface_shptr_t m_disp;
@@ -113,8 +115,7 @@ class actual_binder_t final : public disp_binder_t
 		bind(
 			agent_t & agent ) noexcept override
 			{
-				auto queue = m_disp->query_resources_for_agent( agent );
-				agent.so_bind_to_dispatcher( *queue );
+				agent.so_bind_to_dispatcher( bind_transferred( agent ) );
 			}
 
 		void
@@ -123,6 +124,13 @@ class actual_binder_t final : public disp_binder_t
 			{
 				m_disp->unbind_agent( agent );
 			}
+
+		event_queue_t &
+		bind_transferred(
+			agent_t & agent ) noexcept override
+			{
+				return *(m_disp->query_resources_for_agent( agent ));
+			}
 	};
 
 //
@@ -152,10 +160,15 @@ class actual_dispatcher_implementation_t final
 					env.get(),
 					params,
 					name_base,
-					params.thread_count(),
+					so_5::disp::reuse::initial_thread_count(
+							params.thread_count(), params.elastic() ),
 					params.queue_params()
 				}
 			{
+				if( const auto & elastic = params.elastic() )
+					m_impl.turn_elastic_mode_on(
+							env.get(), params, *elastic, params.thread_count() );
+
 				m_impl.start( env.get() );
 			}
 
@@ -20,6 +20,7 @@
 #include <so_5/disp/reuse/work_thread_activity_tracking.hpp>
 #include <so_5/disp/reuse/work_thread_factory_params.hpp>
 #include <so_5/disp/reuse/default_thread_pool_size.hpp>
+#include <so_5/disp/reuse/elastic_pool.hpp>
 
 #include <string_view>
 #include <thread>
@@ -52,11 +53,14 @@ namespace queue_traits = so_5::disp::mpmc_queue_traits;
 class disp_params_t
 	:	public so_5::disp::reuse::work_thread_activity_tracking_flag_mixin_t< disp_params_t >
 	,	public so_5::disp::reuse::work_thread_factory_mixin_t< disp_params_t >
+	,	public so_5::disp::reuse::elastic_pool_mixin_t< disp_params_t >
 	{
 		using activity_tracking_mixin_t = so_5::disp::reuse::
 				work_thread_activity_tracking_flag_mixin_t< disp_params_t >;
 		using thread_factory_mixin_t = so_5::disp::reuse::
 				work_thread_factory_mixin_t< disp_params_t >;
+		using elastic_mixin_t = so_5::disp::reuse::
+				elastic_pool_mixin_t< disp_params_t >;
 
 	public :
 		//! Default constructor.
@@ -76,6 +80,10 @@ class disp_params_t
 						static_cast< work_thread_factory_mixin_t & >(a),
 						static_cast< work_thread_factory_mixin_t & >(b) );
 
+				swap(
+						static_cast< elastic_mixin_t & >(a),
+						static_cast< elastic_mixin_t & >(b) );
+
 				swap( a.m_thread_count, b.m_thread_count );
 				swap( a.m_queue_params, b.m_queue_params );
 			}
@@ -0,0 +1,812 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \file
+ * \brief An implementation of work-stealing thread pool dispatcher.
+ *
+ * \since v.5.8.3
+ */
+
+#pragma once
+
+#include <so_5/disp/thread_pool/impl/basic_event_queue.hpp>
+#include <so_5/disp/thread_pool/impl/work_thread_template.hpp>
+
+#include <so_5/disp/work_stealing_pool/pub.hpp>
+
+#include <so_5/disp/reuse/wakeup_stats.hpp>
+
+#include <so_5/exception.hpp>
+#include <so_5/ret_code.hpp>
+#include <so_5/spinlocks.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace so_5
+{
+
+namespace disp
+{
+
+namespace work_stealing_pool
+{
+
+namespace impl
+{
+
+using spinlock_t = so_5::default_spinlock_t;
+
+using so_5::disp::thread_pool::impl::basic_event_queue_t;
+
+class dispatcher_queue_t;
+class agent_queue_deque_t;
+
+//
+// agent_queue_t
+//
+/*!
+ * \brief Event queue for the agent (or cooperation).
+ *
+ * An agent queue can be stored in only one deque of ready agent queues
+ * at a time. This is guaranteed by basic_event_queue_t: the agent queue
+ * is scheduled only when it becomes non-empty.
+ *
+ * \since v.5.8.3
+ */
+class agent_queue_t final
+	:	public basic_event_queue_t
+	,	private so_5::atomic_refcounted_t
+	{
+		friend class so_5::intrusive_ptr_t< agent_queue_t >;
+		friend class agent_queue_deque_t;
+
+	public :
+		//! Initializing constructor.
+		agent_queue_t(
+			//! Dispatcher queue to work with.
+			outliving_reference_t< dispatcher_queue_t > disp_queue,
+			//! Parameters for the queue.
+			const bind_params_t & params )
+			:	basic_event_queue_t{
+					params.query_max_demands_at_once()
+				}
+			,	m_disp_queue{ disp_queue.get() }
+			{}
+
+	protected:
+		void
+		schedule_on_disp_queue() noexcept override;
+
+	private :
+		//! Dispatcher queue with that the agent queue has to be used.
+		dispatcher_queue_t & m_disp_queue;
+
+		//! The previous item in a deque of ready agent queues.
+		agent_queue_t * m_deque_prev{ nullptr };
+
+		//! The next item in a deque of ready agent queues.
+		agent_queue_t * m_deque_next{ nullptr };
+	};
+
+//
+// agent_queue_deque_t
+//
+/*!
+ * \brief Intrusive double-ended queue of ready agent queues.
+ *
+ * \note
+ * This class isn't thread safe. All operations have to be performed
+ * under an external lock.
+ *
+ * \since v.5.8.3
+ */
+class agent_queue_deque_t
+	{
+	public :
+		//! Count of items in the deque.
+		[[nodiscard]]
+		std::size_t
+		size() const noexcept { return m_size; }
+
+		void
+		push_back( agent_queue_t * queue ) noexcept
+			{
+				queue->m_deque_prev = m_tail;
+				queue->m_deque_next = nullptr;
+				if( m_tail )
+					m_tail->m_deque_next = queue;
+				else
+					m_head = queue;
+				m_tail = queue;
+				++m_size;
+			}
+
+		//! Extract the oldest item.
+		/*!
+		 * \retval nullptr if the deque is empty.
+		 */
+		[[nodiscard]]
+		agent_queue_t *
+		pop_front() noexcept
+			{
+				auto * r = m_head;
+				if( r )
+					{
+						m_head = r->m_deque_next;
+						if( m_head )
+							m_head->m_deque_prev = nullptr;
+						else
+							m_tail = nullptr;
+						r->m_deque_next = nullptr;
+						--m_size;
+					}
+
+				return r;
+			}
+
+		//! Extract the most recently pushed item.
+		/*!
+		 * \retval nullptr if the deque is empty.
+		 */
+		[[nodiscard]]
+		agent_queue_t *
+		pop_back() noexcept
+			{
+				auto * r = m_tail;
+				if( r )
+					{
+						m_tail = r->m_deque_prev;
+						if( m_tail )
+							m_tail->m_deque_next = nullptr;
+						else
+							m_head = nullptr;
+						r->m_deque_prev = nullptr;
+						--m_size;
+					}
+
+				return r;
+			}
+
+	private :
+		agent_queue_t * m_head{ nullptr };
+		agent_queue_t * m_tail{ nullptr };
+		std::size_t m_size{};
+	};
+
+//
+// worker_slot_t
+//
+/*!
+ * \brief Data of one worker thread inside the dispatcher queue.
+ *
+ * Every slot occupies its own cache line(s) to avoid false sharing
+ * between worker threads.
+ *
+ * \since v.5.8.3
+ */
+struct alignas(64) worker_slot_t
+	{
+		//! Lock for the local deque.
+		spinlock_t m_lock;
+
+		//! Local deque of ready agent queues.
+		/*!
+		 * The owner pushes and pops at the back, thieves pop at the front.
+		 */
+		agent_queue_deque_t m_deque;
+
+		//! The size of m_deque for checks without acquiring m_lock.
+		std::atomic< std::size_t > m_size{ 0u };
+
+		//! The condition object of the owner thread.
+		so_5::disp::mpmc_queue_traits::condition_t * m_condition{ nullptr };
+
+		//
+		// The following fields are used only by the owner thread.
+		//
+
+		//! Count of consecutive pops from the back of the local deque.
+		unsigned int m_lifo_streak{};
+
+		//! Count of attempts to find a work.
+		unsigned int m_ticks{};
+
+		//! State of pseudo-random generator for selection of victims.
+		std::uint32_t m_rng_state{ 1u };
+
+		//! Wakeups avoided by pushes to the local deque.
+		so_5::disp::reuse::wakeup_counters_t m_wakeups;
+
+		//! Get the next pseudo-random value (xorshift32).
+		[[nodiscard]]
+		std::uint32_t
+		next_random() noexcept
+			{
+				auto x = m_rng_state;
+				x ^= x << 13;
+				x ^= x >> 17;
+				x ^= x << 5;
+				m_rng_state = x;
+				return x;
+			}
+	};
+
+//
+// current_worker_t
+//
+/*!
+ * \brief Description of a worker thread that is the current thread.
+ *
+ * \since v.5.8.3
+ */
+struct current_worker_t
+	{
+		//! The dispatcher queue the current thread works with.
+		const dispatcher_queue_t * m_owner{ nullptr };
+
+		//! The slot of the current thread.
+		worker_slot_t * m_slot{ nullptr };
+	};
+
+/*!
+ * \brief Info about the current thread if it's a worker thread of
+ * some %work_stealing_pool dispatcher.
+ *
+ * It's set on the first call to dispatcher_queue_t::pop() and is reset
+ * when the worker thread finishes its work.
+ *
+ * \since v.5.8.3
+ */
+inline thread_local current_worker_t t_current_worker;
+
+//
+// dispatcher_queue_t
+//
+/*!
+ * \brief Multi-producer/Multi-consumer queue of ready agent queues
+ * with work stealing.
+ *
+ * The queue consists of local deques (one per worker thread) and the
+ * global injection queue. A push from a worker thread of the same
+ * dispatcher goes to the local deque of that worker. All other pushes
+ * go to the global injection queue.
+ *
+ * The lock from queue_params is used only for sleeping and waking up
+ * worker threads.
+ *
+ * There is no lost wakeups because:
+ * - a worker increments m_sleeping and only then checks all the queues
+ *   for the last time before going to sleep;
+ * - a producer pushes a queue and only then checks m_sleeping.
+ *
+ * \since v.5.8.3
+ */
+class dispatcher_queue_t
+	{
+	public :
+		using item_t = agent_queue_t;
+
+		dispatcher_queue_t(
+			const so_5::disp::mpmc_queue_traits::queue_params_t & queue_params,
+			std::size_t thread_count )
+			:	m_lock{ queue_params.lock_factory()() }
+			,	m_thread_count{ thread_count }
+			,	m_next_thread_wakeup_threshold{
+					queue_params.next_thread_wakeup_threshold() }
+			,	m_slots{ std::make_unique< worker_slot_t[] >( thread_count ) }
+			{
+				for( std::size_t i = 0u; i != thread_count; ++i )
+					m_slots[ i ].m_rng_state =
+							static_cast< std::uint32_t >( i + 1u ) * 2654435761u;
+
+				m_waiting_customers.reserve( thread_count );
+			}
+
+		//! Initiate shutdown for working threads.
+		void
+		shutdown() noexcept
+			{
+				std::lock_guard< so_5::disp::mpmc_queue_traits::lock_t > lock{ *m_lock };
+
+				m_shutdown.store( true, std::memory_order_release );
+
+				while( !m_waiting_customers.empty() )
+					pop_and_notify_one_waiting_customer();
+			}
+
+		//! Get next active queue.
+		/*!
+		 * \note
+		 * It's expected that this method is called only by worker threads.
+		 *
+		 * \retval nullptr is the case of dispatcher shutdown.
+		 */
+		[[nodiscard]]
+		agent_queue_t *
+		pop( so_5::disp::mpmc_queue_traits::condition_t & condition ) noexcept
+			{
+				auto & slot = bind_current_worker( condition );
+
+				auto * r = find_work( slot );
+				if( !r )
+					r = wait_for_work( slot, condition );
+
+				if( !r )
+					// The worker thread is about to finish.
+					t_current_worker = current_worker_t{};
+
+				return r;
+			}
+
+		//! Switch the current non-empty queue to another one if it is possible.
+		/*!
+		 * Only the global injection queue and the local deque of the
+		 * current worker are checked. If there is another ready queue
+		 * then \a current is returned to the back of the local deque.
+		 *
+		 * \return nullptr is the case of dispatcher shutdown.
+		 */
+		[[nodiscard]]
+		agent_queue_t *
+		try_switch_to_another( agent_queue_t * current ) noexcept
+			{
+				if( m_shutdown.load( std::memory_order_acquire ) )
+					return nullptr;
+
+				auto & slot = *(t_current_worker.m_slot);
+
+				auto * r = pop_global();
+				if( !r )
+					r = pop_local_front( slot );
+
+				if( r )
+					{
+						// No need to wake up someone because the total count of
+						// ready queues isn't changed.
+						push_local( slot, current );
+						return r;
+					}
+
+				return current;
+			}
+
+		//! Schedule execution of demands from the queue.
+		void
+		schedule( agent_queue_t * queue ) noexcept
+			{
+				const auto & current = t_current_worker;
+				if( this == current.m_owner )
+					{
+						const auto size = push_local( *(current.m_slot), queue );
+						// The owner of the local deque will take one queue by
+						// itself, so that queue isn't counted.
+						if( 0u != m_sleeping.load( std::memory_order_seq_cst ) )
+							try_wakeup_someone( size - 1u, false );
+						else
+							current.m_slot->m_wakeups.wakeups_avoided( 1u );
+					}
+				else
+					{
+						const auto size = push_global( queue );
+						if( 0u != m_sleeping.load( std::memory_order_seq_cst ) )
+							try_wakeup_someone( size, true );
+						else
+							m_global_wakeups_avoided.fetch_add(
+									1u, std::memory_order_relaxed );
+					}
+			}
+
+		/*!
+		 * \brief Get the current values of wakeup counters.
+		 *
+		 * \since v.5.8.3
+		 */
+		[[nodiscard]]
+		so_5::disp::reuse::wakeup_stats_t
+		wakeup_stats() const noexcept
+			{
+				auto result = m_wakeup_counters.stats();
+				result.m_avoided += m_global_wakeups_avoided.load(
+						std::memory_order_relaxed );
+				for( std::size_t i = 0u; i != m_thread_count; ++i )
+					result.m_avoided += m_slots[ i ].m_wakeups.stats().m_avoided;
+
+				return result;
+			}
+
+		so_5::disp::mpmc_queue_traits::condition_unique_ptr_t
+		allocate_condition()
+			{
+				if( m_slots_in_use == m_thread_count )
+					SO_5_THROW_EXCEPTION( rc_unexpected_error,
+							"work_stealing_pool: too many worker threads" );
+
+				auto condition = m_lock->allocate_condition();
+				m_slots[ m_slots_in_use ].m_condition = condition.get();
+				++m_slots_in_use;
+
+				return condition;
+			}
+
+	private :
+		//! How often the global queue has to be checked first.
+		/*!
+		 * It prevents the starvation of the global queue when local
+		 * deques are always non-empty.
+		 */
+		static constexpr unsigned int global_queue_check_period = 61u;
+
+		//! Max count of consecutive pops from the back of the local deque.
+		/*!
+		 * It prevents the starvation of old items in the local deque.
+		 */
+		static constexpr unsigned int max_lifo_streak = 8u;
+
+		//! Object's lock.
+		/*!
+		 * Protects m_waiting_customers and m_wakeup_in_progress.
+		 */
+		so_5::disp::mpmc_queue_traits::lock_unique_ptr_t m_lock;
+
+		//! Shutdown flag.
+		std::atomic< bool > m_shutdown{ false };
+
+		//! Count of worker threads.
+		const std::size_t m_thread_count;
+
+		//! Threshold for wake up next working thread.
+		const std::size_t m_next_thread_wakeup_threshold;
+
+		//! Slots for worker threads.
+		std::unique_ptr< worker_slot_t[] > m_slots;
+
+		//! Count of slots already bound to worker threads.
+		std::size_t m_slots_in_use{};
+
+		//! Lock for the global injection queue.
+		alignas(64) spinlock_t m_global_lock;
+
+		//! The global injection queue.
+		agent_queue_deque_t m_global_queue;
+
+		//! The size of m_global_queue for checks without acquiring the lock.
+		std::atomic< std::size_t > m_global_size{ 0u };
+
+		//! Wakeups avoided by pushes to the global queue.
+		/*!
+		 * It's placed near m_global_lock because the cache line is
+		 * already modified by a producer.
+		 */
+		std::atomic< std::size_t > m_global_wakeups_avoided{ 0u };
+
+		//! Count of worker threads that are going to sleep or sleeping.
+		alignas(64) std::atomic< std::size_t > m_sleeping{ 0u };
+
+		//! Is some working thread in wakeup process now?
+		bool m_wakeup_in_progress{ false };
+
+		//! Counters of wakeups those are modified under m_lock.
+		so_5::disp::reuse::wakeup_counters_t m_wakeup_counters;
+
+		//! Waiting threads.
+		std::vector< so_5::disp::mpmc_queue_traits::condition_t * > m_waiting_customers;
+
+		//! Find the slot of the current worker thread.
+		[[nodiscard]]
+		worker_slot_t &
+		bind_current_worker(
+			so_5::disp::mpmc_queue_traits::condition_t & condition ) noexcept
+			{
+				if( this != t_current_worker.m_owner )
+					{
+						for( std::size_t i = 0u; i != m_slots_in_use; ++i )
+							if( &condition == m_slots[ i ].m_condition )
+								{
+									t_current_worker = current_worker_t{
+											this, &m_slots[ i ] };
+									break;
+								}
+					}
+
+				return *(t_current_worker.m_slot);
+			}
+
+		//! An attempt to find a ready agent queue without sleeping.
+		[[nodiscard]]
+		agent_queue_t *
+		find_work( worker_slot_t & slot ) noexcept
+			{
+				if( m_shutdown.load( std::memory_order_acquire ) )
+					return nullptr;
+
+				agent_queue_t * r = nullptr;
+
+				if( 0u == ( ++slot.m_ticks % global_queue_check_period ) )
+					r = pop_global();
+
+				if( !r )
+					r = pop_local( slot );
+				if( !r )
+					r = pop_global();
+				if( !r )
+					r = steal( slot );
+
+				return r;
+			}
+
+		//! Sleep until a ready agent queue appears or shutdown is initiated.
+		[[nodiscard]]
+		agent_queue_t *
+		wait_for_work(
+			worker_slot_t & slot,
+			so_5::disp::mpmc_queue_traits::condition_t & condition ) noexcept
+			{
+				std::lock_guard< so_5::disp::mpmc_queue_traits::lock_t > lock{ *m_lock };
+
+				m_sleeping.fetch_add( 1u, std::memory_order_seq_cst );
+
+				agent_queue_t * r = nullptr;
+				do
+					{
+						if( m_shutdown.load( std::memory_order_acquire ) )
+							break;
+
+						r = find_work( slot );
+						if( r )
+							{
+								m_sleeping.fetch_sub( 1u, std::memory_order_seq_cst );
+
+								// There could be more ready queues and sleeping workers.
+								if( !m_waiting_customers.empty() &&
+										!m_wakeup_in_progress &&
+										visible_work() > m_next_thread_wakeup_threshold )
+									pop_and_notify_one_waiting_customer();
+
+								return r;
+							}
+
+						// Exception safety note: there is no memory allocation here
+						// because m_waiting_customers is reserved in the constructor.
+						m_waiting_customers.push_back( &condition );
+
+						condition.wait();
+						// If we are here then the current wakeup procedure is
+						// finished.
+						m_wakeup_in_progress = false;
+					}
+				while( true );
+
+				m_sleeping.fetch_sub( 1u, std::memory_order_seq_cst );
+
+				return nullptr;
+			}
+
+		//! Wake up a sleeping worker if it's necessary and possible.
+		void
+		try_wakeup_someone(
+			std::size_t ready_queues,
+			bool all_may_sleep ) noexcept
+			{
+				std::lock_guard< so_5::disp::mpmc_queue_traits::lock_t > lock{ *m_lock };
+
+				if( !m_waiting_customers.empty() &&
+						!m_wakeup_in_progress &&
+						( ready_queues > m_next_thread_wakeup_threshold ||
+						( all_may_sleep &&
+							m_thread_count == m_waiting_customers.size() ) ) )
+					{
+						pop_and_notify_one_waiting_customer();
+						m_wakeup_counters.wakeup_issued();
+					}
+				else
+					m_wakeup_counters.wakeups_avoided( 1u );
+			}
+
+		void
+		pop_and_notify_one_waiting_customer() noexcept
+			{
+				auto & condition = *m_waiting_customers.back();
+				m_waiting_customers.pop_back();
+
+				m_wakeup_in_progress = true;
+				condition.notify();
+			}
+
+		//! Approximate count of ready agent queues.
+		[[nodiscard]]
+		std::size_t
+		visible_work() const noexcept
+			{
+				std::size_t r = m_global_size.load( std::memory_order_seq_cst );
+				for( std::size_t i = 0u; i != m_thread_count; ++i )
+					r += m_slots[ i ].m_size.load( std::memory_order_seq_cst );
+
+				return r;
+			}
+
+		//! Push a ready queue to the back of the local deque.
+		/*!
+		 * \return the new size of the local deque.
+		 */
+		std::size_t
+		push_local( worker_slot_t & slot, agent_queue_t * queue ) noexcept
+			{
+				std::lock_guard< spinlock_t > lock{ slot.m_lock };
+				slot.m_deque.push_back( queue );
+				slot.m_size.store( slot.m_deque.size(), std::memory_order_seq_cst );
+
+				return slot.m_deque.size();
+			}
+
+		//! Pop a ready queue from the local deque.
+		/*!
+		 * The back of the deque is used unless there were too many
+		 * consecutive pops from the back.
+		 */
+		[[nodiscard]]
+		agent_queue_t *
+		pop_local( worker_slot_t & slot ) noexcept
+			{
+				if( 0u == slot.m_size.load( std::memory_order_seq_cst ) )
+					return nullptr;
+
+				std::lock_guard< spinlock_t > lock{ slot.m_lock };
+
+				agent_queue_t * r;
+				if( slot.m_lifo_streak < max_lifo_streak )
+					{
+						r = slot.m_deque.pop_back();
+						++slot.m_lifo_streak;
+					}
+				else
+					{
+						r = slot.m_deque.pop_front();
+						slot.m_lifo_streak = 0u;
+					}
+				slot.m_size.store( slot.m_deque.size(), std::memory_order_seq_cst );
+
+				return r;
+			}
+
+		//! Pop the oldest ready queue from the local deque.
+		[[nodiscard]]
+		agent_queue_t *
+		pop_local_front( worker_slot_t & slot ) noexcept
+			{
+				if( 0u == slot.m_size.load( std::memory_order_seq_cst ) )
+					return nullptr;
+
+				std::lock_guard< spinlock_t > lock{ slot.m_lock };
+
+				auto * r = slot.m_deque.pop_front();
+				slot.m_size.store( slot.m_deque.size(), std::memory_order_seq_cst );
+
+				return r;
+			}
+
+		//! Push a ready queue to the global injection queue.
+		/*!
+		 * \return the new size of the global queue.
+		 */
+		std::size_t
+		push_global( agent_queue_t * queue ) noexcept
+			{
+				std::lock_guard< spinlock_t > lock{ m_global_lock };
+				m_global_queue.push_back( queue );
+				m_global_size.store( m_global_queue.size(), std::memory_order_seq_cst );
+
+				return m_global_queue.size();
+			}
+
+		//! Pop the oldest ready queue from the global injection queue.
+		[[nodiscard]]
+		agent_queue_t *
+		pop_global() noexcept
+			{
+				if( 0u == m_global_size.load( std::memory_order_seq_cst ) )
+					return nullptr;
+
+				std::lock_guard< spinlock_t > lock{ m_global_lock };
+
+				auto * r = m_global_queue.pop_front();
+				m_global_size.store( m_global_queue.size(), std::memory_order_seq_cst );
+
+				return r;
+			}
+
+		//! Steal the oldest ready queue from another worker.
+		/*!
+		 * Victims are checked starting from a random one.
+		 */
+		[[nodiscard]]
+		agent_queue_t *
+		steal( worker_slot_t & thief ) noexcept
+			{
+				const std::size_t first = thief.next_random() % m_thread_count;
+				for( std::size_t i = 0u; i != m_thread_count; ++i )
+					{
+						auto & victim = m_slots[ ( first + i ) % m_thread_count ];
+						if( &victim == &thief )
+							continue;
+
+						if( auto * r = pop_local_front( victim ) )
+							{
+								thief.m_lifo_streak = 0u;
+								return r;
+							}
+					}
+
+				return nullptr;
+			}
+	};
+
+inline void
+agent_queue_t::schedule_on_disp_queue() noexcept
+	{
+		m_disp_queue.schedule( this );
+	}
+
+//
+// adaptation_t
+//
+/*!
+ * \brief Adaptation of common implementation of thread-pool-like dispatcher
+ * to the specific of this dispatcher.
+ *
+ * \since v.5.8.3
+ */
+struct adaptation_t
+	{
+		[[nodiscard]]
+		static constexpr std::string_view
+		dispatcher_type_name() noexcept
+			{
+				return { "wsp" }; // work_stealing_pool.
+			}
+
+		[[nodiscard]]
+		static bool
+		is_individual_fifo( const bind_params_t & params ) noexcept
+			{
+				return fifo_t::individual == params.query_fifo();
+			}
+
+		static void
+		wait_for_queue_emptyness( agent_queue_t & queue ) noexcept
+			{
+				queue.wait_for_emptyness();
+			}
+	};
+
+//
+// dispatcher_template_t
+//
+/*!
+ * \brief Template for dispatcher.
+ *
+ * This template depends on work_thread type (with or without activity
+ * tracking).
+ *
+ * \since v.5.8.3
+ */
+template< typename Work_Thread >
+using dispatcher_template_t =
+		so_5::disp::thread_pool::common_implementation::dispatcher_t<
+				Work_Thread,
+				dispatcher_queue_t,
+				bind_params_t,
+				adaptation_t >;
+
+} /* namespace impl */
+
+} /* namespace work_stealing_pool */
+
+} /* namespace disp */
+
+} /* namespace so_5 */
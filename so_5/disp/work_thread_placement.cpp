@@ -0,0 +1,351 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \file
+ * \brief Placement policy for worker threads of dispatchers.
+ *
+ * \since v.5.8.3
+ */
+
+#include <so_5/disp/work_thread_placement.hpp>
+
+#include <so_5/details/rollback_on_exception.hpp>
+#include <so_5/details/suppress_exceptions.hpp>
+
+#include <so_5/detect_os.hpp>
+
+#if defined(SO_5_OS_LINUX)
+	#include <pthread.h>
+	#include <sched.h>
+#endif
+
+#include <fstream>
+#include <iterator>
+#include <sstream>
+
+namespace so_5::disp
+{
+
+namespace placement_details
+{
+
+namespace
+{
+
+#if defined(SO_5_OS_LINUX)
+
+/*!
+ * \brief Parse a list of CPUs in the Linux sysfs format.
+ *
+ * The format looks like `0-3,8-11,16`.
+ */
+[[nodiscard]]
+std::vector< unsigned int >
+parse_cpu_list( const std::string & list )
+	{
+		std::vector< unsigned int > result;
+
+		std::istringstream in{ list };
+		std::string range;
+		while( std::getline( in, range, ',' ) )
+			{
+				if( range.empty() || '\n' == range.front() )
+					continue;
+
+				const auto dash = range.find( '-' );
+				const unsigned long first = std::stoul( range.substr( 0u, dash ) );
+				const unsigned long last = std::string::npos == dash ?
+						first : std::stoul( range.substr( dash + 1u ) );
+
+				for( auto cpu = first; cpu <= last; ++cpu )
+					result.push_back( static_cast< unsigned int >( cpu ) );
+			}
+
+		return result;
+	}
+
+/*!
+ * \brief Read the whole content of a sysfs file.
+ *
+ * \return empty string if the file can't be read.
+ */
+[[nodiscard]]
+std::string
+read_sysfs_file( const std::string & file_name )
+	{
+		std::ifstream file{ file_name };
+		if( !file )
+			return {};
+
+		return std::string{
+				std::istreambuf_iterator< char >{ file },
+				std::istreambuf_iterator< char >{} };
+	}
+
+/*!
+ * \brief Get the list of online NUMA nodes.
+ *
+ * \return empty vector if the list isn't available.
+ */
+[[nodiscard]]
+std::vector< unsigned int >
+online_numa_nodes()
+	{
+		return parse_cpu_list(
+				read_sysfs_file( "/sys/devices/system/node/online" ) );
+	}
+
+/*!
+ * \brief Get the list of CPUs of a NUMA node.
+ *
+ * \return empty vector if the list isn't available.
+ */
+[[nodiscard]]
+std::vector< unsigned int >
+cpus_of_numa_node( unsigned int node )
+	{
+		return parse_cpu_list(
+				read_sysfs_file( "/sys/devices/system/node/node" +
+						std::to_string( node ) + "/cpulist" ) );
+	}
+
+//! Bind the current thread to the specified CPUs.
+void
+set_current_thread_affinity( const std::vector< unsigned int > & cpus )
+	{
+		if( cpus.empty() )
+			return;
+
+		cpu_set_t cpu_set;
+		CPU_ZERO( &cpu_set );
+		for( const auto cpu : cpus )
+			if( cpu < static_cast< unsigned int >( CPU_SETSIZE ) )
+				CPU_SET( cpu, &cpu_set );
+
+		// The result is ignored because the placement is just a hint.
+		(void)pthread_setaffinity_np( pthread_self(), sizeof(cpu_set), &cpu_set );
+	}
+
+//! Set the name for the current thread.
+void
+set_current_thread_name( const std::string & name )
+	{
+		// Linux allows only 15 characters (plus terminating 0).
+		const std::string actual_name = name.substr( 0u, 15u );
+
+		// The result is ignored because the name is just a hint.
+		(void)pthread_setname_np( pthread_self(), actual_name.c_str() );
+	}
+
+//! Detect CPUs to be used by a worker thread.
+[[nodiscard]]
+std::vector< unsigned int >
+detect_cpus(
+	const work_thread_placement_t & placement,
+	std::size_t thread_index )
+	{
+		switch( placement.kind() )
+			{
+			case work_thread_placement_kind_t::not_specified:
+			break;
+
+			case work_thread_placement_kind_t::cpu_set:
+				return placement.cpu_numbers();
+
+			case work_thread_placement_kind_t::spread_across_numa_nodes:
+				{
+					const auto nodes = online_numa_nodes();
+					if( !nodes.empty() )
+						return cpus_of_numa_node( nodes[ thread_index % nodes.size() ] );
+				}
+			break;
+
+			case work_thread_placement_kind_t::compact_on_numa_node:
+				return cpus_of_numa_node( placement.numa_node() );
+			}
+
+		return {};
+	}
+
+#endif
+
+//
+// placement_aware_work_thread_t
+//
+/*!
+ * \brief A wrapper around actual work thread that applies the placement.
+ *
+ * \since v.5.8.3
+ */
+class placement_aware_work_thread_t final : public abstract_work_thread_t
+	{
+		//! The actual thread.
+		abstract_work_thread_t & m_actual;
+
+		//! Placement to be applied.
+		const work_thread_placement_t m_placement;
+
+		//! Index of this thread.
+		const std::size_t m_thread_index;
+
+	public:
+		placement_aware_work_thread_t(
+			abstract_work_thread_t & actual,
+			work_thread_placement_t placement,
+			std::size_t thread_index )
+			:	m_actual{ actual }
+			,	m_placement{ std::move(placement) }
+			,	m_thread_index{ thread_index }
+			{}
+
+		[[nodiscard]]
+		abstract_work_thread_t &
+		actual() const noexcept { return m_actual; }
+
+		void
+		start( body_func_t thread_body ) override
+			{
+				m_actual.start(
+					[this, tb = std::move(thread_body)] {
+						m_placement.apply_to_current_thread( m_thread_index );
+						tb();
+					} );
+			}
+
+		void
+		join() override
+			{
+				m_actual.join();
+			}
+	};
+
+//
+// placement_aware_work_thread_factory_t
+//
+/*!
+ * \brief A wrapper around actual work thread factory that applies the
+ * placement for every thread.
+ *
+ * \since v.5.8.3
+ */
+class placement_aware_work_thread_factory_t final
+	:	public abstract_work_thread_factory_t
+	{
+		//! The actual factory.
+		const abstract_work_thread_factory_shptr_t m_actual_factory;
+
+		//! Placement to be applied.
+		const work_thread_placement_t m_placement;
+
+	public:
+		placement_aware_work_thread_factory_t(
+			abstract_work_thread_factory_shptr_t actual_factory,
+			work_thread_placement_t placement )
+			:	m_actual_factory{ std::move(actual_factory) }
+			,	m_placement{ std::move(placement) }
+			{}
+
+		[[nodiscard]]
+		abstract_work_thread_t &
+		acquire( so_5::environment_t & env ) override
+			{
+				auto & actual = m_actual_factory->acquire( env );
+
+				return *(so_5::details::do_with_rollback_on_exception(
+						[&] {
+							return new placement_aware_work_thread_t{
+									actual,
+									m_placement,
+									m_placement.next_thread_index()
+								};
+						},
+						[&] { m_actual_factory->release( actual ); } ) );
+			}
+
+		void
+		release( abstract_work_thread_t & thread ) noexcept override
+			{
+				// Assume that 'thread' was created via acquire() method.
+				auto * wrapper =
+						static_cast< placement_aware_work_thread_t * >( &thread );
+				m_actual_factory->release( wrapper->actual() );
+				delete wrapper;
+			}
+	};
+
+} /* namespace anonymous */
+
+} /* namespace placement_details */
+
+//
+// work_thread_placement_t
+//
+work_thread_placement_t
+work_thread_placement_t::cpus( std::vector< unsigned int > cpu_numbers )
+	{
+		work_thread_placement_t result;
+		result.m_kind = work_thread_placement_kind_t::cpu_set;
+		result.m_cpus = std::move(cpu_numbers);
+		result.ensure_thread_counter_exists();
+
+		return result;
+	}
+
+work_thread_placement_t
+work_thread_placement_t::spread_across_numa_nodes()
+	{
+		work_thread_placement_t result;
+		result.m_kind = work_thread_placement_kind_t::spread_across_numa_nodes;
+		result.ensure_thread_counter_exists();
+
+		return result;
+	}
+
+work_thread_placement_t
+work_thread_placement_t::compact_on_numa_node( unsigned int node )
+	{
+		work_thread_placement_t result;
+		result.m_kind = work_thread_placement_kind_t::compact_on_numa_node;
+		result.m_numa_node = node;
+		result.ensure_thread_counter_exists();
+
+		return result;
+	}
+
+void
+work_thread_placement_t::apply_to_current_thread(
+	[[maybe_unused]] std::size_t thread_index ) const noexcept
+	{
+#if defined(SO_5_OS_LINUX)
+		// All exceptions (like std::bad_alloc or an exception from parsing
+		// of sysfs content) are ignored because the placement is just a hint.
+		so_5::details::suppress_exceptions( [&] {
+				placement_details::set_current_thread_affinity(
+						placement_details::detect_cpus( *this, thread_index ) );
+
+				if( !m_thread_name.empty() )
+					placement_details::set_current_thread_name(
+							m_thread_name + "-" + std::to_string( thread_index ) );
+			} );
+#endif
+	}
+
+//
+// make_placement_aware_work_thread_factory
+//
+[[nodiscard]]
+SO_5_FUNC
+abstract_work_thread_factory_shptr_t
+make_placement_aware_work_thread_factory(
+	abstract_work_thread_factory_shptr_t actual_factory,
+	work_thread_placement_t placement )
+	{
+		return std::make_shared<
+				placement_details::placement_aware_work_thread_factory_t >(
+						std::move(actual_factory),
+						std::move(placement) );
+	}
+
+} /* namespace so_5::disp */
@@ -0,0 +1,249 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \file
+ * \brief Placement policy for worker threads of dispatchers.
+ *
+ * \since v.5.8.3
+ */
+
+#pragma once
+
+#include <so_5/disp/abstract_work_thread.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace so_5::disp
+{
+
+//
+// work_thread_placement_kind_t
+//
+/*!
+ * \brief Kind of placement for worker threads.
+ *
+ * \since v.5.8.3
+ */
+enum class work_thread_placement_kind_t
+	{
+		//! There is no restriction for CPUs to be used.
+		not_specified,
+		//! All worker threads are bound to the explicitly specified CPUs.
+		cpu_set,
+		//! Worker threads are bound to NUMA nodes in round-robin manner.
+		/*!
+		 * The first worker thread is bound to CPUs of node 0, the second
+		 * to CPUs of node 1, and so on.
+		 */
+		spread_across_numa_nodes,
+		//! All worker threads are bound to CPUs of the specified NUMA node.
+		compact_on_numa_node
+	};
+
+//
+// work_thread_placement_t
+//
+/*!
+ * \brief Placement policy for worker threads of a dispatcher.
+ *
+ * Describes CPUs a worker thread is allowed to run on and the name for
+ * the worker thread. The policy is applied by a worker thread itself
+ * before the start of its main loop. It means that all memory allocated
+ * by the worker thread for its own needs (like thread-local caches)
+ * will be allocated on the worker's NUMA node if the OS uses the
+ * first-touch memory policy.
+ *
+ * Usage example:
+ * \code
+ * using namespace so_5::disp;
+ *
+ * // All threads of the pool will work on CPUs of the first socket.
+ * auto disp = thread_pool::make_dispatcher( env, "pipeline",
+ * 	thread_pool::disp_params_t{}
+ * 		.thread_count( 8 )
+ * 		.work_thread_placement(
+ * 			work_thread_placement_t::compact_on_numa_node( 0 )
+ * 				.thread_name( "pipeline" ) ) );
+ * \endcode
+ *
+ * \note
+ * The placement is a hint. Errors during the applying of the placement
+ * (like wrong CPU numbers or absence of the specified NUMA node) are
+ * ignored.
+ *
+ * \note
+ * The current implementation binds threads to CPUs only on Linux. On
+ * other platforms only thread names are set (if it's supported by the
+ * platform).
+ *
+ * \attention
+ * If a custom work thread factory reuses threads then the placement of
+ * a thread remains in force after the return of the thread to the
+ * factory.
+ *
+ * \since v.5.8.3
+ */
+class SO_5_TYPE work_thread_placement_t
+	{
+	public :
+		//! Default constructor creates an empty placement.
+		work_thread_placement_t() = default;
+
+		//! Bind all worker threads to the specified CPUs.
+		[[nodiscard]]
+		static work_thread_placement_t
+		cpus( std::vector< unsigned int > cpu_numbers );
+
+		//! Bind worker threads to NUMA nodes in round-robin manner.
+		[[nodiscard]]
+		static work_thread_placement_t
+		spread_across_numa_nodes();
+
+		//! Bind all worker threads to CPUs of the specified NUMA node.
+		[[nodiscard]]
+		static work_thread_placement_t
+		compact_on_numa_node( unsigned int node );
+
+		//! Set the prefix for names of worker threads.
+		/*!
+		 * The name of a worker thread will be in the form `prefix-N`,
+		 * where N is the index of the worker thread.
+		 *
+		 * \note
+		 * The name can be truncated because of the OS limits (for example,
+		 * Linux allows only 15 characters).
+		 */
+		work_thread_placement_t &
+		thread_name( std::string prefix )
+			{
+				m_thread_name = std::move(prefix);
+				ensure_thread_counter_exists();
+				return *this;
+			}
+
+		//! Kind of the placement.
+		[[nodiscard]]
+		work_thread_placement_kind_t
+		kind() const noexcept { return m_kind; }
+
+		//! CPUs for work_thread_placement_kind_t::cpu_set.
+		[[nodiscard]]
+		const std::vector< unsigned int > &
+		cpu_numbers() const noexcept { return m_cpus; }
+
+		//! Node for work_thread_placement_kind_t::compact_on_numa_node.
+		[[nodiscard]]
+		unsigned int
+		numa_node() const noexcept { return m_numa_node; }
+
+		//! Prefix for names of worker threads.
+		/*!
+		 * An empty string means that names aren't set.
+		 */
+		[[nodiscard]]
+		const std::string &
+		thread_name() const noexcept { return m_thread_name; }
+
+		//! Does this object specify something?
+		[[nodiscard]]
+		bool
+		empty() const noexcept
+			{
+				return work_thread_placement_kind_t::not_specified == m_kind &&
+						m_thread_name.empty();
+			}
+
+		//! Get the index for the next worker thread.
+		/*!
+		 * The counter is shared between all copies of the placement object.
+		 * It allows to spread threads of several dispatchers created with
+		 * the same parameters.
+		 */
+		[[nodiscard]]
+		std::size_t
+		next_thread_index() const noexcept
+			{
+				return m_thread_counter ?
+						m_thread_counter->fetch_add( 1u, std::memory_order_relaxed ) :
+						0u;
+			}
+
+		//! Apply the placement to the current thread.
+		/*!
+		 * \note
+		 * All errors are ignored.
+		 */
+		void
+		apply_to_current_thread( std::size_t thread_index ) const noexcept;
+
+		friend void
+		swap( work_thread_placement_t & a, work_thread_placement_t & b ) noexcept
+			{
+				using std::swap;
+				swap( a.m_kind, b.m_kind );
+				swap( a.m_cpus, b.m_cpus );
+				swap( a.m_numa_node, b.m_numa_node );
+				swap( a.m_thread_name, b.m_thread_name );
+				swap( a.m_thread_counter, b.m_thread_counter );
+			}
+
+	private :
+		//! Kind of the placement.
+		work_thread_placement_kind_t m_kind{
+				work_thread_placement_kind_t::not_specified };
+
+		//! CPUs for work_thread_placement_kind_t::cpu_set.
+		std::vector< unsigned int > m_cpus;
+
+		//! Node for work_thread_placement_kind_t::compact_on_numa_node.
+		unsigned int m_numa_node{};
+
+		//! Prefix for names of worker threads.
+		std::string m_thread_name;
+
+		//! Counter for indexes of worker threads.
+		/*!
+		 * \note
+		 * It's created on the first call to thread_name() or to
+		 * a static factory method.
+		 */
+		std::shared_ptr< std::atomic< std::size_t > > m_thread_counter;
+
+		void
+		ensure_thread_counter_exists()
+			{
+				if( !m_thread_counter )
+					m_thread_counter =
+							std::make_shared< std::atomic< std::size_t > >( 0u );
+			}
+	};
+
+//
+// make_placement_aware_work_thread_factory
+//
+/*!
+ * \brief Create a work thread factory that applies placement to threads
+ * obtained from another factory.
+ *
+ * Every thread acquired from the resulting factory gets its own index
+ * from work_thread_placement_t::next_thread_index() and applies the
+ * placement just before the execution of the thread body.
+ *
+ * \since v.5.8.3
+ */
+[[nodiscard]]
+SO_5_FUNC
+abstract_work_thread_factory_shptr_t
+make_placement_aware_work_thread_factory(
+	//! Factory for actual threads.
+	abstract_work_thread_factory_shptr_t actual_factory,
+	//! Placement to be applied.
+	work_thread_placement_t placement );
+
+} /* namespace so_5::disp */
@@ -98,5 +98,42 @@ class disp_binder_t
 //! Typedef for the disp_binder smart pointer.
 using disp_binder_shptr_t = std::shared_ptr< disp_binder_t >;
 
+//
+// transfer_queue_provider_t
+//
+
+//! An optional interface for dispatcher binders those can accept
+//! agents migrated from other dispatchers.
+/*!
+ * An already working agent can be moved to another dispatcher by
+ * agent_t::so_migrate_to_dispatcher(). The binder for the new dispatcher
+ * must implement this interface in addition to disp_binder_t.
+ *
+ * All standard dispatchers implement this interface.
+ *
+ * \since v.5.8.3
+ */
+class transfer_queue_provider_t
+{
+	public:
+		virtual ~transfer_queue_provider_t() noexcept = default;
+
+		//! Bind an already working agent to dispatcher.
+		/*!
+		 * This method is called instead of disp_binder_t::bind() after
+		 * disp_binder_t::preallocate_resources(). Unlike bind() it must not
+		 * call agent_t::so_bind_to_dispatcher() because the agent is
+		 * already started. The event queue for the agent should be returned
+		 * instead.
+		 *
+		 * Agent will be unbound by the usual disp_binder_t::unbind() call.
+		 */
+		[[nodiscard]]
+		virtual event_queue_t &
+		bind_transferred(
+			//! Agent for that previous preallocate_resources() was called.
+			agent_t & agent ) noexcept = 0;
+};
+
 } /* namespace so_5 */
 
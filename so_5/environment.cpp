@@ -66,6 +66,7 @@ environment_params_t::environment_params_t(
 	,	m_event_queue_hook( std::move(other.m_event_queue_hook) )
 	,	m_work_thread_factory( std::move(other.m_work_thread_factory) )
 	,	m_default_subscription_storage_factory( std::move(other.m_default_subscription_storage_factory) )
+	,	m_message_pool_params( std::move(other.m_message_pool_params) )
 {}
 
 environment_params_t::~environment_params_t()
@@ -111,6 +112,8 @@ swap( environment_params_t & a, environment_params_t & b ) noexcept
 	swap( a.m_work_thread_factory, b.m_work_thread_factory );
 
 	swap( a.m_default_subscription_storage_factory, b.m_default_subscription_storage_factory );
+
+	swap( a.m_message_pool_params, b.m_message_pool_params );
 }
 
 environment_params_t &
@@ -496,7 +499,10 @@ struct environment_t::internals_t
 		,	m_default_subscription_storage_factory{
 				ensure_subscription_storage_factory_exists(
 					params.default_subscription_storage_factory() ) }
-	{}
+	{
+		if( const auto & pool_params = params.message_pool_params() )
+			impl::message_pool::enable( *pool_params );
+	}
 };
 
 //
@@ -533,6 +539,13 @@ environment_t::create_mbox(
 	return m_impl->m_mbox_core->create_mbox( *this, std::move(nonempty_name) );
 }
 
+mbox_t
+environment_t::create_mbox(
+	const named_mbox_handle_t & handle )
+{
+	return m_impl->m_mbox_core->create_mbox( *this, handle );
+}
+
 mbox_t
 environment_t::introduce_named_mbox(
 	mbox_namespace_name_t mbox_namespace,
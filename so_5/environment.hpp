@@ -20,12 +20,15 @@
 #include <so_5/event_exception_logger.hpp>
 #include <so_5/event_queue_hook.hpp>
 #include <so_5/exception.hpp>
+#include <so_5/fwd.hpp>
 #include <so_5/mbox.hpp>
 #include <so_5/mbox_namespace_name.hpp>
 #include <so_5/mchain.hpp>
 #include <so_5/message.hpp>
+#include <so_5/message_pool.hpp>
 #include <so_5/msg_tracing.hpp>
 #include <so_5/nonempty_name.hpp>
+#include <so_5/optional.hpp>
 #include <so_5/queue_locks_defaults_manager.hpp>
 #include <so_5/so_layer.hpp>
 #include <so_5/stop_guard.hpp>
@@ -662,6 +665,47 @@ class SO_5_TYPE environment_params_t
 				return m_default_subscription_storage_factory;
 			}
 
+		/*!
+		 * \brief Turn the pooled allocation of message instances on.
+		 *
+		 * Usage example:
+		 * \code
+		 * so_5::launch( [](so_5::environment_t & env) {...},
+		 * 	[](so_5::environment_params_t & params) {
+		 * 		params.message_pool( so_5::message_pool_params_t{}
+		 * 			.thread_cache_capacity( 1024u ) );
+		 * 	} );
+		 * \endcode
+		 *
+		 * \attention
+		 * The pool is a process-wide entity. Once it is turned on by
+		 * an environment it remains turned on until the end of the process.
+		 * See message_pool_params_t for more details.
+		 *
+		 * \since v.5.8.3
+		 */
+		environment_params_t &
+		message_pool( message_pool_params_t params )
+			{
+				m_message_pool_params = std::move(params);
+				return *this;
+			}
+
+		/*!
+		 * \brief Get the parameters for the message pool.
+		 *
+		 * \note
+		 * An empty value means that the message pool isn't turned on
+		 * by this environment.
+		 *
+		 * \since v.5.8.3
+		 */
+		[[nodiscard]] const optional< message_pool_params_t > &
+		message_pool_params() const noexcept
+			{
+				return m_message_pool_params;
+			}
+
 		/*!
 		 * \name Methods for internal use only.
 		 * \{
@@ -883,6 +927,17 @@ class SO_5_TYPE environment_params_t
 		 * \since v.5.8.2
 		 */
 		subscription_storage_factory_t m_default_subscription_storage_factory;
+
+		/*!
+		 * \brief Parameters for the message pool.
+		 *
+		 * \note
+		 * It can be empty. It means that the message pool isn't turned on
+		 * by this environment.
+		 *
+		 * \since v.5.8.3
+		 */
+		optional< message_pool_params_t > m_message_pool_params;
 };
 
 //
@@ -1043,6 +1098,24 @@ class SO_5_TYPE environment_t
 			//! Mbox name.
 			nonempty_name_t mbox_name );
 
+		//! Create named MPMC mbox by using a handle with precomputed
+		//! hash of the name.
+		/*!
+		 * It's the same as create_mbox(nonempty_name_t) but the hash of
+		 * the name isn't calculated.
+		 *
+		 * \note
+		 * Usually named_mbox_handle_t::resolve() is used instead of this
+		 * method because resolve() caches the result.
+		 *
+		 * \since v.5.8.3
+		 */
+		[[nodiscard]]
+		mbox_t
+		create_mbox(
+			//! Handle with the name of mbox.
+			const named_mbox_handle_t & handle );
+
 		/*!
 		 * \brief Introduce named mbox with user-provided factory.
 		 *
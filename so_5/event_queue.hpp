@@ -81,6 +81,35 @@ class SO_5_TYPE event_queue_t
 		 */
 		virtual void
 		push_evt_finish( execution_demand_t demand ) noexcept = 0;
+
+		/*!
+		 * \brief Enqueue several demands at once.
+		 *
+		 * This method is used for delivery of a batch of messages
+		 * (see so_5::send_batch()). Demands have to be appended to the
+		 * queue in the same order. An implementation is expected to do that
+		 * under a single acquisition of the queue's lock.
+		 *
+		 * The default implementation just calls push() for every demand.
+		 *
+		 * \note
+		 * This method can throw and it's expected. An implementation
+		 * should provide the strong exception guarantee: either all
+		 * demands are enqueued or none of them. The default implementation
+		 * provides only the basic guarantee.
+		 *
+		 * \since v.5.8.3
+		 */
+		virtual void
+		push_batch(
+			//! Demands to be enqueued. They can be moved-from after the call.
+			execution_demand_t * demands,
+			//! Count of demands.
+			std::size_t count )
+			{
+				for( std::size_t i = 0u; i != count; ++i )
+					this->push( std::move( demands[ i ] ) );
+			}
 	};
 
 } /* namespace so_5 */
@@ -12,12 +12,16 @@
 
 #pragma once
 
+#include <so_5/declspec.hpp>
 #include <so_5/types.hpp>
 #include <so_5/current_thread_id.hpp>
 
 #include <so_5/fwd.hpp>
 
 #include <so_5/message.hpp>
+#include <so_5/message_type_id.hpp>
+
+#include <so_5/details/inplace_function.hpp>
 
 namespace so_5
 {
@@ -30,8 +34,17 @@ namespace so_5
  * v.5.3.0
  *
  * \brief Type of event handler method.
+ *
+ * \note
+ * Since v.5.8.3 it isn't std::function anymore. It's a type-erased
+ * callable with an inline buffer big enough for the wrappers created
+ * for member-function and lambda handlers. It means that subscription
+ * and copying of handlers between subscription storages don't require
+ * memory allocations in the most of cases.
  */
-using event_handler_method_t = std::function< void(message_ref_t &) >;
+using event_handler_method_t = details::inplace_function_t<
+		void(message_ref_t &),
+		6u * sizeof(void *) >;
 
 struct execution_demand_t;
 
@@ -67,6 +80,13 @@ struct execution_demand_t
 	mbox_id_t m_mbox_id;
 	//! Type of the message.
 	std::type_index m_msg_type;
+	//! Dense ID of the message type.
+	/*!
+	 * This ID is used for the search of an event handler.
+	 *
+	 * \since v.5.8.3
+	 */
+	message_type_id_t m_msg_type_id;
 	//! Event incident.
 	message_ref_t m_message_ref;
 	//! Demand handler.
@@ -78,6 +98,7 @@ struct execution_demand_t
 		,	m_limit( nullptr )
 		,	m_mbox_id( 0 )
 		,	m_msg_type( typeid(void) )
+		,	m_msg_type_id()
 		,	m_demand_handler( nullptr )
 		{}
 
@@ -92,6 +113,30 @@ struct execution_demand_t
 		,	m_limit( limit )
 		,	m_mbox_id( mbox_id )
 		,	m_msg_type( msg_type )
+		,	m_msg_type_id( message_type_id_for( msg_type ) )
+		,	m_message_ref( std::move( message_ref ) )
+		,	m_demand_handler( demand_handler )
+		{}
+
+	/*!
+	 * \brief Initializing constructor for the case when the dense ID
+	 * of message type is already known.
+	 *
+	 * \since v.5.8.3
+	 */
+	execution_demand_t(
+		agent_t * receiver,
+		const message_limit::control_block_t * limit,
+		mbox_id_t mbox_id,
+		std::type_index msg_type,
+		message_type_id_t msg_type_id,
+		message_ref_t message_ref,
+		demand_handler_pfn_t demand_handler ) noexcept
+		:	m_receiver( receiver )
+		,	m_limit( limit )
+		,	m_mbox_id( mbox_id )
+		,	m_msg_type( msg_type )
+		,	m_msg_type_id( msg_type_id )
 		,	m_message_ref( std::move( message_ref ) )
 		,	m_demand_handler( demand_handler )
 		{}
@@ -124,38 +169,23 @@ struct execution_demand_t
  * - empty. In that case an invocation of exec() method will only
  *   decrement message limit counter and nothing more.
  *
+ * \note
+ * Since v.5.8.3 the hint doesn't use std::function inside.
+ * It holds a pointer to the event handler found for the demand and
+ * a kind of the demand. So the creation of a hint is just
+ * a search for the event handler.
+ *
  * \since v.5.4.0
  */
 class execution_hint_t
 {
-public :
-	//! Type of function for calling event handler directly.
-	using direct_func_t = std::function<
-				void( execution_demand_t &, current_thread_id_t ) >;
-
-	//! Initializing constructor.
-	execution_hint_t(
-		execution_demand_t & demand,
-		direct_func_t direct_func,
-		thread_safety_t thread_safety )
-		:	m_demand( demand )
-		,	m_direct_func( std::move( direct_func ) )
-		,	m_thread_safety( thread_safety )
-		{}
+	friend class agent_t;
 
+public :
 	//! Call event handler directly.
+	SO_5_FUNC
 	void
-	exec( current_thread_id_t working_thread_id ) const
-		{
-			// If message limit is defined then message count
-			// must be decremented.
-			message_limit::control_block_t::decrement( m_demand.m_limit );
-
-			// Now demand can be handled.
-			if( m_direct_func )
-				m_direct_func( m_demand, is_thread_safe() ?
-						null_current_thread_id() : working_thread_id );
-		}
+	exec( current_thread_id_t working_thread_id ) const;
 
 	//! Is thread safe handler?
 	bool
@@ -177,20 +207,64 @@ public :
 		}
 
 private :
+	/*!
+	 * \brief Kind of the demand for that the hint has been created.
+	 *
+	 * \since v.5.8.3
+	 */
+	enum class demand_kind_t
+		{
+			//! There is no handler for the demand.
+			no_handler,
+			//! An ordinary message or signal with a handler found.
+			message,
+			//! Enveloped message. A handler can be missing.
+			enveloped_msg,
+			//! A special demand (like evt_start or evt_finish) that has
+			//! to be processed by execution_demand_t::call_handler().
+			special
+		};
+
 	//! A reference to demand for which that hint has been created.
 	execution_demand_t & m_demand;
 
-	//! Function for call event handler directly.
-	direct_func_t m_direct_func;
+	//! Kind of the demand.
+	/*!
+	 * \since v.5.8.3
+	 */
+	demand_kind_t m_kind;
+
+	//! Event handler for the demand.
+	/*!
+	 * Can be nullptr for demand_kind_t::enveloped_msg and
+	 * is always nullptr for demand_kind_t::no_handler and
+	 * demand_kind_t::special.
+	 *
+	 * \since v.5.8.3
+	 */
+	const impl::event_handler_data_t * m_handler;
 
 	//! Thread safety for event handler.
 	thread_safety_t m_thread_safety;
 
+	//! Initializing constructor.
+	execution_hint_t(
+		execution_demand_t & demand,
+		demand_kind_t kind,
+		const impl::event_handler_data_t * handler,
+		thread_safety_t thread_safety ) noexcept
+		:	m_demand( demand )
+		,	m_kind( kind )
+		,	m_handler( handler )
+		,	m_thread_safety( thread_safety )
+		{}
+
 	//! A special constructor for the case when there is no
 	//! handler for message.
-	execution_hint_t( execution_demand_t & demand )
+	execution_hint_t( execution_demand_t & demand ) noexcept
 		:	m_demand( demand )
-		,	m_direct_func()
+		,	m_kind( demand_kind_t::no_handler )
+		,	m_handler( nullptr )
 		,	m_thread_safety( thread_safe )
 		{}
 
@@ -200,7 +274,7 @@ public :
 	//! Is event handler defined for the demand?
 	operator bool() const
 		{
-			return static_cast< bool >(m_direct_func);
+			return demand_kind_t::no_handler != m_kind;
 		}
 #endif
 };
@@ -28,6 +28,9 @@ class internal_agent_iface_t;
 class layer_core_t;
 class state_switch_guard_t;
 class sinks_storage_t;
+struct resolved_handlers_t;
+class resolved_handler_cache_t;
+class agent_migration_t;
 
 } /* namespace impl */
 
@@ -37,6 +40,7 @@ class coop_dereg_reason_t;
 class state_t;
 class environment_t;
 class environment_params_t;
+class named_mbox_handle_t;
 class coop_t;
 class agent_t;
 
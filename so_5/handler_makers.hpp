@@ -228,7 +228,7 @@ make_handler_with_arg( Handler_Type lambda )
 
 		return msg_type_and_handler_pair_t{
 				arg_maker::traits_type::subscription_type_index(),
-				method,
+				std::move(method),
 				arg_maker::traits_type::mutability() };
 	}
 
@@ -289,7 +289,7 @@ make_handler_with_arg_for_agent(
 
 		return msg_type_and_handler_pair_t{
 				arg_maker::traits_type::subscription_type_index(),
-				method,
+				std::move(method),
 				arg_maker::traits_type::mutability() };
 	}
 
@@ -0,0 +1,185 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \file
+ * \brief Helpers for migration of an agent to another dispatcher.
+ *
+ * \since v.5.8.3
+ */
+
+#pragma once
+
+#include <so_5/event_queue.hpp>
+#include <so_5/disp_binder.hpp>
+#include <so_5/message.hpp>
+
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+
+namespace so_5
+{
+
+namespace impl
+{
+
+//
+// msg_release_old_binder_t
+//
+/*!
+ * \brief A message for the first demand on the new dispatcher.
+ *
+ * It holds the binder of the old dispatcher. The old binder is
+ * released (by a call to disp_binder_t::unbind()) when this demand
+ * is handled on the new dispatcher. It's safe because the agent
+ * has no demands on the old dispatcher at this moment.
+ *
+ * \since v.5.8.3
+ */
+struct msg_release_old_binder_t final : public message_t
+	{
+		const disp_binder_shptr_t m_binder;
+
+		msg_release_old_binder_t( disp_binder_shptr_t binder )
+			:	m_binder{ std::move(binder) }
+			{}
+	};
+
+//
+// agent_migration_t
+//
+/*!
+ * \brief State of a migration of an agent to another dispatcher.
+ *
+ * This object is used as the agent's event queue while the migration
+ * is in progress. All new demands are collected inside it until all
+ * demands from the old event queue are handled. Then they are passed
+ * to the new event queue in the original order.
+ *
+ * \since v.5.8.3
+ */
+class agent_migration_t final : public event_queue_t
+	{
+	public :
+		agent_migration_t(
+			//! The actual event queue on the old dispatcher.
+			event_queue_t & old_queue,
+			//! The binder of the old dispatcher.
+			disp_binder_shptr_t old_binder )
+			:	m_old_queue{ old_queue }
+			,	m_release_msg{
+					std::make_unique< msg_release_old_binder_t >(
+							std::move(old_binder) ) }
+			{}
+
+		void
+		push( execution_demand_t demand ) override
+			{
+				std::lock_guard< std::mutex > lock{ m_lock };
+				m_delayed.push_back( std::move(demand) );
+			}
+
+		void
+		push_evt_start( execution_demand_t demand ) override
+			{
+				// Isn't expected to be called because the agent is
+				// already started. But handle it just in case.
+				this->push( std::move(demand) );
+			}
+
+		void
+		push_evt_finish( execution_demand_t demand ) noexcept override
+			{
+				std::lock_guard< std::mutex > lock{ m_lock };
+				m_delayed_finish = std::move(demand);
+			}
+
+		void
+		push_batch(
+			execution_demand_t * demands,
+			std::size_t count ) override
+			{
+				std::lock_guard< std::mutex > lock{ m_lock };
+				m_delayed.insert( m_delayed.end(),
+						std::make_move_iterator( demands ),
+						std::make_move_iterator( demands + count ) );
+			}
+
+		[[nodiscard]]
+		event_queue_t &
+		old_queue() const noexcept { return m_old_queue; }
+
+		[[nodiscard]]
+		event_queue_t &
+		new_queue() const noexcept { return *m_new_queue; }
+
+		void
+		set_new_queue( event_queue_t & queue ) noexcept
+			{
+				m_new_queue = &queue;
+			}
+
+		//! Pass all collected demands to the new event queue.
+		/*!
+		 * The first demand in the new event queue will be the demand
+		 * for releasing of the old binder.
+		 *
+		 * \retval true if evt_finish was pushed to the new event queue.
+		 */
+		[[nodiscard]]
+		bool
+		flush_to_new_queue(
+			//! The demand for releasing of the old binder.
+			//! The message for it will be set here.
+			execution_demand_t release_demand )
+			{
+				std::lock_guard< std::mutex > lock{ m_lock };
+
+				release_demand.m_message_ref = message_ref_t{
+						m_release_msg.release() };
+				m_new_queue->push( std::move(release_demand) );
+
+				for( auto & d : m_delayed )
+					m_new_queue->push( std::move(d) );
+				m_delayed.clear();
+
+				if( m_delayed_finish )
+					{
+						m_new_queue->push_evt_finish(
+								std::move(*m_delayed_finish) );
+						return true;
+					}
+
+				return false;
+			}
+
+	private :
+		//! The actual event queue on the old dispatcher.
+		event_queue_t & m_old_queue;
+
+		//! The actual event queue on the new dispatcher.
+		event_queue_t * m_new_queue{ nullptr };
+
+		//! The message for the demand for releasing the old binder.
+		/*!
+		 * It's created in advance because it should be sent
+		 * in a noexcept context.
+		 */
+		std::unique_ptr< msg_release_old_binder_t > m_release_msg;
+
+		//! The lock for the collected demands.
+		std::mutex m_lock;
+
+		//! Demands collected during the migration.
+		std::deque< execution_demand_t > m_delayed;
+
+		//! The evt_finish demand if it was pushed during the migration.
+		std::optional< execution_demand_t > m_delayed_finish;
+	};
+
+} /* namespace impl */
+
+} /* namespace so_5 */
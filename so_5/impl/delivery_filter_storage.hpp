@@ -13,6 +13,7 @@
 #pragma once
 
 #include <so_5/mbox.hpp>
+#include <so_5/message_type_id.hpp>
 
 #include <so_5/compiler_features.hpp>
 
@@ -43,25 +44,42 @@ namespace impl {
 class delivery_filter_storage_t
 	{
 		//! Type of key for filters map.
+		/*!
+		 * \note
+		 * Since v.5.8.3 the key contains only IDs of mbox and
+		 * message type. References to mbox and message type are
+		 * stored in value_t.
+		 */
 		struct key_t
 			{
-				//! Message mbox.
-				mbox_t m_mbox;
-				//! Message type.
-				std::type_index m_msg_type;
+				//! ID of message mbox.
+				mbox_id_t m_mbox_id;
+				//! ID of message type.
+				message_type_id_t m_msg_type;
 
 				bool
-				operator<( const key_t & o ) const
+				operator<( const key_t & o ) const noexcept
 					{
-						const auto id_a = m_mbox->id();
-						const auto id_b = o.m_mbox->id();
-						return id_a < id_b || ( id_a == id_b && m_msg_type < o.m_msg_type );
+						return m_mbox_id < o.m_mbox_id ||
+								( m_mbox_id == o.m_mbox_id && m_msg_type < o.m_msg_type );
 					}
 			};
 
 		//! Type of value for filters map.
 		struct value_t
 			{
+				//! Message mbox.
+				/*!
+				 * \since v.5.8.3
+				 */
+				mbox_t m_mbox;
+
+				//! Message type.
+				/*!
+				 * \since v.5.8.3
+				 */
+				std::type_index m_msg_type;
+
 				//! Delivery filter.
 				/*!
 				 * @note
@@ -81,9 +99,13 @@ class delivery_filter_storage_t
 				std::reference_wrapper< abstract_message_sink_t > m_sink;
 
 				value_t(
+					mbox_t mbox,
+					std::type_index msg_type,
 					delivery_filter_unique_ptr_t filter,
 					so_5::outliving_reference_t< abstract_message_sink_t > sink )
-					:	m_filter{ std::move(filter) }
+					:	m_mbox{ std::move(mbox) }
+					,	m_msg_type{ msg_type }
+					,	m_filter{ std::move(filter) }
 					,	m_sink{ sink.get() }
 					{}
 			};
@@ -103,7 +125,7 @@ class delivery_filter_storage_t
 		drop_all() noexcept
 			{
 				for( auto & [k, v] : m_filters )
-					k.m_mbox->drop_delivery_filter( k.m_msg_type, v.m_sink.get() );
+					v.m_mbox->drop_delivery_filter( v.m_msg_type, v.m_sink.get() );
 
 				m_filters.clear();
 			}
@@ -119,7 +141,7 @@ class delivery_filter_storage_t
 			delivery_filter_unique_ptr_t filter,
 			so_5::outliving_reference_t< abstract_message_sink_t > owner )
 			{
-				const key_t key{ mbox, msg_type };
+				const key_t key{ mbox->id(), message_type_id_for( msg_type ) };
 				auto it = m_filters.find( key );
 				if( it == m_filters.end() )
 					{
@@ -128,6 +150,8 @@ class delivery_filter_storage_t
 						auto ins_result = m_filters.emplace(
 								key,
 								value_t{
+										mbox,
+										msg_type,
 										std::move( filter ),
 										owner
 								} );
@@ -148,7 +172,7 @@ class delivery_filter_storage_t
 					{
 						// Replace previous filter with new one.
 						value_t old_value{ std::move(it->second) };
-						it->second = value_t{ std::move( filter ), owner };
+						it->second = value_t{ mbox, msg_type, std::move( filter ), owner };
 
 						// Mbox must change delivery filter too.
 						so_5::details::do_with_rollback_on_exception(
@@ -170,7 +194,8 @@ class delivery_filter_storage_t
 			const mbox_t & mbox,
 			const std::type_index & msg_type ) noexcept
 			{
-				auto it = m_filters.find( key_t{ mbox, msg_type } );
+				auto it = m_filters.find(
+						key_t{ mbox->id(), message_type_id_for( msg_type ) } );
 				if( it != m_filters.end() )
 					{
 						mbox->drop_delivery_filter(
@@ -0,0 +1,371 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \file
+ * \brief Epoch-based reclamation of objects shared between threads.
+ *
+ * \since v.5.8.3
+ */
+
+#include <so_5/impl/epoch_reclamation.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace so_5
+{
+
+namespace impl
+{
+
+namespace epoch_reclamation
+{
+
+namespace
+{
+
+//! Value of epoch for a thread which is outside of read-side sections.
+constexpr std::uint64_t quiescent_epoch = 0u;
+
+//
+// thread_record_t
+//
+/*!
+ * \brief Information about a thread which uses read-side sections.
+ *
+ * Every record occupies its own cache line. Records are never deleted,
+ * a record of a finished thread is reused by new threads.
+ */
+struct alignas(64) thread_record_t
+	{
+		//! Epoch at the entry to the outermost read-side section.
+		/*!
+		 * It's quiescent_epoch if the thread is outside of read-side sections.
+		 */
+		std::atomic< std::uint64_t > m_epoch{ quiescent_epoch };
+
+		//! Nesting level of read-side sections.
+		/*!
+		 * Is modified only by the owner thread.
+		 */
+		unsigned int m_nesting{};
+
+		//! Is this record owned by some thread?
+		std::atomic< bool > m_in_use{ true };
+
+		//! Next record in the list of all records.
+		thread_record_t * m_next{ nullptr };
+	};
+
+//
+// retired_object_t
+//
+//! Description of a retired object.
+struct retired_object_t
+	{
+		void * m_object;
+		deleter_t m_deleter;
+
+		//! Value of the global epoch at the moment of retirement.
+		std::uint64_t m_epoch;
+	};
+
+//
+// domain_t
+//
+/*!
+ * \brief The global state of epoch-based reclamation.
+ */
+class domain_t
+	{
+	public :
+		[[nodiscard]]
+		thread_record_t *
+		acquire_record()
+			{
+				// Try to reuse a record of a finished thread.
+				for( auto * r = m_records.load( std::memory_order_acquire );
+						r; r = r->m_next )
+					{
+						bool expected = false;
+						if( !r->m_in_use.load( std::memory_order_relaxed ) &&
+								r->m_in_use.compare_exchange_strong(
+										expected, true,
+										std::memory_order_acquire ) )
+							return r;
+					}
+
+				auto * r = new thread_record_t{};
+				auto * head = m_records.load( std::memory_order_relaxed );
+				do
+					{
+						r->m_next = head;
+					}
+				while( !m_records.compare_exchange_weak(
+						head, r,
+						std::memory_order_release,
+						std::memory_order_relaxed ) );
+
+				return r;
+			}
+
+		static void
+		release_record( thread_record_t * r ) noexcept
+			{
+				r->m_nesting = 0u;
+				r->m_epoch.store( quiescent_epoch, std::memory_order_release );
+				r->m_in_use.store( false, std::memory_order_release );
+			}
+
+		void
+		enter( thread_record_t & r ) noexcept
+			{
+				if( 0u == r.m_nesting++ )
+					{
+						r.m_epoch.store(
+								m_global_epoch.load( std::memory_order_seq_cst ),
+								std::memory_order_relaxed );
+						// The announcement has to be visible for writers
+						// before any read of shared pointers.
+						std::atomic_thread_fence( std::memory_order_seq_cst );
+					}
+			}
+
+		static void
+		leave( thread_record_t & r ) noexcept
+			{
+				if( 0u == --r.m_nesting )
+					r.m_epoch.store( quiescent_epoch, std::memory_order_release );
+			}
+
+		void
+		retire( void * object, deleter_t deleter )
+			{
+				std::lock_guard< std::mutex > lock{ m_retired_lock };
+
+				m_retired.push_back( retired_object_t{
+						object,
+						deleter,
+						advance_epoch()
+					} );
+
+				reclaim_unlocked();
+			}
+
+		void
+		synchronize( const thread_record_t * current ) noexcept
+			{
+				const auto epoch = advance_epoch();
+				std::atomic_thread_fence( std::memory_order_seq_cst );
+
+				for( auto * r = m_records.load( std::memory_order_acquire );
+						r; r = r->m_next )
+					{
+						if( r == current )
+							continue;
+
+						for(;;)
+							{
+								const auto e = r->m_epoch.load(
+										std::memory_order_seq_cst );
+								if( quiescent_epoch == e || e > epoch )
+									break;
+
+								std::this_thread::yield();
+							}
+					}
+
+				try_reclaim();
+			}
+
+		void
+		try_reclaim() noexcept
+			{
+				std::lock_guard< std::mutex > lock{ m_retired_lock };
+				reclaim_unlocked();
+			}
+
+	private :
+		//! List of all thread records.
+		std::atomic< thread_record_t * > m_records{ nullptr };
+
+		//! The global epoch.
+		/*!
+		 * Starts from 1 because 0 means quiescent_epoch.
+		 */
+		std::atomic< std::uint64_t > m_global_epoch{ 1u };
+
+		//! Lock for the list of retired objects.
+		std::mutex m_retired_lock;
+
+		//! Retired objects waiting for deletion.
+		std::vector< retired_object_t > m_retired;
+
+		//! Increment the global epoch and return its previous value.
+		std::uint64_t
+		advance_epoch() noexcept
+			{
+				return m_global_epoch.fetch_add( 1u, std::memory_order_seq_cst );
+			}
+
+		//! The minimal epoch of threads inside read-side sections.
+		[[nodiscard]]
+		std::uint64_t
+		min_active_epoch() const noexcept
+			{
+				std::atomic_thread_fence( std::memory_order_seq_cst );
+
+				auto result = std::numeric_limits< std::uint64_t >::max();
+				for( auto * r = m_records.load( std::memory_order_acquire );
+						r; r = r->m_next )
+					{
+						const auto e = r->m_epoch.load( std::memory_order_seq_cst );
+						if( quiescent_epoch != e && e < result )
+							result = e;
+					}
+
+				return result;
+			}
+
+		//! Delete all objects which can't be seen by readers.
+		/*!
+		 * \attention
+		 * Must be called when m_retired_lock is acquired.
+		 */
+		void
+		reclaim_unlocked() noexcept
+			{
+				if( m_retired.empty() )
+					return;
+
+				// An object retired at epoch E can be seen only by readers
+				// those entered their sections at epoch E or earlier.
+				const auto min_epoch = min_active_epoch();
+				const auto it = std::partition(
+						m_retired.begin(), m_retired.end(),
+						[min_epoch]( const retired_object_t & o ) {
+							return o.m_epoch >= min_epoch;
+						} );
+
+				std::for_each( it, m_retired.end(),
+						[]( const retired_object_t & o ) {
+							o.m_deleter( o.m_object );
+						} );
+
+				m_retired.erase( it, m_retired.end() );
+			}
+	};
+
+/*!
+ * \brief Access to the global domain object.
+ *
+ * \note
+ * The domain object is never destroyed because read-side sections
+ * can be used during destruction of global objects.
+ */
+[[nodiscard]]
+domain_t &
+the_domain() noexcept
+	{
+		static domain_t * domain = new domain_t{};
+		return *domain;
+	}
+
+//! Record of the current thread.
+/*!
+ * This pointer has a trivial type and is valid even during the
+ * destruction of other thread_local objects.
+ */
+thread_local thread_record_t * t_record = nullptr;
+
+//! Is the owner of record for the current thread already destroyed?
+thread_local bool t_owner_destroyed = false;
+
+//
+// record_owner_t
+//
+/*!
+ * \brief An object which returns the record of a thread at the thread exit.
+ */
+struct record_owner_t
+	{
+		thread_record_t * m_record{ nullptr };
+
+		~record_owner_t()
+			{
+				if( m_record )
+					domain_t::release_record( m_record );
+
+				t_record = nullptr;
+				t_owner_destroyed = true;
+			}
+	};
+
+thread_local record_owner_t t_owner;
+
+[[nodiscard]]
+thread_record_t &
+current_record() noexcept
+	{
+		if( !t_record )
+			{
+				// NOTE: an exception from acquire_record() is possible only
+				// if there is no memory for a new record. We can't continue
+				// in that case.
+				t_record = the_domain().acquire_record();
+
+				// If the owner is already destroyed then the record is never
+				// returned. It's not a problem because it's an extremely
+				// rare case.
+				if( !t_owner_destroyed )
+					t_owner.m_record = t_record;
+			}
+
+		return *t_record;
+	}
+
+} /* namespace anonymous */
+
+SO_5_FUNC void
+enter_read_section() noexcept
+	{
+		the_domain().enter( current_record() );
+	}
+
+SO_5_FUNC void
+leave_read_section() noexcept
+	{
+		domain_t::leave( *t_record );
+	}
+
+SO_5_FUNC void
+retire( void * object, deleter_t deleter )
+	{
+		the_domain().retire( object, deleter );
+	}
+
+SO_5_FUNC void
+synchronize() noexcept
+	{
+		the_domain().synchronize( t_record );
+	}
+
+SO_5_FUNC void
+try_reclaim() noexcept
+	{
+		the_domain().try_reclaim();
+	}
+
+} /* namespace epoch_reclamation */
+
+} /* namespace impl */
+
+} /* namespace so_5 */
+
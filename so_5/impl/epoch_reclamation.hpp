@@ -0,0 +1,135 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \file
+ * \brief Epoch-based reclamation of objects shared between threads.
+ *
+ * \since v.5.8.3
+ */
+
+#pragma once
+
+#include <so_5/declspec.hpp>
+
+namespace so_5
+{
+
+namespace impl
+{
+
+namespace epoch_reclamation
+{
+
+/*!
+ * \brief Type of function to be used for deletion of a retired object.
+ *
+ * \since v.5.8.3
+ */
+using deleter_t = void (*)( void * ) noexcept;
+
+/*!
+ * \brief Enter a read-side critical section for the current thread.
+ *
+ * Objects retired after the entry won't be deleted until the
+ * thread leaves the section.
+ *
+ * Read-side sections can be nested.
+ *
+ * \note
+ * Only the thread-local record of the current thread is modified.
+ * There are no writes to memory shared with other readers.
+ *
+ * \since v.5.8.3
+ */
+SO_5_FUNC void
+enter_read_section() noexcept;
+
+/*!
+ * \brief Leave a read-side critical section for the current thread.
+ *
+ * \since v.5.8.3
+ */
+SO_5_FUNC void
+leave_read_section() noexcept;
+
+/*!
+ * \brief Pass an object to the deferred deletion.
+ *
+ * The object will be deleted by \a deleter when all read-side sections
+ * which could see the object are finished.
+ *
+ * \attention
+ * The object must already be unreachable for new readers (it means that
+ * a pointer to it must be replaced by a new value before the call to
+ * retire()).
+ *
+ * \note
+ * Objects are deleted during calls to retire() or try_reclaim(),
+ * possibly on another thread.
+ *
+ * \since v.5.8.3
+ */
+SO_5_FUNC void
+retire( void * object, deleter_t deleter );
+
+/*!
+ * \brief Wait until all read-side sections that could see an object
+ * unreachable for new readers are finished.
+ *
+ * It is like synchronize_rcu() in RCU implementations. It has to be
+ * used if the replaced object refers to something that will be destroyed
+ * after the return (for example, a message sink of an agent which
+ * is being deregistered).
+ *
+ * \note
+ * The read-side section of the current thread (if it exists) isn't
+ * waited for. It allows the call to synchronize() from inside
+ * a read-side section without a deadlock.
+ *
+ * \since v.5.8.3
+ */
+SO_5_FUNC void
+synchronize() noexcept;
+
+/*!
+ * \brief Delete retired objects which are not visible for readers anymore.
+ *
+ * \since v.5.8.3
+ */
+SO_5_FUNC void
+try_reclaim() noexcept;
+
+//
+// read_section_t
+//
+/*!
+ * \brief RAII wrapper for a read-side critical section.
+ *
+ * \since v.5.8.3
+ */
+class read_section_t
+	{
+	public :
+		read_section_t() noexcept
+			{
+				enter_read_section();
+			}
+
+		~read_section_t() noexcept
+			{
+				leave_read_section();
+			}
+
+		read_section_t( const read_section_t & ) = delete;
+		read_section_t &
+		operator=( const read_section_t & ) = delete;
+	};
+
+} /* namespace epoch_reclamation */
+
+} /* namespace impl */
+
+} /* namespace so_5 */
+
@@ -9,7 +9,12 @@
 
 #pragma once
 
+#include <algorithm>
+#include <atomic>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <type_traits>
 #include <vector>
 
 #include <so_5/types.hpp>
@@ -20,9 +25,11 @@
 #include <so_5/msg_tracing.hpp>
 
 #include <so_5/mbox.hpp>
+#include <so_5/message_type_id.hpp>
 #include <so_5/enveloped_msg.hpp>
 
 #include <so_5/impl/local_mbox_basic_subscription_info.hpp>
+#include <so_5/impl/epoch_reclamation.hpp>
 
 #include <so_5/impl/msg_tracing_helpers.hpp>
 
@@ -586,28 +593,149 @@ public :
 };
 
 //
-// data_t
+// insert_or_modify_subscriber_info
 //
+/*!
+ * \brief Add a new subscriber to the container or modify the information
+ * about an existing one.
+ *
+ * \retval true if the information about an existing subscriber
+ * was modified.
+ *
+ * \since v.5.8.3
+ */
+template< typename Info_Maker, typename Info_Changer >
+bool
+insert_or_modify_subscriber_info(
+	subscriber_adaptive_container_t & sinks,
+	abstract_message_sink_t & subscriber,
+	Info_Maker & maker,
+	Info_Changer & changer )
+	{
+		auto pos = sinks.find( subscriber );
+		if( pos != sinks.end() )
+		{
+			// Agent is already in subscribers list.
+			// But its state must be updated.
+			changer( *pos );
+			return true;
+		}
+
+		// There is no subscriber in the container.
+		// It must be added.
+		sinks.insert( subscriber, maker() );
+		return false;
+	}
 
+//
+// modify_and_remove_subscriber_info_if_needed
+//
 /*!
- * \since
- * v.5.5.9
+ * \brief Modify the information about a subscriber and remove it if
+ * the information becomes empty.
  *
- * \brief A coolection of data required for local mbox implementation.
+ * \since v.5.8.3
  */
-struct data_t
+template< typename Info_Changer >
+void
+modify_and_remove_subscriber_info_if_needed(
+	subscriber_adaptive_container_t & sinks,
+	abstract_message_sink_t & subscriber,
+	Info_Changer & changer )
 	{
-		data_t( mbox_id_t id, environment_t & env )
-			:	m_id{ id }
-			,	m_env{ env }
-			{}
+		auto pos = sinks.find( subscriber );
+		if( pos != sinks.end() )
+		{
+			// Subscriber is found and must be modified.
+			changer( *pos );
 
-		//! ID of this mbox.
-		const mbox_id_t m_id;
+			// If info about subscriber becomes empty after modification
+			// then subscriber info must be removed.
+			if( pos->empty() )
+				sinks.erase( pos );
+		}
+	}
 
-		//! Environment for which the mbox is created.
-		environment_t & m_env;
+//
+// rw_locked_subscribers_table_t
+//
+/*!
+ * \brief Table of subscribers protected by a reader-writer spinlock.
+ *
+ * It's the default table for local mboxes.
+ *
+ * \note
+ * Every delivery acquires the read lock. It means a modification of
+ * a counter of readers inside the lock.
+ *
+ * \since v.5.8.3
+ */
+class rw_locked_subscribers_table_t
+	{
+	public :
+		template< typename Info_Maker, typename Info_Changer >
+		void
+		insert_or_modify(
+			message_type_id_t msg_type_id,
+			abstract_message_sink_t & subscriber,
+			Info_Maker maker,
+			Info_Changer changer )
+			{
+				std::unique_lock< default_rw_spinlock_t > lock( m_lock );
+
+				auto it = m_subscribers.find( msg_type_id );
+				if( it == m_subscribers.end() )
+				{
+					// There isn't such message type yet.
+					subscriber_adaptive_container_t container;
+					container.insert( subscriber, maker() );
+
+					m_subscribers.emplace( msg_type_id, std::move( container ) );
+				}
+				else
+					insert_or_modify_subscriber_info(
+							it->second, subscriber, maker, changer );
+			}
+
+		template< typename Info_Changer >
+		void
+		modify_and_remove_if_needed(
+			message_type_id_t msg_type_id,
+			abstract_message_sink_t & subscriber,
+			Info_Changer changer )
+			{
+				std::unique_lock< default_rw_spinlock_t > lock( m_lock );
 
+				auto it = m_subscribers.find( msg_type_id );
+				if( it != m_subscribers.end() )
+				{
+					auto & sinks = it->second;
+					modify_and_remove_subscriber_info_if_needed(
+							sinks, subscriber, changer );
+
+					if( sinks.empty() )
+						m_subscribers.erase( it );
+				}
+			}
+
+		//! Call \a handler for the container of subscribers to
+		//! the specified message type.
+		/*!
+		 * nullptr is passed to \a handler if there are no subscribers.
+		 */
+		template< typename Handler >
+		void
+		access_subscribers(
+			message_type_id_t msg_type_id,
+			Handler && handler )
+			{
+				read_lock_guard_t< default_rw_spinlock_t > lock( m_lock );
+
+				auto it = m_subscribers.find( msg_type_id );
+				handler( it != m_subscribers.end() ? &(it->second) : nullptr );
+			}
+
+	private :
 		//! Object lock.
 		default_rw_spinlock_t m_lock;
 
@@ -616,15 +744,295 @@ struct data_t
 		 * v.5.4.0
 		 *
 		 * \brief Map from message type to subscribers.
+		 *
+		 * \note
+		 * Since v.5.8.3 the dense ID of message type is used as the key.
 		 */
 		using messages_table_t = std::map<
-				std::type_index,
+				message_type_id_t,
 				subscriber_adaptive_container_t >;
 
 		//! Map of subscribers to messages.
 		messages_table_t m_subscribers;
 	};
 
+//
+// snapshot_subscribers_table_t
+//
+/*!
+ * \brief Table of subscribers in the form of immutable snapshots.
+ *
+ * Every modification creates a new snapshot of the table and publishes
+ * it via an atomic pointer. Containers for message types which are not
+ * affected by the modification are shared between the old and new
+ * snapshots.
+ *
+ * A reader only loads the pointer to the current snapshot inside
+ * an epoch-based read-side section. The reader doesn't write to memory
+ * shared with other readers, so there is no contended cache line for
+ * parallel senders.
+ *
+ * Old snapshots are deleted via epoch-based reclamation. If a modification
+ * can make a pointer to a message sink or delivery filter invalid (e.g.
+ * unsubscription or removal of a delivery filter) then the modification
+ * waits until all readers of the old snapshot finished their work.
+ * It's the same guarantee that is provided by the write lock in
+ * rw_locked_subscribers_table_t.
+ *
+ * \attention
+ * Modifications are much more expensive than for
+ * rw_locked_subscribers_table_t.
+ *
+ * \since v.5.8.3
+ */
+class snapshot_subscribers_table_t
+	{
+		using container_shptr_t =
+				std::shared_ptr< const subscriber_adaptive_container_t >;
+
+		//! An immutable snapshot of the table.
+		struct snapshot_t
+			{
+				using item_t = std::pair< message_type_id_t, container_shptr_t >;
+
+				//! Items ordered by message type ID.
+				std::vector< item_t > m_items;
+
+				[[nodiscard]]
+				static bool
+				less( const item_t & item, message_type_id_t id ) noexcept
+					{
+						return item.first < id;
+					}
+
+				[[nodiscard]]
+				const subscriber_adaptive_container_t *
+				find( message_type_id_t id ) const noexcept
+					{
+						const auto it = std::lower_bound(
+								m_items.begin(), m_items.end(), id, &less );
+						if( it != m_items.end() && it->first == id )
+							return it->second.get();
+						return nullptr;
+					}
+
+				static void
+				destroy( void * what ) noexcept
+					{
+						delete static_cast< snapshot_t * >( what );
+					}
+			};
+
+	public :
+		snapshot_subscribers_table_t() = default;
+		snapshot_subscribers_table_t(
+			const snapshot_subscribers_table_t & ) = delete;
+		snapshot_subscribers_table_t &
+		operator=( const snapshot_subscribers_table_t & ) = delete;
+
+		~snapshot_subscribers_table_t() noexcept
+			{
+				// There can't be readers when the mbox is being destroyed.
+				delete m_snapshot.load( std::memory_order_acquire );
+			}
+
+		template< typename Info_Maker, typename Info_Changer >
+		void
+		insert_or_modify(
+			message_type_id_t msg_type_id,
+			abstract_message_sink_t & subscriber,
+			Info_Maker maker,
+			Info_Changer changer )
+			{
+				std::unique_lock< std::mutex > lock( m_lock );
+
+				const snapshot_t * current = m_snapshot.load(
+						std::memory_order_relaxed );
+
+				subscriber_adaptive_container_t sinks;
+				if( current )
+					if( const auto * c = current->find( msg_type_id ) )
+						sinks = *c;
+
+				const bool existing_info_modified =
+						insert_or_modify_subscriber_info(
+								sinks, subscriber, maker, changer );
+
+				publish(
+						lock,
+						make_new_snapshot( current, msg_type_id, std::move(sinks) ),
+						existing_info_modified );
+			}
+
+		template< typename Info_Changer >
+		void
+		modify_and_remove_if_needed(
+			message_type_id_t msg_type_id,
+			abstract_message_sink_t & subscriber,
+			Info_Changer changer )
+			{
+				std::unique_lock< std::mutex > lock( m_lock );
+
+				const snapshot_t * current = m_snapshot.load(
+						std::memory_order_relaxed );
+				if( !current )
+					return;
+
+				const auto * c = current->find( msg_type_id );
+				if( !c )
+					return;
+
+				subscriber_adaptive_container_t sinks{ *c };
+				modify_and_remove_subscriber_info_if_needed(
+						sinks, subscriber, changer );
+
+				publish(
+						lock,
+						make_new_snapshot( current, msg_type_id, std::move(sinks) ),
+						true );
+			}
+
+		//! Call \a handler for the container of subscribers to
+		//! the specified message type.
+		/*!
+		 * nullptr is passed to \a handler if there are no subscribers.
+		 */
+		template< typename Handler >
+		void
+		access_subscribers(
+			message_type_id_t msg_type_id,
+			Handler && handler )
+			{
+				epoch_reclamation::read_section_t section;
+
+				const snapshot_t * current = m_snapshot.load(
+						std::memory_order_acquire );
+				handler( current ? current->find( msg_type_id ) : nullptr );
+			}
+
+	private :
+		//! Lock for modifications.
+		std::mutex m_lock;
+
+		//! The current snapshot.
+		/*!
+		 * It's nullptr if there are no subscribers at all.
+		 */
+		std::atomic< const snapshot_t * > m_snapshot{ nullptr };
+
+		//! Make a copy of \a current with the new content of
+		//! container for \a msg_type_id.
+		/*!
+		 * The item for \a msg_type_id is removed if \a sinks is empty.
+		 *
+		 * \return nullptr if the new snapshot is empty.
+		 */
+		[[nodiscard]]
+		static std::unique_ptr< snapshot_t >
+		make_new_snapshot(
+			const snapshot_t * current,
+			message_type_id_t msg_type_id,
+			subscriber_adaptive_container_t sinks )
+			{
+				auto result = std::make_unique< snapshot_t >();
+				if( current )
+					result->m_items = current->m_items;
+
+				auto & items = result->m_items;
+				auto it = std::lower_bound(
+						items.begin(), items.end(), msg_type_id, &snapshot_t::less );
+				const bool found = it != items.end() && it->first == msg_type_id;
+
+				if( sinks.empty() )
+					{
+						if( found )
+							items.erase( it );
+					}
+				else
+					{
+						auto c = std::make_shared< const subscriber_adaptive_container_t >(
+								std::move(sinks) );
+						if( found )
+							it->second = std::move(c);
+						else
+							items.emplace( it, msg_type_id, std::move(c) );
+					}
+
+				if( items.empty() )
+					result.reset();
+
+				return result;
+			}
+
+		//! Replace the current snapshot by a new one.
+		/*!
+		 * If \a wait_for_readers is true then the return happens only
+		 * after all readers of the old snapshot finished their work.
+		 */
+		void
+		publish(
+			std::unique_lock< std::mutex > & lock,
+			std::unique_ptr< snapshot_t > new_snapshot,
+			bool wait_for_readers )
+			{
+				std::unique_ptr< const snapshot_t > old{
+						m_snapshot.exchange(
+								new_snapshot.release(),
+								std::memory_order_seq_cst )
+					};
+				lock.unlock();
+
+				if( !wait_for_readers && old )
+					{
+						try
+							{
+								epoch_reclamation::retire(
+										const_cast< snapshot_t * >( old.get() ),
+										&snapshot_t::destroy );
+								// The old snapshot is owned by epoch_reclamation now.
+								old.release();
+								return;
+							}
+						catch( ... )
+							{
+								// The old snapshot can't be retired.
+								// We have to wait for readers.
+							}
+					}
+
+				epoch_reclamation::synchronize();
+				// There are no readers of the old snapshot anymore.
+				// It will be deleted by the unique_ptr.
+			}
+	};
+
+//
+// data_t
+//
+
+/*!
+ * \since
+ * v.5.5.9
+ *
+ * \brief A coolection of data required for local mbox implementation.
+ *
+ * \note
+ * Since v.5.8.3 the table of subscribers isn't a part of data_t.
+ */
+struct data_t
+	{
+		data_t( mbox_id_t id, environment_t & env )
+			:	m_id{ id }
+			,	m_env{ env }
+			{}
+
+		//! ID of this mbox.
+		const mbox_id_t m_id;
+
+		//! Environment for which the mbox is created.
+		environment_t & m_env;
+	};
+
 } /* namespace local_mbox_details */
 
 //
@@ -638,8 +1046,14 @@ struct data_t
  *
  * \tparam Tracing_Base base class with implementation of message
  * delivery tracing methods.
+ *
+ * \tparam Subscribers_Table type of the table of subscribers.
+ * Since v.5.8.3 it can be local_mbox_details::rw_locked_subscribers_table_t
+ * or local_mbox_details::snapshot_subscribers_table_t.
  */
-template< typename Tracing_Base >
+template<
+	typename Tracing_Base,
+	typename Subscribers_Table = local_mbox_details::rw_locked_subscribers_table_t >
 class local_mbox_template
 	:	public abstract_message_box_t
 	,	private local_mbox_details::data_t
@@ -736,6 +1150,45 @@ class local_mbox_template
 						redirection_deep );
 			}
 
+		/*!
+		 * \note
+		 * If message delivery tracing is on then messages are delivered
+		 * one by one via do_deliver_message().
+		 */
+		void
+		do_deliver_message_batch(
+			message_delivery_mode_t delivery_mode,
+			const std::type_index & msg_type,
+			const message_ref_t * messages,
+			std::size_t count,
+			unsigned int redirection_deep ) override
+			{
+				if constexpr( std::is_same_v<
+						Tracing_Base,
+						msg_tracing_helpers::tracing_disabled_base > )
+					{
+						if( !count )
+							return;
+
+						for( std::size_t i = 0u; i != count; ++i )
+							ensure_immutable_message( msg_type, messages[ i ] );
+
+						do_deliver_message_batch_impl(
+								delivery_mode,
+								msg_type,
+								messages,
+								count,
+								redirection_deep );
+					}
+				else
+					abstract_message_box_t::do_deliver_message_batch(
+							delivery_mode,
+							msg_type,
+							messages,
+							count,
+							redirection_deep );
+			}
+
 		void
 		set_delivery_filter(
 			const std::type_index & msg_type,
@@ -775,6 +1228,12 @@ class local_mbox_template
 			}
 
 	private :
+		//! Table of subscribers.
+		/*!
+		 * \since v.5.8.3
+		 */
+		Subscribers_Table m_subscribers;
+
 		template< typename Info_Maker, typename Info_Changer >
 		void
 		insert_or_modify_subscriber(
@@ -783,33 +1242,11 @@ class local_mbox_template
 			Info_Maker maker,
 			Info_Changer changer )
 			{
-				std::unique_lock< default_rw_spinlock_t > lock( m_lock );
-
-				auto it = m_subscribers.find( type_wrapper );
-				if( it == m_subscribers.end() )
-				{
-					// There isn't such message type yet.
-					local_mbox_details::subscriber_adaptive_container_t container;
-					container.insert( subscriber, maker() );
-
-					m_subscribers.emplace( type_wrapper, std::move( container ) );
-				}
-				else
-				{
-					auto & sinks = it->second;
-
-					auto pos = sinks.find( subscriber );
-					if( pos != sinks.end() )
-					{
-						// Agent is already in subscribers list.
-						// But its state must be updated.
-						changer( *pos );
-					}
-					else
-						// There is no subscriber in the container.
-						// It must be added.
-						sinks.insert( subscriber, maker() );
-				}
+				m_subscribers.insert_or_modify(
+						message_type_id_for( type_wrapper ),
+						subscriber,
+						std::move(maker),
+						std::move(changer) );
 			}
 
 		template< typename Info_Changer >
@@ -819,28 +1256,10 @@ class local_mbox_template
 			abstract_message_sink_t & subscriber,
 			Info_Changer changer )
 			{
-				std::unique_lock< default_rw_spinlock_t > lock( m_lock );
-
-				auto it = m_subscribers.find( type_wrapper );
-				if( it != m_subscribers.end() )
-				{
-					auto & sinks = it->second;
-
-					auto pos = sinks.find( subscriber );
-					if( pos != sinks.end() )
-					{
-						// Subscriber is found and must be modified.
-						changer( *pos );
-
-						// If info about subscriber becomes empty after modification
-						// then subscriber info must be removed.
-						if( pos->empty() )
-							sinks.erase( pos );
-					}
-
-					if( sinks.empty() )
-						m_subscribers.erase( it );
-				}
+				m_subscribers.modify_and_remove_if_needed(
+						message_type_id_for( type_wrapper ),
+						subscriber,
+						std::move(changer) );
 			}
 
 		void
@@ -851,22 +1270,88 @@ class local_mbox_template
 			const message_ref_t & message,
 			unsigned int redirection_deep )
 			{
-				read_lock_guard_t< default_rw_spinlock_t > lock( m_lock );
+				m_subscribers.access_subscribers(
+					message_type_id_for( msg_type ),
+					[&]( const local_mbox_details::subscriber_adaptive_container_t * sinks )
+					{
+						if( sinks )
+							{
+								for( const auto & a : *sinks )
+									do_deliver_message_to_subscriber(
+											a,
+											tracer,
+											delivery_mode,
+											msg_type,
+											message,
+											redirection_deep );
+							}
+						else
+							tracer.no_subscribers();
+					} );
+			}
 
-				auto it = m_subscribers.find( msg_type );
-				if( it != m_subscribers.end() )
+		/*!
+		 * \brief Delivery of a batch of messages when tracing is off.
+		 *
+		 * Subscribers are found only once. Subscribers without delivery
+		 * filters receive all messages at once, a delivery filter is
+		 * checked for every message.
+		 *
+		 * \pre \a count is greater than 0.
+		 *
+		 * \since v.5.8.3
+		 */
+		void
+		do_deliver_message_batch_impl(
+			message_delivery_mode_t delivery_mode,
+			const std::type_index & msg_type,
+			const message_ref_t * messages,
+			std::size_t count,
+			unsigned int redirection_deep )
+			{
+				// This tracer does nothing because tracing is off.
+				typename Tracing_Base::deliver_op_tracer tracer{
+						*this, // as Tracing_base
+						*this, // as abstract_message_box_t
+						"deliver_message_batch",
+						delivery_mode,
+						msg_type,
+						messages[ 0 ],
+						redirection_deep };
+
+				m_subscribers.access_subscribers(
+					message_type_id_for( msg_type ),
+					[&]( const local_mbox_details::subscriber_adaptive_container_t * sinks )
 					{
-						for( const auto & a : it->second )
-							do_deliver_message_to_subscriber(
-									a,
-									tracer,
-									delivery_mode,
-									msg_type,
-									message,
-									redirection_deep );
-					}
-				else
-					tracer.no_subscribers();
+						if( !sinks )
+							return;
+
+						for( const auto & a : *sinks )
+							{
+								if( !a.sink_pointer() )
+									// There is only a delivery filter.
+									continue;
+
+								if( a.has_filter() )
+									for( std::size_t i = 0u; i != count; ++i )
+										do_deliver_message_to_subscriber(
+												a,
+												tracer,
+												delivery_mode,
+												msg_type,
+												messages[ i ],
+												redirection_deep );
+								else
+									a.sink_reference().push_event_batch(
+											this->m_id,
+											delivery_mode,
+											msg_type,
+											messages,
+											count,
+											redirection_deep,
+											tracer.overlimit_tracer() );
+							}
+					} );
 			}
 
 		void
@@ -941,6 +1426,28 @@ using local_mbox_without_tracing =
 using local_mbox_with_tracing =
 	local_mbox_template< msg_tracing_helpers::tracing_enabled_base >;
 
+/*!
+ * \brief Alias for local mbox with snapshot table of subscribers
+ * and without message delivery tracing.
+ *
+ * \since v.5.8.3
+ */
+using snapshot_local_mbox_without_tracing =
+	local_mbox_template<
+			msg_tracing_helpers::tracing_disabled_base,
+			local_mbox_details::snapshot_subscribers_table_t >;
+
+/*!
+ * \brief Alias for local mbox with snapshot table of subscribers
+ * and with message delivery tracing.
+ *
+ * \since v.5.8.3
+ */
+using snapshot_local_mbox_with_tracing =
+	local_mbox_template<
+			msg_tracing_helpers::tracing_enabled_base,
+			local_mbox_details::snapshot_subscribers_table_t >;
+
 } /* namespace impl */
 
 } /* namespace so_5 */
@@ -310,6 +310,18 @@ public :
 		return need_deliver;
 	}
 
+	/*!
+	 * \brief Is there a delivery filter for the subscriber?
+	 *
+	 * \since v.5.8.3
+	 */
+	[[nodiscard]]
+	bool
+	has_filter() const noexcept
+	{
+		return nullptr != m_filter;
+	}
+
 	/*!
 	 * \brief Get a reference to the subscribed sink.
 	 *
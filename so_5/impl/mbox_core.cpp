@@ -47,52 +47,27 @@ mbox_core_t::create_mbox(
 	environment_t & env,
 	nonempty_name_t mbox_name )
 {
-	mbox_t result; // Will be created later,
-
-	full_named_mbox_id_t key{
-			default_global_mbox_namespace(),
-			mbox_name.giveout_value()
-		};
+	return create_named_mbox(
+			env,
+			full_named_mbox_id_t{
+					default_global_mbox_namespace(),
+					mbox_name.giveout_value()
+				} );
 	// NOTE: mbox_name can't be used anymore!
+}
 
-	std::lock_guard< std::mutex > lock( m_dictionary_lock );
-
-	named_mboxes_dictionary_t::iterator it =
-		m_named_mboxes_dictionary.find( key );
-
-	if( m_named_mboxes_dictionary.end() != it )
-	{
-		// For strong exception safety create a new instance
-		// of named_local_mbox first...
-		result = mbox_t{
-				new named_local_mbox_t( key, it->second.m_mbox, *this )
-			};
-
-		// ... now the count of references can be incremented safely
-		// (exceptions is no more expected).
-		++(it->second.m_external_ref_count);
-	}
-	else
-	{
-		// There is no mbox with such name. New mbox should be created.
-		// NOTE: it's safe to call create_mbox(env) when mbox_core is
-		// locked because create_mbox(env) doesn't to lock the mbox_core.
-		mbox_t mbox_ref = create_mbox( env );
-
-		// For strong exception safety create a new instance
-		// of named_local_mbox first...
-		result = mbox_t{
-				new named_local_mbox_t( key, mbox_ref, *this )
-			};
-
-		// ...now we can update the dictionary. If there will be an exception
-		// then all new object will be destroyed automatically.
-		m_named_mboxes_dictionary.emplace(
-				key,
-				named_mbox_info_t( mbox_ref ) );
-	}
-
-	return result;
+mbox_t
+mbox_core_t::create_mbox(
+	environment_t & env,
+	const named_mbox_handle_t & handle )
+{
+	return create_named_mbox(
+			env,
+			full_named_mbox_id_t{
+					default_global_mbox_namespace(),
+					handle.name(),
+					handle.hash()
+				} );
 }
 
 namespace {
@@ -158,16 +133,16 @@ void
 mbox_core_t::destroy_mbox(
 	const full_named_mbox_id_t & name ) noexcept
 {
-	std::lock_guard< std::mutex > lock( m_dictionary_lock );
+	auto & shard = shard_for( name );
+	std::lock_guard< std::mutex > lock( shard.m_lock );
 
-	named_mboxes_dictionary_t::iterator it =
-		m_named_mboxes_dictionary.find( name );
+	named_mboxes_dictionary_t::iterator it = shard.m_mboxes.find( name );
 
-	if( m_named_mboxes_dictionary.end() != it )
+	if( shard.m_mboxes.end() != it )
 	{
 		const unsigned int ref_count = --(it->second.m_external_ref_count);
 		if( 0 == ref_count )
-			m_named_mboxes_dictionary.erase( it );
+			shard.m_mboxes.erase( it );
 	}
 }
 
@@ -199,15 +174,16 @@ mbox_core_t::introduce_named_mbox(
 		};
 	// NOTE: mbox_name can't be used anymore!
 
+	auto & shard = shard_for( key );
+
 	// Step 1. Check the presense of this mbox.
 	// It's important to do that step on locked object.
 	{
-		std::lock_guard< std::mutex > lock( m_dictionary_lock );
+		std::lock_guard< std::mutex > lock( shard.m_lock );
 
-		named_mboxes_dictionary_t::iterator it =
-			m_named_mboxes_dictionary.find( key );
+		named_mboxes_dictionary_t::iterator it = shard.m_mboxes.find( key );
 
-		if( m_named_mboxes_dictionary.end() != it )
+		if( shard.m_mboxes.end() != it )
 		{
 			// For strong exception safety create a new instance
 			// of named_local_mbox first...
@@ -234,14 +210,13 @@ mbox_core_t::introduce_named_mbox(
 		// Step 3. Try to register the fresh_mbox.
 		// It has to be done on locked object.
 		{
-			std::lock_guard< std::mutex > lock( m_dictionary_lock );
+			std::lock_guard< std::mutex > lock( shard.m_lock );
 
 			// Another search. This is necessary because the name may have been
 			// created while mbox_factory() was running.
-			named_mboxes_dictionary_t::iterator it =
-				m_named_mboxes_dictionary.find( key );
+			named_mboxes_dictionary_t::iterator it = shard.m_mboxes.find( key );
 
-			if( m_named_mboxes_dictionary.end() != it )
+			if( shard.m_mboxes.end() != it )
 			{
 				// Yes, the name has been created while we were inside
 				// mbox_factory() call. The fresh_mbox has to be discarded.
@@ -266,7 +241,7 @@ mbox_core_t::introduce_named_mbox(
 
 				// ...now we can update the dictionary. If there will be an
 				// exception then all new object will be destroyed automatically.
-				m_named_mboxes_dictionary.emplace(
+				shard.m_mboxes.emplace(
 						key,
 						named_mbox_info_t( fresh_mbox ) );
 			}
@@ -300,9 +275,14 @@ mbox_core_t::create_mchain(
 mbox_core_stats_t
 mbox_core_t::query_stats()
 {
-	std::lock_guard< std::mutex > lock{ m_dictionary_lock };
+	std::size_t named_mbox_count{};
+	for( auto & shard : m_dictionary_shards )
+	{
+		std::lock_guard< std::mutex > lock{ shard.m_lock };
+		named_mbox_count += shard.m_mboxes.size();
+	}
 
-	return mbox_core_stats_t{ m_named_mboxes_dictionary.size() };
+	return mbox_core_stats_t{ named_mbox_count };
 }
 
 [[nodiscard]] mbox_id_t
@@ -311,6 +291,66 @@ mbox_core_t::allocate_mbox_id() noexcept
 	return ++m_mbox_id_counter;
 }
 
+mbox_core_t::dictionary_shard_t &
+mbox_core_t::shard_for( const full_named_mbox_id_t & name ) noexcept
+{
+	// The lower bits of the hash are used by unordered_map for the
+	// selection of a bucket. So the higher bits are mixed in for the
+	// selection of a shard.
+	const std::size_t h = name.m_hash;
+	const std::size_t index = ( h ^ ( h >> 17 ) ^ ( h >> 31 ) ) %
+			dictionary_shard_count;
+
+	return m_dictionary_shards[ index ];
+}
+
+mbox_t
+mbox_core_t::create_named_mbox(
+	environment_t & env,
+	full_named_mbox_id_t key )
+{
+	mbox_t result; // Will be created later,
+
+	auto & shard = shard_for( key );
+	std::lock_guard< std::mutex > lock( shard.m_lock );
+
+	named_mboxes_dictionary_t::iterator it = shard.m_mboxes.find( key );
+
+	if( shard.m_mboxes.end() != it )
+	{
+		// For strong exception safety create a new instance
+		// of named_local_mbox first...
+		result = mbox_t{
+				new named_local_mbox_t( key, it->second.m_mbox, *this )
+			};
+
+		// ... now the count of references can be incremented safely
+		// (exceptions is no more expected).
+		++(it->second.m_external_ref_count);
+	}
+	else
+	{
+		// There is no mbox with such name. New mbox should be created.
+		// NOTE: it's safe to call create_mbox(env) when the shard is
+		// locked because create_mbox(env) doesn't to lock the mbox_core.
+		mbox_t mbox_ref = create_mbox( env );
+
+		// For strong exception safety create a new instance
+		// of named_local_mbox first...
+		result = mbox_t{
+				new named_local_mbox_t( key, mbox_ref, *this )
+			};
+
+		// ...now we can update the dictionary. If there will be an exception
+		// then all new object will be destroyed automatically.
+		shard.m_mboxes.emplace(
+				std::move(key),
+				named_mbox_info_t( mbox_ref ) );
+	}
+
+	return result;
+}
+
 } /* namespace impl */
 
 } /* namespace so_5 */
@@ -21,13 +21,15 @@
 #include <so_5/outliving.hpp>
 
 #include <so_5/custom_mbox.hpp>
+#include <so_5/named_mbox_handle.hpp>
 
+#include <array>
 #include <functional>
-#include <map>
 #include <memory>
 #include <mutex>
 #include <string>
 #include <tuple>
+#include <unordered_map>
 #include <vector>
 
 namespace so_5
@@ -82,12 +84,36 @@ struct full_named_mbox_id_t
 		 */
 		std::string m_name;
 
+		/*!
+		 * \brief Precomputed hash of the full name.
+		 *
+		 * \since v.5.8.3
+		 */
+		std::size_t m_hash;
+
 		//! Initializing constructor.
 		full_named_mbox_id_t(
 			std::string mbox_namespace,
 			std::string mbox_name )
 			:	m_namespace{ std::move(mbox_namespace) }
 			,	m_name{ std::move(mbox_name) }
+			,	m_hash{ named_mbox_details::hash_of_full_name(
+					m_namespace, m_name ) }
+			{}
+
+		/*!
+		 * \brief Initializing constructor for the case when the hash
+		 * is already known.
+		 *
+		 * \since v.5.8.3
+		 */
+		full_named_mbox_id_t(
+			std::string mbox_namespace,
+			std::string mbox_name,
+			std::size_t hash )
+			:	m_namespace{ std::move(mbox_namespace) }
+			,	m_name{ std::move(mbox_name) }
+			,	m_hash{ hash }
 			{}
 	};
 
@@ -101,6 +127,40 @@ operator<(
 				std::tie(b.m_namespace, b.m_name);
 	}
 
+/*!
+ * \since v.5.8.3
+ */
+[[nodiscard]]
+inline bool
+operator==(
+	const full_named_mbox_id_t & a,
+	const full_named_mbox_id_t & b )
+	{
+		return a.m_hash == b.m_hash &&
+				a.m_name == b.m_name &&
+				a.m_namespace == b.m_namespace;
+	}
+
+//
+// full_named_mbox_id_hash_t
+//
+/*!
+ * \brief Hash function for full_named_mbox_id_t.
+ *
+ * Just returns the precomputed value.
+ *
+ * \since v.5.8.3
+ */
+struct full_named_mbox_id_hash_t
+	{
+		[[nodiscard]]
+		std::size_t
+		operator()( const full_named_mbox_id_t & id ) const noexcept
+			{
+				return id.m_hash;
+			}
+	};
+
 //
 // default_global_mbox_namespace
 //
@@ -163,6 +223,20 @@ class mbox_core_t final : private atomic_refcounted_t
 			//! Mbox name.
 			nonempty_name_t mbox_name );
 
+		/*!
+		 * \brief Create local named mbox by using a handle with precomputed
+		 * hash of the name.
+		 *
+		 * \since v.5.8.3
+		 */
+		[[nodiscard]]
+		mbox_t
+		create_mbox(
+			//! Environment for which the mbox is created.
+			environment_t & env,
+			//! Handle with mbox name.
+			const named_mbox_handle_t & handle );
+
 		/*!
 		 * \brief Create mpsc_mbox that handles message limits.
 		 *
@@ -269,9 +343,6 @@ class mbox_core_t final : private atomic_refcounted_t
 		 */
 		outliving_reference_t< so_5::msg_tracing::holder_t > m_msg_tracing_stuff;
 
-		//! Named mbox map's lock.
-		std::mutex m_dictionary_lock;
-
 		//! Named mbox information.
 		struct named_mbox_info_t
 		{
@@ -288,14 +359,50 @@ class mbox_core_t final : private atomic_refcounted_t
 		};
 
 		//! Typedef for the map from the mbox name to the mbox information.
-		using named_mboxes_dictionary_t = std::map<
+		/*!
+		 * \note
+		 * Since v.5.8.3 it's a hash table that uses precomputed
+		 * hashes of names.
+		 */
+		using named_mboxes_dictionary_t = std::unordered_map<
 				full_named_mbox_id_t,
 				named_mbox_info_t,
-				std::less<> // It's important.
-			>;
+				full_named_mbox_id_hash_t >;
+
+		/*!
+		 * \brief A part of the dictionary of named mboxes.
+		 *
+		 * \since v.5.8.3
+		 */
+		struct dictionary_shard_t
+		{
+			//! Lock for this part of dictionary.
+			std::mutex m_lock;
+
+			//! Named mboxes.
+			named_mboxes_dictionary_t m_mboxes;
+		};
 
-		//! Named mboxes.
-		named_mboxes_dictionary_t m_named_mboxes_dictionary;
+		//! Count of parts of the dictionary of named mboxes.
+		/*!
+		 * \since v.5.8.3
+		 */
+		static constexpr std::size_t dictionary_shard_count = 64u;
+
+		/*!
+		 * \brief Dictionary of named mboxes.
+		 *
+		 * Every named mbox belongs to the part selected by the hash of
+		 * mbox name. It allows to work with different named mboxes
+		 * in parallel.
+		 *
+		 * \note
+		 * It was a single std::map with one lock until v.5.8.3.
+		 *
+		 * \since v.5.8.3
+		 */
+		std::array< dictionary_shard_t, dictionary_shard_count >
+				m_dictionary_shards;
 
 		/*!
 		 * \since
@@ -304,6 +411,29 @@ class mbox_core_t final : private atomic_refcounted_t
 		 * \brief A counter for mbox ID generation.
 		 */
 		std::atomic< mbox_id_t > m_mbox_id_counter;
+
+		/*!
+		 * \brief Get a part of dictionary for the name.
+		 *
+		 * \since v.5.8.3
+		 */
+		[[nodiscard]]
+		dictionary_shard_t &
+		shard_for( const full_named_mbox_id_t & name ) noexcept;
+
+		/*!
+		 * \brief Create local named mbox in the default namespace or
+		 * return a reference to the existing one.
+		 *
+		 * \since v.5.8.3
+		 */
+		[[nodiscard]]
+		mbox_t
+		create_named_mbox(
+			//! Environment for which the mbox is created.
+			environment_t & env,
+			//! Mbox name.
+			full_named_mbox_id_t key );
 };
 
 //! Smart reference to the mbox_core_t.
@@ -0,0 +1,400 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \file
+ * \brief Implementation of pooled allocation of message instances.
+ *
+ * \since v.5.8.3
+ */
+
+#include <so_5/message_pool.hpp>
+
+#include <so_5/spinlocks.hpp>
+
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <new>
+
+namespace so_5
+{
+
+namespace impl
+{
+
+namespace message_pool
+{
+
+namespace
+{
+
+//! Count of size classes.
+constexpr std::size_t size_class_count =
+		message_pool_params_t::max_pooled_size /
+		message_pool_params_t::size_class_granularity;
+
+static_assert( 0u == message_pool_params_t::max_pooled_size %
+		message_pool_params_t::size_class_granularity,
+		"max_pooled_size must be a multiple of size_class_granularity" );
+
+static_assert( message_pool_params_t::size_class_granularity >=
+		alignof(std::max_align_t),
+		"size_class_granularity must guarantee fundamental alignment" );
+
+//! Index of size class for a block of \a size bytes.
+/*!
+ * \pre 0 < size && size <= max_pooled_size.
+ */
+[[nodiscard]]
+constexpr std::size_t
+size_class_index( std::size_t size ) noexcept
+	{
+		return ( size - 1u ) / message_pool_params_t::size_class_granularity;
+	}
+
+//! Actual size of blocks of a size class.
+[[nodiscard]]
+constexpr std::size_t
+size_class_capacity( std::size_t index ) noexcept
+	{
+		return ( index + 1u ) * message_pool_params_t::size_class_granularity;
+	}
+
+[[nodiscard]]
+constexpr bool
+is_pooled_size( std::size_t size ) noexcept
+	{
+		return 0u != size && size <= message_pool_params_t::max_pooled_size;
+	}
+
+//! Free block is used as an item of intrusive list.
+struct free_block_t
+	{
+		free_block_t * m_next;
+	};
+
+//! Singly linked list of free blocks with a counter.
+struct block_list_t
+	{
+		free_block_t * m_head{ nullptr };
+		std::size_t m_count{};
+
+		void
+		push( free_block_t * block ) noexcept
+			{
+				block->m_next = m_head;
+				m_head = block;
+				++m_count;
+			}
+
+		[[nodiscard]]
+		free_block_t *
+		pop() noexcept
+			{
+				free_block_t * r = m_head;
+				m_head = r->m_next;
+				--m_count;
+				return r;
+			}
+
+		//! Move up to \a count blocks from the head of this list to \a to.
+		void
+		move_to( block_list_t & to, std::size_t count ) noexcept
+			{
+				while( count && m_head )
+					{
+						to.push( pop() );
+						--count;
+					}
+			}
+	};
+
+//
+// central_list_t
+//
+/*!
+ * \brief Central list of free blocks for one size class.
+ *
+ * This list is used for moving blocks between threads: a thread
+ * which releases more blocks than it allocates returns them here,
+ * a thread which allocates more than it releases takes them from here.
+ */
+struct central_list_t
+	{
+		default_spinlock_t m_lock;
+		block_list_t m_blocks;
+	};
+
+//
+// pool_t
+//
+/*!
+ * \brief The global state of the message pool.
+ */
+class pool_t
+	{
+	public :
+		[[nodiscard]]
+		bool
+		enabled() const noexcept
+			{
+				return m_enabled.load( std::memory_order_acquire );
+			}
+
+		void
+		enable( const message_pool_params_t & params ) noexcept
+			{
+				m_thread_cache_capacity.store(
+						params.thread_cache_capacity(),
+						std::memory_order_relaxed );
+				m_blocks_per_slab.store(
+						params.blocks_per_slab(),
+						std::memory_order_relaxed );
+				m_enabled.store( true, std::memory_order_release );
+			}
+
+		[[nodiscard]]
+		std::size_t
+		thread_cache_capacity() const noexcept
+			{
+				return m_thread_cache_capacity.load( std::memory_order_relaxed );
+			}
+
+		//! Take a batch of free blocks for a thread cache.
+		/*!
+		 * A new slab is allocated if the central list is empty.
+		 */
+		void
+		refill( std::size_t index, block_list_t & to )
+			{
+				const auto batch = ( thread_cache_capacity() + 1u ) / 2u;
+				{
+					auto & central = m_central[ index ];
+					std::lock_guard< default_spinlock_t > lock{ central.m_lock };
+					central.m_blocks.move_to( to, batch );
+				}
+
+				if( to.m_count )
+					m_central_refills.fetch_add( 1u, std::memory_order_relaxed );
+				else
+					allocate_slab( index, to );
+			}
+
+		//! Return \a count blocks from a thread cache to the central list.
+		void
+		give_back(
+			std::size_t index,
+			block_list_t & from,
+			std::size_t count ) noexcept
+			{
+				auto & central = m_central[ index ];
+				std::lock_guard< default_spinlock_t > lock{ central.m_lock };
+				from.move_to( central.m_blocks, count );
+
+				m_central_returns.fetch_add( 1u, std::memory_order_relaxed );
+			}
+
+		//! Return a single block directly to the central list.
+		/*!
+		 * Is used when a thread cache is already destroyed.
+		 */
+		void
+		give_back( std::size_t index, free_block_t * block ) noexcept
+			{
+				auto & central = m_central[ index ];
+				std::lock_guard< default_spinlock_t > lock{ central.m_lock };
+				central.m_blocks.push( block );
+			}
+
+		[[nodiscard]]
+		message_pool_stats_t
+		query_stats() const noexcept
+			{
+				message_pool_stats_t r;
+				r.m_enabled = enabled();
+				r.m_slabs_allocated = m_slabs_allocated.load(
+						std::memory_order_relaxed );
+				r.m_central_refills = m_central_refills.load(
+						std::memory_order_relaxed );
+				r.m_central_returns = m_central_returns.load(
+						std::memory_order_relaxed );
+
+				return r;
+			}
+
+	private :
+		std::atomic< bool > m_enabled{ false };
+		std::atomic< std::size_t > m_thread_cache_capacity{
+				message_pool_params_t::default_thread_cache_capacity };
+		std::atomic< std::size_t > m_blocks_per_slab{
+				message_pool_params_t::default_blocks_per_slab };
+
+		std::array< central_list_t, size_class_count > m_central;
+
+		std::atomic< std::size_t > m_slabs_allocated{};
+		std::atomic< std::size_t > m_central_refills{};
+		std::atomic< std::size_t > m_central_returns{};
+
+		void
+		allocate_slab( std::size_t index, block_list_t & to )
+			{
+				const auto block_size = size_class_capacity( index );
+				const auto blocks = m_blocks_per_slab.load(
+						std::memory_order_relaxed );
+
+				// Slabs are never deallocated.
+				auto * slab = static_cast< char * >(
+						::operator new( block_size * blocks ) );
+				for( std::size_t i = 0u; i != blocks; ++i )
+					to.push( reinterpret_cast< free_block_t * >(
+							slab + i * block_size ) );
+
+				m_slabs_allocated.fetch_add( 1u, std::memory_order_relaxed );
+			}
+	};
+
+/*!
+ * \brief Access to the global pool object.
+ *
+ * \note
+ * The pool object is never destroyed because message instances
+ * can be released during destruction of global objects.
+ */
+[[nodiscard]]
+pool_t &
+the_pool() noexcept
+	{
+		static pool_t * pool = new pool_t{};
+		return *pool;
+	}
+
+//! Is the cache of the current thread already destroyed?
+/*!
+ * This flag has a trivial type and is valid even during the
+ * destruction of other thread_local objects.
+ */
+thread_local bool t_cache_destroyed = false;
+
+//
+// thread_cache_t
+//
+/*!
+ * \brief Per-thread cache of free blocks.
+ */
+class thread_cache_t
+	{
+	public :
+		thread_cache_t() = default;
+		thread_cache_t( const thread_cache_t & ) = delete;
+		thread_cache_t & operator=( const thread_cache_t & ) = delete;
+
+		~thread_cache_t()
+			{
+				auto & pool = the_pool();
+				for( std::size_t i = 0u; i != size_class_count; ++i )
+					if( m_lists[ i ].m_count )
+						pool.give_back( i, m_lists[ i ], m_lists[ i ].m_count );
+
+				t_cache_destroyed = true;
+			}
+
+		[[nodiscard]]
+		void *
+		allocate( std::size_t index )
+			{
+				auto & list = m_lists[ index ];
+				if( !list.m_count )
+					the_pool().refill( index, list );
+
+				return list.pop();
+			}
+
+		void
+		deallocate( std::size_t index, void * ptr ) noexcept
+			{
+				auto & list = m_lists[ index ];
+				list.push( static_cast< free_block_t * >( ptr ) );
+
+				auto & pool = the_pool();
+				const auto capacity = pool.thread_cache_capacity();
+				if( list.m_count > capacity )
+					pool.give_back( index, list, list.m_count - capacity / 2u );
+			}
+
+	private :
+		std::array< block_list_t, size_class_count > m_lists;
+	};
+
+thread_local thread_cache_t t_cache;
+
+} /* namespace anonymous */
+
+SO_5_FUNC void
+enable( const message_pool_params_t & params )
+	{
+		the_pool().enable( params );
+	}
+
+SO_5_FUNC void *
+allocate( std::size_t size )
+	{
+		if( !is_pooled_size( size ) )
+			return ::operator new( size );
+
+		const auto index = size_class_index( size );
+		if( !the_pool().enabled() )
+			// Block has to be allocated with the size of the whole size class
+			// because it can be returned to the pool if the pool
+			// will be turned on during the lifetime of the message.
+			return ::operator new( size_class_capacity( index ) );
+
+		if( t_cache_destroyed )
+			{
+				// This thread is being finished. There is no need for caching.
+				block_list_t tmp;
+				the_pool().refill( index, tmp );
+				void * r = tmp.pop();
+				while( tmp.m_count )
+					the_pool().give_back( index, tmp.pop() );
+
+				return r;
+			}
+
+		return t_cache.allocate( index );
+	}
+
+SO_5_FUNC void
+deallocate( void * ptr, std::size_t size ) noexcept
+	{
+		if( !ptr )
+			return;
+
+		if( !is_pooled_size( size ) || !the_pool().enabled() )
+			{
+				// NOTE: the pool can't be turned off, so if it is turned off
+				// now then the block was allocated in the global heap.
+				::operator delete( ptr );
+				return;
+			}
+
+		const auto index = size_class_index( size );
+		if( t_cache_destroyed )
+			the_pool().give_back( index, static_cast< free_block_t * >( ptr ) );
+		else
+			t_cache.deallocate( index, ptr );
+	}
+
+} /* namespace message_pool */
+
+} /* namespace impl */
+
+SO_5_FUNC message_pool_stats_t
+query_message_pool_stats() noexcept
+	{
+		return impl::message_pool::the_pool().query_stats();
+	}
+
+} /* namespace so_5 */
+
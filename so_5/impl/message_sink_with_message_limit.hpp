@@ -12,6 +12,8 @@
 
 #include <so_5/impl/message_sink_for_agent.hpp>
 
+#include <so_5/details/rollback_on_exception.hpp>
+
 namespace so_5
 {
 
@@ -133,6 +135,89 @@ class message_sink_with_message_limit_t final
 						exception_guard.commit();
 					}
 			}
+
+		/*!
+		 * Places for as many messages as the limit allows are reserved
+		 * at once and those messages are pushed to the agent's queue
+		 * as one batch. The rest of messages are handled one by one by
+		 * push_event(), so the overlimit reaction is performed for them.
+		 */
+		void
+		push_event_batch(
+			mbox_id_t mbox_id,
+			message_delivery_mode_t delivery_mode,
+			const std::type_index & msg_type,
+			const message_ref_t * messages,
+			std::size_t count,
+			unsigned int redirection_deep,
+			const message_limit::impl::action_msg_tracer_t * tracer ) override
+			{
+				const auto accepted = reserve_places( count );
+				if( accepted )
+					{
+						if( tracer )
+							for( std::size_t i = 0u; i != accepted; ++i )
+								tracer->push_to_queue( this, owner_pointer() );
+
+						std::size_t pushed{};
+						so_5::details::do_with_rollback_on_exception(
+							[&] {
+								agent_t::call_push_event_batch(
+										owner_reference(),
+										std::addressof( m_control_block ),
+										mbox_id,
+										msg_type,
+										messages,
+										accepted,
+										pushed );
+							},
+							[&] {
+								m_control_block.m_count -=
+										static_cast< unsigned int >( accepted - pushed );
+							} );
+					}
+
+				for( std::size_t i = accepted; i != count; ++i )
+					push_event(
+							mbox_id,
+							delivery_mode,
+							msg_type,
+							messages[ i ],
+							redirection_deep,
+							tracer );
+			}
+
+	private:
+		//! Try to increment messages count for up to \a count messages.
+		/*!
+		 * \return the count of messages for that places are reserved.
+		 *
+		 * \since v.5.8.3
+		 */
+		[[nodiscard]]
+		std::size_t
+		reserve_places( std::size_t count ) noexcept
+			{
+				auto current = m_control_block.m_count.load(
+						std::memory_order_relaxed );
+				std::size_t accepted{};
+				do
+					{
+						const std::size_t free_places =
+								m_control_block.m_limit > current ?
+								m_control_block.m_limit - current : 0u;
+						accepted = ( count < free_places ? count : free_places );
+						if( !accepted )
+							break;
+					}
+				while( !m_control_block.m_count.compare_exchange_weak(
+						current,
+						current + static_cast< unsigned int >( accepted ),
+						std::memory_order_acq_rel,
+						std::memory_order_relaxed ) );
+
+				return accepted;
+			}
 	};
 
 } /* namespace impl */
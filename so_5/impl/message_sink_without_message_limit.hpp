@@ -63,6 +63,33 @@ class message_sink_without_message_limit_t final
 						msg_type,
 						message );
 			}
+
+		void
+		push_event_batch(
+			mbox_id_t mbox_id,
+			message_delivery_mode_t /*delivery_mode*/,
+			const std::type_index & msg_type,
+			const message_ref_t * messages,
+			std::size_t count,
+			unsigned int /*redirection_deep*/,
+			const message_limit::impl::action_msg_tracer_t * tracer ) override
+			{
+				if( tracer )
+					for( std::size_t i = 0u; i != count; ++i )
+						tracer->push_to_queue( this, owner_pointer() );
+
+				// There is no need in the number of pushed messages
+				// because there is no message limit.
+				std::size_t pushed{};
+				agent_t::call_push_event_batch(
+						owner_reference(),
+						nullptr /* no message limit */,
+						mbox_id,
+						msg_type,
+						messages,
+						count,
+						pushed );
+			}
 	};
 
 } /* namespace impl */
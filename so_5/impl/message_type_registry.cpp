@@ -0,0 +1,244 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \file
+ * \brief Implementation of the registry of message type IDs.
+ *
+ * \since v.5.8.3
+ */
+
+#include <so_5/message_type_id.hpp>
+
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace so_5
+{
+
+namespace impl
+{
+
+namespace message_type_registry
+{
+
+namespace
+{
+
+//! Capacity of the table for lock-free lookups.
+/*!
+ * \note
+ * Must be a power of 2.
+ */
+constexpr std::size_t lookup_table_capacity = 4096u;
+
+//! Max count of items in the table for lock-free lookups.
+/*!
+ * Types that don't fit into the table are still supported, but
+ * an attempt to get ID for them requires a lock.
+ */
+constexpr std::size_t lookup_table_max_items =
+		lookup_table_capacity / 4u * 3u;
+
+//! An item of the table for lock-free lookups.
+struct lookup_slot_t
+	{
+		//! Key: a pointer to the name of type.
+		/*!
+		 * Null for an empty slot. Once set it is never changed.
+		 */
+		std::atomic< const char * > m_key{ nullptr };
+
+		//! ID for the type.
+		/*!
+		 * Is set before m_key.
+		 */
+		std::atomic< std::uint32_t > m_id{};
+	};
+
+[[nodiscard]]
+std::size_t
+slot_index( const char * key ) noexcept
+	{
+		// Fibonacci hashing of the pointer value.
+		const auto h = static_cast< std::uint64_t >(
+				reinterpret_cast< std::uintptr_t >( key ) ) *
+				0x9E3779B97F4A7C15ull;
+		return static_cast< std::size_t >( h >> 32 ) &
+				( lookup_table_capacity - 1u );
+	}
+
+//
+// registry_t
+//
+/*!
+ * \brief The registry of message type IDs.
+ *
+ * The source of truth is a map from std::type_index to ID. It is
+ * protected by a mutex.
+ *
+ * To avoid locking and comparison of type names on every lookup
+ * there is a lock-free open-addressing table where the key is
+ * a pointer returned by std::type_info::name(). This pointer is the
+ * same for all std::type_index objects created for a type in
+ * a module. The same type can have different pointers to names in
+ * different modules (shared libraries), every such pointer gets
+ * its own item in the lookup table, but all of them refer to the
+ * same ID.
+ */
+class registry_t
+	{
+	public :
+		registry_t()
+			{
+				// ID 0 is reserved for void.
+				m_ids.emplace( std::type_index{ typeid(void) }, 0u );
+				m_types.emplace_back( typeid(void) );
+			}
+
+		[[nodiscard]]
+		message_type_id_t
+		id_for( const std::type_index & msg_type ) noexcept
+			{
+				const char * key = msg_type.name();
+				auto index = slot_index( key );
+				for( std::size_t i = 0u; i != lookup_table_capacity; ++i )
+					{
+						const auto & slot = m_lookup_table[ index ];
+						const char * k = slot.m_key.load( std::memory_order_acquire );
+						if( k == key )
+							return message_type_id_t{
+									slot.m_id.load( std::memory_order_relaxed ) };
+						if( !k )
+							break;
+
+						index = ( index + 1u ) & ( lookup_table_capacity - 1u );
+					}
+
+				return register_type( msg_type );
+			}
+
+		[[nodiscard]]
+		std::type_index
+		type_for( message_type_id_t id )
+			{
+				std::lock_guard< std::mutex > lock{ m_lock };
+				if( id.value() < m_types.size() )
+					return m_types[ id.value() ];
+
+				return std::type_index{ typeid(void) };
+			}
+
+	private :
+		std::array< lookup_slot_t, lookup_table_capacity > m_lookup_table;
+
+		std::mutex m_lock;
+
+		//! Count of occupied slots in m_lookup_table.
+		/*!
+		 * Is protected by m_lock.
+		 */
+		std::size_t m_lookup_table_items{};
+
+		//! IDs of registered types.
+		/*!
+		 * Is protected by m_lock.
+		 */
+		std::unordered_map< std::type_index, std::uint32_t > m_ids;
+
+		//! Registered types. An index in that vector is the ID of type.
+		/*!
+		 * Is protected by m_lock.
+		 */
+		std::vector< std::type_index > m_types;
+
+		[[nodiscard]]
+		message_type_id_t
+		register_type( const std::type_index & msg_type ) noexcept
+			{
+				std::lock_guard< std::mutex > lock{ m_lock };
+
+				auto it = m_ids.find( msg_type );
+				if( it == m_ids.end() )
+					{
+						const auto id = static_cast< std::uint32_t >( m_types.size() );
+						m_types.push_back( msg_type );
+						it = m_ids.emplace( msg_type, id ).first;
+					}
+
+				const message_type_id_t result{ it->second };
+				if( m_lookup_table_items < lookup_table_max_items )
+					add_to_lookup_table( msg_type.name(), result );
+
+				return result;
+			}
+
+		//! Add a new key to the lookup table.
+		/*!
+		 * \pre m_lock is acquired.
+		 */
+		void
+		add_to_lookup_table(
+			const char * key,
+			message_type_id_t id ) noexcept
+			{
+				auto index = slot_index( key );
+				for(;;)
+					{
+						auto & slot = m_lookup_table[ index ];
+						const char * k = slot.m_key.load( std::memory_order_relaxed );
+						if( k == key )
+							// Already added by another thread.
+							return;
+
+						if( !k )
+							{
+								slot.m_id.store( id.value(), std::memory_order_relaxed );
+								slot.m_key.store( key, std::memory_order_release );
+								++m_lookup_table_items;
+								return;
+							}
+
+						index = ( index + 1u ) & ( lookup_table_capacity - 1u );
+					}
+			}
+	};
+
+/*!
+ * \brief Access to the global registry.
+ *
+ * \note
+ * The registry is never destroyed because IDs can be requested
+ * during destruction of global objects.
+ */
+[[nodiscard]]
+registry_t &
+the_registry()
+	{
+		static registry_t * registry = new registry_t{};
+		return *registry;
+	}
+
+} /* namespace anonymous */
+
+} /* namespace message_type_registry */
+
+} /* namespace impl */
+
+SO_5_FUNC message_type_id_t
+message_type_id_for( const std::type_index & msg_type ) noexcept
+	{
+		return impl::message_type_registry::the_registry().id_for( msg_type );
+	}
+
+SO_5_FUNC std::type_index
+message_type_index_for( message_type_id_t id )
+	{
+		return impl::message_type_registry::the_registry().type_for( id );
+	}
+
+} /* namespace so_5 */
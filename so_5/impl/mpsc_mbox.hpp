@@ -17,6 +17,7 @@
 #include <so_5/spinlocks.hpp>
 
 #include <so_5/mbox.hpp>
+#include <so_5/message_type_id.hpp>
 #include <so_5/event_queue.hpp>
 #include <so_5/message_limit.hpp>
 
@@ -278,6 +279,55 @@ class mpsc_mbox_template_t final
 					} );
 			}
 
+		/*!
+		 * \note
+		 * Messages are passed to the subscriber at once only if message
+		 * delivery tracing is off and there is no delivery filter.
+		 * Otherwise they are delivered one by one via do_deliver_message().
+		 */
+		void
+		do_deliver_message_batch(
+			message_delivery_mode_t delivery_mode,
+			const std::type_index & msg_type,
+			const message_ref_t * messages,
+			std::size_t count,
+			unsigned int redirection_deep ) override
+			{
+				if constexpr( std::is_same_v<
+						Tracing_Base,
+						msg_tracing_helpers::tracing_disabled_base > )
+					{
+						const auto msg_type_id = message_type_id_for( msg_type );
+
+						read_lock_guard_t< default_rw_spinlock_t > lock{ m_lock };
+
+						const auto it = m_subscriptions.find( msg_type_id );
+						if( it == m_subscriptions.end() )
+							return;
+
+						const auto & info = it->second;
+						if( info.sink_pointer() && !info.has_filter() )
+							{
+								this->message_sink_to_use( info ).push_event_batch(
+										this->m_id,
+										delivery_mode,
+										msg_type,
+										messages,
+										count,
+										redirection_deep,
+										nullptr );
+								return;
+							}
+					}
+
+				abstract_message_box_t::do_deliver_message_batch(
+						delivery_mode,
+						msg_type,
+						messages,
+						count,
+						redirection_deep );
+			}
+
 		void
 		set_delivery_filter(
 			const std::type_index & msg_type,
@@ -332,10 +382,13 @@ class mpsc_mbox_template_t final
 		 * \brief Type of dictionary for information about the current
 		 * subscriptions.
 		 *
+		 * \note
+		 * Since v.5.8.3 the dense ID of message type is used as the key.
+		 *
 		 * \since v.5.7.1
 		 */
 		using subscriptions_map_t = std::map<
-				std::type_index,
+				message_type_id_t,
 				subscription_info_t >;
 
 		/*!
@@ -386,11 +439,12 @@ class mpsc_mbox_template_t final
 			Info_Maker maker,
 			Info_Changer changer )
 			{
-				auto it = m_subscriptions.find( msg_type );
+				const auto msg_type_id = message_type_id_for( msg_type );
+				auto it = m_subscriptions.find( msg_type_id );
 				if( it == m_subscriptions.end() )
 				{
 					// Subscription for that type has to be created.
-					m_subscriptions.emplace( msg_type, maker() );
+					m_subscriptions.emplace( msg_type_id, maker() );
 				}
 				else
 				{
@@ -411,7 +465,7 @@ class mpsc_mbox_template_t final
 			const std::type_index & msg_type,
 			Info_Changer changer )
 			{
-				auto it = m_subscriptions.find( msg_type );
+				auto it = m_subscriptions.find( message_type_id_for( msg_type ) );
 				if( it != m_subscriptions.end() )
 				{
 					changer( it->second );
@@ -440,9 +494,11 @@ class mpsc_mbox_template_t final
 			//! Lambda with actual delivery actions.
 			L l )
 			{
+				const auto msg_type_id = message_type_id_for( msg_type );
+
 				read_lock_guard_t< default_rw_spinlock_t > lock{ m_lock };
 
-				const auto it = m_subscriptions.find( msg_type );
+				const auto it = m_subscriptions.find( msg_type_id );
 				if( it != m_subscriptions.end() )
 					{
 						// Since v.5.7.4 we have to ask delivery_filter before the
@@ -0,0 +1,162 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \file
+ * \brief A cache of event handlers resolved for agent's states.
+ *
+ * \since v.5.8.3
+ */
+
+#pragma once
+
+#include <so_5/types.hpp>
+#include <so_5/message_type_id.hpp>
+#include <so_5/fwd.hpp>
+
+#include <functional>
+#include <unordered_map>
+
+namespace so_5
+{
+
+namespace impl
+{
+
+//
+// resolved_handlers_t
+//
+/*!
+ * \brief Result of the search for event handlers for a message.
+ *
+ * \since v.5.8.3
+ */
+struct resolved_handlers_t
+	{
+		//! Handler found in the current state or in one of its parents.
+		/*!
+		 * Null if there is no such handler.
+		 */
+		const event_handler_data_t * m_handler{ nullptr };
+
+		//! Deadletter handler for the message.
+		/*!
+		 * It's searched only if m_handler is null.
+		 */
+		const event_handler_data_t * m_deadletter_handler{ nullptr };
+	};
+
+//
+// resolved_handler_cache_t
+//
+/*!
+ * \brief A cache of event handlers resolved for agent's states.
+ *
+ * The search of an event handler for a nested state requires a lookup
+ * in the subscription storage for the state itself and then for every
+ * parent state until a handler is found (and then one more lookup for
+ * a deadletter handler if nothing was found). This cache holds the
+ * results of those searches, so an event for a deep state costs just
+ * one lookup in the cache.
+ *
+ * The key includes the pointer to the current state, so there is no
+ * need to invalidate the cache on state switches. The cache has to
+ * be cleared on every change of agent's subscriptions.
+ *
+ * \note
+ * This class isn't thread safe. All operations have to be performed
+ * on agent's working context.
+ *
+ * \since v.5.8.3
+ */
+class resolved_handler_cache_t
+	{
+	public :
+		//! Get resolved handlers from the cache or resolve them.
+		/*!
+		 * \a resolver is called if there is no item for the key.
+		 * It has to return resolved_handlers_t.
+		 *
+		 * \note
+		 * If the result of \a resolver can't be stored in the cache
+		 * (because of an exception) then the result is returned as is.
+		 */
+		template< typename Resolver >
+		[[nodiscard]]
+		resolved_handlers_t
+		find_or_resolve(
+			const state_t & state,
+			mbox_id_t mbox_id,
+			message_type_id_t msg_type,
+			Resolver && resolver )
+			{
+				const key_t key{ &state, mbox_id, msg_type };
+
+				const auto it = m_items.find( key );
+				if( it != m_items.end() )
+					return it->second;
+
+				const resolved_handlers_t result = resolver();
+				try
+					{
+						m_items.emplace( key, result );
+					}
+				catch( ... )
+					{
+						// The item isn't cached, it will be resolved next time.
+					}
+
+				return result;
+			}
+
+		//! Remove all cached items.
+		void
+		clear() noexcept
+			{
+				m_items.clear();
+			}
+
+	private :
+		//! Type of key for the cache.
+		struct key_t
+			{
+				const state_t * m_state;
+				mbox_id_t m_mbox_id;
+				message_type_id_t m_msg_type;
+
+				[[nodiscard]]
+				bool
+				operator==( const key_t & o ) const noexcept
+					{
+						return m_state == o.m_state &&
+								m_mbox_id == o.m_mbox_id &&
+								m_msg_type == o.m_msg_type;
+					}
+			};
+
+		//! Hash function for the key.
+		struct hash_t
+			{
+				[[nodiscard]]
+				std::size_t
+				operator()( const key_t & k ) const noexcept
+					{
+						// See the description of boost::hash_combine.
+						const auto h1 = std::hash< mbox_id_t >{}( k.m_mbox_id );
+						const auto h2 = h1 ^
+								( std::hash< message_type_id_t >{}( k.m_msg_type ) +
+								 	0x9e3779b9 + (h1 << 6) + (h1 >> 2) );
+
+						return h2 ^ ( std::hash< const state_t * >{}( k.m_state ) +
+								0x9e3779b9 + (h2 << 6) + (h2 >> 2) );
+					}
+			};
+
+		//! Cached items.
+		std::unordered_map< key_t, resolved_handlers_t, hash_t > m_items;
+	};
+
+} /* namespace impl */
+
+} /* namespace so_5 */
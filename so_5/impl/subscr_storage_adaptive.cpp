@@ -78,7 +78,7 @@ class storage_t : public subscription_storage_t
 		const event_handler_data_t *
 		find_handler(
 			mbox_id_t mbox_id,
-			const std::type_index & msg_type,
+			message_type_id_t msg_type,
 			const state_t & current_state ) const noexcept override;
 
 		void
@@ -186,7 +186,7 @@ storage_t::drop_all_subscriptions() noexcept
 const event_handler_data_t *
 storage_t::find_handler(
 	mbox_id_t mbox_id,
-	const std::type_index & msg_type,
+	message_type_id_t msg_type,
 	const state_t & current_state ) const noexcept
 	{
 		return m_current_storage->find_handler(
@@ -40,14 +40,18 @@ struct key_t
 	//! Unique ID of mbox.
 	mbox_id_t m_mbox_id;
 	//! Message type.
-	std::type_index m_msg_type;
+	/*!
+	 * \note
+	 * Since v.5.8.3 it's a dense ID of message type.
+	 */
+	message_type_id_t m_msg_type;
 	//! State of agent.
 	const state_t * m_state;
 
 	//! Default constructor.
 	inline key_t()
 		:	m_mbox_id( null_mbox_id() )
-		,	m_msg_type( typeid(void) )
+		,	m_msg_type()
 		,	m_state( nullptr )
 		{}
 
@@ -55,7 +59,7 @@ struct key_t
 	//! find all keys with (mbox_id, msg_type) prefix.
 	inline key_t(
 		mbox_id_t mbox_id,
-		std::type_index msg_type )
+		message_type_id_t msg_type )
 		:	m_mbox_id( mbox_id )
 		,	m_msg_type( msg_type )
 		,	m_state( nullptr )
@@ -64,7 +68,7 @@ struct key_t
 	//! Initializing constructor.
 	inline key_t(
 		mbox_id_t mbox_id,
-		std::type_index msg_type,
+		message_type_id_t msg_type,
 		const state_t & state )
 		:	m_mbox_id( mbox_id )
 		,	m_msg_type( msg_type )
@@ -125,7 +129,7 @@ struct hash_t
 				const auto h1 =
 					std::hash< so_5::mbox_id_t >()( ptr->m_mbox_id );
 				const auto h2 = h1 ^
-					(std::hash< std::type_index >()( ptr->m_msg_type ) +
+					(std::hash< message_type_id_t >()( ptr->m_msg_type ) +
 					 	0x9e3779b9 + (h1 << 6) + (h1 >> 2));
 
 				return h2 ^ (std::hash< const state_t * >()(
@@ -237,7 +241,7 @@ class storage_t : public subscription_storage_t
 		const event_handler_data_t *
 		find_handler(
 			mbox_id_t mbox_id,
-			const std::type_index & msg_type,
+			message_type_id_t msg_type,
 			const state_t & current_state ) const noexcept override;
 
 		void
@@ -262,6 +266,11 @@ class storage_t : public subscription_storage_t
 		struct mbox_with_sink_info_t
 			{
 				mbox_t m_mbox;
+				//! Type of message.
+				/*!
+				 * \since v.5.8.3
+				 */
+				std::type_index m_msg_type;
 				std::reference_wrapper< abstract_message_sink_t > m_message_sink;
 			};
 
@@ -310,11 +319,11 @@ storage_t::create_event_subscription(
 	{
 		using namespace subscription_storage_common;
 
-		key_t key{ mbox->id(), type_index, target_state };
+		key_t key{ mbox->id(), message_type_id_for( type_index ), target_state };
 
 		auto insertion_result = m_map.emplace(
 				key,
-				mbox_with_sink_info_t{ mbox, std::ref(message_sink) } );
+				mbox_with_sink_info_t{ mbox, type_index, std::ref(message_sink) } );
 
 		if( !insertion_result.second )
 			SO_5_THROW_EXCEPTION(
@@ -352,7 +361,7 @@ storage_t::drop_subscription(
 	const std::type_index & type_index,
 	const state_t & target_state ) noexcept
 	{
-		key_t key( mbox_ref->id(), type_index, target_state );
+		key_t key( mbox_ref->id(), message_type_id_for( type_index ), target_state );
 
 		auto it = m_map.find( key );
 
@@ -379,7 +388,7 @@ storage_t::drop_subscription_for_all_states(
 	const mbox_t & mbox_ref,
 	const std::type_index & type_index ) noexcept
 	{
-		const key_t key( mbox_ref->id(), type_index );
+		const key_t key( mbox_ref->id(), message_type_id_for( type_index ) );
 
 		auto it = m_map.lower_bound( key );
 		auto need_erase = [&] {
@@ -414,7 +423,7 @@ storage_t::drop_all_subscriptions() noexcept
 const event_handler_data_t *
 storage_t::find_handler(
 	mbox_id_t mbox_id,
-	const std::type_index & msg_type,
+	message_type_id_t msg_type,
 	const state_t & current_state ) const noexcept
 	{
 		key_t k( mbox_id, msg_type, current_state );
@@ -430,7 +439,7 @@ storage_t::debug_dump( std::ostream & to ) const
 	{
 		for( const auto & v : m_map )
 			to << "{" << v.first.m_mbox_id << ", "
-					<< v.first.m_msg_type.name() << ", "
+					<< v.second.m_msg_type.name() << ", "
 					<< v.first.m_state->query_name() << "}"
 					<< std::endl;
 	}
@@ -449,7 +458,7 @@ storage_t::destroy_all_subscriptions() noexcept
 							!previous->first.is_same_mbox_msg_pair( i.first ) )
 						{
 							i.second.m_mbox->unsubscribe_event_handler(
-								i.first.m_msg_type,
+								i.second.m_msg_type,
 								i.second.m_message_sink.get() );
 						}
 
@@ -488,7 +497,7 @@ storage_t::query_content() const
 
 							return subscr_info_t {
 									map_item->second.m_mbox,
-									map_item->first.m_msg_type,
+									map_item->second.m_msg_type,
 									map_item->second.m_message_sink.get(),
 									*(map_item->first.m_state),
 									i.second.m_method,
@@ -514,12 +523,13 @@ storage_t::setup_content(
 		for_each( begin(info), end(info),
 			[&]( const subscr_info_t & i )
 			{
-				key_t k{ i.m_mbox->id(), i.m_msg_type, *(i.m_state) };
+				key_t k{ i.m_mbox->id(), i.m_msg_type_id, *(i.m_state) };
 
 				auto ins_result = fresh_map.emplace(
 						k,
 						mbox_with_sink_info_t{
 								i.m_mbox,
+								i.m_msg_type,
 								i.m_message_sink
 						} );
 
@@ -75,7 +75,7 @@ class storage_t : public subscription_storage_t
 		const event_handler_data_t *
 		find_handler(
 			mbox_id_t mbox_id,
-			const std::type_index & msg_type,
+			message_type_id_t msg_type,
 			const state_t & current_state ) const noexcept override;
 
 		void
@@ -99,15 +99,15 @@ class storage_t : public subscription_storage_t
 		struct key_t
 			{
 				mbox_id_t m_mbox_id;
-				std::type_index m_msg_type;
+				message_type_id_t m_msg_type;
 				const state_t * m_state;
 
 				key_t(
 					mbox_id_t mbox_id,
-					std::type_index msg_type,
+					message_type_id_t msg_type,
 					const state_t * state )
 					:	m_mbox_id( mbox_id )
-					,	m_msg_type( std::move( msg_type ) )
+					,	m_msg_type( msg_type )
 					,	m_state( state )
 					{}
 
@@ -139,6 +139,13 @@ class storage_t : public subscription_storage_t
 				 */
 				const mbox_t m_mbox;
 
+				/*!
+				 * Type of message.
+				 *
+				 * \since v.5.8.3
+				 */
+				const std::type_index m_msg_type;
+
 				/*!
 				 * Message sink used for that mbox.
 				 */
@@ -167,7 +174,7 @@ namespace
 	auto
 	find( C & c,
 		const mbox_id_t & mbox_id,
-		const std::type_index & msg_type,
+		message_type_id_t msg_type,
 		const state_t & target_state ) -> decltype( c.begin() )
 		{
 			return c.find( typename C::key_type {
@@ -177,7 +184,7 @@ namespace
 	struct is_same_mbox_msg
 		{
 			const mbox_id_t m_id;
-			const std::type_index & m_type;
+			const message_type_id_t m_type;
 
 			template< class K >
 			[[nodiscard]]
@@ -234,10 +241,11 @@ storage_t::create_event_subscription(
 		using namespace subscription_storage_common;
 
 		const auto mbox_id = mbox->id();
+		const auto msg_type_id = message_type_id_for( msg_type );
 
 		// Check that this subscription is new.
 		auto existed_position = find(
-				m_events, mbox_id, msg_type, target_state );
+				m_events, mbox_id, msg_type_id, target_state );
 
 		if( existed_position != m_events.end() )
 			SO_5_THROW_EXCEPTION(
@@ -247,9 +255,10 @@ storage_t::create_event_subscription(
 
 		// Just add subscription to the end.
 		auto ins_result = m_events.emplace(
-					key_t { mbox_id, msg_type, &target_state },
+					key_t { mbox_id, msg_type_id, &target_state },
 					value_t {
 							mbox,
+							msg_type,
 							std::ref( message_sink ),
 							event_handler_data_t {
 									method,
@@ -286,7 +295,7 @@ storage_t::drop_subscription(
 	const state_t & target_state ) noexcept
 	{
 		auto existed_position = find(
-				m_events, mbox->id(), msg_type, target_state );
+				m_events, mbox->id(), message_type_id_for( msg_type ), target_state );
 		if( existed_position != m_events.end() )
 			{
 				// Note v.5.5.9 unsubscribe_event_handler is called for
@@ -317,10 +326,11 @@ storage_t::drop_subscription_for_all_states(
 	const mbox_t & mbox,
 	const std::type_index & msg_type ) noexcept
 	{
-		const is_same_mbox_msg is_same{ mbox->id(), msg_type };
+		const auto msg_type_id = message_type_id_for( msg_type );
+		const is_same_mbox_msg is_same{ mbox->id(), msg_type_id };
 
 		auto lower_bound = m_events.lower_bound(
-				key_t{ mbox->id(), msg_type, nullptr } );
+				key_t{ mbox->id(), msg_type_id, nullptr } );
 
 		auto need_erase = [&] {
 				return lower_bound != std::end(m_events) &&
@@ -358,7 +368,7 @@ storage_t::drop_all_subscriptions() noexcept
 const event_handler_data_t *
 storage_t::find_handler(
 	mbox_id_t mbox_id,
-	const std::type_index & msg_type,
+	message_type_id_t msg_type,
 	const state_t & current_state ) const noexcept
 	{
 		auto it = find( m_events, mbox_id, msg_type, current_state );
@@ -374,7 +384,7 @@ storage_t::debug_dump( std::ostream & to ) const
 	{
 		for( const auto & e : m_events )
 			to << "{" << e.first.m_mbox_id << ", "
-					<< e.first.m_msg_type.name() << ", "
+					<< e.second.m_msg_type.name() << ", "
 					<< e.first.m_state->query_name() << "}"
 					<< std::endl;
 	}
@@ -394,7 +404,7 @@ storage_t::destroy_all_subscriptions() noexcept
 						cur->first.m_msg_type }( it->first ) )
 					{
 						cur->second.m_mbox->unsubscribe_event_handler(
-								cur->first.m_msg_type,
+								cur->second.m_msg_type,
 								cur->second.m_message_sink.get() );
 					}
 
@@ -426,7 +436,7 @@ storage_t::query_content() const
 						{
 							return subscr_info_t(
 									e.second.m_mbox,
-									e.first.m_msg_type,
+									e.second.m_msg_type,
 									e.second.m_message_sink.get(),
 									*(e.first.m_state),
 									e.second.m_handler.m_method,
@@ -453,11 +463,12 @@ storage_t::setup_content(
 					return subscr_map_t::value_type {
 							key_t {
 								i.m_mbox->id(),
-								i.m_msg_type,
+								i.m_msg_type_id,
 								i.m_state
 							},
 							value_t {
 								i.m_mbox,
+								i.m_msg_type,
 								i.m_message_sink,
 								i.m_handler
 							} };
@@ -80,7 +80,7 @@ class storage_t : public subscription_storage_t
 		const event_handler_data_t *
 		find_handler(
 			mbox_id_t mbox_id,
-			const std::type_index & msg_type,
+			message_type_id_t msg_type,
 			const state_t & current_state ) const noexcept override;
 
 		void
@@ -109,13 +109,13 @@ class storage_t : public subscription_storage_t
 		struct is_same_mbox_msg
 			{
 				const mbox_id_t m_id;
-				const std::type_index & m_type;
+				const message_type_id_t m_type;
 
 				bool
 				operator()( const info_t & info ) const
 					{
 						return m_id == info.m_mbox->id() &&
-								m_type == info.m_msg_type;
+								m_type == info.m_msg_type_id;
 					}
 			};
 
@@ -132,7 +132,7 @@ namespace
 	auto
 	find( Container & c,
 		const mbox_id_t & mbox_id,
-		const std::type_index & msg_type,
+		message_type_id_t msg_type,
 		const state_t & target_state ) -> decltype( c.begin() )
 		{
 			using namespace std;
@@ -140,7 +140,7 @@ namespace
 			return find_if( begin( c ), end( c ),
 				[&]( typename Container::value_type const & o ) {
 					return ( o.m_mbox->id() == mbox_id &&
-						o.m_msg_type == msg_type &&
+						o.m_msg_type_id == msg_type &&
 						o.m_state == &target_state );
 				} );
 		}
@@ -172,6 +172,7 @@ storage_t::create_event_subscription(
 		using namespace subscription_storage_common;
 
 		const auto mbox_id = mbox->id();
+		const auto msg_type_id = message_type_id_for( msg_type );
 
 		// Check that this subscription is new.
 		bool has_subscriptions_from_that_mbox = false;
@@ -179,7 +180,7 @@ storage_t::create_event_subscription(
 				it != it_end; ++it )
 			{
 				if( it->m_mbox->id() == mbox_id &&
-						it->m_msg_type == msg_type )
+						it->m_msg_type_id == msg_type_id )
 					{
 						has_subscriptions_from_that_mbox = true;
 						if( it->m_state == std::addressof(target_state) )
@@ -232,6 +233,7 @@ storage_t::drop_subscription(
 		using namespace std;
 
 		const auto mbox_id = mbox->id();
+		const auto msg_type_id = message_type_id_for( msg_type );
 
 		// Try to find a subscription. And calculate number of subscriptions
 		// from the same mbox for same msg_type.
@@ -242,7 +244,7 @@ storage_t::drop_subscription(
 		for(; it != it_end; ++it )
 			{
 				if( it->m_mbox->id() == mbox_id &&
-						it->m_msg_type == msg_type )
+						it->m_msg_type_id == msg_type_id )
 					{
 						++number_of_subscriptions;
 						if( it->m_state == std::addressof(target_state) )
@@ -269,7 +271,7 @@ storage_t::drop_subscription(
 					{
 						// Maybe there are subscriptions in the right part of m_events?
 						if( m_events.end() != std::find_if( it, m_events.end(),
-								is_same_mbox_msg{ mbox_id, msg_type } ) )
+								is_same_mbox_msg{ mbox_id, msg_type_id } ) )
 							number_of_subscriptions = 1;
 					}
 
@@ -292,7 +294,8 @@ storage_t::drop_subscription_for_all_states(
 	{
 		using namespace std;
 
-		const auto predicate = is_same_mbox_msg{ mbox->id(), msg_type };
+		const auto predicate = is_same_mbox_msg{
+				mbox->id(), message_type_id_for( msg_type ) };
 		if( auto it =
 				find_if( begin( m_events ), end( m_events ), predicate );
 				it != end( m_events ) )
@@ -323,7 +326,7 @@ storage_t::drop_all_subscriptions() noexcept
 const event_handler_data_t *
 storage_t::find_handler(
 	mbox_id_t mbox_id,
-	const std::type_index & msg_type,
+	message_type_id_t msg_type,
 	const state_t & current_state ) const noexcept
 	{
 		auto it = find( m_events, mbox_id, msg_type, current_state );
@@ -362,7 +365,7 @@ storage_t::destroy_all_subscriptions() noexcept
 				{
 					return a.m_mbox->id() < b.m_mbox->id() ||
 							( a.m_mbox->id() == b.m_mbox->id() &&
-							 a.m_msg_type < b.m_msg_type );
+							 a.m_msg_type_id < b.m_msg_type_id );
 				} );
 
 		// Step two.
@@ -383,7 +386,7 @@ storage_t::destroy_all_subscriptions() noexcept
 					{
 						const auto & next_info = m_events[ i+j ];
 						if( current_info.m_mbox->id() != next_info.m_mbox->id() ||
-								current_info.m_msg_type != next_info.m_msg_type )
+								current_info.m_msg_type_id != next_info.m_msg_type_id )
 							break;
 					}
 
@@ -15,6 +15,7 @@
 #include <so_5/types.hpp>
 
 #include <so_5/mbox.hpp>
+#include <so_5/message_type_id.hpp>
 #include <so_5/state.hpp>
 #include <so_5/execution_demand.hpp>
 #include <so_5/subscription_storage_fwd.hpp>
@@ -87,6 +88,11 @@ struct subscr_info_t
 		 */
 		mbox_t m_mbox;
 		std::type_index m_msg_type;
+		//! Dense ID of message type.
+		/*!
+		 * \since v.5.8.3
+		 */
+		message_type_id_t m_msg_type_id;
 		//! Message sink used for subscription.
 		std::reference_wrapper< abstract_message_sink_t > m_message_sink;
 		const state_t * m_state;
@@ -102,6 +108,7 @@ struct subscr_info_t
 			event_handler_kind_t handler_kind )
 			:	m_mbox( std::move( mbox ) )
 			,	m_msg_type( std::move( msg_type ) )
+			,	m_msg_type_id( message_type_id_for( m_msg_type ) )
 			,	m_message_sink( message_sink )
 			,	m_state( &state )
 			,	m_handler( method, thread_safety, handler_kind )
@@ -197,10 +204,14 @@ class subscription_storage_t
 		virtual void
 		drop_all_subscriptions() noexcept = 0;
 
+		/*!
+		 * \note
+		 * Since v.5.8.3 message type is specified by its dense ID.
+		 */
 		virtual const event_handler_data_t *
 		find_handler(
 			mbox_id_t mbox_id,
-			const std::type_index & msg_type,
+			message_type_id_t msg_type,
 			const state_t & current_state ) const noexcept = 0;
 
 		virtual void
@@ -280,6 +280,41 @@ class SO_5_TYPE abstract_message_box_t : protected atomic_refcounted_t
 			//! Current deep of overlimit reaction recursion.
 			unsigned int redirection_deep ) = 0;
 
+		/*!
+		 * \brief Deliver several messages of the same type to all
+		 * subscribers with respect to message limits.
+		 *
+		 * This method is used by so_5::send_batch(). An implementation
+		 * is expected to find subscribers for \a msg_type only once and
+		 * to pass all messages to every subscriber at once (see
+		 * abstract_message_sink_t::push_event_batch()).
+		 *
+		 * The default implementation calls do_deliver_message() for
+		 * every message.
+		 *
+		 * \since v.5.8.3
+		 */
+		virtual void
+		do_deliver_message_batch(
+			//! Can the delivery blocks the current thread?
+			message_delivery_mode_t delivery_mode,
+			//! Type of the messages to deliver.
+			const std::type_index & msg_type,
+			//! Pointer to the first message to be delivered.
+			const message_ref_t * messages,
+			//! Count of messages to be delivered.
+			std::size_t count,
+			//! Current deep of overlimit reaction recursion.
+			unsigned int redirection_deep )
+			{
+				for( std::size_t i = 0u; i != count; ++i )
+					this->do_deliver_message(
+							delivery_mode,
+							msg_type,
+							messages[ i ],
+							redirection_deep );
+			}
+
 		/*!
 		 * \name Methods for working with delivery filters.
 		 * \{
@@ -457,6 +492,39 @@ deliver_signal(
 			1u );
 	}
 
+//! Deliver several messages of the same type.
+/*!
+ * All messages are delivered via one call to
+ * abstract_message_box_t::do_deliver_message_batch().
+ *
+ * \note
+ * This function is a part of low-level SObjectizer's interface.
+ * Because of that this function can be removed or changed in some
+ * future version without prior notice.
+ *
+ * \since v.5.8.3
+ */
+inline void
+deliver_message_batch(
+	//! Can the delivery blocks the current thread?
+	message_delivery_mode_t delivery_mode,
+	//! Destination for messages.
+	abstract_message_box_t & target,
+	//! Subscription type for messages.
+	const std::type_index & subscription_type,
+	//! Pointer to the first message.
+	const message_ref_t * messages,
+	//! Count of messages.
+	std::size_t count )
+	{
+		target.do_deliver_message_batch(
+				delivery_mode,
+				subscription_type,
+				messages,
+				count,
+				1u );
+	}
+
 } /* namespace low_level_api */
 
 } /* namespace so_5 */
@@ -13,6 +13,7 @@
 #include <so_5/exception.hpp>
 #include <so_5/atomic_refcounted.hpp>
 #include <so_5/types.hpp>
+#include <so_5/message_pool.hpp>
 
 #include <so_5/agent_ref_fwd.hpp>
 
@@ -21,6 +22,7 @@
 #include <functional>
 #include <future>
 #include <atomic>
+#include <new>
 
 namespace so_5
 {
@@ -65,6 +67,64 @@ class SO_5_TYPE message_t : public atomic_refcounted_t
 
 		virtual ~message_t() noexcept = default;
 
+		/*!
+		 * \name Allocation of message instances.
+		 *
+		 * Instances of all message types are allocated via the message pool
+		 * if it is turned on (see message_pool_params_t). Otherwise the
+		 * global heap is used.
+		 *
+		 * \note
+		 * Because message_t has a virtual destructor the sized form of
+		 * operator delete receives the size of the most derived type.
+		 *
+		 * \since v.5.8.3
+		 * \{
+		 */
+		[[nodiscard]]
+		static void *
+		operator new( std::size_t size )
+			{
+				return impl::message_pool::allocate( size );
+			}
+
+		static void
+		operator delete( void * ptr, std::size_t size ) noexcept
+			{
+				impl::message_pool::deallocate( ptr, size );
+			}
+
+		// Over-aligned types are always allocated in the global heap.
+		[[nodiscard]]
+		static void *
+		operator new( std::size_t size, std::align_val_t alignment )
+			{
+				return ::operator new( size, alignment );
+			}
+
+		static void
+		operator delete(
+			void * ptr, std::size_t size, std::align_val_t alignment ) noexcept
+			{
+				::operator delete( ptr, size, alignment );
+			}
+
+		// Placement forms have to be declared explicitly because
+		// the declarations above hide the global ones.
+		[[nodiscard]]
+		static void *
+		operator new( std::size_t, void * place ) noexcept
+			{
+				return place;
+			}
+
+		static void
+		operator delete( void *, void * ) noexcept
+			{}
+		/*!
+		 * \}
+		 */
+
 		/*!
 		 * \brief Helper method for safe get of message mutability flag.
 		 *
@@ -0,0 +1,205 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \file
+ * \brief Pooled allocation of message instances.
+ *
+ * \since v.5.8.3
+ */
+
+#pragma once
+
+#include <so_5/declspec.hpp>
+
+#include <cstddef>
+
+namespace so_5
+{
+
+//
+// message_pool_params_t
+//
+/*!
+ * \brief Parameters for pooled allocation of message instances.
+ *
+ * Pooled allocation is turned off by default. It can be turned on
+ * via environment_params_t::message_pool():
+ * \code
+ * so_5::launch( [](so_5::environment_t & env) {...},
+ * 	[](so_5::environment_params_t & params) {
+ * 		params.message_pool( so_5::message_pool_params_t{}
+ * 			.thread_cache_capacity( 512u )
+ * 			.blocks_per_slab( 128u ) );
+ * 	} );
+ * \endcode
+ *
+ * When the pool is turned on instances of all types derived from
+ * message_t (including user_type_message_t<T>) whose size doesn't exceed
+ * message_pool_params_t::max_pooled_size are allocated from per-size-class
+ * slabs. Every thread has its own cache of free blocks for every
+ * size class, so allocation and deallocation of a message in the
+ * steady state is just a pop/push on a thread-local list. Blocks which
+ * are released on another thread (the typical case: a message is created
+ * by a sender and destroyed by a receiver) are moved between threads
+ * by batches via central per-size-class return lists.
+ *
+ * \attention
+ * Once turned on the pool remains active until the end of the process.
+ * It is because message instances can outlive the environment which
+ * turned the pool on. Memory of slabs is never returned to the
+ * global heap.
+ *
+ * \since v.5.8.3
+ */
+class message_pool_params_t
+	{
+	public :
+		//! Granularity of size classes.
+		static constexpr std::size_t size_class_granularity = 16u;
+
+		//! Max size of message instance to be allocated from the pool.
+		/*!
+		 * Bigger messages are always allocated in the global heap.
+		 */
+		static constexpr std::size_t max_pooled_size = 256u;
+
+		//! Default capacity of a per-thread cache for one size class.
+		static constexpr std::size_t default_thread_cache_capacity = 256u;
+
+		//! Default count of blocks in a new slab.
+		static constexpr std::size_t default_blocks_per_slab = 64u;
+
+		message_pool_params_t() = default;
+
+		//! Set max count of free blocks in a per-thread cache for
+		//! one size class.
+		/*!
+		 * If the count of free blocks exceeds that value then a half
+		 * of them is returned to the central list.
+		 *
+		 * \note
+		 * Zero value is replaced by 1.
+		 */
+		message_pool_params_t &
+		thread_cache_capacity( std::size_t v ) noexcept
+			{
+				m_thread_cache_capacity = ( v ? v : 1u );
+				return *this;
+			}
+
+		[[nodiscard]]
+		std::size_t
+		thread_cache_capacity() const noexcept
+			{
+				return m_thread_cache_capacity;
+			}
+
+		//! Set count of blocks to be allocated at once in a new slab.
+		/*!
+		 * \note
+		 * Zero value is replaced by 1.
+		 */
+		message_pool_params_t &
+		blocks_per_slab( std::size_t v ) noexcept
+			{
+				m_blocks_per_slab = ( v ? v : 1u );
+				return *this;
+			}
+
+		[[nodiscard]]
+		std::size_t
+		blocks_per_slab() const noexcept
+			{
+				return m_blocks_per_slab;
+			}
+
+	private :
+		//! Max count of free blocks in a per-thread cache.
+		std::size_t m_thread_cache_capacity{ default_thread_cache_capacity };
+
+		//! Count of blocks in a new slab.
+		std::size_t m_blocks_per_slab{ default_blocks_per_slab };
+	};
+
+//
+// message_pool_stats_t
+//
+/*!
+ * \brief Statistics of the message pool.
+ *
+ * \note
+ * Values are collected only on slow paths (refilling of a thread cache
+ * from the central list, returning blocks to the central list, creation
+ * of new slabs). There is no overhead for the fast path.
+ *
+ * \since v.5.8.3
+ */
+struct message_pool_stats_t
+	{
+		//! Is the pool turned on?
+		bool m_enabled{ false };
+
+		//! Total count of slabs allocated so far.
+		std::size_t m_slabs_allocated{};
+
+		//! Count of refills of thread caches from the central lists.
+		std::size_t m_central_refills{};
+
+		//! Count of batches returned from thread caches to the central lists.
+		std::size_t m_central_returns{};
+	};
+
+/*!
+ * \brief Get the current statistics of the message pool.
+ *
+ * \since v.5.8.3
+ */
+[[nodiscard]]
+SO_5_FUNC message_pool_stats_t
+query_message_pool_stats() noexcept;
+
+namespace impl
+{
+
+namespace message_pool
+{
+
+/*!
+ * \brief Turn the message pool on (or update its parameters if
+ * the pool is already turned on).
+ *
+ * \note
+ * This function is intended to be called by environment_t.
+ *
+ * \since v.5.8.3
+ */
+SO_5_FUNC void
+enable( const message_pool_params_t & params );
+
+/*!
+ * \brief Allocate a memory block for a message instance.
+ *
+ * \since v.5.8.3
+ */
+[[nodiscard]]
+SO_5_FUNC void *
+allocate( std::size_t size );
+
+/*!
+ * \brief Deallocate a memory block of a message instance.
+ *
+ * \a size must be the same value that was passed to allocate().
+ *
+ * \since v.5.8.3
+ */
+SO_5_FUNC void
+deallocate( void * ptr, std::size_t size ) noexcept;
+
+} /* namespace message_pool */
+
+} /* namespace impl */
+
+} /* namespace so_5 */
+
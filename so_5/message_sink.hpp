@@ -134,6 +134,48 @@ class SO_5_TYPE abstract_message_sink_t
 			//! NOTE: it will be nullptr when message delivery tracing if off.
 			const message_limit::impl::action_msg_tracer_t * tracer ) = 0;
 
+		//! Get several messages of the same type and push them to the
+		//! appropriate destination.
+		/*!
+		 * This method is used for delivery of a batch of messages
+		 * (see so_5::send_batch()). Message sinks for agents override it
+		 * to push all messages into the agent's event queue at once.
+		 *
+		 * The default implementation calls push_event() for every message.
+		 *
+		 * \note
+		 * All rules for push_event() are applicable to this method too.
+		 *
+		 * \since v.5.8.3
+		 */
+		virtual void
+		push_event_batch(
+			//! ID of mbox from that the messages are received.
+			mbox_id_t mbox_id,
+			//! Delivery mode for this delivery attempt.
+			message_delivery_mode_t delivery_mode,
+			//! Type of messages to be delivered.
+			const std::type_index & msg_type,
+			//! Pointer to the first message to be delivered.
+			const message_ref_t * messages,
+			//! Count of messages to be delivered.
+			std::size_t count,
+			//! The current deep of message redirection between mboxes and msinks.
+			unsigned int redirection_deep,
+			//! Message delivery tracer to be used inside overlimit reaction.
+			//! NOTE: it will be nullptr when message delivery tracing if off.
+			const message_limit::impl::action_msg_tracer_t * tracer )
+			{
+				for( std::size_t i = 0u; i != count; ++i )
+					this->push_event(
+							mbox_id,
+							delivery_mode,
+							msg_type,
+							messages[ i ],
+							redirection_deep,
+							tracer );
+			}
+
 		[[nodiscard]]
 		static bool
 		special_sink_ptr_compare(
@@ -0,0 +1,147 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \file
+ * \brief Dense identifiers of message types.
+ *
+ * \since v.5.8.3
+ */
+
+#pragma once
+
+#include <so_5/declspec.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <typeindex>
+
+namespace so_5
+{
+
+//
+// message_type_id_t
+//
+/*!
+ * \brief A small dense identifier of a message type.
+ *
+ * Every message type gets its own ID at the first request of that ID
+ * (see message_type_id_for()). IDs are allocated sequentially and are
+ * never reused, so the ID is a compact 32-bit integer that can be
+ * compared and hashed much cheaper than std::type_index (comparison of
+ * std::type_index can require comparison of mangled names of types on
+ * some ABIs).
+ *
+ * IDs are valid only inside the current process and the same type can
+ * get different IDs in different runs of an application.
+ *
+ * Default constructed ID is the ID of `void`.
+ *
+ * \since v.5.8.3
+ */
+class message_type_id_t
+	{
+	public :
+		constexpr message_type_id_t() noexcept = default;
+
+		constexpr explicit message_type_id_t( std::uint32_t value ) noexcept
+			:	m_value{ value }
+			{}
+
+		[[nodiscard]]
+		constexpr std::uint32_t
+		value() const noexcept { return m_value; }
+
+		[[nodiscard]]
+		friend constexpr bool
+		operator==( message_type_id_t a, message_type_id_t b ) noexcept
+			{
+				return a.m_value == b.m_value;
+			}
+
+		[[nodiscard]]
+		friend constexpr bool
+		operator!=( message_type_id_t a, message_type_id_t b ) noexcept
+			{
+				return a.m_value != b.m_value;
+			}
+
+		[[nodiscard]]
+		friend constexpr bool
+		operator<( message_type_id_t a, message_type_id_t b ) noexcept
+			{
+				return a.m_value < b.m_value;
+			}
+
+	private :
+		std::uint32_t m_value{};
+	};
+
+/*!
+ * \brief Get the ID for a message type.
+ *
+ * The ID is allocated at the first call for a type. Subsequent calls
+ * for the same type are lock-free lookups.
+ *
+ * \note
+ * This function is noexcept. If there is no memory for registration
+ * of a new type then the application will be terminated.
+ *
+ * \since v.5.8.3
+ */
+[[nodiscard]]
+SO_5_FUNC message_type_id_t
+message_type_id_for( const std::type_index & msg_type ) noexcept;
+
+/*!
+ * \brief Get the ID for a message type.
+ *
+ * Usage example:
+ * \code
+ * const auto id = so_5::message_type_id_for< my_message >();
+ * \endcode
+ *
+ * \since v.5.8.3
+ */
+template< typename T >
+[[nodiscard]]
+message_type_id_t
+message_type_id_for() noexcept
+	{
+		static const message_type_id_t id =
+				message_type_id_for( std::type_index{ typeid(T) } );
+		return id;
+	}
+
+/*!
+ * \brief Get the type for a message type ID.
+ *
+ * This function is intended to be used for diagnostic purposes only.
+ * It acquires a lock inside.
+ *
+ * \return std::type_index for `void` if \a id is unknown.
+ *
+ * \since v.5.8.3
+ */
+[[nodiscard]]
+SO_5_FUNC std::type_index
+message_type_index_for( message_type_id_t id );
+
+} /* namespace so_5 */
+
+namespace std
+{
+
+template<>
+struct hash< so_5::message_type_id_t >
+	{
+		[[nodiscard]]
+		std::size_t
+		operator()( so_5::message_type_id_t id ) const noexcept
+			{
+				return id.value();
+			}
+	};
+
+} /* namespace std */
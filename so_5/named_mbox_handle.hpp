@@ -0,0 +1,156 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \file
+ * \brief A handle for a named mbox with precomputed hash of the name.
+ *
+ * \since v.5.8.3
+ */
+
+#pragma once
+
+#include <so_5/environment.hpp>
+#include <so_5/nonempty_name.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <string_view>
+
+namespace so_5
+{
+
+namespace named_mbox_details
+{
+
+/*!
+ * \brief Calculate hash for the full name of a named mbox.
+ *
+ * \note
+ * This hash is used for the dictionary of named mboxes inside
+ * SObjectizer Environment.
+ *
+ * \since v.5.8.3
+ */
+[[nodiscard]]
+inline std::size_t
+hash_of_full_name(
+	std::string_view mbox_namespace,
+	std::string_view mbox_name ) noexcept
+	{
+		std::size_t h = std::hash< std::string_view >{}( mbox_namespace );
+		const std::size_t n = std::hash< std::string_view >{}( mbox_name );
+		h ^= n + static_cast< std::size_t >( 0x9e3779b97f4a7c15ull ) +
+				( h << 6 ) + ( h >> 2 );
+		return h;
+	}
+
+} /* namespace named_mbox_details */
+
+//
+// named_mbox_handle_t
+//
+/*!
+ * \brief A handle for named MPMC mbox created by
+ * environment_t::create_mbox(nonempty_name_t).
+ *
+ * The handle holds the name of mbox with precomputed hash. It allows
+ * to avoid the calculation of hash for every lookup of the mbox.
+ *
+ * The handle also caches the result of the lookup. The first call to
+ * resolve() performs the lookup in the dictionary of named mboxes, all
+ * subsequent calls return the cached mbox without touching the
+ * dictionary:
+ * \code
+ * class session_manager final : public so_5::agent_t {
+ * 	std::vector< so_5::named_mbox_handle_t > sessions_;
+ * 	...
+ * 	void on_new_connection(mhood_t<new_connection> cmd) {
+ * 		auto & h = sessions_.emplace_back(
+ * 				"session-" + std::to_string(cmd->id_));
+ * 		so_5::send<greeting>(h.resolve(so_environment()), ...);
+ * 	}
+ * };
+ * \endcode
+ *
+ * \attention
+ * The cached mbox holds a reference to the named mbox. It means that
+ * the named mbox isn't destroyed while the handle holds the cached mbox.
+ * The cached mbox can be released by reset().
+ *
+ * \note
+ * This class isn't thread safe.
+ *
+ * \since v.5.8.3
+ */
+class named_mbox_handle_t
+	{
+	public :
+		//! Initializing constructor.
+		named_mbox_handle_t( nonempty_name_t mbox_name )
+			:	m_name{ mbox_name.giveout_value() }
+			,	m_hash{ named_mbox_details::hash_of_full_name(
+					std::string_view{}, m_name ) }
+			{}
+
+		//! Name of the mbox.
+		[[nodiscard]]
+		const std::string &
+		name() const noexcept
+			{
+				return m_name;
+			}
+
+		//! Precomputed hash of the mbox name.
+		[[nodiscard]]
+		std::size_t
+		hash() const noexcept
+			{
+				return m_hash;
+			}
+
+		//! Is there a cached mbox?
+		[[nodiscard]]
+		bool
+		is_resolved() const noexcept
+			{
+				return static_cast< bool >( m_mbox );
+			}
+
+		//! Get the mbox for the name.
+		/*!
+		 * The lookup is performed only if there is no cached mbox or
+		 * the cached mbox belongs to another environment.
+		 */
+		[[nodiscard]]
+		const mbox_t &
+		resolve( environment_t & env )
+			{
+				if( !m_mbox || &(m_mbox->environment()) != &env )
+					m_mbox = env.create_mbox( *this );
+
+				return m_mbox;
+			}
+
+		//! Drop the cached mbox.
+		void
+		reset() noexcept
+			{
+				m_mbox = mbox_t{};
+			}
+
+	private :
+		//! Name of the mbox.
+		std::string m_name;
+
+		//! Precomputed hash of the name.
+		std::size_t m_hash;
+
+		//! The cached mbox.
+		mbox_t m_mbox;
+	};
+
+} /* namespace so_5 */
+
@@ -71,6 +71,10 @@ class Prj < MxxRu::Cpp::LibOrDllTarget
 		sources_root( 'impl' ) {
 			cpp_source 'msg_tracing_helpers.cpp'
 
+			cpp_source 'message_pool.cpp'
+			cpp_source 'message_type_registry.cpp'
+			cpp_source 'epoch_reclamation.cpp'
+
 			cpp_source 'subscription_storage_iface.cpp'
 			cpp_source 'subscr_storage_vector_based.cpp'
 			cpp_source 'subscr_storage_flat_set_based.cpp'
@@ -107,6 +111,7 @@ class Prj < MxxRu::Cpp::LibOrDllTarget
 
 		sources_root( 'disp' ) {
 			cpp_source 'abstract_work_thread.cpp'
+			cpp_source 'work_thread_placement.cpp'
 
 			sources_root( 'mpsc_queue_traits' ) {
 				cpp_source 'pub.cpp'
@@ -132,6 +137,10 @@ class Prj < MxxRu::Cpp::LibOrDllTarget
 				cpp_source 'pub.cpp'
 			}
 
+			sources_root( 'balancing_one_thread' ) {
+				cpp_source 'pub.cpp'
+			}
+
 			sources_root( 'thread_pool' ) {
 				cpp_source 'pub.cpp'
 			}
@@ -144,6 +153,10 @@ class Prj < MxxRu::Cpp::LibOrDllTarget
 				cpp_source 'pub.cpp'
 			}
 
+			sources_root( 'work_stealing_pool' ) {
+				cpp_source 'pub.cpp'
+			}
+
 			sources_root( 'prio_one_thread' ) {
 				sources_root( 'strictly_ordered' ) {
 					cpp_source 'pub.cpp'
@@ -547,6 +547,34 @@ const int rc_empty_agent_name = 196;
  */
 const int rc_agent_name_too_long = 197;
 
+/*!
+ * \brief Dispatcher binder doesn't support migration of agents.
+ *
+ * It means that the binder doesn't implement
+ * so_5::transfer_queue_provider_t interface.
+ *
+ * \since v.5.8.3
+ */
+const int rc_disp_binder_does_not_support_transfer = 198;
+
+/*!
+ * \brief An attempt to migrate an agent while the previous
+ * migration isn't completed yet.
+ *
+ * \since v.5.8.3
+ */
+const int rc_agent_migration_in_progress = 199;
+
+/*!
+ * \brief Agent can't be migrated to another dispatcher.
+ *
+ * For example, the agent isn't bound to a dispatcher yet or is
+ * being deregistered.
+ *
+ * \since v.5.8.3
+ */
+const int rc_agent_cannot_be_migrated = 200;
+
 //! \name Common error codes.
 //! \{
 
@@ -16,6 +16,10 @@
 
 #include <so_5/compiler_features.hpp>
 
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
 namespace so_5
 {
 
@@ -349,6 +353,74 @@ send(
 				what.make_reference() );
 	}
 
+/*!
+ * \brief A utility function for creating and delivering several messages
+ * of the same type at once.
+ *
+ * A new instance of \a Message is created for every item of \a range
+ * (the item is passed to Message's constructor as the only argument).
+ * Then all instances are delivered to the destination by one call
+ * to abstract_message_box_t::do_deliver_message_batch(). For ordinary
+ * MPMC mboxes it means that subscribers are searched only once and all
+ * messages go to the event queue of a subscriber under one lock of that
+ * queue.
+ *
+ * Usage example:
+ * \code
+	struct price_update { std::string m_ticker; double m_price; };
+
+	std::vector< price_update > updates = ...;
+	so_5::send_batch< price_update >( market_data_mbox, updates );
+ * \endcode
+ *
+ * \note
+ * Custom mboxes and event queues which don't support batches
+ * handle messages one by one.
+ *
+ * \tparam Message type of message to be sent (it can be in form of Msg,
+ * so_5::immutable_msg<Msg> or so_5::mutable_msg<Msg>). Signals are
+ * not supported.
+ * \tparam Target identification of the destination. Could be reference to
+ * so_5::mbox_t, to so_5::agent_t or to so_5::mchain_t.
+ * \tparam Range type of a range with arguments for Message's constructor.
+ *
+ * \since v.5.8.3
+ */
+template< typename Message, typename Target, typename Range >
+void
+send_batch( Target && to, Range && range )
+	{
+		using std::begin;
+		using std::end;
+
+		ensure_not_signal< Message >();
+
+		auto first = begin( range );
+		const auto last = end( range );
+
+		std::vector< message_ref_t > messages;
+
+		using iterator_category = typename std::iterator_traits<
+				decltype(first) >::iterator_category;
+		if constexpr( std::is_base_of_v<
+				std::forward_iterator_tag, iterator_category > )
+			messages.reserve(
+					static_cast< std::size_t >( std::distance( first, last ) ) );
+
+		for(; first != last; ++first )
+			messages.emplace_back(
+					so_5::details::make_message_instance< Message >( *first )
+							.release() );
+
+		if( !messages.empty() )
+			so_5::low_level_api::deliver_message_batch(
+					message_delivery_mode_t::ordinary,
+					*send_functions_details::arg_to_mbox( std::forward<Target>(to) ),
+					message_payload_type< Message >::subscription_type_index(),
+					messages.data(),
+					messages.size() );
+	}
+
 /*!
  * \brief A utility function for creating and delivering a delayed message
  * to the specified destination.
@@ -0,0 +1,89 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \file
+ * \brief Factory for MPMC mbox with immutable snapshots of subscribers table.
+ *
+ * \since v.5.8.3
+ */
+
+#pragma once
+
+#include <so_5/environment.hpp>
+
+#include <so_5/impl/local_mbox.hpp>
+
+namespace so_5 {
+
+//
+// make_snapshot_mbox
+//
+/*!
+ * \brief Factory function for creation of a new MPMC mbox which uses
+ * immutable snapshots of the subscribers table.
+ *
+ * An ordinary MPMC mbox (created by environment_t::create_mbox())
+ * acquires a reader-writer spinlock for every message delivery. The
+ * acquisition of that lock is a modification of a counter of readers.
+ * If there are many threads those send messages to the same mbox
+ * in parallel the cache line with that counter becomes a point of
+ * contention.
+ *
+ * The mbox created by make_snapshot_mbox() stores subscribers as an
+ * immutable snapshot. A message delivery is just a load of the pointer to
+ * the current snapshot inside an epoch-based read-side section that
+ * modifies only thread-local data. Subscription, unsubscription and
+ * changes of delivery filters create a new snapshot.
+ *
+ * Usage example:
+ * \code
+ * so_5::environment_t & env = ...;
+ * auto mbox = so_5::make_snapshot_mbox(env);
+ * \endcode
+ *
+ * \attention
+ * Modifications of the subscribers table are much more expensive than for
+ * an ordinary MPMC mbox. Unsubscriptions and removals of delivery filters
+ * wait until all parallel deliveries to the mbox are finished. This
+ * mbox should be used when there are a lot of senders and the set of
+ * subscribers is changed rarely.
+ *
+ * \note
+ * This mbox has the same behavior as an ordinary MPMC mbox: only
+ * immutable messages can be sent to it, message delivery tracing is
+ * supported.
+ *
+ * \since v.5.8.3
+ */
+[[nodiscard]]
+inline mbox_t
+make_snapshot_mbox( so_5::environment_t & env )
+	{
+		return env.make_custom_mbox(
+				[]( const mbox_creation_data_t & data ) {
+					mbox_t result;
+
+					if( data.m_tracer.get().is_msg_tracing_enabled() )
+						result = mbox_t{
+								new impl::snapshot_local_mbox_with_tracing{
+										data.m_id,
+										data.m_env.get(),
+										data.m_tracer
+								}
+							};
+					else
+						result = mbox_t{
+								new impl::snapshot_local_mbox_without_tracing{
+										data.m_id,
+										data.m_env.get()
+								}
+							};
+
+					return result;
+				} );
+	}
+
+} /* namespace so_5 */
+
@@ -110,6 +110,30 @@ demand_quote()
 		IMPL_SUFFIX( "/demands.quote" )
 	}
 
+SO_5_FUNC suffix_t
+demand_pool_hits()
+	{
+		IMPL_SUFFIX( "/demand_pool.hits" )
+	}
+
+SO_5_FUNC suffix_t
+demand_pool_misses()
+	{
+		IMPL_SUFFIX( "/demand_pool.misses" )
+	}
+
+SO_5_FUNC suffix_t
+wakeups_issued()
+	{
+		IMPL_SUFFIX( "/wakeups.issued" )
+	}
+
+SO_5_FUNC suffix_t
+wakeups_avoided()
+	{
+		IMPL_SUFFIX( "/wakeups.avoided" )
+	}
+
 #undef IMPL_SUFFIX
 
 } /* namespace suffixes */
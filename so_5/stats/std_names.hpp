@@ -157,6 +157,47 @@ timer_periodic_count();
 SO_5_FUNC suffix_t
 demand_quote();
 
+/*!
+ * \brief Suffix for data source with count of demand allocations
+ * satisfied by demand node caches.
+ *
+ * This suffix is used in adv_thread_pool dispatcher.
+ *
+ * \since v.5.8.3
+ */
+SO_5_FUNC suffix_t
+demand_pool_hits();
+
+/*!
+ * \brief Suffix for data source with count of demand allocations
+ * that weren't satisfied by demand node caches.
+ *
+ * This suffix is used in adv_thread_pool dispatcher.
+ *
+ * \since v.5.8.3
+ */
+SO_5_FUNC suffix_t
+demand_pool_misses();
+
+/*!
+ * \brief Suffix for data source with count of notifications of
+ * sleeping work threads.
+ *
+ * \since v.5.8.3
+ */
+SO_5_FUNC suffix_t
+wakeups_issued();
+
+/*!
+ * \brief Suffix for data source with count of new demands (or queues
+ * of demands) those didn't require a notification of a work thread
+ * because the work thread wasn't sleeping.
+ *
+ * \since v.5.8.3
+ */
+SO_5_FUNC suffix_t
+wakeups_avoided();
+
 } /* namespace suffixes */
 
 } /* namespace stats */
@@ -12,6 +12,7 @@
 #include <so_5/details/sync_helpers.hpp>
 
 #include <so_5/mbox.hpp>
+#include <so_5/message_type_id.hpp>
 
 #include <so_5/impl/msg_tracing_helpers.hpp>
 #include <so_5/impl/local_mbox_basic_subscription_info.hpp>
@@ -58,8 +59,11 @@ struct data_t
 
 		/*!
 		 * \brief Map from message type to subscribers.
+		 *
+		 * \note
+		 * Since v.5.8.3 the dense ID of message type is used as the key.
 		 */
-		using messages_table_t = std::map< std::type_index, subscriber_info_t >;
+		using messages_table_t = std::map< message_type_id_t, subscriber_info_t >;
 
 		//! Map of subscribers to messages.
 		messages_table_t m_subscribers;
@@ -218,12 +222,14 @@ class actual_mbox_t final
 			Info_Maker maker,
 			Info_Changer changer )
 			{
+				const auto msg_type_id = message_type_id_for( msg_type );
+
 				this->lock_and_perform( [&] {
-					auto it = this->m_subscribers.find( msg_type );
+					auto it = this->m_subscribers.find( msg_type_id );
 					if( it == this->m_subscribers.end() )
 						{
 							// There isn't such message type yet.
-							m_subscribers.emplace( msg_type, maker() );
+							m_subscribers.emplace( msg_type_id, maker() );
 						}
 					else
 						{
@@ -249,8 +255,10 @@ class actual_mbox_t final
 			abstract_message_sink_t & subscriber,
 			Info_Changer changer )
 			{
+				const auto msg_type_id = message_type_id_for( msg_type );
+
 				this->lock_and_perform( [&] {
-					auto it = this->m_subscribers.find( msg_type );
+					auto it = this->m_subscribers.find( msg_type_id );
 					if( it != this->m_subscribers.end() )
 						{
 							auto & subscriber_info = it->second;
@@ -279,8 +287,10 @@ class actual_mbox_t final
 			const message_ref_t & message,
 			unsigned int redirection_deep )
 			{
+				const auto msg_type_id = message_type_id_for( msg_type );
+
 				this->lock_and_perform( [&] {
-					auto it = this->m_subscribers.find( msg_type );
+					auto it = this->m_subscribers.find( msg_type_id );
 					if( it != this->m_subscribers.end() )
 						{
 							do_deliver_message_to_subscriber(
@@ -49,6 +49,8 @@ struct	cfg_t
 
 	queue_lock_type_t m_queue_lock_type = queue_lock_type_t::combined;
 
+	bool m_lock_free_queue = false;
+
 	pool_fifo_t m_fifo = pool_fifo_t::individual;
 
 	std::size_t m_next_thread_wakeup_threshold = 0;
@@ -81,6 +83,8 @@ try_parse_cmdline(
 							"                     prio_ot_strictly_ordered\n"
 							"-L, --queue-lock     type of queue lock to be used:\n"
 							"                     combined, simple\n"
+							"-F, --lock-free-queue use lock-free demand queue "
+								"(one_thread only)\n"
 							"-f, --fifo           type of fifo for dispatcher with "
 								"thread pool:\n"
 							"                     cooperation, individual (default)\n"
@@ -120,6 +124,8 @@ try_parse_cmdline(
 					else
 						throw std::runtime_error( "unsupported dispatcher type: " + name );
 				}
+			else if( is_arg( *current, "-F", "--lock-free-queue" ) )
+				tmp_cfg.m_lock_free_queue = true;
 			else if( is_arg( *current, "-L", "--queue-lock" ) )
 				{
 					std::string name;
@@ -155,6 +161,11 @@ try_parse_cmdline(
 						std::string( "unknown argument: " ) + *current );
 		}
 
+	if( tmp_cfg.m_lock_free_queue &&
+			dispatcher_type_t::one_thread != tmp_cfg.m_dispatcher_type )
+		throw std::runtime_error(
+				"lock-free queue is supported only for one_thread dispatcher" );
+
 	return tmp_cfg;
 }
 
@@ -283,7 +294,8 @@ show_cfg(
 			<< "\n\t" "rounds: " << cfg.m_rounds
 			<< "\n\t" "direct mboxes: " << ( cfg.m_direct_mboxes ? "yes" : "no" )
 			<< "\n\t" "disp: " << dispatcher_type_name( cfg.m_dispatcher_type )
-			<< "\n\t" "queue_lock: " << queue_lock_type_name( cfg.m_queue_lock_type );
+			<< "\n\t" "queue_lock: " << queue_lock_type_name( cfg.m_queue_lock_type )
+			<< "\n\t" "lock-free queue: " << ( cfg.m_lock_free_queue ? "yes" : "no" );
 
 		if( dispatcher_type_t::thread_pool == cfg.m_dispatcher_type ||
 				dispatcher_type_t::adv_thread_pool == cfg.m_dispatcher_type )
@@ -357,6 +369,9 @@ create_disp_binder(
 					[]{ return queue_traits::combined_lock_factory(); },
 					[]{ return queue_traits::simple_lock_factory(); },
 					[]( queue_traits::queue_params_t & ) {} );
+			if( cfg.m_lock_free_queue )
+				disp_params.demand_queue_kind(
+						queue_traits::demand_queue_kind_t::lock_free );
 			return make_dispatcher( env, "disp", disp_params ).binder();
 		}
 		else if( dispatcher_type_t::nef_one_thread == t )
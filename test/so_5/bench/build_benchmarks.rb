@@ -9,6 +9,7 @@ MxxRu::Cpp::composite_target {
 	required_prj "#{path}/same_msg_in_different_states/prj.rb"
 	required_prj "#{path}/parallel_send_to_same_mbox/prj.rb"
 	required_prj "#{path}/change_state/prj.rb"
+	required_prj "#{path}/deep_states/prj.rb"
 	required_prj "#{path}/many_mboxes/prj.rb"
 	required_prj "#{path}/thread_pool_disp/prj.rb"
 	required_prj "#{path}/no_workload/prj.rb"
@@ -0,0 +1,120 @@
+/*
+ * A simple benchmark for the search of event handlers in deep
+ * hierarchical states.
+ *
+ * Usage:
+ *
+ * _test.bench.so_5.deep_states [messages] [cache]
+ *
+ * If `cache` is specified then the cache of resolved event handlers
+ * is turned on for the agent.
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <cstring>
+
+#include <so_5/all.hpp>
+
+#include <test/3rd_party/various_helpers/benchmark_helpers.hpp>
+
+struct msg_ping final : public so_5::signal_t {};
+
+class a_test_t final : public so_5::agent_t
+	{
+	public :
+		a_test_t(
+			context_t ctx,
+			bool use_cache,
+			unsigned int messages )
+			:	so_5::agent_t( tune( std::move(ctx), use_cache ) )
+			,	m_messages( messages )
+			{}
+
+		void
+		so_define_agent() override
+			{
+				this >>= st_6;
+
+				// The handler is defined only for the top-level state,
+				// so the search from a leaf goes through all the hierarchy.
+				st_1.event( &a_test_t::evt_ping );
+			}
+
+		void
+		so_evt_start() override
+			{
+				m_bench.start();
+				so_5::send< msg_ping >( *this );
+			}
+
+	private :
+		state_t st_1{ this, "1" };
+		state_t st_2{ initial_substate_of{ st_1 }, "2" };
+		state_t st_3{ initial_substate_of{ st_2 }, "3" };
+		state_t st_4{ initial_substate_of{ st_3 }, "4" };
+		state_t st_5{ initial_substate_of{ st_4 }, "5" };
+		state_t st_6{ initial_substate_of{ st_5 }, "6" };
+		state_t st_6b{ substate_of{ st_5 }, "6b" };
+
+		const unsigned int m_messages;
+		unsigned int m_received{};
+
+		benchmarker_t m_bench;
+
+		static context_t
+		tune( context_t ctx, bool use_cache )
+			{
+				ctx.options().resolved_handler_cache( use_cache );
+				return ctx;
+			}
+
+		void
+		evt_ping( mhood_t< msg_ping > )
+			{
+				if( ++m_received == m_messages )
+					{
+						m_bench.finish_and_show_stats( m_received, "msgs" );
+						so_deregister_agent_coop_normally();
+						return;
+					}
+
+				// Switch between two leaf states.
+				if( st_6.is_active() )
+					this >>= st_6b;
+				else
+					this >>= st_6;
+
+				so_5::send< msg_ping >( *this );
+			}
+	};
+
+int
+main( int argc, char ** argv )
+{
+	try
+	{
+		const unsigned int messages = static_cast< unsigned int >(
+				argc >= 2 ? std::atoi( argv[1] ) : 1000000 );
+		const bool use_cache = argc >= 3 &&
+				0 == std::strcmp( argv[2], "cache" );
+
+		std::cout << "messages: " << messages
+				<< ", cache: " << ( use_cache ? "on" : "off" ) << std::endl;
+
+		so_5::launch(
+			[&]( so_5::environment_t & env )
+			{
+				env.introduce_coop( [&]( so_5::coop_t & coop ) {
+						coop.make_agent< a_test_t >( use_cache, messages );
+					} );
+			} );
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
@@ -9,6 +9,7 @@
 #include <iterator>
 #include <numeric>
 #include <cstdlib>
+#include <cstring>
 
 #include <so_5/all.hpp>
 
@@ -78,9 +79,11 @@ void
 init(
 	so_5::environment_t & env,
 	unsigned int agent_count,
-	unsigned int send_count )
+	unsigned int send_count,
+	bool use_snapshot_mbox )
 	{
-		auto mbox = env.create_mbox();
+		auto mbox = use_snapshot_mbox ?
+				so_5::make_snapshot_mbox( env ) : env.create_mbox();
 
 		auto coop = env.make_coop(
 				so_5::disp::active_obj::make_dispatcher(
@@ -99,8 +102,10 @@ init(
 void
 print_usage()
 {
-	std::cout << "Usage: parallel_sent_to_same_mbox <agent_count> <send_count>\n\n"
-			"<agent_count> and <send_count> must not be 0"
+	std::cout << "Usage: parallel_sent_to_same_mbox <agent_count> <send_count> "
+			"[snapshot]\n\n"
+			"<agent_count> and <send_count> must not be 0\n"
+			"snapshot: use mbox created by so_5::make_snapshot_mbox()"
 			<< std::endl;
 }
 
@@ -119,7 +124,8 @@ main( int argc, char ** argv )
 		auto ensure_args_validity = []( bool p, const char * msg ) {
 			if( !p ) throw cmd_line_exception( msg );
 		};
-		ensure_args_validity( 3 == argc, "wrong number of arguments" );
+		ensure_args_validity( 3 == argc || 4 == argc,
+				"wrong number of arguments" );
 
 		const unsigned int agent_count = static_cast< unsigned int >(std::atoi( argv[1] ));
 		ensure_args_validity( agent_count != 0, "agent_count must not be 0" );
@@ -127,13 +133,21 @@ main( int argc, char ** argv )
 		const unsigned int send_count = static_cast< unsigned int >(std::atoi( argv[2] ));
 		ensure_args_validity( send_count != 0, "send_count must not be 0" );
 
+		bool use_snapshot_mbox = false;
+		if( 4 == argc )
+		{
+			ensure_args_validity( 0 == std::strcmp( "snapshot", argv[3] ),
+					"unknown mbox type" );
+			use_snapshot_mbox = true;
+		}
+
 		benchmarker_t benchmark;
 		benchmark.start();
 
 		so_5::launch(
-			[agent_count, send_count]( so_5::environment_t & env )
+			[agent_count, send_count, use_snapshot_mbox]( so_5::environment_t & env )
 			{
-				init( env, agent_count, send_count );
+				init( env, agent_count, send_count, use_snapshot_mbox );
 			} );
 
 		benchmark.finish_and_show_stats(
@@ -39,6 +39,10 @@ struct	cfg_t
 
 	bool	m_track_activity = false;
 
+	bool	m_message_pool = false;
+
+	bool	m_lock_free_queue = false;
+
 	env_type_t m_env = env_type_t::default_mt;
 };
 
@@ -63,6 +67,7 @@ try_parse_cmdline(
 							"-d, --direct-mboxes  use direct(mpsc) mboxes for agents\n"
 							"-l, --message-limits use message limits for agents\n"
 							"-s, --simple-lock    use simple lock factory for event queue\n"
+							"-F, --lock-free-queue use lock-free demand queue\n"
 							"-T, --track-activity turn work thread activity tracking on\n"
 							"-e, --env            environment infrastructure to be used:\n"
 							"                       default_mt (default),\n"
@@ -70,6 +75,8 @@ try_parse_cmdline(
 							"                       simple_not_mtsafe\n"
 							"-M, --use-messages   use messages for interaction "
 									"(signals are used by default)\n"
+							"-P, --message-pool   use pooled allocation of messages "
+									"(implies -M)\n"
 							"-h, --help           show this help"
 							<< std::endl;
 					std::exit( 1 );
@@ -82,6 +89,8 @@ try_parse_cmdline(
 				tmp_cfg.m_message_limits = true;
 			else if( is_arg( *current, "-s", "--simple-lock" ) )
 				tmp_cfg.m_simple_lock = true;
+			else if( is_arg( *current, "-F", "--lock-free-queue" ) )
+				tmp_cfg.m_lock_free_queue = true;
 			else if( is_arg( *current, "-r", "--requests" ) )
 				mandatory_arg_to_value(
 						tmp_cfg.m_request_count, ++current, last_arg,
@@ -109,6 +118,11 @@ try_parse_cmdline(
 				}
 			else if( is_arg( *current, "-M", "--use-messages" ) )
 				tmp_cfg.m_use_messages = true;
+			else if( is_arg( *current, "-P", "--message-pool" ) )
+				{
+					tmp_cfg.m_message_pool = true;
+					tmp_cfg.m_use_messages = true;
+				}
 			else
 				throw std::runtime_error(
 						std::string( "unknown argument: " ) + *current );
@@ -268,12 +282,14 @@ show_cfg(
 			<< ", direct mboxes: " << ( cfg.m_direct_mboxes ? "yes" : "no" )
 			<< ", limits: " << ( cfg.m_message_limits ? "yes" : "no" )
 			<< ", locks: " << ( cfg.m_simple_lock ? "simple" : "combined" )
+			<< ", lock-free queue: " << ( cfg.m_lock_free_queue ? "yes" : "no" )
 			<< ", requests: " << cfg.m_request_count
 			<< ", activity tracking: " << ( cfg.m_track_activity ? "on" : "off" )
 			<< ", env: " << ( env_type_t::default_mt == cfg.m_env ?
 					"mt" : ( env_type_t::simple_mtsafe == cfg.m_env ?
 							"mtsafe" : "not_mtsafe" ) )
 			<< ", " << ( cfg.m_use_messages ? "messages" : "signals" )
+			<< ", message pool: " << ( cfg.m_message_pool ? "on" : "off" )
 			<< std::endl;
 	}
 
@@ -306,6 +322,19 @@ ensure_valid_cfg( const cfg_t & cfg )
 		if( cfg.m_active_objects && env_type_t::simple_not_mtsafe == cfg.m_env )
 			throw std::runtime_error( "invalid config: active objects can't be"
 					" used with simple_not_mtsafe environment infrastructure" );
+		if( cfg.m_lock_free_queue && !cfg.m_active_objects &&
+				env_type_t::default_mt != cfg.m_env )
+			throw std::runtime_error( "invalid config: lock-free queue can be"
+					" used only with default_mt environment infrastructure"
+					" or with active objects" );
+	}
+
+so_5::disp::mpsc_queue_traits::demand_queue_kind_t
+demand_queue_kind( const cfg_t & cfg )
+	{
+		return cfg.m_lock_free_queue ?
+				so_5::disp::mpsc_queue_traits::demand_queue_kind_t::lock_free :
+				so_5::disp::mpsc_queue_traits::demand_queue_kind_t::lock_based;
 	}
 
 class test_env_t
@@ -319,7 +348,9 @@ class test_env_t
 		init( so_5::environment_t & env )
 			{
 				auto binder = ( m_cfg.m_active_objects ?
-						so_5::disp::active_obj::make_dispatcher( env ).binder() :
+						so_5::disp::active_obj::make_dispatcher( env, std::string_view{},
+								so_5::disp::active_obj::disp_params_t{}
+									.demand_queue_kind( demand_queue_kind( m_cfg ) ) ).binder() :
 						so_5::make_default_disp_binder( env ) );
 
 				auto coop = env.make_coop( std::move(binder) );
@@ -400,6 +431,14 @@ main( int argc, char ** argv )
 				if( cfg.m_simple_lock )
 					params.queue_locks_defaults_manager(
 							so_5::make_defaults_manager_for_simple_locks() );
+
+				if( cfg.m_message_pool )
+					params.message_pool( so_5::message_pool_params_t{} );
+
+				if( cfg.m_lock_free_queue )
+					params.default_disp_params(
+							so_5::disp::one_thread::disp_params_t{}
+								.demand_queue_kind( demand_queue_kind( cfg ) ) );
 			} );
 
 		test_env.process_results();
@@ -1,5 +1,6 @@
 #include <iostream>
 #include <chrono>
+#include <cstring>
 
 #include <so_5/all.hpp>
 
@@ -10,12 +11,11 @@ const unsigned int divider = 10;
 
 using number = unsigned long long;
 
-using disp_handle = disp::thread_pool::dispatcher_handle_t;
-
-disp::thread_pool::bind_params_t bind_params()
+template< typename Bind_Params, typename Fifo >
+Bind_Params bind_params()
 {
-	return disp::thread_pool::bind_params_t{}
-		.fifo( disp::thread_pool::fifo_t::cooperation )
+	return Bind_Params{}
+		.fifo( Fifo::cooperation )
 		.max_demands_at_once( divider * 3 )
 	;
 }
@@ -23,9 +23,9 @@ disp::thread_pool::bind_params_t bind_params()
 class skynet final : public agent_t
 {
 public :
-	skynet( context_t ctx, disp_handle disp, mbox_t parent, number num, unsigned int size )
+	skynet( context_t ctx, disp_binder_shptr_t binder, mbox_t parent, number num, unsigned int size )
 		:	agent_t{ ctx }
-		,	m_disp{ std::move(disp) }
+		,	m_binder{ std::move(binder) }
 		,	m_parent{ std::move(parent) }
 		,	m_num{ num }
 		,	m_size{ size }
@@ -43,7 +43,7 @@ public :
 	}
 
 private :
-	const disp_handle m_disp;
+	const disp_binder_shptr_t m_binder;
 	const mbox_t m_parent;
 	const number m_num;
 	const unsigned int m_size;
@@ -64,14 +64,14 @@ private :
 	void create_agents()
 	{
 		so_environment().introduce_coop(
-			m_disp.binder( bind_params() ),
+			m_binder,
 			[&]( coop_t & coop ) {
 				m_child = coop.handle();
 
 				const auto subsize = m_size / divider;
 				coop.reserve( divider );
 				for( unsigned int i = 0; i != divider; ++i )
-					coop.make_agent< skynet >( m_disp, so_direct_mbox(), m_num + i * subsize, subsize );
+					coop.make_agent< skynet >( m_binder, so_direct_mbox(), m_num + i * subsize, subsize );
 			} );
 	}
 };
@@ -82,23 +82,43 @@ size_t pool_size()
 	return c > 1 ? c - 1 : 1;
 }
 
-int main()
+disp_binder_shptr_t make_binder( environment_t & env, bool work_stealing )
 {
+	if( work_stealing )
+		return disp::work_stealing_pool::make_dispatcher( env, pool_size() )
+			.binder( bind_params<
+					disp::work_stealing_pool::bind_params_t,
+					disp::work_stealing_pool::fifo_t >() );
+	else
+		return disp::thread_pool::make_dispatcher( env, pool_size() )
+			.binder( bind_params<
+					disp::thread_pool::bind_params_t,
+					disp::thread_pool::fifo_t >() );
+}
+
+int main( int argc, char ** argv )
+{
+	// Use -W or --work-stealing-pool to run the benchmark on
+	// work_stealing_pool dispatcher instead of thread_pool dispatcher.
+	const bool work_stealing = 2 == argc &&
+		( 0 == std::strcmp( argv[ 1 ], "-W" ) ||
+			0 == std::strcmp( argv[ 1 ], "--work-stealing-pool" ) );
+
 	number result = 0;
 
 	using clock_type = std::chrono::high_resolution_clock;
 	const auto start_at = clock_type::now();
 
-	so_5::launch( [&result]( environment_t & env ) {
-		auto tp_disp = disp::thread_pool::make_dispatcher( env, pool_size() );
+	so_5::launch( [&result, work_stealing]( environment_t & env ) {
+		auto binder = make_binder( env, work_stealing );
 
 		auto result_ch = env.create_mchain( make_unlimited_mchain_params() );
 
 		env.introduce_coop(
-			tp_disp.binder(),
+			binder,
 			[&]( coop_t & coop ) {
 				coop.make_agent< skynet >(
-						tp_disp, result_ch->as_mbox(), 0u, 1000000u );
+						binder, result_ch->as_mbox(), 0u, 1000000u );
 			} );
 
 		receive( from(result_ch).handle_n(1), [&result]( number v ) { result = v; } );
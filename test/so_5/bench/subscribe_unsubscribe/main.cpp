@@ -52,6 +52,8 @@ struct cfg_t
 
 		subscr_storage_type_t m_subscr_storage =
 				subscr_storage_type_t::map_based;
+
+		bool m_method_handlers = false;
 	};
 
 cfg_t
@@ -76,6 +78,8 @@ try_parse_cmdline(
 							"-l, --loops            loops to be done\n"
 							"-s, --storage-type     type of subscription storage\n"
 							"                       allowed values: vector, map, hash, flat_set\n"
+							"-m, --method-handlers  use agent's methods as event handlers\n"
+							"                       (lambdas are used by default)\n"
 							"-h, --help             show this description\n"
 							<< std::endl;
 					std::exit(1);
@@ -110,6 +114,8 @@ try_parse_cmdline(
 								std::string( "unsupported subscription storage type: " ) +
 										type );
 				}
+			else if( is_arg( *current, "-m", "--method-handlers" ) )
+				tmp_cfg.m_method_handlers = true;
 			else
 				throw std::runtime_error(
 						std::string( "unknown argument: " ) + *current );
@@ -193,9 +199,11 @@ class a_worker_t
 		a_worker_t(
 			context_t ctx,
 			std::size_t iterations,
+			bool method_handlers,
 			so_5::subscription_storage_factory_t subscr_storage_factory )
 			:	so_5::agent_t{ ctx + subscr_storage_factory }
 			,	m_iterations{ iterations }
+			,	m_method_handlers{ method_handlers }
 			{}
 
 		void
@@ -212,16 +220,27 @@ class a_worker_t
 
 	protected :
 		const std::size_t m_iterations;
+		const bool m_method_handlers;
 
 		so_5::mbox_t m_next;
 
+		template< typename Signal >
+		void
+		evt_signal( mhood_t<Signal> )
+			{
+				/* Nothing to do */
+			}
+
 		template< typename Signal >
 		void
 		make_subscription()
 			{
-				so_subscribe_self().event( [](mhood_t<Signal>) {
-						/* Nothing to do */
-					} );
+				if( m_method_handlers )
+					so_subscribe_self().event( &a_worker_t::evt_signal<Signal> );
+				else
+					so_subscribe_self().event( [](mhood_t<Signal>) {
+							/* Nothing to do */
+						} );
 			}
 
 		template< typename Signal >
@@ -380,8 +399,13 @@ class a_first_worker_t final : public a_worker_t
 			context_t ctx,
 			std::size_t loops,
 			std::size_t iterations,
+			bool method_handlers,
 			so_5::subscription_storage_factory_t subscr_storage_factory )
-			:	a_worker_t{ std::move(ctx), iterations, std::move(subscr_storage_factory) }
+			:	a_worker_t{
+					std::move(ctx),
+					iterations,
+					method_handlers,
+					std::move(subscr_storage_factory) }
 			,	m_loops{ loops }
 			{}
 
@@ -473,11 +497,13 @@ run_benchmark(
 			workers.push_back( coop.make_agent< a_first_worker_t >(
 					cfg.m_loops,
 					cfg.m_iterations,
+					cfg.m_method_handlers,
 					factory ) );
 
 			for( std::size_t i = 1; i != cfg.m_agents; ++i )
 				workers.push_back( coop.make_agent< a_worker_t >(
 						cfg.m_iterations,
+						cfg.m_method_handlers,
 						factory ) );
 
 			for( std::size_t i = 0; i != cfg.m_agents; ++i )
@@ -507,7 +533,8 @@ main( int argc, char ** argv )
 				<< "* agents: " << cfg.m_agents << "\n"
 				<< "* iterations: " << cfg.m_iterations << "\n"
 				<< "* loops: " << cfg.m_loops << "\n"
-				<< "* subscr_storage: " << subscr_storage_name( cfg.m_subscr_storage )
+				<< "* subscr_storage: " << subscr_storage_name( cfg.m_subscr_storage ) << "\n"
+				<< "* handlers: " << ( cfg.m_method_handlers ? "methods" : "lambdas" )
 				<< std::endl;
 
 		so_5::launch(
@@ -33,7 +33,8 @@ default_thread_pool_size()
 enum class dispatcher_t
 	{
 		thread_pool,
-		adv_thread_pool
+		adv_thread_pool,
+		work_stealing_pool
 	};
 
 enum class lock_type_t
@@ -80,6 +81,7 @@ try_parse_cmdline(
 							"-t, --threads           size of thread pool\n"
 							"-i, --individual-fifo   use individual FIFO for agents\n"
 							"-P, --adv-thread-pool   use adv_thread_pool dispatcher\n"
+							"-W, --work-stealing-pool use work_stealing_pool dispatcher\n"
 							"-s, --simple-lock       use simple_lock_factory for MPMC queue\n"
 							"-T, --track-activity    turn work thread activity tracking on\n"
 							"-h, --help              show this description\n"
@@ -122,6 +124,9 @@ try_parse_cmdline(
 			else if( is_arg( *current, "-P", "--adv-thread-pool" ) )
 				tmp_cfg.m_dispatcher = dispatcher_t::adv_thread_pool;
 
+			else if( is_arg( *current, "-W", "--work-stealing-pool" ) )
+				tmp_cfg.m_dispatcher = dispatcher_t::work_stealing_pool;
+
 			else if( is_arg( *current, "-s", "--simple-lock" ) )
 				tmp_cfg.m_lock_type = lock_type_t::simple_lock;
 
@@ -324,6 +329,31 @@ class a_contoller_t : public so_5::agent_t
 							so_environment(), "thread_pool", disp_params() )
 						.binder( bind_params() );
 			}
+			else if( dispatcher_t::work_stealing_pool == m_cfg.m_dispatcher )
+			{
+				using namespace so_5::disp::work_stealing_pool;
+
+				const auto disp_params = [&] {
+					disp_params_t params;
+					params.thread_count( threads );
+					if( lock_type_t::simple_lock == m_cfg.m_lock_type )
+						params.set_queue_params( queue_traits::queue_params_t{}
+								.lock_factory( queue_traits::simple_lock_factory() ) );
+					return params;
+				};
+				const auto bind_params = [&] {
+					bind_params_t params;
+					if( m_cfg.m_individual_fifo )
+						params.fifo( fifo_t::individual );
+					if( m_cfg.m_demands_at_once )
+						params.max_demands_at_once( m_cfg.m_demands_at_once );
+					return params;
+				};
+
+				m_binder = make_dispatcher(
+							so_environment(), "work_stealing_pool", disp_params() )
+						.binder( bind_params() );
+			}
 			else
 			{
 				using namespace so_5::disp::adv_thread_pool;
@@ -353,6 +383,19 @@ class a_contoller_t : public so_5::agent_t
 		}
 };
 
+const char *
+dispatcher_name( dispatcher_t dispatcher )
+{
+	switch( dispatcher )
+	{
+		case dispatcher_t::thread_pool: return "thread_pool";
+		case dispatcher_t::adv_thread_pool: return "adv_thread_pool";
+		case dispatcher_t::work_stealing_pool: return "work_stealing_pool";
+	}
+
+	return "unknown";
+}
+
 void
 show_cfg( const cfg_t & cfg )
 {
@@ -364,15 +407,14 @@ show_cfg( const cfg_t & cfg )
 			<< std::endl;
 
 	std::cout << "\n" "dispatcher: "
-			<< (dispatcher_t::thread_pool == cfg.m_dispatcher ?
-					"thread_pool" : "adv_thread_pool")
+			<< dispatcher_name( cfg.m_dispatcher )
 			<< std::endl;
 	std::cout << "  MPMC queue lock: "
 			<< (lock_type_t::combined_lock == cfg.m_lock_type ?
 					"combined" : "simple")
 			<< std::endl;
 
-	if( dispatcher_t::thread_pool == cfg.m_dispatcher ) 
+	if( dispatcher_t::adv_thread_pool != cfg.m_dispatcher )
 	{
 		std::cout << "\n*** demands_at_once: ";
 		if( cfg.m_demands_at_once )
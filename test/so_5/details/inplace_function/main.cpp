@@ -0,0 +1,103 @@
+/*
+ * A test for so_5::details::inplace_function_t.
+ */
+
+#include <so_5/details/inplace_function.hpp>
+
+#include <test/3rd_party/various_helpers/ensure.hpp>
+
+#include <array>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+
+using small_func_t = so_5::details::inplace_function_t< int(int), 32u >;
+
+void
+empty_object()
+{
+	small_func_t f;
+	ensure_or_die( !f, "default constructed object must be empty" );
+
+	bool thrown = false;
+	try { f( 0 ); }
+	catch( const std::bad_function_call & ) { thrown = true; }
+	ensure_or_die( thrown, "bad_function_call is expected" );
+
+	int (*null_pfn)(int) = nullptr;
+	small_func_t f2{ null_pfn };
+	ensure_or_die( !f2, "null pointer must produce empty object" );
+}
+
+int
+twice( int v ) { return v * 2; }
+
+void
+free_function()
+{
+	small_func_t f{ &twice };
+	ensure_or_die( static_cast<bool>(f), "object must not be empty" );
+	ensure_or_die( 6 == f( 3 ), "unexpected result of free function" );
+}
+
+void
+small_lambda()
+{
+	int calls = 0;
+	small_func_t f{ [&calls]( int v ) mutable { ++calls; return v + 1; } };
+	small_func_t copy{ f };
+	ensure_or_die( 2 == copy( 1 ), "unexpected result of copy" );
+	ensure_or_die( 3 == f( 2 ), "unexpected result of original" );
+	ensure_or_die( 2 == calls, "two calls expected" );
+
+	small_func_t moved{ std::move(f) };
+	ensure_or_die( !f, "moved-from object must be empty" );
+	ensure_or_die( 4 == moved( 3 ), "unexpected result of moved object" );
+}
+
+void
+big_lambda()
+{
+	// This lambda doesn't fit into the internal buffer.
+	std::array< int, 16 > data{};
+	data[ 15 ] = 10;
+	small_func_t f{ [data]( int v ) { return data[ 15 ] + v; } };
+	small_func_t copy;
+	copy = f;
+	ensure_or_die( 11 == f( 1 ), "unexpected result of big lambda" );
+	ensure_or_die( 12 == copy( 2 ), "unexpected result of copy of big lambda" );
+
+	swap( f, copy );
+	ensure_or_die( 13 == f( 3 ), "unexpected result after swap" );
+
+	f = nullptr;
+	ensure_or_die( !f, "object must be empty after assignment of nullptr" );
+}
+
+void
+lifetime_of_captures()
+{
+	auto counter = std::make_shared< int >( 0 );
+	{
+		small_func_t f{ [counter]( int v ) { return v; } };
+		small_func_t copy{ f };
+		small_func_t other{ &twice };
+		other = std::move(copy);
+		ensure_or_die( 3 == counter.use_count(), "two copies expected" );
+	}
+	ensure_or_die( 1 == counter.use_count(), "all copies must be destroyed" );
+}
+
+int
+main()
+{
+	empty_object();
+	free_function();
+	small_lambda();
+	big_lambda();
+	lifetime_of_captures();
+
+	std::cout << "OK" << std::endl;
+
+	return 0;
+}
@@ -6,4 +6,5 @@ MxxRu::Cpp::composite_target {
 	path = 'test/so_5/disp/active_obj'
 
 	required_prj( "#{path}/custom_work_thread/prj.ut.rb" )
+	required_prj( "#{path}/lock_free_queue/prj.ut.rb" )
 }
@@ -0,0 +1,114 @@
+/*
+ * A test for active_obj dispatcher with lock-free demand queues.
+ */
+
+#include <so_5/all.hpp>
+
+#include <test/3rd_party/various_helpers/time_limited_execution.hpp>
+#include <test/3rd_party/various_helpers/ensure.hpp>
+
+#include <vector>
+
+namespace queue_traits = so_5::disp::active_obj::queue_traits;
+
+constexpr int ring_size = 8;
+constexpr int laps = 2000;
+
+struct msg_token final : public so_5::message_t
+{
+	int m_hops;
+
+	explicit msg_token( int hops ) : m_hops{ hops } {}
+};
+
+struct msg_noise final : public so_5::signal_t {};
+
+class a_ring_member_t final : public so_5::agent_t
+{
+	const bool m_starter;
+
+	so_5::mbox_t m_next;
+
+public:
+	a_ring_member_t( context_t ctx, bool starter )
+		:	so_5::agent_t{ std::move(ctx) }
+		,	m_starter{ starter }
+	{}
+
+	void
+	set_next( so_5::mbox_t next ) { m_next = std::move(next); }
+
+	void
+	so_define_agent() override
+	{
+		so_subscribe_self()
+			.event( [this]( mhood_t< msg_token > cmd ) {
+					if( ring_size * laps == cmd->m_hops )
+						so_deregister_agent_coop_normally();
+					else
+					{
+						// Some demands will remain in queues at the shutdown.
+						so_5::send< msg_noise >( m_next );
+						so_5::send< msg_token >( m_next, cmd->m_hops + 1 );
+					}
+				} )
+			.event( []( mhood_t< msg_noise > ) {} );
+	}
+
+	void
+	so_evt_start() override
+	{
+		if( m_starter )
+			so_5::send< msg_token >( m_next, 1 );
+	}
+};
+
+void
+run_test(
+	so_5::work_thread_activity_tracking_t tracking,
+	queue_traits::lock_factory_t lock_factory )
+{
+	so_5::launch( [&]( so_5::environment_t & env ) {
+			env.introduce_coop(
+				so_5::disp::active_obj::make_dispatcher( env,
+						"lock_free",
+						so_5::disp::active_obj::disp_params_t{}
+							.demand_queue_kind(
+									queue_traits::demand_queue_kind_t::lock_free )
+							.work_thread_activity_tracking( tracking )
+							.tune_queue_params(
+								[&]( queue_traits::queue_params_t & p ) {
+									p.lock_factory( lock_factory );
+								} ) ).binder(),
+				[&]( so_5::coop_t & coop ) {
+					std::vector< a_ring_member_t * > members;
+					for( int i = 0; i != ring_size; ++i )
+						members.push_back(
+								coop.make_agent< a_ring_member_t >( 0 == i ) );
+
+					for( int i = 0; i != ring_size; ++i )
+						members[ static_cast< std::size_t >(i) ]->set_next(
+								members[ static_cast< std::size_t >(
+										(i + 1) % ring_size ) ]->so_direct_mbox() );
+				} );
+		} );
+}
+
+int
+main()
+{
+	run_with_time_limit( [] {
+				run_test( so_5::work_thread_activity_tracking_t::off,
+						queue_traits::combined_lock_factory() );
+				run_test( so_5::work_thread_activity_tracking_t::on,
+						queue_traits::combined_lock_factory() );
+				run_test( so_5::work_thread_activity_tracking_t::off,
+						queue_traits::simple_lock_factory() );
+				run_test( so_5::work_thread_activity_tracking_t::on,
+						queue_traits::simple_lock_factory() );
+			},
+			120 );
+
+	return 0;
+}
+
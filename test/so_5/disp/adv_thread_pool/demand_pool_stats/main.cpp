@@ -0,0 +1,139 @@
+/*
+ * A test for statistics of demand nodes recycling in adv_thread_pool.
+ */
+
+#include <iostream>
+#include <exception>
+#include <stdexcept>
+#include <cstdlib>
+
+#include <so_5/all.hpp>
+
+#include <test/3rd_party/various_helpers/time_limited_execution.hpp>
+
+namespace atp_disp = so_5::disp::adv_thread_pool;
+
+class a_test_t final : public so_5::agent_t
+	{
+		struct msg_next final : public so_5::signal_t {};
+
+	public :
+		a_test_t( context_t ctx, bool pool_expected )
+			:	so_5::agent_t( std::move(ctx) )
+			,	m_pool_expected( pool_expected )
+			{}
+
+		void
+		so_define_agent() override
+			{
+				so_subscribe_self().event( &a_test_t::evt_next );
+
+				so_default_state().event(
+						so_environment().stats_controller().mbox(),
+						&a_test_t::evt_monitor_quantity );
+			}
+
+		void
+		so_evt_start() override
+			{
+				so_5::send< msg_next >( *this );
+			}
+
+	private :
+		const bool m_pool_expected;
+
+		unsigned int m_remaining{ 1000u };
+
+		bool m_hits_received{ false };
+		bool m_misses_received{ false };
+
+		void
+		evt_next( mhood_t< msg_next > )
+			{
+				if( --m_remaining )
+					so_5::send< msg_next >( *this );
+				else
+					so_environment().stats_controller().turn_on();
+			}
+
+		void
+		evt_monitor_quantity(
+			const so_5::stats::messages::quantity< std::size_t > & evt )
+			{
+				namespace stats = so_5::stats;
+
+				if( stats::suffixes::demand_pool_hits() == evt.m_suffix )
+					{
+						std::cout << evt.m_prefix.c_str() << evt.m_suffix.c_str()
+								<< ": " << evt.m_value << std::endl;
+
+						if( m_pool_expected && 0u == evt.m_value )
+							throw std::runtime_error( "demand pool hits expected" );
+						if( !m_pool_expected && 0u != evt.m_value )
+							throw std::runtime_error( "no demand pool hits expected" );
+
+						m_hits_received = true;
+					}
+				else if( stats::suffixes::demand_pool_misses() == evt.m_suffix )
+					{
+						std::cout << evt.m_prefix.c_str() << evt.m_suffix.c_str()
+								<< ": " << evt.m_value << std::endl;
+
+						// Misses are counted only if there are caches.
+						// NOTE: there can be no misses at all because nodes
+						// created by external producers are recycled too.
+						if( !m_pool_expected && 0u != evt.m_value )
+							throw std::runtime_error( "no demand pool misses expected" );
+
+						m_misses_received = true;
+					}
+
+				if( m_hits_received && m_misses_received )
+					so_deregister_agent_coop_normally();
+			}
+	};
+
+void
+do_test( std::size_t cache_size )
+	{
+		run_with_time_limit(
+			[cache_size]()
+			{
+				so_5::launch(
+					[cache_size]( so_5::environment_t & env )
+					{
+						auto disp = atp_disp::make_dispatcher(
+								env,
+								"adv_tp",
+								atp_disp::disp_params_t{}
+									.thread_count( 2 )
+									.demand_node_cache_size( cache_size ) );
+
+						env.introduce_coop(
+								disp.binder(),
+								[cache_size]( so_5::coop_t & coop ) {
+									coop.make_agent< a_test_t >( 0u != cache_size );
+								} );
+					} );
+			},
+			20,
+			"adv_thread_pool demand pool stats test" );
+	}
+
+int
+main()
+	{
+		try
+			{
+				do_test( 64u );
+				do_test( 0u );
+			}
+		catch( const std::exception & ex )
+			{
+				std::cerr << "Error: " << ex.what() << std::endl;
+				return 1;
+			}
+
+		return 0;
+	}
+
@@ -0,0 +1,26 @@
+/*
+ * A test for the elastic mode of adv_thread_pool dispatcher.
+ */
+
+#include <so_5/all.hpp>
+
+#include "../../elastic_pool_test.hpp"
+
+int
+main()
+{
+	namespace atp_disp = so_5::disp::adv_thread_pool;
+
+	elastic_pool_test::run( "adv_thread_pool",
+		[]( so_5::environment_t & env ) {
+			return atp_disp::make_dispatcher( env,
+					elastic_pool_test::disp_name,
+					atp_disp::disp_params_t{}
+						.thread_count( elastic_pool_test::max_threads )
+						.elastic( elastic_pool_test::make_elastic_params() ) )
+				.binder( atp_disp::bind_params_t{}
+						.fifo( atp_disp::fifo_t::individual ) );
+		} );
+
+	return 0;
+}
@@ -0,0 +1,10 @@
+#!/usr/local/bin/ruby
+require 'mxx_ru/cpp'
+
+MxxRu::Cpp::composite_target {
+
+	path = 'test/so_5/disp/balancing_one_thread'
+
+	required_prj( "#{path}/simple/prj.ut.rb" )
+	required_prj( "#{path}/rebalance/prj.ut.rb" )
+}
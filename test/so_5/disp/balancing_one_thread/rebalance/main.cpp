@@ -0,0 +1,223 @@
+/*
+ * A test for rebalancing of agents in balancing_one_thread dispatcher.
+ */
+
+#include <so_5/all.hpp>
+
+#include <test/3rd_party/various_helpers/time_limited_execution.hpp>
+#include <test/3rd_party/various_helpers/ensure.hpp>
+
+#include <atomic>
+#include <set>
+#include <vector>
+
+namespace bot_disp = so_5::disp::balancing_one_thread;
+
+constexpr std::size_t thread_count = 3u;
+constexpr std::size_t workers = 6u;
+constexpr int messages_to_send = 1000;
+
+struct msg_started final : public so_5::signal_t {};
+
+struct msg_seq final : public so_5::message_t
+{
+	int m_value;
+
+	msg_seq( int value ) : m_value{ value } {}
+};
+
+struct msg_get_report final : public so_5::signal_t {};
+
+struct msg_report final : public so_5::message_t
+{
+	std::size_t m_threads_used;
+
+	msg_report( std::size_t threads_used ) : m_threads_used{ threads_used } {}
+};
+
+class a_worker_t final : public so_5::agent_t
+{
+	const so_5::mbox_t m_driver;
+
+	std::set< so_5::current_thread_id_t > m_threads;
+	int m_expected{};
+
+	std::atomic< int > m_handlers_running{};
+
+public:
+	a_worker_t( context_t ctx, so_5::mbox_t driver )
+		:	so_5::agent_t{ std::move(ctx) }
+		,	m_driver{ std::move(driver) }
+	{}
+
+	void
+	so_define_agent() override
+	{
+		so_subscribe_self()
+			.event( [this]( mhood_t< msg_seq > cmd ) {
+					ensure( 1 == ++m_handlers_running,
+							"agent is running on several threads at the same time" );
+
+					m_threads.insert( so_5::query_current_thread_id() );
+					ensure( m_expected == cmd->m_value,
+							"unexpected order of messages, expected: " +
+							std::to_string( m_expected ) + ", received: " +
+							std::to_string( cmd->m_value ) );
+					++m_expected;
+
+					--m_handlers_running;
+				} )
+			.event( [this]( mhood_t< msg_get_report > ) {
+					ensure( messages_to_send == m_expected,
+							"not all messages are received: " +
+							std::to_string( m_expected ) );
+
+					so_5::send< msg_report >( m_driver, m_threads.size() );
+				} );
+	}
+
+	void
+	so_evt_start() override
+	{
+		m_threads.insert( so_5::query_current_thread_id() );
+		so_5::send< msg_started >( m_driver );
+	}
+};
+
+class a_driver_t final : public so_5::agent_t
+{
+	struct msg_check_counts final : public so_5::signal_t {};
+
+	const bot_disp::dispatcher_handle_t m_disp;
+
+	std::vector< so_5::coop_handle_t > m_coops;
+	std::vector< so_5::mbox_t > m_workers;
+
+	std::size_t m_started{};
+
+	std::size_t m_reports{};
+	std::size_t m_threads_used{};
+
+public:
+	a_driver_t( context_t ctx, bot_disp::dispatcher_handle_t disp )
+		:	so_5::agent_t{ std::move(ctx) }
+		,	m_disp{ std::move(disp) }
+	{}
+
+	void
+	so_define_agent() override
+	{
+		so_subscribe_self()
+			.event( &a_driver_t::evt_started )
+			.event( &a_driver_t::evt_check_counts )
+			.event( &a_driver_t::evt_report );
+	}
+
+	void
+	so_evt_start() override
+	{
+		// Agents will be placed on threads 0, 1, 2, 0, 1, 2.
+		for( std::size_t i = 0u; i != workers; ++i )
+			so_environment().introduce_coop( m_disp.binder(),
+				[&]( so_5::coop_t & coop ) {
+					m_workers.push_back(
+							coop.make_agent< a_worker_t >( so_direct_mbox() )
+									->so_direct_mbox() );
+					m_coops.push_back( coop.handle() );
+				} );
+	}
+
+private:
+	void
+	evt_started( mhood_t< msg_started > )
+	{
+		if( workers != ++m_started )
+			return;
+
+		// Only agents on the last thread should remain.
+		for( std::size_t i = 0u; i != workers; ++i )
+			if( thread_count - 1u != i % thread_count )
+				so_environment().deregister_coop(
+						m_coops[ i ], so_5::dereg_reason::normal );
+
+		so_5::send< msg_check_counts >( *this );
+	}
+
+	void
+	evt_check_counts( mhood_t< msg_check_counts > )
+	{
+		const auto expected = std::vector< std::size_t >{ 0u, 0u, 2u };
+		if( expected != m_disp.agents_per_thread() )
+		{
+			// Deregistration isn't finished yet.
+			so_5::send_delayed< msg_check_counts >(
+					*this, std::chrono::milliseconds{ 1 } );
+			return;
+		}
+
+		// Messages are sent before and after the start of rebalancing.
+		const auto & w1 = m_workers[ thread_count - 1u ];
+		const auto & w2 = m_workers[ workers - 1u ];
+		for( int i = 0; i != messages_to_send / 2; ++i )
+		{
+			so_5::send< msg_seq >( w1, i );
+			so_5::send< msg_seq >( w2, i );
+		}
+
+		const auto switched = m_disp.rebalance();
+		ensure( 1u == switched,
+				"one agent should be switched, switched: " +
+				std::to_string( switched ) );
+
+		const auto counts = m_disp.agents_per_thread();
+		ensure( 1u == counts[ 0 ] && 0u == counts[ 1 ] && 1u == counts[ 2 ],
+				"unexpected counts after rebalancing" );
+
+		// The second call does nothing.
+		ensure( 0u == m_disp.rebalance(), "nothing should be switched" );
+
+		for( int i = messages_to_send / 2; i != messages_to_send; ++i )
+		{
+			so_5::send< msg_seq >( w1, i );
+			so_5::send< msg_seq >( w2, i );
+		}
+
+		so_5::send< msg_get_report >( w1 );
+		so_5::send< msg_get_report >( w2 );
+	}
+
+	void
+	evt_report( mhood_t< msg_report > cmd )
+	{
+		m_threads_used += cmd->m_threads_used;
+		if( 2u == ++m_reports )
+		{
+			// One agent worked on one thread, another on two threads.
+			ensure( 3u == m_threads_used,
+					"unexpected count of threads used: " +
+					std::to_string( m_threads_used ) );
+
+			so_environment().stop();
+		}
+	}
+};
+
+int
+main()
+{
+	run_with_time_limit( [] {
+			so_5::launch( []( so_5::environment_t & env ) {
+					auto disp = bot_disp::make_dispatcher( env, "bot",
+							bot_disp::disp_params_t{}
+								.thread_count( thread_count )
+								.load_metric( bot_disp::load_metric_t::agent_count ) );
+
+					env.introduce_coop( [&]( so_5::coop_t & coop ) {
+							coop.make_agent< a_driver_t >( disp );
+						} );
+				} );
+		},
+		20 );
+
+	return 0;
+}
@@ -0,0 +1,146 @@
+/*
+ * A simple test for balancing_one_thread dispatcher.
+ */
+
+#include <so_5/all.hpp>
+
+#include <test/3rd_party/various_helpers/time_limited_execution.hpp>
+#include <test/3rd_party/various_helpers/ensure.hpp>
+
+#include <map>
+
+namespace bot_disp = so_5::disp::balancing_one_thread;
+
+constexpr std::size_t thread_count = 3u;
+constexpr std::size_t agents_per_thread = 2u;
+
+struct msg_started final : public so_5::message_t
+{
+	so_5::current_thread_id_t m_thread_id;
+
+	msg_started( so_5::current_thread_id_t thread_id )
+		:	m_thread_id{ thread_id }
+	{}
+};
+
+class a_worker_t final : public so_5::agent_t
+{
+	const so_5::mbox_t m_checker;
+
+public:
+	a_worker_t( context_t ctx, so_5::mbox_t checker )
+		:	so_5::agent_t{ std::move(ctx) }
+		,	m_checker{ std::move(checker) }
+	{}
+
+	void
+	so_evt_start() override
+	{
+		so_5::send< msg_started >( m_checker, so_5::query_current_thread_id() );
+	}
+};
+
+class a_checker_t final : public so_5::agent_t
+{
+	const bot_disp::dispatcher_handle_t m_disp;
+	const bool m_exact_distribution;
+
+	std::map< so_5::current_thread_id_t, std::size_t > m_agents_by_thread;
+	std::size_t m_started{};
+
+public:
+	a_checker_t(
+		context_t ctx,
+		bot_disp::dispatcher_handle_t disp,
+		bool exact_distribution )
+		:	so_5::agent_t{ std::move(ctx) }
+		,	m_disp{ std::move(disp) }
+		,	m_exact_distribution{ exact_distribution }
+	{}
+
+	void
+	so_define_agent() override
+	{
+		so_subscribe_self().event( &a_checker_t::evt_started );
+	}
+
+private:
+	void
+	evt_started( mhood_t< msg_started > cmd )
+	{
+		++m_agents_by_thread[ cmd->m_thread_id ];
+
+		if( thread_count * agents_per_thread == ++m_started )
+		{
+			const auto counts = m_disp.agents_per_thread();
+			ensure( thread_count == counts.size(),
+					"unexpected size of agents_per_thread" );
+
+			std::size_t total = 0u;
+			for( const auto c : counts )
+				total += c;
+			ensure( thread_count * agents_per_thread == total,
+					"unexpected total count of agents: " + std::to_string( total ) );
+
+			// NOTE: for metrics those use the count of demands the
+			// distribution depends on the timing.
+			if( m_exact_distribution )
+			{
+				ensure( thread_count == m_agents_by_thread.size(),
+						"all threads should be used, threads used: " +
+						std::to_string( m_agents_by_thread.size() ) );
+
+				for( const auto & p : m_agents_by_thread )
+					ensure( agents_per_thread == p.second,
+							"unexpected count of agents on a thread: " +
+							std::to_string( p.second ) );
+
+				for( const auto c : counts )
+					ensure( agents_per_thread == c,
+							"unexpected value in agents_per_thread: " +
+							std::to_string( c ) );
+			}
+
+			so_environment().stop();
+		}
+	}
+};
+
+void
+run_test( bot_disp::load_metric_t metric )
+{
+	run_with_time_limit( [metric] {
+			so_5::launch( [metric]( so_5::environment_t & env ) {
+					auto disp = bot_disp::make_dispatcher( env, "bot",
+							bot_disp::disp_params_t{}
+								.thread_count( thread_count )
+								.load_metric( metric ) );
+
+					auto checker = env.introduce_coop( [&]( so_5::coop_t & coop ) {
+							return coop.make_agent< a_checker_t >( disp,
+										bot_disp::load_metric_t::agent_count == metric )
+									->so_direct_mbox();
+						} );
+
+					// NOTE: every agent is registered in a separate coop
+					// because all agents of a coop are bound at once.
+					for( std::size_t i = 0u;
+							i != thread_count * agents_per_thread; ++i )
+						env.introduce_coop( disp.binder(),
+							[&]( so_5::coop_t & coop ) {
+								coop.make_agent< a_worker_t >( checker );
+							} );
+				} );
+		},
+		10 );
+}
+
+int
+main()
+{
+	run_test( bot_disp::load_metric_t::agent_count );
+	run_test( bot_disp::load_metric_t::demand_count );
+	run_test( bot_disp::load_metric_t::agent_and_demand_count );
+
+	return 0;
+}
@@ -8,5 +8,6 @@ MxxRu::Cpp::composite_target {
 	add_test[ 'bind_to_disp_2/prj.ut.rb' ]
 	add_test[ 'bind_to_disp_3/prj.ut.rb' ]
 	add_test[ 'correct_unbind_after_throw_on_bind/prj.ut.rb' ]
+	add_test[ 'migrate_agent/prj.ut.rb' ]
 }
 
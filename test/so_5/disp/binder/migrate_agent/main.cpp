@@ -0,0 +1,398 @@
+/*
+ * A test for migration of an agent between dispatchers.
+ */
+
+#include <so_5/all.hpp>
+
+#include <test/3rd_party/various_helpers/time_limited_execution.hpp>
+#include <test/3rd_party/various_helpers/ensure.hpp>
+
+#include <array>
+#include <atomic>
+#include <functional>
+#include <set>
+#include <string>
+
+constexpr int steps_per_stage = 20;
+constexpr std::size_t stages = 3u;
+
+//
+// Counters of calls to a binder.
+//
+struct binder_counters_t
+{
+	std::atomic< int > m_bound{ 0 };
+	std::atomic< int > m_unbound{ 0 };
+};
+
+//
+// A binder that counts calls to the actual binder.
+//
+class counting_binder_t final
+	:	public so_5::disp_binder_t
+	,	public so_5::transfer_queue_provider_t
+{
+	const so_5::disp_binder_shptr_t m_actual;
+	binder_counters_t & m_counters;
+
+public:
+	counting_binder_t(
+		so_5::disp_binder_shptr_t actual,
+		binder_counters_t & counters )
+		:	m_actual{ std::move(actual) }
+		,	m_counters{ counters }
+	{}
+
+	void
+	preallocate_resources( so_5::agent_t & agent ) override
+	{
+		m_actual->preallocate_resources( agent );
+	}
+
+	void
+	undo_preallocation( so_5::agent_t & agent ) noexcept override
+	{
+		m_actual->undo_preallocation( agent );
+	}
+
+	void
+	bind( so_5::agent_t & agent ) noexcept override
+	{
+		++m_counters.m_bound;
+		m_actual->bind( agent );
+	}
+
+	void
+	unbind( so_5::agent_t & agent ) noexcept override
+	{
+		++m_counters.m_unbound;
+		m_actual->unbind( agent );
+	}
+
+	so_5::event_queue_t &
+	bind_transferred( so_5::agent_t & agent ) noexcept override
+	{
+		++m_counters.m_bound;
+		return dynamic_cast< so_5::transfer_queue_provider_t & >( *m_actual )
+				.bind_transferred( agent );
+	}
+};
+
+//
+// A binder without support for migration.
+//
+class non_transferable_binder_t final : public so_5::disp_binder_t
+{
+	const so_5::disp_binder_shptr_t m_actual;
+
+public:
+	non_transferable_binder_t( so_5::disp_binder_shptr_t actual )
+		:	m_actual{ std::move(actual) }
+	{}
+
+	void
+	preallocate_resources( so_5::agent_t & agent ) override
+	{
+		m_actual->preallocate_resources( agent );
+	}
+
+	void
+	undo_preallocation( so_5::agent_t & agent ) noexcept override
+	{
+		m_actual->undo_preallocation( agent );
+	}
+
+	void
+	bind( so_5::agent_t & agent ) noexcept override
+	{
+		m_actual->bind( agent );
+	}
+
+	void
+	unbind( so_5::agent_t & agent ) noexcept override
+	{
+		m_actual->unbind( agent );
+	}
+};
+
+template< typename Lambda >
+void
+ensure_error_code( int expected, const char * what, Lambda && lambda )
+{
+	try
+	{
+		lambda();
+	}
+	catch( const so_5::exception_t & x )
+	{
+		ensure( expected == x.error_code(),
+				std::string{ what } + ": unexpected error code: " +
+				std::to_string( x.error_code() ) );
+		return;
+	}
+
+	throw std::runtime_error( std::string{ what } + ": exception expected" );
+}
+
+struct msg_step final : public so_5::message_t
+{
+	int m_index;
+
+	msg_step( int index ) : m_index{ index } {}
+};
+
+//
+// An agent that goes through three dispatchers.
+//
+// Demands sent before a migration have to be handled on the old
+// dispatcher, demands sent after it -- on the new one. The order
+// of demands must be preserved.
+//
+class a_test_t final : public so_5::agent_t
+{
+	const so_5::disp_binder_shptr_t m_second_binder;
+	const so_5::disp_binder_shptr_t m_third_binder;
+
+	// Threads used on previous dispatchers.
+	std::set< so_5::current_thread_id_t > m_previous_threads;
+	// Threads used on the current dispatcher.
+	std::set< so_5::current_thread_id_t > m_current_threads;
+
+	int m_expected{ 0 };
+
+public:
+	a_test_t(
+		context_t ctx,
+		so_5::disp_binder_shptr_t second_binder,
+		so_5::disp_binder_shptr_t third_binder )
+		:	so_5::agent_t{ std::move(ctx) }
+		,	m_second_binder{ std::move(second_binder) }
+		,	m_third_binder{ std::move(third_binder) }
+	{}
+
+	void
+	so_define_agent() override
+	{
+		// The agent isn't bound to a dispatcher yet.
+		ensure_error_code( so_5::rc_agent_cannot_be_migrated,
+				"migration from so_define_agent",
+				[this] { so_migrate_to_dispatcher( m_second_binder ); } );
+
+		so_subscribe_self().event( &a_test_t::evt_step );
+	}
+
+	void
+	so_evt_start() override
+	{
+		m_current_threads.insert( so_5::query_current_thread_id() );
+
+		ensure_error_code( so_5::rc_disp_binder_does_not_support_transfer,
+				"migration with null binder",
+				[this] { so_migrate_to_dispatcher( {} ); } );
+
+		send_steps( 0 );
+		so_migrate_to_dispatcher( m_second_binder );
+
+		ensure_error_code( so_5::rc_agent_migration_in_progress,
+				"the second migration",
+				[this] { so_migrate_to_dispatcher( m_third_binder ); } );
+
+		send_steps( 1 );
+	}
+
+	void
+	so_evt_finish() override
+	{
+		ensure( stages * steps_per_stage == static_cast< std::size_t >(m_expected),
+				"all steps have to be handled before evt_finish, handled: " +
+				std::to_string( m_expected ) );
+
+		check_thread();
+
+		so_environment().stop();
+	}
+
+private:
+	void
+	send_steps( int stage )
+	{
+		for( int i = 0; i != steps_per_stage; ++i )
+			so_5::send< msg_step >( *this, stage * steps_per_stage + i );
+	}
+
+	void
+	check_thread()
+	{
+		const auto id = so_5::query_current_thread_id();
+		ensure( m_previous_threads.end() == m_previous_threads.find( id ),
+				"demand is handled on a thread of the previous dispatcher" );
+
+		m_current_threads.insert( id );
+	}
+
+	void
+	evt_step( mhood_t< msg_step > cmd )
+	{
+		ensure( m_expected == cmd->m_index,
+				"unexpected step: " + std::to_string( cmd->m_index ) +
+				", expected: " + std::to_string( m_expected ) );
+		++m_expected;
+
+		if( cmd->m_index > 0 && 0 == cmd->m_index % steps_per_stage )
+		{
+			// The first demand on the new dispatcher.
+			m_previous_threads.insert(
+					m_current_threads.begin(), m_current_threads.end() );
+			m_current_threads.clear();
+		}
+
+		check_thread();
+
+		if( 2 * steps_per_stage - 1 == cmd->m_index )
+		{
+			so_migrate_to_dispatcher( m_third_binder );
+			send_steps( 2 );
+
+			// evt_finish has to be handled on the third dispatcher
+			// after all the steps.
+			so_deregister_agent_coop_normally();
+		}
+	}
+};
+
+using binder_factory_t =
+		std::function< so_5::disp_binder_shptr_t( so_5::environment_t & ) >;
+
+void
+run_scenario(
+	const std::string & name,
+	const std::array< binder_factory_t, stages > & factories )
+{
+	std::array< binder_counters_t, stages > counters;
+
+	run_with_time_limit( [&] {
+			so_5::launch( [&]( so_5::environment_t & env ) {
+					std::array< so_5::disp_binder_shptr_t, stages > binders;
+					for( std::size_t i = 0u; i != stages; ++i )
+						binders[ i ] = std::make_shared< counting_binder_t >(
+								factories[ i ]( env ), counters[ i ] );
+
+					env.introduce_coop( binders[ 0 ],
+						[&]( so_5::coop_t & coop ) {
+							coop.make_agent< a_test_t >( binders[ 1 ], binders[ 2 ] );
+						} );
+				} );
+		},
+		10,
+		name );
+
+	for( std::size_t i = 0u; i != stages; ++i )
+	{
+		ensure( 1 == counters[ i ].m_bound,
+				name + ": unexpected count of bindings for binder #" +
+				std::to_string( i ) );
+		ensure( 1 == counters[ i ].m_unbound,
+				name + ": unexpected count of unbindings for binder #" +
+				std::to_string( i ) );
+	}
+}
+
+class a_non_transferable_t final : public so_5::agent_t
+{
+public:
+	using so_5::agent_t::agent_t;
+
+	void
+	so_evt_start() override
+	{
+		ensure_error_code( so_5::rc_disp_binder_does_not_support_transfer,
+				"migration to non_transferable_binder",
+				[this] {
+					so_migrate_to_dispatcher(
+							std::make_shared< non_transferable_binder_t >(
+									so_5::disp::one_thread::make_dispatcher(
+											so_environment() ).binder() ) );
+				} );
+
+		so_environment().stop();
+	}
+};
+
+void
+run_non_transferable_scenario()
+{
+	run_with_time_limit( [] {
+			so_5::launch( []( so_5::environment_t & env ) {
+					env.introduce_coop( []( so_5::coop_t & coop ) {
+							coop.make_agent< a_non_transferable_t >();
+						} );
+				} );
+		},
+		10,
+		"non_transferable" );
+}
+
+int
+main()
+{
+	namespace disp = so_5::disp;
+
+	const binder_factory_t one_thread = []( so_5::environment_t & env ) {
+			return disp::one_thread::make_dispatcher( env ).binder();
+		};
+	const binder_factory_t nef_one_thread = []( so_5::environment_t & env ) {
+			return disp::nef_one_thread::make_dispatcher( env ).binder();
+		};
+	const binder_factory_t active_obj = []( so_5::environment_t & env ) {
+			return disp::active_obj::make_dispatcher( env ).binder();
+		};
+	const binder_factory_t active_group = []( so_5::environment_t & env ) {
+			return disp::active_group::make_dispatcher( env ).binder( "group" );
+		};
+	const binder_factory_t thread_pool = []( so_5::environment_t & env ) {
+			return disp::thread_pool::make_dispatcher( env, 2u ).binder();
+		};
+	const binder_factory_t adv_thread_pool = []( so_5::environment_t & env ) {
+			return disp::adv_thread_pool::make_dispatcher( env, 2u ).binder();
+		};
+	const binder_factory_t nef_thread_pool = []( so_5::environment_t & env ) {
+			return disp::nef_thread_pool::make_dispatcher( env, 2u ).binder();
+		};
+	const binder_factory_t work_stealing_pool = []( so_5::environment_t & env ) {
+			return disp::work_stealing_pool::make_dispatcher( env, 2u ).binder();
+		};
+	const binder_factory_t balancing_one_thread = []( so_5::environment_t & env ) {
+			return disp::balancing_one_thread::make_dispatcher( env,
+					"bot",
+					disp::balancing_one_thread::disp_params_t{}.thread_count( 2u ) )
+				.binder();
+		};
+	const binder_factory_t prio_ot_strictly_ordered = []( so_5::environment_t & env ) {
+			return disp::prio_one_thread::strictly_ordered::make_dispatcher( env )
+				.binder();
+		};
+	const binder_factory_t prio_ot_quoted_round_robin = []( so_5::environment_t & env ) {
+			return disp::prio_one_thread::quoted_round_robin::make_dispatcher(
+					env, disp::prio_one_thread::quoted_round_robin::quotes_t{ 5u } )
+				.binder();
+		};
+	const binder_factory_t prio_dt_one_per_prio = []( so_5::environment_t & env ) {
+			return disp::prio_dedicated_threads::one_per_prio::make_dispatcher( env )
+				.binder();
+		};
+
+	run_scenario( "one_thread->thread_pool->active_obj",
+			{ one_thread, thread_pool, active_obj } );
+	run_scenario( "active_group->adv_thread_pool->nef_one_thread",
+			{ active_group, adv_thread_pool, nef_one_thread } );
+	run_scenario( "work_stealing_pool->balancing_one_thread->prio_ot_strictly_ordered",
+			{ work_stealing_pool, balancing_one_thread, prio_ot_strictly_ordered } );
+	run_scenario( "nef_thread_pool->prio_dt_one_per_prio->prio_ot_quoted_round_robin",
+			{ nef_thread_pool, prio_dt_one_per_prio, prio_ot_quoted_round_robin } );
+	run_scenario( "prio_ot_quoted_round_robin->one_thread->thread_pool",
+			{ prio_ot_quoted_round_robin, one_thread, thread_pool } );
+
+	run_non_transferable_scenario();
+
+	return 0;
+}
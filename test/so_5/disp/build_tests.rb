@@ -5,15 +5,19 @@ MxxRu::Cpp::composite_target {
 	add_test = lambda { |name| required_prj "test/so_5/disp/#{name}" }
 
 	add_test[ 'binder/build_tests.rb' ]
+	add_test[ 'work_thread_placement/build_tests.rb' ]
+	add_test[ 'idle_strategy/build_tests.rb' ]
 
 	add_test[ 'one_thread/build_tests.rb' ]
 	add_test[ 'nef_one_thread/build_tests.rb' ]
 	add_test[ 'active_obj/build_tests.rb' ]
 	add_test[ 'active_group/build_tests.rb' ]
+	add_test[ 'balancing_one_thread/build_tests.rb' ]
 
 	add_test[ 'thread_pool/build_tests.rb' ]
 	add_test[ 'adv_thread_pool/build_tests.rb' ]
 	add_test[ 'nef_thread_pool/build_tests.rb' ]
+	add_test[ 'work_stealing_pool/build_tests.rb' ]
 
 	add_test[ 'private_dispatchers/build_tests.rb' ]
 
@@ -0,0 +1,159 @@
+#pragma once
+
+#include <so_5/all.hpp>
+
+#include <test/3rd_party/various_helpers/time_limited_execution.hpp>
+#include <test/3rd_party/various_helpers/ensure.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <thread>
+
+namespace elastic_pool_test
+{
+
+using namespace std::chrono_literals;
+
+//! Name of dispatcher to be found in names of data sources.
+constexpr const char * disp_name = "elastic_disp";
+
+//! Max count of threads for the dispatcher.
+constexpr std::size_t max_threads = 4u;
+
+[[nodiscard]]
+inline so_5::disp::elastic_pool_params_t
+make_elastic_params()
+{
+	return so_5::disp::elastic_pool_params_t{}
+			.min_threads( 1u )
+			.scale_up_queue_depth( 1u )
+			.scale_up_delay( 20ms )
+			.scale_down_idle_time( 100ms )
+			.check_period( 5ms );
+}
+
+struct msg_worker_finished final : public so_5::signal_t {};
+
+//
+// a_worker_t
+//
+/*!
+ * Blocks its work thread until all workers are running at the same time.
+ * It is possible only if the dispatcher starts additional threads.
+ */
+class a_worker_t final : public so_5::agent_t
+{
+	std::atomic< std::size_t > & m_running;
+	const so_5::mbox_t m_checker;
+
+public:
+	a_worker_t(
+		context_t ctx,
+		std::atomic< std::size_t > & running,
+		so_5::mbox_t checker )
+		:	so_5::agent_t{ std::move(ctx) }
+		,	m_running{ running }
+		,	m_checker{ std::move(checker) }
+	{}
+
+	void
+	so_evt_start() override
+	{
+		++m_running;
+
+		const auto deadline = std::chrono::steady_clock::now() + 10s;
+		while( m_running.load() != max_threads )
+		{
+			ensure( std::chrono::steady_clock::now() < deadline,
+					"all workers can't run at the same time, running: " +
+					std::to_string( m_running.load() ) );
+			std::this_thread::sleep_for( 1ms );
+		}
+
+		so_5::send< msg_worker_finished >( m_checker );
+	}
+};
+
+//
+// a_checker_t
+//
+/*!
+ * Waits for completion of all workers and then waits for the decrement
+ * of thread count to the min value.
+ */
+class a_checker_t final : public so_5::agent_t
+{
+	std::size_t m_finished_workers{};
+
+public:
+	using so_5::agent_t::agent_t;
+
+	void
+	so_define_agent() override
+	{
+		so_subscribe_self().event( [this]( mhood_t< msg_worker_finished > ) {
+				++m_finished_workers;
+			} );
+
+		so_subscribe( so_environment().stats_controller().mbox() )
+			.event( &a_checker_t::evt_quantity );
+	}
+
+	void
+	so_evt_start() override
+	{
+		so_environment().stats_controller().set_distribution_period( 20ms );
+		so_environment().stats_controller().turn_on();
+	}
+
+private:
+	void
+	evt_quantity(
+		const so_5::stats::messages::quantity< std::size_t > & evt )
+	{
+		if( so_5::stats::suffixes::disp_thread_count() != evt.m_suffix ||
+				!std::strstr( evt.m_prefix.c_str(), disp_name ) )
+			return;
+
+		ensure( evt.m_value >= 1u && evt.m_value <= max_threads,
+				"unexpected thread count: " + std::to_string( evt.m_value ) );
+
+		if( max_threads == m_finished_workers && 1u == evt.m_value )
+			so_deregister_agent_coop_normally();
+	}
+};
+
+using binder_maker_t = std::function<
+		so_5::disp_binder_shptr_t( so_5::environment_t & ) >;
+
+inline void
+run( const char * case_name, const binder_maker_t & binder_maker )
+{
+	std::cout << case_name << "..." << std::flush;
+
+	run_with_time_limit( [&] {
+			std::atomic< std::size_t > running{ 0u };
+
+			so_5::launch( [&]( so_5::environment_t & env ) {
+					env.introduce_coop( [&]( so_5::coop_t & coop ) {
+							auto * checker = coop.make_agent< a_checker_t >();
+
+							auto binder = binder_maker( env );
+							for( std::size_t i = 0; i != max_threads; ++i )
+								coop.make_agent_with_binder< a_worker_t >(
+										binder,
+										std::ref(running),
+										checker->so_direct_mbox() );
+						} );
+				} );
+		},
+		30 );
+
+	std::cout << "OK" << std::endl;
+}
+
+} /* namespace elastic_pool_test */
@@ -0,0 +1,252 @@
+/*
+ * Basic checks for idle strategies of queue locks.
+ */
+
+#include <so_5/all.hpp>
+
+#include <test/3rd_party/various_helpers/time_limited_execution.hpp>
+#include <test/3rd_party/various_helpers/ensure.hpp>
+
+#include <functional>
+#include <iostream>
+#include <string>
+
+constexpr int pings_to_send = 50;
+
+struct msg_ping final : public so_5::signal_t {};
+struct msg_pong final : public so_5::signal_t {};
+
+class a_pinger_t final : public so_5::agent_t
+{
+	const so_5::mbox_t m_ponger;
+	int & m_pongs_received;
+
+public:
+	a_pinger_t( context_t ctx, so_5::mbox_t ponger, int & pongs_received )
+		:	so_5::agent_t{ std::move(ctx) }
+		,	m_ponger{ std::move(ponger) }
+		,	m_pongs_received{ pongs_received }
+	{}
+
+	void
+	so_define_agent() override
+	{
+		so_subscribe_self().event( [this]( mhood_t< msg_pong > ) {
+				if( pings_to_send == ++m_pongs_received )
+					so_deregister_agent_coop_normally();
+				else
+					so_5::send< msg_ping >( m_ponger );
+			} );
+	}
+
+	void
+	so_evt_start() override
+	{
+		so_5::send< msg_ping >( m_ponger );
+	}
+};
+
+class a_ponger_t final : public so_5::agent_t
+{
+	so_5::mbox_t m_pinger;
+
+public:
+	using so_5::agent_t::agent_t;
+
+	void
+	set_pinger( so_5::mbox_t pinger ) { m_pinger = std::move(pinger); }
+
+	void
+	so_define_agent() override
+	{
+		so_subscribe_self().event( [this]( mhood_t< msg_ping > ) {
+				so_5::send< msg_pong >( m_pinger );
+			} );
+	}
+};
+
+struct lock_factories_t
+{
+	so_5::disp::mpsc_queue_traits::lock_factory_t m_mpsc;
+	so_5::disp::mpmc_queue_traits::lock_factory_t m_mpmc;
+};
+
+using binder_maker_t = std::function<
+		so_5::disp_binder_shptr_t(
+				so_5::environment_t &,
+				const lock_factories_t & ) >;
+
+void
+run_ping_pong(
+	const binder_maker_t & binder_maker,
+	const lock_factories_t & factories )
+{
+	int pongs_received = 0;
+
+	run_with_time_limit( [&] {
+			so_5::launch( [&]( so_5::environment_t & env ) {
+					env.introduce_coop(
+						binder_maker( env, factories ),
+						[&]( so_5::coop_t & coop ) {
+							// Ponger works on the default dispatcher, so the
+							// pinger's work thread waits for every pong.
+							auto * ponger = coop.make_agent_with_binder< a_ponger_t >(
+									so_5::make_default_disp_binder( env ) );
+							auto * pinger = coop.make_agent< a_pinger_t >(
+									ponger->so_direct_mbox(),
+									std::ref(pongs_received) );
+							ponger->set_pinger( pinger->so_direct_mbox() );
+						} );
+				} );
+		},
+		60 );
+
+	ensure( pings_to_send == pongs_received,
+			"unexpected count of pongs: " + std::to_string( pongs_received ) );
+}
+
+void
+check_strategy(
+	const std::string & strategy_name,
+	so_5::disp::idle_strategy_t strategy,
+	const std::string & disp_name,
+	const binder_maker_t & binder_maker )
+{
+	using so_5::disp::idle_strategy_kind_t;
+
+	std::cout << disp_name << " with " << strategy_name << "..." << std::flush;
+
+	auto stats = std::make_shared< so_5::disp::idle_stats_collector_t >();
+
+	run_ping_pong( binder_maker,
+			lock_factories_t{
+				so_5::disp::mpsc_queue_traits::idle_strategy_lock_factory(
+						strategy, stats ),
+				so_5::disp::mpmc_queue_traits::idle_strategy_lock_factory(
+						strategy, stats )
+			} );
+
+	const auto r = stats->stats();
+
+	ensure( 0u != r.m_wakeups, "at least one wakeup is expected" );
+	ensure( r.m_wakeups == r.m_active_wakeups + r.m_parked_wakeups,
+			"wakeups: " + std::to_string( r.m_wakeups ) +
+			", active: " + std::to_string( r.m_active_wakeups ) +
+			", parked: " + std::to_string( r.m_parked_wakeups ) );
+	ensure( r.m_max_wakeup_latency <= r.m_total_wakeup_latency,
+			"max latency can't be greater than total latency" );
+
+	switch( strategy.kind() )
+	{
+	case idle_strategy_kind_t::busy_spin:
+	case idle_strategy_kind_t::exponential_backoff:
+		ensure( 0u == r.m_parked_wakeups, "no parking is expected" );
+		ensure( 0 == r.m_parked_time.count(), "no parked time is expected" );
+	break;
+
+	case idle_strategy_kind_t::park:
+		ensure( 0u == r.m_active_wakeups, "no active wakeups are expected" );
+		ensure( 0 == r.m_idle_cpu_time.count(), "no idle CPU time is expected" );
+	break;
+
+	case idle_strategy_kind_t::spin_then_yield:
+	break;
+	}
+
+	// Locks without stats collector.
+	run_ping_pong( binder_maker,
+			lock_factories_t{
+				so_5::disp::mpsc_queue_traits::idle_strategy_lock_factory( strategy ),
+				so_5::disp::mpmc_queue_traits::idle_strategy_lock_factory( strategy )
+			} );
+
+	std::cout << "OK" << std::endl;
+}
+
+void
+check_all_strategies(
+	const std::string & disp_name,
+	const binder_maker_t & binder_maker )
+{
+	using so_5::disp::idle_strategy_t;
+
+	check_strategy( "busy_spin", idle_strategy_t::busy_spin(),
+			disp_name, binder_maker );
+	check_strategy( "spin_then_yield",
+			idle_strategy_t::spin_then_yield( 100u, std::chrono::microseconds{ 50 } ),
+			disp_name, binder_maker );
+	check_strategy( "exponential_backoff",
+			idle_strategy_t::exponential_backoff(
+					std::chrono::microseconds{ 1 },
+					std::chrono::microseconds{ 200 } ),
+			disp_name, binder_maker );
+	check_strategy( "park", idle_strategy_t::park(),
+			disp_name, binder_maker );
+}
+
+int
+main()
+{
+	using namespace so_5::disp;
+
+	check_all_strategies( "one_thread",
+		[]( so_5::environment_t & env, const lock_factories_t & f ) {
+			return one_thread::make_dispatcher( env, "one_thread",
+					one_thread::disp_params_t{}
+						.tune_queue_params( [&]( one_thread::queue_traits::queue_params_t & p ) {
+							p.lock_factory( f.m_mpsc );
+						} ) ).binder();
+		} );
+
+	check_all_strategies( "one_thread(lock_free)",
+		[]( so_5::environment_t & env, const lock_factories_t & f ) {
+			return one_thread::make_dispatcher( env, "one_thread",
+					one_thread::disp_params_t{}
+						.demand_queue_kind( mpsc_queue_traits::demand_queue_kind_t::lock_free )
+						.tune_queue_params( [&]( one_thread::queue_traits::queue_params_t & p ) {
+							p.lock_factory( f.m_mpsc );
+						} ) ).binder();
+		} );
+
+	check_all_strategies( "prio_one_thread::strictly_ordered",
+		[]( so_5::environment_t & env, const lock_factories_t & f ) {
+			using namespace prio_one_thread::strictly_ordered;
+			return make_dispatcher( env, "so",
+					disp_params_t{}
+						.tune_queue_params( [&]( queue_traits::queue_params_t & p ) {
+							p.lock_factory( f.m_mpsc );
+						} ) ).binder();
+		} );
+
+	check_all_strategies( "thread_pool",
+		[]( so_5::environment_t & env, const lock_factories_t & f ) {
+			return thread_pool::make_dispatcher( env, "thread_pool",
+					thread_pool::disp_params_t{}
+						.thread_count( 2 )
+						.tune_queue_params( [&]( thread_pool::queue_traits::queue_params_t & p ) {
+							p.lock_factory( f.m_mpmc );
+						} ) ).binder();
+		} );
+
+	check_all_strategies( "adv_thread_pool",
+		[]( so_5::environment_t & env, const lock_factories_t & f ) {
+			return adv_thread_pool::make_dispatcher( env, "adv_thread_pool",
+					adv_thread_pool::disp_params_t{}
+						.thread_count( 2 )
+						.tune_queue_params( [&]( adv_thread_pool::queue_traits::queue_params_t & p ) {
+							p.lock_factory( f.m_mpmc );
+						} ) ).binder();
+		} );
+
+	check_all_strategies( "work_stealing_pool",
+		[]( so_5::environment_t & env, const lock_factories_t & f ) {
+			return work_stealing_pool::make_dispatcher( env, "work_stealing_pool",
+					work_stealing_pool::disp_params_t{}
+						.thread_count( 2 )
+						.tune_queue_params( [&]( work_stealing_pool::queue_traits::queue_params_t & p ) {
+							p.lock_factory( f.m_mpmc );
+						} ) ).binder();
+		} );
+
+	return 0;
+}
@@ -7,4 +7,7 @@ MxxRu::Cpp::composite_target {
 
 	required_prj( "#{path}/custom_work_thread/prj.ut.rb" )
 	required_prj( "#{path}/custom_work_thread_2/prj.ut.rb" )
+	required_prj( "#{path}/lock_free_queue/prj.ut.rb" )
+	required_prj( "#{path}/same_thread_delivery/prj.ut.rb" )
+	required_prj( "#{path}/wakeup_stats/prj.ut.rb" )
 }
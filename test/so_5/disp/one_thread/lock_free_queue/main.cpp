@@ -0,0 +1,157 @@
+/*
+ * A test for one_thread dispatcher with lock-free demand queue.
+ */
+
+#include <so_5/all.hpp>
+
+#include <test/3rd_party/various_helpers/time_limited_execution.hpp>
+#include <test/3rd_party/various_helpers/ensure.hpp>
+
+#include <array>
+#include <thread>
+#include <vector>
+
+namespace queue_traits = so_5::disp::one_thread::queue_traits;
+
+constexpr int sender_count = 4;
+constexpr int messages_per_sender = 20000;
+constexpr int batch_size = 10;
+
+struct msg_value final : public so_5::message_t
+{
+	int m_sender;
+	int m_value;
+
+	msg_value( int sender, int value )
+		:	m_sender{ sender }
+		,	m_value{ value }
+	{}
+};
+
+struct msg_batch_item
+{
+	int m_sender;
+	int m_value;
+};
+
+struct msg_batch_value final : public so_5::message_t
+{
+	int m_sender;
+	int m_value;
+
+	msg_batch_value( const msg_batch_item & item )
+		:	m_sender{ item.m_sender }
+		,	m_value{ item.m_value }
+	{}
+};
+
+class a_receiver_t final : public so_5::agent_t
+{
+	std::array< int, sender_count > m_last_values;
+	std::array< int, sender_count > m_last_batch_values;
+
+	int m_received{};
+
+public:
+	a_receiver_t( context_t ctx )
+		:	so_5::agent_t{ std::move(ctx) }
+	{
+		m_last_values.fill( -1 );
+		m_last_batch_values.fill( -1 );
+	}
+
+	void
+	so_define_agent() override
+	{
+		so_subscribe_self()
+			.event( [this]( mhood_t< msg_value > cmd ) {
+					check_order( m_last_values, cmd->m_sender, cmd->m_value );
+				} )
+			.event( [this]( mhood_t< msg_batch_value > cmd ) {
+					check_order( m_last_batch_values,
+							cmd->m_sender, cmd->m_value );
+				} );
+	}
+
+private:
+	void
+	check_order(
+		std::array< int, sender_count > & last_values,
+		int sender,
+		int value )
+	{
+		ensure_or_die( last_values[ sender ] + 1 == value,
+				"unexpected value from sender " + std::to_string( sender ) +
+				": " + std::to_string( value ) + ", expected: " +
+				std::to_string( last_values[ sender ] + 1 ) );
+
+		last_values[ sender ] = value;
+
+		if( 2 * sender_count * messages_per_sender == ++m_received )
+			so_deregister_agent_coop_normally();
+	}
+};
+
+void
+run_test(
+	so_5::work_thread_activity_tracking_t tracking,
+	queue_traits::lock_factory_t lock_factory )
+{
+	so_5::launch( [&]( so_5::environment_t & env ) {
+			so_5::mbox_t receiver;
+			env.introduce_coop(
+				so_5::disp::one_thread::make_dispatcher( env,
+						"lock_free",
+						so_5::disp::one_thread::disp_params_t{}
+							.demand_queue_kind(
+									queue_traits::demand_queue_kind_t::lock_free )
+							.work_thread_activity_tracking( tracking )
+							.tune_queue_params(
+								[&]( queue_traits::queue_params_t & p ) {
+									p.lock_factory( lock_factory );
+								} ) ).binder(),
+				[&]( so_5::coop_t & coop ) {
+					receiver = coop.make_agent< a_receiver_t >()->so_direct_mbox();
+				} );
+
+			std::vector< std::thread > senders;
+			for( int s = 0; s != sender_count; ++s )
+				senders.emplace_back( [s, receiver] {
+						for( int i = 0; i != messages_per_sender; ++i )
+							so_5::send< msg_value >( receiver, s, i );
+					} );
+			for( int s = 0; s != sender_count; ++s )
+				senders.emplace_back( [s, receiver] {
+						std::vector< msg_batch_item > items( batch_size );
+						for( int i = 0; i != messages_per_sender; i += batch_size )
+						{
+							for( int j = 0; j != batch_size; ++j )
+								items[ static_cast< std::size_t >(j) ] =
+										msg_batch_item{ s, i + j };
+							so_5::send_batch< msg_batch_value >( receiver, items );
+						}
+					} );
+
+			for( auto & t : senders )
+				t.join();
+		} );
+}
+
+int
+main()
+{
+	run_with_time_limit( [] {
+				run_test( so_5::work_thread_activity_tracking_t::off,
+						queue_traits::combined_lock_factory() );
+				run_test( so_5::work_thread_activity_tracking_t::on,
+						queue_traits::combined_lock_factory() );
+				run_test( so_5::work_thread_activity_tracking_t::off,
+						queue_traits::simple_lock_factory() );
+				run_test( so_5::work_thread_activity_tracking_t::on,
+						queue_traits::simple_lock_factory() );
+			},
+			120 );
+
+	return 0;
+}
+
@@ -0,0 +1,256 @@
+/*
+ * A test for one_thread dispatcher with the same-thread delivery.
+ */
+
+#include <so_5/all.hpp>
+
+#include <test/3rd_party/various_helpers/time_limited_execution.hpp>
+#include <test/3rd_party/various_helpers/ensure.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace queue_traits = so_5::disp::one_thread::queue_traits;
+
+constexpr int iterations = 10000;
+
+// Count of lock acquisitions made by the tracked thread.
+std::atomic< std::size_t > g_lock_count{ 0u };
+std::atomic< std::thread::id > g_tracked_thread{};
+
+//
+// A lock that counts acquisitions.
+//
+class counting_lock_t final : public queue_traits::lock_t
+{
+	std::mutex m_mutex;
+	std::condition_variable m_cv;
+
+public:
+	void
+	lock() noexcept override
+	{
+		m_mutex.lock();
+		if( std::this_thread::get_id() == g_tracked_thread.load() )
+			++g_lock_count;
+	}
+
+	void
+	unlock() noexcept override
+	{
+		m_mutex.unlock();
+	}
+
+protected:
+	void
+	wait_for_notify() noexcept override
+	{
+		std::unique_lock< std::mutex > lock{ m_mutex, std::adopt_lock };
+		m_cv.wait( lock );
+		lock.release();
+	}
+
+	void
+	notify_one() noexcept override
+	{
+		m_cv.notify_one();
+	}
+};
+
+struct msg_external final : public so_5::message_t
+{
+	int m_index;
+
+	explicit msg_external( int index ) : m_index{ index } {}
+};
+
+struct msg_trigger final : public so_5::message_t
+{
+	int m_index;
+
+	explicit msg_trigger( int index ) : m_index{ index } {}
+};
+
+struct msg_internal final : public so_5::message_t
+{
+	int m_index;
+
+	explicit msg_internal( int index ) : m_index{ index } {}
+};
+
+struct msg_check_locks final : public so_5::signal_t {};
+
+struct msg_noise final : public so_5::signal_t {};
+
+//
+// Receives messages from the external sender and from the neighbour.
+//
+class a_receiver_t final : public so_5::agent_t
+{
+	int m_last_external{ -1 };
+	int m_last_internal{ -1 };
+
+public:
+	using so_5::agent_t::agent_t;
+
+	void
+	so_define_agent() override
+	{
+		so_subscribe_self()
+			.event( [this]( mhood_t< msg_external > cmd ) {
+					ensure_or_die( m_last_external + 1 == cmd->m_index,
+							"unexpected external message: " +
+							std::to_string( cmd->m_index ) );
+					m_last_external = cmd->m_index;
+				} )
+			.event( [this]( mhood_t< msg_internal > cmd ) {
+					ensure_or_die( m_last_internal + 1 == cmd->m_index,
+							"unexpected internal message: " +
+							std::to_string( cmd->m_index ) );
+					// The external message was sent before the trigger
+					// for the internal one.
+					ensure_or_die( m_last_external >= cmd->m_index,
+							"internal message is received before the external one: " +
+							std::to_string( cmd->m_index ) );
+					m_last_internal = cmd->m_index;
+
+					if( iterations - 1 == cmd->m_index )
+						so_environment().stop();
+				} );
+	}
+};
+
+//
+// Sends messages to the receiver on the same work thread.
+//
+class a_neighbour_t final : public so_5::agent_t
+{
+	const so_5::mbox_t m_receiver;
+	const bool m_expect_no_locks;
+
+public:
+	a_neighbour_t(
+		context_t ctx,
+		so_5::mbox_t receiver,
+		bool expect_no_locks )
+		:	so_5::agent_t{ std::move(ctx) }
+		,	m_receiver{ std::move(receiver) }
+		,	m_expect_no_locks{ expect_no_locks }
+	{}
+
+	void
+	so_define_agent() override
+	{
+		so_subscribe_self()
+			.event( [this]( mhood_t< msg_trigger > cmd ) {
+					so_5::send< msg_internal >( m_receiver, cmd->m_index );
+				} )
+			.event( [this]( mhood_t< msg_check_locks > ) {
+					g_tracked_thread = std::this_thread::get_id();
+					const auto before = g_lock_count.load();
+
+					for( int i = 0; i != 10; ++i )
+						so_5::send< msg_noise >( *this );
+
+					const auto locks = g_lock_count.load() - before;
+					g_tracked_thread = std::thread::id{};
+
+					if( m_expect_no_locks )
+						ensure_or_die( 0u == locks,
+								"demand queue is locked for the same-thread delivery: " +
+								std::to_string( locks ) );
+					else
+						ensure_or_die( 0u != locks,
+								"demand queue isn't locked without the same-thread "
+								"delivery" );
+				} )
+			.event( []( mhood_t< msg_noise > ) {} );
+	}
+
+	void
+	so_evt_start() override
+	{
+		so_5::send< msg_check_locks >( *this );
+	}
+};
+
+//
+// Sends messages to the receiver and triggers for the neighbour.
+//
+class a_external_t final : public so_5::agent_t
+{
+	const so_5::mbox_t m_receiver;
+	const so_5::mbox_t m_neighbour;
+
+public:
+	a_external_t(
+		context_t ctx,
+		so_5::mbox_t receiver,
+		so_5::mbox_t neighbour )
+		:	so_5::agent_t{ std::move(ctx) }
+		,	m_receiver{ std::move(receiver) }
+		,	m_neighbour{ std::move(neighbour) }
+	{}
+
+	void
+	so_evt_start() override
+	{
+		for( int i = 0; i != iterations; ++i )
+		{
+			so_5::send< msg_external >( m_receiver, i );
+			so_5::send< msg_trigger >( m_neighbour, i );
+		}
+	}
+};
+
+void
+run_test(
+	queue_traits::demand_queue_kind_t queue_kind,
+	bool same_thread_delivery )
+{
+	so_5::launch( [&]( so_5::environment_t & env ) {
+			env.introduce_coop( [&]( so_5::coop_t & coop ) {
+					auto disp = so_5::disp::one_thread::make_dispatcher( env,
+							"std",
+							so_5::disp::one_thread::disp_params_t{}
+								.demand_queue_kind( queue_kind )
+								.same_thread_delivery( same_thread_delivery )
+								.tune_queue_params(
+									[]( queue_traits::queue_params_t & p ) {
+										p.lock_factory( [] {
+												return std::make_unique< counting_lock_t >();
+											} );
+									} ) );
+
+					auto receiver = coop.make_agent_with_binder< a_receiver_t >(
+							disp.binder() )->so_direct_mbox();
+					auto neighbour = coop.make_agent_with_binder< a_neighbour_t >(
+							disp.binder(),
+							receiver,
+							// Pushes to lock-free queue don't acquire the lock.
+							same_thread_delivery ||
+								queue_traits::demand_queue_kind_t::lock_free == queue_kind )
+						->so_direct_mbox();
+
+					coop.make_agent_with_binder< a_external_t >(
+							so_5::disp::one_thread::make_dispatcher( env ).binder(),
+							receiver,
+							neighbour );
+				} );
+		} );
+}
+
+int
+main()
+{
+	run_with_time_limit( [] {
+				run_test( queue_traits::demand_queue_kind_t::lock_based, true );
+				run_test( queue_traits::demand_queue_kind_t::lock_free, true );
+				run_test( queue_traits::demand_queue_kind_t::lock_based, false );
+			},
+			60 );
+
+	return 0;
+}
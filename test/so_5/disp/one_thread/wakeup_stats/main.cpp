@@ -0,0 +1,202 @@
+/*
+ * A test for counters of wakeups of work threads.
+ */
+
+#include <so_5/all.hpp>
+
+#include <test/3rd_party/various_helpers/time_limited_execution.hpp>
+#include <test/3rd_party/various_helpers/ensure.hpp>
+
+#include <cstring>
+#include <future>
+#include <optional>
+
+namespace queue_traits = so_5::disp::one_thread::queue_traits;
+
+constexpr std::size_t messages_count = 1000u;
+
+constexpr const char * disp_name = "wakeup_test";
+
+struct msg_value final : public so_5::message_t
+{
+	std::size_t m_index;
+
+	explicit msg_value( std::size_t index ) : m_index{ index } {}
+};
+
+//
+// Receives messages and blocks on the first one until all of them
+// are sent.
+//
+class a_receiver_t final : public so_5::agent_t
+{
+	const std::shared_future< void > m_all_sent;
+
+	std::size_t m_received{ 0u };
+
+public:
+	a_receiver_t( context_t ctx, std::shared_future< void > all_sent )
+		:	so_5::agent_t{ std::move(ctx) }
+		,	m_all_sent{ std::move(all_sent) }
+	{}
+
+	void
+	so_define_agent() override
+	{
+		so_subscribe_self().event( [this]( mhood_t< msg_value > cmd ) {
+				// All other messages will be sent when the work thread
+				// is running.
+				if( 0u == cmd->m_index )
+					m_all_sent.wait();
+
+				if( messages_count == ++m_received )
+					so_environment().stats_controller().turn_on();
+			} );
+	}
+};
+
+//
+// Sends messages to the receiver.
+//
+class a_sender_t final : public so_5::agent_t
+{
+	const so_5::mbox_t m_receiver;
+	std::promise< void > & m_all_sent;
+
+public:
+	a_sender_t(
+		context_t ctx,
+		so_5::mbox_t receiver,
+		std::promise< void > & all_sent )
+		:	so_5::agent_t{ std::move(ctx) }
+		,	m_receiver{ std::move(receiver) }
+		,	m_all_sent{ all_sent }
+	{}
+
+	void
+	so_evt_start() override
+	{
+		for( std::size_t i = 0u; i != messages_count; ++i )
+			so_5::send< msg_value >( m_receiver, i );
+
+		m_all_sent.set_value();
+	}
+};
+
+//
+// Checks values of wakeup counters.
+//
+class a_listener_t final : public so_5::agent_t
+{
+	// Should every demand be counted?
+	const bool m_count_demands;
+
+	std::optional< std::size_t > m_issued;
+	std::optional< std::size_t > m_avoided;
+
+public:
+	a_listener_t( context_t ctx, bool count_demands )
+		:	so_5::agent_t{ std::move(ctx) }
+		,	m_count_demands{ count_demands }
+	{}
+
+	void
+	so_define_agent() override
+	{
+		so_subscribe( so_environment().stats_controller().mbox() )
+			.event( &a_listener_t::evt_quantity );
+	}
+
+	void
+	so_evt_start() override
+	{
+		so_environment().stats_controller().set_distribution_period(
+				std::chrono::milliseconds( 100 ) );
+	}
+
+private:
+	void
+	evt_quantity(
+		const so_5::stats::messages::quantity< std::size_t > & evt )
+	{
+		namespace suffixes = so_5::stats::suffixes;
+
+		if( !std::strstr( evt.m_prefix.c_str(), disp_name ) )
+			return;
+
+		if( suffixes::wakeups_issued() == evt.m_suffix )
+			m_issued = evt.m_value;
+		else if( suffixes::wakeups_avoided() == evt.m_suffix )
+			m_avoided = evt.m_value;
+
+		if( m_issued && m_avoided )
+		{
+			if( m_count_demands )
+				ensure_or_die( *m_avoided >= messages_count - 1u,
+						"unexpected count of avoided wakeups: " +
+						std::to_string( *m_avoided ) +
+						", issued: " + std::to_string( *m_issued ) );
+
+			so_environment().stop();
+		}
+	}
+};
+
+template< typename Disp_Factory >
+void
+run_test( Disp_Factory && disp_factory, bool count_demands )
+{
+	std::promise< void > all_sent;
+
+	so_5::launch( [&]( so_5::environment_t & env ) {
+			env.introduce_coop( [&]( so_5::coop_t & coop ) {
+					coop.make_agent< a_listener_t >( count_demands );
+
+					auto receiver = coop.make_agent_with_binder< a_receiver_t >(
+							disp_factory( env ),
+							all_sent.get_future().share() );
+
+					coop.make_agent_with_binder< a_sender_t >(
+							so_5::disp::one_thread::make_dispatcher( env ).binder(),
+							receiver->so_direct_mbox(),
+							all_sent );
+				} );
+		} );
+}
+
+int
+main()
+{
+	run_with_time_limit( [] {
+				for( const auto kind : {
+						queue_traits::demand_queue_kind_t::lock_based,
+						queue_traits::demand_queue_kind_t::lock_free } )
+				{
+					run_test( [kind]( so_5::environment_t & env ) {
+							return so_5::disp::one_thread::make_dispatcher( env,
+									disp_name,
+									so_5::disp::one_thread::disp_params_t{}
+										.demand_queue_kind( kind ) ).binder();
+						},
+						true );
+				}
+
+				// Queues of agents are counted instead of demands for
+				// thread pools.
+				run_test( []( so_5::environment_t & env ) {
+						return so_5::disp::thread_pool::make_dispatcher( env,
+								disp_name,
+								1u ).binder();
+					},
+					false );
+				run_test( []( so_5::environment_t & env ) {
+						return so_5::disp::work_stealing_pool::make_dispatcher( env,
+								disp_name,
+								1u ).binder();
+					},
+					false );
+			},
+			60 );
+
+	return 0;
+}
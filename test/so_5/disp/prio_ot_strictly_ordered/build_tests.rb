@@ -11,4 +11,5 @@ MxxRu::Cpp::composite_target {
 	required_prj "#{path}/simple_seq3/prj.ut.rb"
 	required_prj "#{path}/dereg_when_queue_not_empty/prj.ut.rb"
 	required_prj "#{path}/shutdown_on_bad_alloc/prj.ut.rb"
+	required_prj "#{path}/lock_free_seq/prj.ut.rb"
 }
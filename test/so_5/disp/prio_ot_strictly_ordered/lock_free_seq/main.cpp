@@ -0,0 +1,285 @@
+/*
+ * A test of simple sequence of messages for
+ * prio_one_thread::strictly_ordered dispatcher with lock-free demand queue.
+ */
+
+#include <so_5/all.hpp>
+
+#include <test/3rd_party/various_helpers/time_limited_execution.hpp>
+
+#include <array>
+#include <atomic>
+#include <vector>
+
+struct msg_hello : public so_5::signal_t {};
+
+void
+define_receiver_agent(
+	so_5::coop_t & coop,
+	so_5::disp::prio_one_thread::strictly_ordered::dispatcher_handle_t & disp,
+	so_5::priority_t priority,
+	const so_5::mbox_t & common_mbox,
+	std::string & sequence )
+	{
+		class actor_t final : public so_5::agent_t
+			{
+				std::string & m_seq;
+			public:
+				actor_t(
+					context_t ctx,
+					so_5::priority_t priority,
+					const so_5::mbox_t & common_mbox,
+					std::string & seq )
+					:	so_5::agent_t{ ctx + priority }
+					,	m_seq{ seq }
+					{
+						so_subscribe( common_mbox ).event(
+							[this, priority](mhood_t<msg_hello>) {
+								m_seq += std::to_string( so_5::to_size_t( priority ) );
+							} );
+					}
+			};
+
+		coop.make_agent_with_binder< actor_t >(
+				disp.binder(),
+				priority,
+				std::cref(common_mbox),
+				std::ref(sequence) );
+	}
+
+std::string &
+define_main_agent(
+	so_5::coop_t & coop,
+	so_5::disp::prio_one_thread::strictly_ordered::dispatcher_handle_t & disp,
+	const so_5::mbox_t & common_mbox )
+	{
+		class actor_t final : public so_5::agent_t
+			{
+				std::string m_seq;
+			public:
+				actor_t( context_t ctx, const so_5::mbox_t & common_mbox )
+					:	so_5::agent_t{ ctx + so_5::prio::p0 }
+				{
+					so_subscribe( common_mbox ).event(
+						[this]( mhood_t<msg_hello> ) {
+							m_seq += "0";
+							if( "76543210" != m_seq )
+								throw std::runtime_error(
+										"Unexpected value of sequence: " + m_seq );
+							else
+								so_environment().stop();
+						} );
+				}
+
+				std::string & sequence() noexcept { return m_seq; }
+			};
+
+		return coop.make_agent_with_binder< actor_t >(
+				disp.binder(), std::cref(common_mbox) )->sequence();
+	}
+
+void
+define_starter_agent(
+	so_5::coop_t & coop,
+	so_5::disp::prio_one_thread::strictly_ordered::dispatcher_handle_t disp )
+	{
+		using disp_t = so_5::disp::prio_one_thread::strictly_ordered::dispatcher_handle_t;
+
+		class actor_t final : public so_5::agent_t
+			{
+				disp_t m_disp;
+			public :
+				actor_t( context_t ctx, disp_t disp )
+					:	so_5::agent_t{ ctx + so_5::prio::p0 }
+					,	m_disp{ std::move(disp) }
+					{}
+
+				void so_evt_start() override
+					{
+						auto common_mbox = so_environment().create_mbox();
+
+						so_environment().introduce_coop(
+							[&]( so_5::coop_t & child )
+							{
+								using namespace so_5::prio;
+
+								std::string & sequence = define_main_agent(
+										child, m_disp, common_mbox );
+								define_receiver_agent(
+										child, m_disp, p1, common_mbox, sequence );
+								define_receiver_agent(
+										child, m_disp, p2, common_mbox, sequence );
+								define_receiver_agent(
+										child, m_disp, p3, common_mbox, sequence );
+								define_receiver_agent(
+										child, m_disp, p4, common_mbox, sequence );
+								define_receiver_agent(
+										child, m_disp, p5, common_mbox, sequence );
+								define_receiver_agent(
+										child, m_disp, p6, common_mbox, sequence );
+								define_receiver_agent(
+										child, m_disp, p7, common_mbox, sequence );
+							} );
+
+						so_5::send< msg_hello >( common_mbox );
+					}
+			};
+
+		coop.make_agent_with_binder< actor_t >( disp.binder(), disp );
+	}
+
+void
+fill_coop(
+	so_5::coop_t & coop )
+	{
+		using namespace so_5::disp::prio_one_thread::strictly_ordered;
+
+		define_starter_agent( coop,
+				make_dispatcher( coop.environment(),
+						std::string_view{},
+						disp_params_t{}.demand_queue_kind(
+								queue_traits::demand_queue_kind_t::lock_free ) ) );
+	}
+
+// Several producers from different threads send messages to
+// agents with different priorities.
+struct msg_number : public so_5::message_t
+	{
+		std::size_t m_producer;
+		std::size_t m_number;
+
+		msg_number( std::size_t producer, std::size_t number )
+			:	m_producer{ producer }, m_number{ number }
+			{}
+	};
+
+constexpr std::size_t producers_count = 4u;
+constexpr std::size_t numbers_count = 5000u;
+
+void
+run_multi_producer_test()
+	{
+		using namespace so_5::disp::prio_one_thread::strictly_ordered;
+
+		class a_receiver_t final : public so_5::agent_t
+			{
+				std::array< std::size_t, producers_count > m_expected{};
+				std::size_t m_received{ 0u };
+				std::atomic< std::size_t > & m_finished;
+
+			public :
+				a_receiver_t(
+					context_t ctx,
+					so_5::priority_t priority,
+					std::atomic< std::size_t > & finished )
+					:	so_5::agent_t{ ctx + priority }
+					,	m_finished{ finished }
+					{
+						so_subscribe_self().event( [this]( mhood_t< msg_number > cmd ) {
+								auto & expected = m_expected[ cmd->m_producer ];
+								if( expected != cmd->m_number )
+									throw std::runtime_error( "unexpected number: " +
+											std::to_string( cmd->m_number ) + ", expected: " +
+											std::to_string( expected ) );
+								++expected;
+
+								if( producers_count * numbers_count == ++m_received &&
+										4u == ++m_finished )
+									so_environment().stop();
+							} );
+					}
+			};
+
+		class a_producer_t final : public so_5::agent_t
+			{
+				const std::size_t m_id;
+				const std::vector< so_5::mbox_t > m_receivers;
+
+			public :
+				a_producer_t(
+					context_t ctx,
+					std::size_t id,
+					std::vector< so_5::mbox_t > receivers )
+					:	so_5::agent_t{ std::move(ctx) }
+					,	m_id{ id }
+					,	m_receivers{ std::move(receivers) }
+					{}
+
+				void so_evt_start() override
+					{
+						for( std::size_t i = 0u; i != numbers_count; ++i )
+							for( const auto & r : m_receivers )
+								so_5::send< msg_number >( r, m_id, i );
+					}
+			};
+
+		std::atomic< std::size_t > finished{ 0u };
+
+		run_with_time_limit(
+			[&finished]()
+			{
+				so_5::launch(
+					[&finished]( so_5::environment_t & env )
+					{
+						env.introduce_coop( [&finished]( so_5::coop_t & coop ) {
+								using namespace so_5::prio;
+
+								auto disp = make_dispatcher( coop.environment(),
+										std::string_view{},
+										disp_params_t{}.demand_queue_kind(
+												queue_traits::demand_queue_kind_t::lock_free ) );
+
+								std::vector< so_5::mbox_t > receivers;
+								for( const auto p : { p1, p3, p5, p7 } )
+									receivers.push_back(
+											coop.make_agent_with_binder< a_receiver_t >(
+													disp.binder(), p, std::ref(finished) )
+												->so_direct_mbox() );
+
+								auto producers_disp =
+										so_5::disp::active_obj::make_dispatcher(
+												coop.environment() );
+								for( std::size_t i = 0u; i != producers_count; ++i )
+									coop.make_agent_with_binder< a_producer_t >(
+											producers_disp.binder(), i, receivers );
+							} );
+					} );
+			},
+			20,
+			"multi-producer test" );
+	}
+
+int
+main()
+{
+	try
+	{
+		// Do several iterations to increase probability of errors detection.
+		std::cout << "runing iterations" << std::flush;
+		for( int i = 0; i != 100; ++i )
+		{
+			run_with_time_limit(
+				[]()
+				{
+					so_5::launch(
+						[]( so_5::environment_t & env )
+						{
+							env.introduce_coop( fill_coop );
+						} );
+				},
+				20 );
+			std::cout << "." << std::flush;
+		}
+		std::cout << "done" << std::endl;
+
+		run_multi_producer_test();
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
+
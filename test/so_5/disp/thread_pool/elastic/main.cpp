@@ -0,0 +1,26 @@
+/*
+ * A test for the elastic mode of thread_pool dispatcher.
+ */
+
+#include <so_5/all.hpp>
+
+#include "../../elastic_pool_test.hpp"
+
+int
+main()
+{
+	namespace tp_disp = so_5::disp::thread_pool;
+
+	elastic_pool_test::run( "thread_pool",
+		[]( so_5::environment_t & env ) {
+			return tp_disp::make_dispatcher( env,
+					elastic_pool_test::disp_name,
+					tp_disp::disp_params_t{}
+						.thread_count( elastic_pool_test::max_threads )
+						.elastic( elastic_pool_test::make_elastic_params() ) )
+				.binder( tp_disp::bind_params_t{}
+						.fifo( tp_disp::fifo_t::individual ) );
+		} );
+
+	return 0;
+}
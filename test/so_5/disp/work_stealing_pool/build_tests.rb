@@ -0,0 +1,12 @@
+#!/usr/local/bin/ruby
+require 'mxx_ru/cpp'
+
+MxxRu::Cpp::composite_target {
+
+	path = 'test/so_5/disp/work_stealing_pool'
+
+	required_prj( "#{path}/simple/prj.ut.rb" )
+	required_prj( "#{path}/cooperation_fifo/prj.ut.rb" )
+	required_prj( "#{path}/max_demands_at_once/prj.ut.rb" )
+	required_prj( "#{path}/message_order/prj.ut.rb" )
+}
@@ -0,0 +1,11 @@
+require 'mxx_ru/cpp'
+
+MxxRu::Cpp::exe_target {
+
+	required_prj( "so_5/prj.rb" )
+
+	target( "_unit.test.disp.work_stealing_pool.cooperation_fifo" )
+
+	cpp_source( "main.cpp" )
+}
+
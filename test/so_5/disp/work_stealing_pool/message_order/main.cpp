@@ -0,0 +1,189 @@
+/*
+ * A test for work_stealing_pool dispatcher that checks the order of
+ * messages from external threads and from agents of the same dispatcher.
+ */
+
+#include <so_5/all.hpp>
+
+#include <test/3rd_party/various_helpers/time_limited_execution.hpp>
+#include <test/3rd_party/various_helpers/ensure.hpp>
+
+#include "../for_each_lock_factory.hpp"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace wsp_disp = so_5::disp::work_stealing_pool;
+
+constexpr std::size_t worker_count = 16;
+constexpr std::size_t workers_in_coop = 4;
+constexpr std::size_t external_sender_count = 2;
+constexpr int messages_per_sender = 2000;
+
+struct msg_external final : public so_5::message_t
+{
+	std::size_t m_sender;
+	int m_seq;
+
+	msg_external( std::size_t sender, int seq )
+		:	m_sender{ sender }
+		,	m_seq{ seq }
+	{}
+};
+
+struct msg_internal final : public so_5::message_t
+{
+	int m_seq;
+
+	explicit msg_internal( int seq ) : m_seq{ seq } {}
+};
+
+struct msg_done final : public so_5::signal_t {};
+
+class a_supervisor_t final : public so_5::agent_t
+{
+	std::size_t m_done{};
+
+public:
+	using so_5::agent_t::agent_t;
+
+	void
+	so_define_agent() override
+	{
+		so_subscribe_self().event( [this]( mhood_t< msg_done > ) {
+				if( worker_count == ++m_done )
+					so_environment().stop();
+			} );
+	}
+};
+
+class a_worker_t final : public so_5::agent_t
+{
+	const so_5::mbox_t m_self;
+	const so_5::mbox_t m_next;
+	const so_5::mbox_t m_supervisor;
+
+	std::vector< int > m_last_external;
+	int m_last_internal{ -1 };
+	int m_forwarded{};
+
+	int m_received{};
+
+public:
+	a_worker_t(
+		context_t ctx,
+		so_5::mbox_t self,
+		so_5::mbox_t next,
+		so_5::mbox_t supervisor )
+		:	so_5::agent_t{ std::move(ctx) }
+		,	m_self{ std::move(self) }
+		,	m_next{ std::move(next) }
+		,	m_supervisor{ std::move(supervisor) }
+		,	m_last_external( external_sender_count, -1 )
+	{}
+
+	void
+	so_define_agent() override
+	{
+		so_subscribe( m_self )
+			.event( [this]( mhood_t< msg_external > cmd ) {
+					ensure_or_die( m_last_external[ cmd->m_sender ] + 1 == cmd->m_seq,
+							"unexpected external seq: " + std::to_string( cmd->m_seq ) +
+							", expected: " +
+							std::to_string( m_last_external[ cmd->m_sender ] + 1 ) );
+					m_last_external[ cmd->m_sender ] = cmd->m_seq;
+
+					so_5::send< msg_internal >( m_next, m_forwarded++ );
+
+					count_received();
+				} )
+			.event( [this]( mhood_t< msg_internal > cmd ) {
+					ensure_or_die( m_last_internal + 1 == cmd->m_seq,
+							"unexpected internal seq: " + std::to_string( cmd->m_seq ) +
+							", expected: " + std::to_string( m_last_internal + 1 ) );
+					m_last_internal = cmd->m_seq;
+
+					count_received();
+				} );
+	}
+
+private:
+	void
+	count_received()
+	{
+		constexpr int expected =
+				2 * static_cast< int >( external_sender_count ) * messages_per_sender;
+
+		if( expected == ++m_received )
+			so_5::send< msg_done >( m_supervisor );
+	}
+};
+
+void
+run_test(
+	wsp_disp::queue_traits::lock_factory_t factory,
+	wsp_disp::bind_params_t bind_params )
+{
+	so_5::launch( [&]( so_5::environment_t & env ) {
+			auto disp = wsp_disp::make_dispatcher( env,
+					std::string_view{},
+					wsp_disp::disp_params_t{}
+						.thread_count( 4 )
+						.set_queue_params( wsp_disp::queue_traits::queue_params_t{}
+								.lock_factory( factory ) ) );
+
+			so_5::mbox_t supervisor;
+			env.introduce_coop( [&]( so_5::coop_t & coop ) {
+					supervisor = coop.make_agent< a_supervisor_t >()->so_direct_mbox();
+				} );
+
+			std::vector< so_5::mbox_t > mboxes;
+			for( std::size_t i = 0; i != worker_count; ++i )
+				mboxes.push_back( env.create_mbox() );
+
+			for( std::size_t c = 0; c != worker_count / workers_in_coop; ++c )
+				env.introduce_coop( disp.binder( bind_params ),
+					[&]( so_5::coop_t & coop ) {
+						for( std::size_t i = 0; i != workers_in_coop; ++i )
+						{
+							const auto index = c * workers_in_coop + i;
+							coop.make_agent< a_worker_t >(
+									mboxes[ index ],
+									mboxes[ (index + 1) % worker_count ],
+									supervisor );
+						}
+					} );
+
+			std::vector< std::thread > senders;
+			for( std::size_t s = 0; s != external_sender_count; ++s )
+				senders.emplace_back( [s, &mboxes] {
+						for( int i = 0; i != messages_per_sender; ++i )
+							for( auto & m : mboxes )
+								so_5::send< msg_external >( m, s, i );
+					} );
+
+			for( auto & t : senders )
+				t.join();
+		} );
+}
+
+int
+main()
+{
+	for_each_lock_factory( []( wsp_disp::queue_traits::lock_factory_t factory ) {
+		run_with_time_limit( [&] {
+				run_test( factory, wsp_disp::bind_params_t{}
+						.fifo( wsp_disp::fifo_t::individual ) );
+				run_test( factory, wsp_disp::bind_params_t{}
+						.fifo( wsp_disp::fifo_t::individual )
+						.max_demands_at_once( 1 ) );
+				run_test( factory, wsp_disp::bind_params_t{}
+						.fifo( wsp_disp::fifo_t::cooperation ) );
+			},
+			120,
+			"message_order test" );
+	} );
+
+	return 0;
+}
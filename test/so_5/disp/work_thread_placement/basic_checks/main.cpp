@@ -0,0 +1,294 @@
+/*
+ * Basic checks for placement of worker threads.
+ */
+
+#include <so_5/all.hpp>
+
+#include <so_5/detect_os.hpp>
+
+#include <test/3rd_party/various_helpers/time_limited_execution.hpp>
+#include <test/3rd_party/various_helpers/ensure.hpp>
+
+#if defined(SO_5_OS_LINUX)
+	#include <pthread.h>
+	#include <sched.h>
+#endif
+
+#include <atomic>
+#include <functional>
+#include <iostream>
+#include <string>
+
+struct probe_result_t
+{
+	bool m_handled{ false };
+	std::string m_thread_name;
+	int m_cpu_count{ -1 };
+	bool m_cpu0_allowed{ false };
+};
+
+void
+collect_current_thread_info( probe_result_t & result )
+{
+	result.m_handled = true;
+
+#if defined(SO_5_OS_LINUX)
+	char name[ 32 ] = {};
+	if( 0 == pthread_getname_np( pthread_self(), name, sizeof(name) ) )
+		result.m_thread_name = name;
+
+	cpu_set_t cpu_set;
+	CPU_ZERO( &cpu_set );
+	if( 0 == pthread_getaffinity_np( pthread_self(), sizeof(cpu_set), &cpu_set ) )
+	{
+		result.m_cpu_count = CPU_COUNT( &cpu_set );
+		result.m_cpu0_allowed = CPU_ISSET( 0, &cpu_set );
+	}
+#endif
+}
+
+class a_probe_t final : public so_5::agent_t
+{
+	probe_result_t & m_result;
+
+public:
+	a_probe_t( context_t ctx, probe_result_t & result )
+		:	so_5::agent_t{ std::move(ctx) }
+		,	m_result{ result }
+	{}
+
+	void
+	so_evt_start() override
+	{
+		collect_current_thread_info( m_result );
+		so_environment().stop();
+	}
+};
+
+class counting_factory_t final : public so_5::disp::abstract_work_thread_factory_t
+{
+	so_5::disp::abstract_work_thread_factory_shptr_t m_actual{
+			so_5::disp::make_std_work_thread_factory() };
+
+public:
+	std::atomic< int > m_acquired{ 0 };
+
+	so_5::disp::abstract_work_thread_t &
+	acquire( so_5::environment_t & env ) override
+	{
+		++m_acquired;
+		return m_actual->acquire( env );
+	}
+
+	void
+	release( so_5::disp::abstract_work_thread_t & thread ) noexcept override
+	{
+		m_actual->release( thread );
+	}
+};
+
+using binder_maker_t = std::function<
+		so_5::disp_binder_shptr_t(
+				so_5::environment_t &,
+				so_5::disp::work_thread_placement_t ) >;
+
+probe_result_t
+run_probe(
+	const binder_maker_t & binder_maker,
+	so_5::disp::work_thread_placement_t placement )
+{
+	probe_result_t result;
+
+	run_with_time_limit( [&] {
+			so_5::launch( [&]( so_5::environment_t & env ) {
+					env.introduce_coop(
+							binder_maker( env, placement ),
+							[&]( so_5::coop_t & coop ) {
+								coop.make_agent< a_probe_t >( std::ref(result) );
+							} );
+				} );
+		},
+		20 );
+
+	ensure( result.m_handled, "probe agent hasn't been started" );
+
+	return result;
+}
+
+void
+check_cpu_set_and_name(
+	const std::string & case_name,
+	const binder_maker_t & binder_maker )
+{
+	std::cout << case_name << "..." << std::flush;
+
+	const auto result = run_probe(
+			binder_maker,
+			so_5::disp::work_thread_placement_t::cpus( { 0u } )
+				.thread_name( "wtp" ) );
+
+#if defined(SO_5_OS_LINUX)
+	ensure( 0 == result.m_thread_name.rfind( "wtp-", 0 ),
+			case_name + ": unexpected thread name: " + result.m_thread_name );
+	ensure( 1 == result.m_cpu_count && result.m_cpu0_allowed,
+			case_name + ": unexpected affinity, cpu count: " +
+			std::to_string( result.m_cpu_count ) );
+#endif
+
+	std::cout << "OK" << std::endl;
+}
+
+void
+check_numa_placements()
+{
+	std::cout << "numa placements..." << std::flush;
+
+	const binder_maker_t maker = []( so_5::environment_t & env, auto placement ) {
+			return so_5::disp::thread_pool::make_dispatcher( env, "numa",
+					so_5::disp::thread_pool::disp_params_t{}
+						.thread_count( 2 )
+						.work_thread_placement( std::move(placement) ) ).binder();
+		};
+
+	for( auto placement : {
+			so_5::disp::work_thread_placement_t::spread_across_numa_nodes(),
+			so_5::disp::work_thread_placement_t::compact_on_numa_node( 0u ) } )
+	{
+		const auto result = run_probe( maker, placement );
+#if defined(SO_5_OS_LINUX)
+		ensure( 0 < result.m_cpu_count, "at least one CPU is expected" );
+#endif
+	}
+
+	// Placement for a node that doesn't exist has to be ignored.
+	const auto result = run_probe( maker,
+			so_5::disp::work_thread_placement_t::compact_on_numa_node( 100500u ) );
+#if defined(SO_5_OS_LINUX)
+	ensure( 0 < result.m_cpu_count, "at least one CPU is expected" );
+#endif
+
+	std::cout << "OK" << std::endl;
+}
+
+void
+check_custom_factory()
+{
+	std::cout << "custom factory..." << std::flush;
+
+	auto factory = std::make_shared< counting_factory_t >();
+
+	const auto result = run_probe(
+			[factory]( so_5::environment_t & env, auto placement ) {
+				return so_5::disp::active_obj::make_dispatcher( env, "factory",
+						so_5::disp::active_obj::disp_params_t{}
+							.work_thread_factory( factory )
+							.work_thread_placement( std::move(placement) ) ).binder();
+			},
+			so_5::disp::work_thread_placement_t{}.thread_name( "custom" ) );
+
+	ensure( 1 == factory->m_acquired, "custom factory has to be used" );
+#if defined(SO_5_OS_LINUX)
+	ensure( "custom-0" == result.m_thread_name,
+			"unexpected thread name: " + result.m_thread_name );
+#else
+	(void)result;
+#endif
+
+	std::cout << "OK" << std::endl;
+}
+
+int
+main()
+{
+	using namespace so_5::disp;
+
+	check_cpu_set_and_name( "one_thread",
+		[]( so_5::environment_t & env, work_thread_placement_t placement ) {
+			return one_thread::make_dispatcher( env, "one_thread",
+					one_thread::disp_params_t{}
+						.work_thread_placement( std::move(placement) ) ).binder();
+		} );
+
+	check_cpu_set_and_name( "nef_one_thread",
+		[]( so_5::environment_t & env, work_thread_placement_t placement ) {
+			return nef_one_thread::make_dispatcher( env, "nef_one_thread",
+					nef_one_thread::disp_params_t{}
+						.work_thread_placement( std::move(placement) ) ).binder();
+		} );
+
+	check_cpu_set_and_name( "active_obj",
+		[]( so_5::environment_t & env, work_thread_placement_t placement ) {
+			return active_obj::make_dispatcher( env, "active_obj",
+					active_obj::disp_params_t{}
+						.work_thread_placement( std::move(placement) ) ).binder();
+		} );
+
+	check_cpu_set_and_name( "active_group",
+		[]( so_5::environment_t & env, work_thread_placement_t placement ) {
+			return active_group::make_dispatcher( env, "active_group",
+					active_group::disp_params_t{}
+						.work_thread_placement( std::move(placement) ) )
+				.binder( "group" );
+		} );
+
+	check_cpu_set_and_name( "thread_pool",
+		[]( so_5::environment_t & env, work_thread_placement_t placement ) {
+			return thread_pool::make_dispatcher( env, "thread_pool",
+					thread_pool::disp_params_t{}
+						.thread_count( 2 )
+						.work_thread_placement( std::move(placement) ) ).binder();
+		} );
+
+	check_cpu_set_and_name( "adv_thread_pool",
+		[]( so_5::environment_t & env, work_thread_placement_t placement ) {
+			return adv_thread_pool::make_dispatcher( env, "adv_thread_pool",
+					adv_thread_pool::disp_params_t{}
+						.thread_count( 2 )
+						.work_thread_placement( std::move(placement) ) ).binder();
+		} );
+
+	check_cpu_set_and_name( "nef_thread_pool",
+		[]( so_5::environment_t & env, work_thread_placement_t placement ) {
+			return nef_thread_pool::make_dispatcher( env, "nef_thread_pool",
+					nef_thread_pool::disp_params_t{}
+						.thread_count( 2 )
+						.work_thread_placement( std::move(placement) ) ).binder();
+		} );
+
+	check_cpu_set_and_name( "work_stealing_pool",
+		[]( so_5::environment_t & env, work_thread_placement_t placement ) {
+			return work_stealing_pool::make_dispatcher( env, "work_stealing_pool",
+					work_stealing_pool::disp_params_t{}
+						.thread_count( 2 )
+						.work_thread_placement( std::move(placement) ) ).binder();
+		} );
+
+	check_cpu_set_and_name( "prio_one_thread::strictly_ordered",
+		[]( so_5::environment_t & env, work_thread_placement_t placement ) {
+			return prio_one_thread::strictly_ordered::make_dispatcher( env, "so",
+					prio_one_thread::strictly_ordered::disp_params_t{}
+						.work_thread_placement( std::move(placement) ) ).binder();
+		} );
+
+	check_cpu_set_and_name( "prio_one_thread::quoted_round_robin",
+		[]( so_5::environment_t & env, work_thread_placement_t placement ) {
+			return prio_one_thread::quoted_round_robin::make_dispatcher( env,
+					"qrr",
+					prio_one_thread::quoted_round_robin::quotes_t{ 10 },
+					prio_one_thread::quoted_round_robin::disp_params_t{}
+						.work_thread_placement( std::move(placement) ) ).binder();
+		} );
+
+	check_cpu_set_and_name( "prio_dedicated_threads::one_per_prio",
+		[]( so_5::environment_t & env, work_thread_placement_t placement ) {
+			return prio_dedicated_threads::one_per_prio::make_dispatcher( env, "opp",
+					prio_dedicated_threads::one_per_prio::disp_params_t{}
+						.work_thread_placement( std::move(placement) ) ).binder();
+		} );
+
+	check_numa_placements();
+
+	check_custom_factory();
+
+	return 0;
+}
@@ -0,0 +1,9 @@
+#!/usr/local/bin/ruby
+require 'mxx_ru/cpp'
+
+MxxRu::Cpp::composite_target {
+
+	path = 'test/so_5/disp/work_thread_placement'
+
+	required_prj( "#{path}/basic_checks/prj.ut.rb" )
+}
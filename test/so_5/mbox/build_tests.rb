@@ -21,5 +21,7 @@ MxxRu::Cpp::composite_target {
 	required_prj( "#{path}/custom_direct_mbox_factory/prj.ut.rb" )
 	required_prj( "#{path}/sink_binding/build_tests.rb" )
 	required_prj( "#{path}/unique_subscribers/build_tests.rb" )
+	required_prj( "#{path}/snapshot_mbox/prj.ut.rb" )
 	required_prj( "#{path}/introduce_named_mbox/build_tests.rb" )
+	required_prj( "#{path}/named_mbox_handle/prj.ut.rb" )
 }
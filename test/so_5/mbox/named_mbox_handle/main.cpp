@@ -0,0 +1,118 @@
+/*
+ * A test for so_5::named_mbox_handle_t and parallel work with named mboxes.
+ */
+
+#include <so_5/all.hpp>
+
+#include <test/3rd_party/various_helpers/time_limited_execution.hpp>
+#include <test/3rd_party/various_helpers/ensure.hpp>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+void
+check_resolve( so_5::environment_t & env )
+{
+	so_5::named_mbox_handle_t handle{ "alpha" };
+	ensure( !handle.is_resolved(), "handle must not be resolved yet" );
+	ensure( "alpha" == handle.name(), "unexpected name" );
+
+	const so_5::mbox_t & first = handle.resolve( env );
+	ensure( handle.is_resolved(), "handle must be resolved" );
+	ensure( "alpha" == first->query_name(), "unexpected mbox name" );
+
+	const so_5::mbox_t & second = handle.resolve( env );
+	ensure( first.get() == second.get(), "the cached mbox is expected" );
+
+	auto by_name = env.create_mbox( "alpha" );
+	ensure( first->id() == by_name->id(), "the same mbox is expected" );
+
+	so_5::named_mbox_handle_t another{ std::string{ "alpha" } };
+	ensure( handle.hash() == another.hash(), "the same hash is expected" );
+	ensure( another.resolve( env )->id() == by_name->id(),
+			"the same mbox is expected for another handle" );
+
+	auto in_namespace = env.introduce_named_mbox(
+			so_5::mbox_namespace_name_t{ "demo" },
+			"alpha",
+			[&env]() { return env.create_mbox(); } );
+	ensure( in_namespace->id() != by_name->id(),
+			"mbox from another namespace is expected" );
+
+	handle.reset();
+	ensure( !handle.is_resolved(), "handle must not be resolved after reset" );
+}
+
+void
+check_destruction( so_5::environment_t & env )
+{
+	so_5::mbox_id_t old_id;
+	{
+		so_5::named_mbox_handle_t handle{ "beta" };
+		old_id = handle.resolve( env )->id();
+	}
+
+	// The handle held the last reference, so a new mbox is expected.
+	so_5::named_mbox_handle_t handle{ "beta" };
+	ensure( old_id != handle.resolve( env )->id(),
+			"a new mbox is expected after the destruction of the old one" );
+}
+
+void
+check_parallel_access( so_5::environment_t & env )
+{
+	constexpr std::size_t thread_count = 4u;
+	constexpr std::size_t name_count = 2000u;
+
+	std::vector< std::vector< so_5::mbox_t > > results( thread_count );
+
+	std::vector< std::thread > threads;
+	for( std::size_t t = 0u; t != thread_count; ++t )
+		threads.emplace_back( [&env, &results, t] {
+				auto & r = results[ t ];
+				r.reserve( name_count );
+				// Every thread goes through names in its own order.
+				for( std::size_t i = 0u; i != name_count; ++i )
+				{
+					const auto n = ( i * ( 2u * t + 1u ) ) % name_count;
+					so_5::named_mbox_handle_t handle{
+							"parallel-" + std::to_string( n ) };
+					r.push_back( handle.resolve( env ) );
+				}
+			} );
+
+	for( auto & th : threads )
+		th.join();
+
+	std::vector< so_5::mbox_id_t > expected_ids( name_count );
+	for( std::size_t i = 0u; i != name_count; ++i )
+		expected_ids[ i ] = results[ 0 ][ i ]->id();
+
+	for( std::size_t t = 1u; t != thread_count; ++t )
+		for( std::size_t i = 0u; i != name_count; ++i )
+		{
+			const auto n = ( i * ( 2u * t + 1u ) ) % name_count;
+			ensure( expected_ids[ n ] == results[ t ][ i ]->id(),
+					"the same mbox is expected for the name parallel-" +
+					std::to_string( n ) );
+		}
+}
+
+int
+main()
+{
+	run_with_time_limit( [] {
+				so_5::launch( []( so_5::environment_t & env ) {
+						check_resolve( env );
+						check_destruction( env );
+						check_parallel_access( env );
+
+						env.stop();
+					} );
+			},
+			20 );
+
+	return 0;
+}
+
@@ -0,0 +1,231 @@
+/*
+ * A test for MPMC mbox with snapshot table of subscribers.
+ */
+
+#include <so_5/all.hpp>
+
+#include <test/3rd_party/various_helpers/time_limited_execution.hpp>
+#include <test/3rd_party/various_helpers/ensure.hpp>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+struct msg_value final : public so_5::message_t
+{
+	int m_value;
+
+	explicit msg_value( int value ) : m_value{ value } {}
+};
+
+struct finish final : public so_5::signal_t {};
+
+constexpr int messages_to_send = 1000;
+
+class receiver_t final : public so_5::agent_t
+{
+	const so_5::mbox_t m_mbox;
+	const bool m_only_even;
+
+	int m_received{};
+
+public:
+	receiver_t( context_t ctx, so_5::mbox_t mbox, bool only_even )
+		:	so_5::agent_t{ std::move(ctx) }
+		,	m_mbox{ std::move(mbox) }
+		,	m_only_even{ only_even }
+	{}
+
+	void
+	so_define_agent() override
+	{
+		if( m_only_even )
+			so_set_delivery_filter( m_mbox, []( const msg_value & msg ) {
+					return 0 == msg.m_value % 2;
+				} );
+
+		so_subscribe( m_mbox )
+			.event( [this]( mhood_t<msg_value> ) {
+					++m_received;
+				} )
+			.event( [this]( mhood_t<finish> ) {
+					const int expected = m_only_even ?
+							messages_to_send / 2 : messages_to_send;
+					ensure( expected == m_received,
+							"unexpected count of received messages: " +
+							std::to_string( m_received ) );
+
+					so_deregister_agent_coop_normally();
+				} );
+	}
+};
+
+void
+run_simple_test()
+{
+	so_5::launch( []( so_5::environment_t & env ) {
+			auto mbox = so_5::make_snapshot_mbox( env );
+
+			ensure( so_5::mbox_type_t::multi_producer_multi_consumer ==
+					mbox->type(), "MPMC mbox is expected" );
+
+			env.introduce_coop( [&]( so_5::coop_t & coop ) {
+					coop.make_agent< receiver_t >( mbox, false );
+					coop.make_agent< receiver_t >( mbox, true );
+					coop.make_agent< receiver_t >( mbox, false );
+				} );
+
+			for( int i = 0; i != messages_to_send; ++i )
+				so_5::send< msg_value >( mbox, i );
+			so_5::send< finish >( mbox );
+
+			bool exception_thrown = false;
+			try
+			{
+				so_5::send< so_5::mutable_msg< msg_value > >( mbox, 0 );
+			}
+			catch( const so_5::exception_t & x )
+			{
+				exception_thrown = true;
+				ensure( so_5::rc_mutable_msg_cannot_be_delivered_via_mpmc_mbox ==
+						x.error_code(), "unexpected error code" );
+			}
+			ensure( exception_thrown, "mutable message must be rejected" );
+		} );
+}
+
+struct msg_dereg_child final : public so_5::signal_t {};
+
+class child_t final : public so_5::agent_t
+{
+	const so_5::mbox_t m_mbox;
+	const bool m_use_filter;
+
+public:
+	child_t( context_t ctx, so_5::mbox_t mbox, bool use_filter )
+		:	so_5::agent_t{ std::move(ctx) }
+		,	m_mbox{ std::move(mbox) }
+		,	m_use_filter{ use_filter }
+	{}
+
+	void
+	so_define_agent() override
+	{
+		if( m_use_filter )
+			so_set_delivery_filter( m_mbox, []( const msg_value & msg ) {
+					return 0 == msg.m_value % 3;
+				} );
+
+		so_subscribe( m_mbox ).event( []( mhood_t<msg_value> ) {} );
+	}
+};
+
+// Agents are subscribed and destroyed while messages are being
+// sent from several threads.
+class manager_t final : public so_5::agent_t
+{
+	const so_5::mbox_t m_mbox;
+
+	int m_iterations_left{ 30 };
+
+	so_5::coop_handle_t m_child;
+
+	std::atomic< bool > m_stop{ false };
+	std::vector< std::thread > m_senders;
+
+public:
+	manager_t( context_t ctx )
+		:	so_5::agent_t{ std::move(ctx) }
+		,	m_mbox{ so_5::make_snapshot_mbox( so_environment() ) }
+	{}
+
+	~manager_t() override
+	{
+		stop_senders();
+	}
+
+	void
+	so_define_agent() override
+	{
+		so_subscribe_self().event( &manager_t::evt_dereg_child );
+	}
+
+	void
+	so_evt_start() override
+	{
+		for( int i = 0; i != 4; ++i )
+			m_senders.emplace_back( [this] {
+					int value = 0;
+					while( !m_stop.load( std::memory_order_acquire ) )
+						so_5::send< msg_value >( m_mbox, ++value );
+				} );
+
+		next_iteration();
+	}
+
+private:
+	void
+	evt_dereg_child( mhood_t< msg_dereg_child > )
+	{
+		so_environment().deregister_coop(
+				m_child, so_5::dereg_reason::normal );
+
+		next_iteration();
+	}
+
+	void
+	next_iteration()
+	{
+		if( !m_iterations_left )
+		{
+			stop_senders();
+			so_deregister_agent_coop_normally();
+			return;
+		}
+
+		--m_iterations_left;
+
+		auto coop = so_5::create_child_coop( *this,
+				so_5::disp::active_obj::make_dispatcher(
+						so_environment() ).binder() );
+		for( int i = 0; i != 8; ++i )
+			coop->make_agent< child_t >( m_mbox, 0 == i % 2 );
+
+		m_child = so_environment().register_coop( std::move(coop) );
+
+		so_5::send_delayed< msg_dereg_child >(
+				*this, std::chrono::milliseconds( 5 ) );
+	}
+
+	void
+	stop_senders()
+	{
+		m_stop.store( true, std::memory_order_release );
+		for( auto & t : m_senders )
+			t.join();
+		m_senders.clear();
+	}
+};
+
+void
+run_stress_test()
+{
+	so_5::launch( []( so_5::environment_t & env ) {
+			env.introduce_coop( []( so_5::coop_t & coop ) {
+					coop.make_agent< manager_t >();
+				} );
+		} );
+}
+
+int
+main()
+{
+	run_with_time_limit( [] {
+				run_simple_test();
+				run_stress_test();
+			},
+			60 );
+
+	return 0;
+}
+
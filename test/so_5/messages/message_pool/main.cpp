@@ -0,0 +1,152 @@
+/*
+ * A test for pooled allocation of message instances.
+ */
+
+#include <so_5/all.hpp>
+
+#include <test/3rd_party/various_helpers/time_limited_execution.hpp>
+#include <test/3rd_party/various_helpers/ensure.hpp>
+
+#include <cstdint>
+
+struct small_msg final : public so_5::message_t
+{
+	int m_value;
+
+	explicit small_msg( int value ) : m_value{ value } {}
+};
+
+struct big_msg final : public so_5::message_t
+{
+	char m_data[ 1024 ];
+	int m_value;
+
+	explicit big_msg( int value ) : m_value{ value } {}
+};
+
+struct alignas(64) aligned_msg final : public so_5::message_t
+{
+	int m_value;
+
+	explicit aligned_msg( int value ) : m_value{ value } {}
+};
+
+struct user_msg
+{
+	std::string m_text;
+	int m_value;
+};
+
+struct finish final : public so_5::signal_t {};
+
+constexpr int messages_to_send = 10000;
+
+class receiver_t final : public so_5::agent_t
+{
+	int m_expected_small{};
+	int m_expected_big{};
+	int m_expected_aligned{};
+	int m_expected_user{};
+
+public:
+	using so_5::agent_t::agent_t;
+
+	void
+	so_define_agent() override
+	{
+		so_subscribe_self()
+			.event( [this]( mhood_t<small_msg> cmd ) {
+					ensure( m_expected_small == cmd->m_value,
+							"unexpected small_msg value" );
+					++m_expected_small;
+				} )
+			.event( [this]( mhood_t<big_msg> cmd ) {
+					ensure( m_expected_big == cmd->m_value,
+							"unexpected big_msg value" );
+					++m_expected_big;
+				} )
+			.event( [this]( mhood_t<aligned_msg> cmd ) {
+					ensure( 0u == reinterpret_cast<std::uintptr_t>(cmd.get()) % 64u,
+							"aligned_msg must be aligned to 64 bytes" );
+					ensure( m_expected_aligned == cmd->m_value,
+							"unexpected aligned_msg value" );
+					++m_expected_aligned;
+				} )
+			.event( [this]( mhood_t<user_msg> cmd ) {
+					ensure( m_expected_user == cmd->m_value,
+							"unexpected user_msg value" );
+					ensure( std::to_string( cmd->m_value ) == cmd->m_text,
+							"unexpected user_msg text" );
+					++m_expected_user;
+				} )
+			.event( [this]( mhood_t<finish> ) {
+					ensure( messages_to_send == m_expected_small,
+							"not all small_msg received" );
+					ensure( messages_to_send == m_expected_big,
+							"not all big_msg received" );
+					ensure( messages_to_send == m_expected_aligned,
+							"not all aligned_msg received" );
+					ensure( messages_to_send == m_expected_user,
+							"not all user_msg received" );
+
+					so_deregister_agent_coop_normally();
+				} );
+	}
+};
+
+class sender_t final : public so_5::agent_t
+{
+	const so_5::mbox_t m_receiver;
+
+public:
+	sender_t( context_t ctx, so_5::mbox_t receiver )
+		:	so_5::agent_t{ std::move(ctx) }
+		,	m_receiver{ std::move(receiver) }
+	{}
+
+	void
+	so_evt_start() override
+	{
+		for( int i = 0; i != messages_to_send; ++i )
+		{
+			so_5::send< small_msg >( m_receiver, i );
+			so_5::send< big_msg >( m_receiver, i );
+			so_5::send< aligned_msg >( m_receiver, i );
+			so_5::send< user_msg >( m_receiver, std::to_string( i ), i );
+		}
+		so_5::send< finish >( m_receiver );
+	}
+};
+
+int
+main()
+{
+	run_with_time_limit( [] {
+				so_5::launch( []( so_5::environment_t & env ) {
+						env.introduce_coop(
+								so_5::disp::active_obj::make_dispatcher( env ).binder(),
+								[]( so_5::coop_t & coop ) {
+									auto receiver = coop.make_agent< receiver_t >()
+											->so_direct_mbox();
+
+									coop.make_agent< sender_t >( receiver );
+								} );
+					},
+					[]( so_5::environment_params_t & params ) {
+						params.message_pool( so_5::message_pool_params_t{}
+								.thread_cache_capacity( 16u )
+								.blocks_per_slab( 8u ) );
+					} );
+
+				const auto stats = so_5::query_message_pool_stats();
+				ensure( stats.m_enabled, "message pool must be enabled" );
+				ensure( 0u != stats.m_slabs_allocated,
+						"some slabs must be allocated" );
+				ensure( 0u != stats.m_central_returns,
+						"some blocks must be returned to the central lists" );
+			},
+			20 );
+
+	return 0;
+}
+
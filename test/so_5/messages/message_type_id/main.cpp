@@ -0,0 +1,90 @@
+/*
+ * A test for dense message type IDs.
+ */
+
+#include <so_5/all.hpp>
+
+#include <test/3rd_party/various_helpers/time_limited_execution.hpp>
+#include <test/3rd_party/various_helpers/ensure.hpp>
+
+#include <set>
+#include <thread>
+#include <utility>
+#include <vector>
+
+template< int N >
+struct msg final : public so_5::message_t {};
+
+template< int... N >
+std::vector< so_5::message_type_id_t >
+ids_for( std::integer_sequence< int, N... > )
+{
+	return { so_5::message_type_id_for( typeid(msg<N>) )... };
+}
+
+void
+check_basic_properties()
+{
+	ensure( so_5::message_type_id_t{} ==
+			so_5::message_type_id_for( typeid(void) ),
+			"default ID must be the ID of void" );
+
+	const auto id1 = so_5::message_type_id_for( typeid(msg<1>) );
+	const auto id2 = so_5::message_type_id_for( typeid(msg<2>) );
+	ensure( id1 != id2, "different types must have different IDs" );
+	ensure( id1 == so_5::message_type_id_for( typeid(msg<1>) ),
+			"the same type must have the same ID" );
+	ensure( id1 == so_5::message_type_id_for< msg<1> >(),
+			"template version must return the same ID" );
+
+	ensure( std::type_index{ typeid(msg<2>) } ==
+			so_5::message_type_index_for( id2 ),
+			"type must be found by ID" );
+	ensure( std::type_index{ typeid(void) } ==
+			so_5::message_type_index_for(
+					so_5::message_type_id_t{ 0xFFFFFFFFu } ),
+			"void is expected for unknown ID" );
+}
+
+void
+check_parallel_registration()
+{
+	constexpr std::size_t threads_count = 4u;
+	using seq_t = std::make_integer_sequence< int, 256 >;
+
+	std::vector< std::vector< so_5::message_type_id_t > > results(
+			threads_count );
+	std::vector< std::thread > threads;
+	for( std::size_t i = 0u; i != threads_count; ++i )
+		threads.emplace_back( [&results, i] {
+				results[ i ] = ids_for( seq_t{} );
+			} );
+	for( auto & t : threads )
+		t.join();
+
+	for( std::size_t i = 1u; i != threads_count; ++i )
+		ensure( results[ 0 ] == results[ i ],
+				"all threads must get the same IDs" );
+
+	std::set< std::uint32_t > unique_ids;
+	for( const auto id : results[ 0 ] )
+		unique_ids.insert( id.value() );
+	ensure( results[ 0 ].size() == unique_ids.size(),
+			"all IDs must be unique" );
+
+	// IDs are dense, so they can't be greater than the count of
+	// registered types.
+	ensure( *unique_ids.rbegin() < 1024u, "IDs must be dense" );
+}
+
+int
+main()
+{
+	run_with_time_limit( [] {
+				check_basic_properties();
+				check_parallel_registration();
+			},
+			20 );
+
+	return 0;
+}
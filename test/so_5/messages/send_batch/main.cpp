@@ -0,0 +1,236 @@
+/*
+ * A test for so_5::send_batch.
+ */
+
+#include <so_5/all.hpp>
+
+#include <test/3rd_party/various_helpers/time_limited_execution.hpp>
+#include <test/3rd_party/various_helpers/ensure.hpp>
+
+#include <functional>
+#include <list>
+#include <vector>
+
+struct classic_msg final : public so_5::message_t
+{
+	int m_value;
+
+	explicit classic_msg( int value ) : m_value{ value } {}
+};
+
+struct user_msg
+{
+	int m_value;
+};
+
+struct finish final : public so_5::signal_t {};
+
+constexpr int messages_to_send = 1000;
+
+class receiver_t final : public so_5::agent_t
+{
+	const so_5::mbox_t m_mpmc_mbox;
+
+	int m_expected_direct{};
+	int m_expected_mpmc{};
+	int m_expected_filtered{};
+
+public:
+	receiver_t( context_t ctx, so_5::mbox_t mpmc_mbox )
+		:	so_5::agent_t{ std::move(ctx) }
+		,	m_mpmc_mbox{ std::move(mpmc_mbox) }
+	{}
+
+	void
+	so_define_agent() override
+	{
+		so_subscribe_self()
+			.event( [this]( mhood_t<classic_msg> cmd ) {
+					ensure( m_expected_direct == cmd->m_value,
+							"unexpected classic_msg value" );
+					++m_expected_direct;
+				} )
+			.event( [this]( mhood_t<finish> ) {
+					ensure( messages_to_send == m_expected_direct,
+							"not all classic_msg received" );
+					ensure( messages_to_send == m_expected_mpmc,
+							"not all user_msg received" );
+					ensure( messages_to_send == m_expected_filtered,
+							"not all filtered classic_msg received" );
+
+					so_deregister_agent_coop_normally();
+				} );
+
+		so_subscribe( m_mpmc_mbox )
+			.event( [this]( mhood_t<user_msg> cmd ) {
+					ensure( m_expected_mpmc == cmd->m_value,
+							"unexpected user_msg value" );
+					++m_expected_mpmc;
+				} )
+			.event( [this]( mhood_t<classic_msg> cmd ) {
+					ensure( m_expected_filtered == cmd->m_value,
+							"unexpected filtered classic_msg value" );
+					m_expected_filtered += 2;
+				} );
+
+		so_set_delivery_filter( m_mpmc_mbox,
+				[]( const classic_msg & msg ) { return 0 == msg.m_value % 2; } );
+	}
+};
+
+class sender_t final : public so_5::agent_t
+{
+	const so_5::mbox_t m_receiver;
+	const so_5::mbox_t m_mpmc_mbox;
+
+public:
+	sender_t(
+		context_t ctx,
+		so_5::mbox_t receiver,
+		so_5::mbox_t mpmc_mbox )
+		:	so_5::agent_t{ std::move(ctx) }
+		,	m_receiver{ std::move(receiver) }
+		,	m_mpmc_mbox{ std::move(mpmc_mbox) }
+	{}
+
+	void
+	so_evt_start() override
+	{
+		std::vector< int > values;
+		for( int i = 0; i != messages_to_send; ++i )
+			values.push_back( i );
+
+		// Several batches of different sizes.
+		so_5::send_batch< classic_msg >( m_receiver,
+				std::vector< int >( values.begin(), values.begin() + 7 ) );
+		so_5::send_batch< classic_msg >( m_receiver,
+				std::vector< int >( values.begin() + 7, values.end() ) );
+
+		std::list< user_msg > user_values;
+		for( int i = 0; i != messages_to_send; ++i )
+			user_values.push_back( user_msg{ i } );
+		so_5::send_batch< user_msg >( m_mpmc_mbox, user_values );
+
+		// Only even values have to pass the delivery filter.
+		so_5::send_batch< classic_msg >( m_mpmc_mbox, values );
+		so_5::send_batch< classic_msg >( m_mpmc_mbox,
+				std::vector< int >( 1, messages_to_send + 1 ) );
+
+		// An empty batch does nothing.
+		so_5::send_batch< classic_msg >( m_receiver, std::vector< int >{} );
+
+		so_5::send< finish >( m_receiver );
+	}
+};
+
+void
+run_delivery_test(
+	so_5::environment_t & env,
+	std::function< so_5::disp_binder_shptr_t() > binder_maker )
+{
+	env.introduce_coop(
+			binder_maker(),
+			[&env]( so_5::coop_t & coop ) {
+				auto mpmc_mbox = env.create_mbox();
+				auto receiver = coop.make_agent< receiver_t >( mpmc_mbox )
+						->so_direct_mbox();
+
+				coop.make_agent< sender_t >( receiver, mpmc_mbox );
+			} );
+}
+
+class limited_receiver_t final : public so_5::agent_t
+{
+	int m_received{};
+
+public:
+	limited_receiver_t( context_t ctx )
+		:	so_5::agent_t{ ctx
+				+ limit_then_drop< classic_msg >( 5u )
+				+ limit_then_abort< finish >( 1u ) }
+	{}
+
+	void
+	so_define_agent() override
+	{
+		so_subscribe_self()
+			.event( [this]( mhood_t<classic_msg> cmd ) {
+					ensure( m_received == cmd->m_value,
+							"unexpected classic_msg value" );
+					++m_received;
+				} )
+			.event( [this]( mhood_t<finish> ) {
+					ensure( 5 == m_received,
+							"exactly 5 messages have to be received" );
+
+					so_deregister_agent_coop_normally();
+				} );
+	}
+};
+
+class limited_sender_t final : public so_5::agent_t
+{
+	const so_5::mbox_t m_receiver;
+
+public:
+	limited_sender_t( context_t ctx, so_5::mbox_t receiver )
+		:	so_5::agent_t{ std::move(ctx) }
+		,	m_receiver{ std::move(receiver) }
+	{}
+
+	void
+	so_evt_start() override
+	{
+		so_5::send_batch< classic_msg >( m_receiver,
+				std::vector< int >{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 } );
+		so_5::send< finish >( m_receiver );
+	}
+};
+
+void
+run_limit_test( so_5::environment_t & env )
+{
+	// All agents are bound to the same one_thread dispatcher,
+	// so the receiver can't handle any message before the whole
+	// batch is pushed.
+	env.introduce_coop(
+			so_5::disp::one_thread::make_dispatcher( env ).binder(),
+			[]( so_5::coop_t & coop ) {
+				auto receiver = coop.make_agent< limited_receiver_t >()
+						->so_direct_mbox();
+
+				coop.make_agent< limited_sender_t >( receiver );
+			} );
+}
+
+int
+main()
+{
+	run_with_time_limit( [] {
+				so_5::launch( []( so_5::environment_t & env ) {
+						run_delivery_test( env, [&env] {
+								return so_5::disp::one_thread::make_dispatcher( env )
+										.binder();
+							} );
+						run_delivery_test( env, [&env] {
+								return so_5::disp::thread_pool::make_dispatcher( env, 2u )
+										.binder( []( auto & params ) {
+												params.fifo(
+														so_5::disp::thread_pool::fifo_t::cooperation );
+											} );
+							} );
+						run_delivery_test( env, [&env] {
+								return so_5::disp::adv_thread_pool::make_dispatcher( env, 2u )
+										.binder( []( auto & params ) {
+												params.fifo(
+														so_5::disp::adv_thread_pool::fifo_t::cooperation );
+											} );
+							} );
+
+						run_limit_test( env );
+					} );
+			},
+			20 );
+
+	return 0;
+}
@@ -0,0 +1,131 @@
+/*
+ * A test for the cache of resolved event handlers.
+ */
+
+#include <so_5/all.hpp>
+
+#include <test/3rd_party/various_helpers/time_limited_execution.hpp>
+#include <test/3rd_party/various_helpers/ensure.hpp>
+
+#include <string>
+
+class a_test_t final : public so_5::agent_t
+{
+	struct probe final : public so_5::signal_t {};
+	struct step final : public so_5::signal_t {};
+
+	state_t st_top{ this, "top" };
+	state_t st_mid{ initial_substate_of{ st_top }, "mid" };
+	state_t st_leaf{ initial_substate_of{ st_mid }, "leaf" };
+	state_t st_sibling{ substate_of{ st_top }, "sibling" };
+	state_t st_other{ this, "other" };
+
+	std::string & m_log;
+	int m_step{};
+
+public :
+	a_test_t( context_t ctx, std::string & log )
+		:	so_5::agent_t{ with_handler_cache( std::move(ctx) ) }
+		,	m_log{ log }
+	{}
+
+	void
+	so_define_agent() override
+	{
+		st_top.event( [this](mhood_t< probe >) { m_log += "top;"; } );
+
+		so_subscribe_deadletter_handler( so_direct_mbox(),
+				[this](mhood_t< probe >) { m_log += "dead;"; } );
+		so_subscribe_deadletter_handler( so_direct_mbox(),
+				[this](mhood_t< step >) { on_step(); } );
+	}
+
+	void
+	so_evt_start() override
+	{
+		so_5::send< step >( *this );
+	}
+
+private :
+	static context_t
+	with_handler_cache( context_t ctx )
+	{
+		ctx.options().resolved_handler_cache( true );
+		return ctx;
+	}
+
+	void
+	on_step()
+	{
+		switch( m_step++ )
+		{
+		case 0: this >>= st_leaf; break;
+
+		case 1:
+			// New subscription has to invalidate the cache.
+			st_leaf.event( [this](mhood_t< probe >) { m_log += "leaf;"; } );
+		break;
+
+		case 2: this >>= st_sibling; break;
+
+		case 3: this >>= st_leaf; break;
+
+		case 4:
+			// Removal of subscription has to invalidate the cache.
+			so_drop_subscription< probe >( so_direct_mbox(), st_leaf );
+		break;
+
+		case 5: this >>= st_other; break;
+
+		case 6: this >>= st_leaf; break;
+
+		default:
+			so_deregister_agent_coop_normally();
+			return;
+		}
+
+		so_5::send< probe >( *this );
+		so_5::send< step >( *this );
+	}
+};
+
+class null_tracer_t final : public so_5::msg_tracing::tracer_t
+{
+public :
+	void
+	trace( const std::string & ) noexcept override {}
+};
+
+void
+run_test( bool msg_tracing )
+{
+	std::string log;
+
+	so_5::launch( [&log]( so_5::environment_t & env ) {
+			env.introduce_coop( [&log]( so_5::coop_t & coop ) {
+					coop.make_agent< a_test_t >( std::ref(log) );
+				} );
+		},
+		[msg_tracing]( so_5::environment_params_t & params ) {
+			if( msg_tracing )
+				params.message_delivery_tracer(
+						std::make_unique< null_tracer_t >() );
+		} );
+
+	const std::string expected = "top;leaf;top;leaf;top;dead;top;";
+	ensure( expected == log,
+			"unexpected log (msg_tracing=" + std::to_string( msg_tracing ) +
+			"): " + log );
+}
+
+int
+main()
+{
+	run_with_time_limit( [] {
+				run_test( false );
+				run_test( true );
+			},
+			20 );
+
+	return 0;
+}